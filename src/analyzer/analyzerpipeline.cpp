@@ -0,0 +1,207 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <algorithm>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// The number of stage threads that are not used by any pipeline
+std::atomic<int>& availableStageThreads() {
+    static std::atomic<int> s_availableStageThreads(
+            AnalyzerPipeline::maxStageThreads());
+    return s_availableStageThreads;
+}
+
+int acquireStageThreads(int numThreads) {
+    auto& available = availableStageThreads();
+    int expected = available.load();
+    int acquired;
+    do {
+        acquired = math_min(expected, numThreads);
+    } while (!available.compare_exchange_weak(expected, expected - acquired));
+    return acquired;
+}
+
+void releaseStageThreads(int numThreads) {
+    availableStageThreads().fetch_add(numThreads);
+}
+
+} // anonymous namespace
+
+class AnalyzerPipeline::StageThread : public QThread {
+  public:
+    StageThread(AnalyzerPipeline* pPipeline, int index)
+            : m_consumedBlocks(0),
+              m_pPipeline(pPipeline) {
+        setObjectName(QStringLiteral("AnalyzerPipeline %1").arg(index));
+    }
+
+    void addAnalyzer(AnalyzerWithState* pAnalyzer) {
+        m_analyzers.push_back(pAnalyzer);
+    }
+
+    const std::vector<AnalyzerWithState*>& analyzers() const {
+        return m_analyzers;
+    }
+
+    // Only accessed while holding the mutex of the pipeline
+    quint64 m_consumedBlocks;
+
+  protected:
+    void run() override {
+        m_pPipeline->runStage(this);
+    }
+
+  private:
+    AnalyzerPipeline* const m_pPipeline;
+    std::vector<AnalyzerWithState*> m_analyzers;
+};
+
+// static
+int AnalyzerPipeline::maxStageThreads() {
+    return math_max(1, QThread::idealThreadCount());
+}
+
+AnalyzerPipeline::AnalyzerPipeline(
+        std::vector<AnalyzerWithState>* pAnalyzers,
+        int numBlocks,
+        SINT samplesPerBlock)
+        : m_publishedBlocks(0),
+          m_suspended(false),
+          m_quit(false),
+          m_discard(false) {
+    DEBUG_ASSERT(pAnalyzers);
+    DEBUG_ASSERT(numBlocks > 0);
+    const int numStages =
+            acquireStageThreads(static_cast<int>(pAnalyzers->size()));
+    if (numStages <= 0) {
+        return;
+    }
+    m_blocks.reserve(numBlocks);
+    for (int i = 0; i < numBlocks; ++i) {
+        m_blocks.emplace_back(samplesPerBlock);
+    }
+    m_stages.reserve(numStages);
+    for (int i = 0; i < numStages; ++i) {
+        m_stages.push_back(std::make_unique<StageThread>(this, i));
+    }
+    // Distribute the analyzers evenly if there are less stages
+    for (std::size_t i = 0; i < pAnalyzers->size(); ++i) {
+        m_stages[i % m_stages.size()]->addAnalyzer(&(*pAnalyzers)[i]);
+    }
+    // Inherit the priority of the producer thread
+    for (const auto& pStage : m_stages) {
+        pStage->start();
+    }
+}
+
+AnalyzerPipeline::~AnalyzerPipeline() {
+    discard();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_quit = true;
+    }
+    m_blockPublished.notify_all();
+    for (const auto& pStage : m_stages) {
+        pStage->wait();
+    }
+    releaseStageThreads(numStages());
+}
+
+void AnalyzerPipeline::suspend() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_suspended = true;
+}
+
+void AnalyzerPipeline::resume() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_suspended = false;
+    }
+    m_blockPublished.notify_all();
+}
+
+mixxx::SampleBuffer::WritableSlice AnalyzerPipeline::nextWritableBlock() {
+    DEBUG_ASSERT(!m_blocks.empty());
+    std::unique_lock<std::mutex> lock(m_mutex);
+    Block& block = m_blocks[m_publishedBlocks % m_blocks.size()];
+    m_blockConsumed.wait(lock, [&block] { return block.pendingStages == 0; });
+    return mixxx::SampleBuffer::WritableSlice(block.buffer);
+}
+
+void AnalyzerPipeline::publishBlock(const CSAMPLE* pSamples, SINT sampleCount) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Block& block = m_blocks[m_publishedBlocks % m_blocks.size()];
+        DEBUG_ASSERT(block.pendingStages == 0);
+        DEBUG_ASSERT(sampleCount <= block.buffer.size());
+        block.pSamples = pSamples;
+        block.sampleCount = sampleCount;
+        block.pendingStages = static_cast<int>(m_stages.size());
+        if (block.pendingStages == 0) {
+            // Nothing to do
+            return;
+        }
+        ++m_publishedBlocks;
+    }
+    m_blockPublished.notify_all();
+}
+
+bool AnalyzerPipeline::allBlocksConsumed() const {
+    for (const auto& block : m_blocks) {
+        if (block.pendingStages > 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void AnalyzerPipeline::drain() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_blockConsumed.wait(lock, [this] { return allBlocksConsumed(); });
+}
+
+void AnalyzerPipeline::discard() {
+    {
+        // Suspended stages need to skip their pending blocks
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_discard.store(true);
+    }
+    m_blockPublished.notify_all();
+    drain();
+    m_discard.store(false);
+}
+
+void AnalyzerPipeline::runStage(StageThread* pStage) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+        m_blockPublished.wait(lock, [this, pStage] {
+            return m_quit ||
+                    (pStage->m_consumedBlocks < m_publishedBlocks &&
+                            (!m_suspended || m_discard.load()));
+        });
+        if (m_quit) {
+            return;
+        }
+        Block& block = m_blocks[pStage->m_consumedBlocks % m_blocks.size()];
+        lock.unlock();
+        // The block is not modified by the producer until all stages
+        // have consumed it.
+        for (auto* pAnalyzer : pStage->analyzers()) {
+            if (m_discard.load()) {
+                break;
+            }
+            pAnalyzer->processSamples(
+                    block.pSamples,
+                    static_cast<int>(block.sampleCount));
+        }
+        lock.lock();
+        ++pStage->m_consumedBlocks;
+        DEBUG_ASSERT(block.pendingStages > 0);
+        if (--block.pendingStages == 0) {
+            m_blockConsumed.notify_all();
+        }
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <QThread>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "analyzer/analyzer.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+/// Runs multiple analyzers concurrently on the same stream of decoded
+/// audio data.
+///
+/// The producer (the AnalyzerThread) decodes into a ring of reusable
+/// blocks. Each analyzer is a separate stage with its own thread that
+/// consumes all blocks in order. A block is reused after all stages have
+/// consumed it, i.e. the producer is blocked while the slowest analyzer
+/// lags behind by more than the number of blocks. The wall-clock time
+/// for analyzing a track is then determined by the slowest analyzer and
+/// not by the sum of all analyzers.
+///
+/// Analyzers are only accessed by their stage thread between the first
+/// published block and the return from drain(). Before and after that
+/// they are owned by the producer thread.
+///
+/// The total number of stage threads of all pipelines is limited to
+/// maxStageThreads(). Analyzers share a stage thread when the limit is
+/// reached.
+class AnalyzerPipeline {
+  public:
+    /// Starts a stage thread for each analyzer unless the limit for the
+    /// total number of stage threads has been reached. The analyzers
+    /// must outlive the pipeline.
+    AnalyzerPipeline(
+            std::vector<AnalyzerWithState>* pAnalyzers,
+            int numBlocks,
+            SINT samplesPerBlock);
+    ~AnalyzerPipeline();
+
+    /// The maximum number of stage threads of all pipelines
+    static int maxStageThreads();
+
+    /// The number of stage threads of this pipeline. No blocks can be
+    /// published if no stage thread was available.
+    int numStages() const {
+        return static_cast<int>(m_stages.size());
+    }
+
+    /// Stops the stages from consuming blocks until resume() is called.
+    /// Blocks that are currently processed are finished.
+    void suspend();
+    void resume();
+
+    /// Returns the next block for writing by the producer. Blocks while
+    /// the stages have not consumed it yet.
+    mixxx::SampleBuffer::WritableSlice nextWritableBlock();
+
+    /// Passes the samples that have been written into the block returned
+    /// by nextWritableBlock() to all stages.
+    void publishBlock(const CSAMPLE* pSamples, SINT sampleCount);
+
+    /// Waits until all stages have consumed all published blocks.
+    void drain();
+
+    /// Waits until all stages are idle without processing the blocks
+    /// that are still pending, e.g. when the analysis is cancelled.
+    void discard();
+
+  private:
+    class StageThread;
+
+    struct Block {
+        explicit Block(SINT size)
+                : buffer(size),
+                  pSamples(nullptr),
+                  sampleCount(0),
+                  pendingStages(0) {
+        }
+        mixxx::SampleBuffer buffer;
+        const CSAMPLE* pSamples;
+        SINT sampleCount;
+        int pendingStages;
+    };
+
+    void runStage(StageThread* pStage);
+    bool allBlocksConsumed() const;
+
+    std::vector<Block> m_blocks;
+    std::vector<std::unique_ptr<StageThread>> m_stages;
+
+    std::mutex m_mutex;
+    std::condition_variable m_blockPublished;
+    std::condition_variable m_blockConsumed;
+    quint64 m_publishedBlocks;
+    bool m_suspended;
+    bool m_quit;
+
+    std::atomic<bool> m_discard;
+};
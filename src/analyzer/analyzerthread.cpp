@@ -36,6 +36,10 @@ mixxx::Logger kLogger("AnalyzerThread");
 // continuous feedback.
 const mixxx::Duration kBusyProgressInhibitDuration = mixxx::Duration::fromMillis(60);
 
+// Number of decoded chunks the fastest analyzer may run ahead of the
+// slowest analyzer in pipelined mode.
+constexpr int kPipelineBlocks = 16;
+
 void deleteAnalyzerThread(AnalyzerThread* plainPtr) {
     if (plainPtr) {
         plainPtr->deleteAfterFinished();
@@ -84,7 +88,6 @@ AnalyzerThread::AnalyzerThread(
           m_pConfig(pConfig),
           m_modeFlags(modeFlags),
           m_nextTrack(2), // minimum capacity
-          m_sampleBuffer(mixxx::kAnalysisSamplesPerChunk),
           m_emittedState(AnalyzerThreadState::Void) {
     std::call_once(registerMetaTypesOnceFlag, registerMetaTypesOnce);
 }
@@ -120,6 +123,26 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(!m_analyzers.empty());
     kLogger.debug() << "Activated" << m_analyzers.size() << "analyzers";
 
+    if ((m_modeFlags & AnalyzerModeFlags::Pipelined) && m_analyzers.size() > 1) {
+        auto pPipeline = std::make_unique<AnalyzerPipeline>(
+                &m_analyzers,
+                kPipelineBlocks,
+                mixxx::kAnalysisSamplesPerChunk);
+        if (pPipeline->numStages() > 0) {
+            std::lock_guard<std::mutex> lock(m_pipelineMutex);
+            if (isSuspended()) {
+                pPipeline->suspend();
+            }
+            m_pPipeline = std::move(pPipeline);
+        } else {
+            kLogger.info()
+                    << "No analyzer stage threads available, analyzing sequentially";
+        }
+    }
+    if (!m_pPipeline) {
+        mixxx::SampleBuffer(mixxx::kAnalysisSamplesPerChunk).swap(m_sampleBuffer);
+    }
+
     m_lastBusyProgressEmittedTimer.start();
 
     mixxx::AudioSource::OpenParams openParams;
@@ -154,6 +177,14 @@ void AnalyzerThread::doRun() {
         if (processTrack) {
             const auto analysisResult = analyzeAudioSource(audioSource);
             DEBUG_ASSERT(analysisResult != AnalysisResult::Pending);
+            if (m_pPipeline) {
+                // Take back the analyzers from the pipeline stages
+                if (analysisResult == AnalysisResult::Finished) {
+                    m_pPipeline->drain();
+                } else {
+                    m_pPipeline->discard();
+                }
+            }
             if (analysisResult == AnalysisResult::Finished) {
                 // The analysis has been finished, and is either complete without
                 // any errors or partial if it has been aborted due to a corrupt
@@ -181,6 +212,10 @@ void AnalyzerThread::doRun() {
     DEBUG_ASSERT(!m_currentTrack);
     DEBUG_ASSERT(isStopping());
 
+    {
+        std::lock_guard<std::mutex> lock(m_pipelineMutex);
+        m_pPipeline.reset();
+    }
     m_analyzers.clear();
 
     kLogger.debug() << "Exiting worker thread";
@@ -203,6 +238,24 @@ bool AnalyzerThread::submitNextTrack(TrackPointer nextTrack) {
     return false;
 }
 
+void AnalyzerThread::suspend() {
+    WorkerThread::suspend();
+    std::lock_guard<std::mutex> lock(m_pipelineMutex);
+    if (m_pPipeline) {
+        m_pPipeline->suspend();
+    }
+}
+
+void AnalyzerThread::resume() {
+    {
+        std::lock_guard<std::mutex> lock(m_pipelineMutex);
+        if (m_pPipeline) {
+            m_pPipeline->resume();
+        }
+    }
+    WorkerThread::resume();
+}
+
 WorkerThread::TryFetchWorkItemsResult AnalyzerThread::tryFetchWorkItems() {
     DEBUG_ASSERT(!m_currentTrack);
     TrackPointer* pFront = m_nextTrack.front();
@@ -248,12 +301,16 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
                         math_min(mixxx::kAnalysisFramesPerChunk, remainingFrameRange.length()));
         DEBUG_ASSERT(!chunkFrameRange.empty());
 
-        // Request the next chunk of audio data
+        // Request the next chunk of audio data. In pipelined mode the
+        // block is only reused after all analyzers have consumed it.
+        const auto writableSlice = m_pPipeline
+                ? m_pPipeline->nextWritableBlock()
+                : mixxx::SampleBuffer::WritableSlice(m_sampleBuffer);
         const auto readableSampleFrames =
                 audioSourceProxy.readSampleFrames(
                         mixxx::WritableSampleFrames(
                                 chunkFrameRange,
-                                mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+                                writableSlice));
         // The returned range fits into the requested range
         DEBUG_ASSERT(readableSampleFrames.frameIndexRange().isSubrangeOf(chunkFrameRange));
 
@@ -297,7 +354,13 @@ AnalyzerThread::AnalysisResult AnalyzerThread::analyzeAudioSource(
         }
 
         // 2nd: step: Analyze chunk of decoded audio data
-        if (!readableSampleFrames.frameIndexRange().empty()) {
+        if (readableSampleFrames.frameIndexRange().empty()) {
+            // Nothing to analyze
+        } else if (m_pPipeline) {
+            m_pPipeline->publishBlock(
+                    readableSampleFrames.readableData(),
+                    readableSampleFrames.readableLength());
+        } else {
             for (auto&& analyzer : m_analyzers) {
                 analyzer.processSamples(
                         readableSampleFrames.readableData(),
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <mutex>
 #include <vector>
 
 #include "analyzer/analyzer.h"
+#include "analyzer/analyzerpipeline.h"
 #include "analyzer/analyzerprogress.h"
 #include "preferences/usersettings.h"
 #include "rigtorp/SPSCQueue.h"
@@ -20,6 +22,8 @@ enum AnalyzerModeFlags {
     WithBeats = 0x01,
     WithWaveform = 0x02,
     LowPriority = 0x04,
+    // Run all analyzers concurrently on separate threads
+    Pipelined = 0x08,
     All = WithBeats | WithWaveform,
 };
 
@@ -77,6 +81,10 @@ class AnalyzerThread : public WorkerThread {
     // worker thread, yet.
     bool submitNextTrack(TrackPointer nextTrack);
 
+    // Also suspends/resumes the stage threads in pipelined mode
+    void suspend() override;
+    void resume() override;
+
   signals:
     // Use a single signal for progress updates to ensure that all signals
     // are queued and received in the same order as emitted from the internal
@@ -116,6 +124,13 @@ class AnalyzerThread : public WorkerThread {
 
     std::vector<AnalyzerWithState> m_analyzers;
 
+    // Only created in pipelined mode. The pointer is guarded by the
+    // mutex, because the pipeline is suspended and resumed from the
+    // host thread.
+    std::unique_ptr<AnalyzerPipeline> m_pPipeline;
+    std::mutex m_pipelineMutex;
+
+    // Only allocated if not pipelined
     mixxx::SampleBuffer m_sampleBuffer;
 
     TrackPointer m_currentTrack;
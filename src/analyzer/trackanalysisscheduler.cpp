@@ -1,5 +1,8 @@
 #include "analyzer/trackanalysisscheduler.h"
 
+#include <algorithm>
+
+#include "control/controlobject.h"
 #include "moc_trackanalysisscheduler.cpp"
 #include "track/track.h"
 #include "util/logger.h"
@@ -34,13 +37,15 @@ TrackAnalysisScheduler::Pointer TrackAnalysisScheduler::createInstance(
         int numWorkerThreads,
         const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
         const UserSettingsPointer& pConfig,
-        AnalyzerModeFlags modeFlags) {
+        AnalyzerModeFlags modeFlags,
+        const QString& group) {
     return Pointer(new TrackAnalysisScheduler(
                            std::move(pEnvironment),
                            numWorkerThreads,
                            pDbConnectionPool,
                            pConfig,
-                           modeFlags),
+                           modeFlags,
+                           group),
             deleteTrackAnalysisScheduler);
 }
 
@@ -49,14 +54,26 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
         int numWorkerThreads,
         const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
         const UserSettingsPointer& pConfig,
-        AnalyzerModeFlags modeFlags)
+        AnalyzerModeFlags modeFlags,
+        const QString& group)
         : m_pEnvironment(std::move(pEnvironment)),
+          m_pDbConnectionPool(pDbConnectionPool),
+          m_pConfig(pConfig),
+          m_modeFlags(modeFlags),
+          m_maxActiveWorkers(numWorkerThreads),
+          m_suspended(false),
+          m_pAnalysisProgress(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("analysis_progress")))),
+          m_pAnalysisQueueDepth(std::make_unique<ControlObject>(
+                  ConfigKey(group, QStringLiteral("analysis_queue_depth")))),
           m_currentTrackProgress(kAnalyzerProgressUnknown),
           m_currentTrackNumber(0),
           m_dequeuedTracksCount(0),
           // The first signal should always be emitted
           m_lastProgressEmittedAt(Clock::now() - kProgressInhibitDuration) {
     DEBUG_ASSERT(m_pEnvironment);
+    m_pAnalysisProgress->setReadOnly();
+    m_pAnalysisQueueDepth->setReadOnly();
     VERIFY_OR_DEBUG_ASSERT(numWorkerThreads > 0) {
             kLogger.warning()
                     << "Invalid number of worker threads:"
@@ -68,28 +85,69 @@ TrackAnalysisScheduler::TrackAnalysisScheduler(
                 << "worker threads. Priority: "
                 << (modeFlags & AnalyzerModeFlags::LowPriority ? "low" : "normal");
     }
-    // 1st pass: Create worker threads
-    m_workers.reserve(numWorkerThreads);
-    for (int threadId = 0; threadId < numWorkerThreads; ++threadId) {
-        m_workers.emplace_back(AnalyzerThread::createInstance(
-                threadId,
-                pDbConnectionPool,
-                pConfig,
-                modeFlags));
-        connect(m_workers.back().thread(),
-                &AnalyzerThread::progress,
-                this,
-                &TrackAnalysisScheduler::onWorkerThreadProgress);
-    }
-    // 2nd pass: Start worker threads in a suspended state
-    for (const auto& worker: m_workers) {
-        worker.thread()->suspend();
-        worker.thread()->start(kWorkerThreadPriority);
+    // The additional worker thread that picks up tracks with a higher
+    // priority while the other workers are preempted is started on demand
+    m_workers.reserve(numWorkerThreads + 1);
+    for (int i = 0; i < numWorkerThreads; ++i) {
+        addWorker();
+    }
+    instances().push_back(this);
+}
+
+// static
+std::vector<TrackAnalysisScheduler*>& TrackAnalysisScheduler::instances() {
+    static std::vector<TrackAnalysisScheduler*> s_instances;
+    return s_instances;
+}
+
+void TrackAnalysisScheduler::addWorker() {
+    const int threadId = static_cast<int>(m_workers.size());
+    m_workers.emplace_back(AnalyzerThread::createInstance(
+            threadId,
+            m_pDbConnectionPool,
+            m_pConfig,
+            m_modeFlags));
+    AnalyzerThread* const pThread = m_workers.back().thread();
+    connect(pThread,
+            &AnalyzerThread::progress,
+            this,
+            &TrackAnalysisScheduler::onWorkerThreadProgress);
+    // Start the worker thread in a suspended state
+    pThread->suspend();
+    pThread->start(kWorkerThreadPriority);
+}
+
+void TrackAnalysisScheduler::addReservedWorkerOnDemand() {
+    if (m_suspended ||
+            static_cast<int>(m_workers.size()) > m_maxActiveWorkers) {
+        return;
+    }
+    const auto queuedPriority = highestQueuedPriority();
+    if (!queuedPriority) {
+        return;
+    }
+    for (const auto& worker : m_workers) {
+        if (!worker ||
+                !worker.hasTrack() ||
+                worker.trackPriority() <= *queuedPriority) {
+            // Either an idle worker picks up the track or the
+            // track would not preempt this worker
+            return;
+        }
     }
+    kLogger.debug()
+            << "Starting additional worker thread for track with priority"
+            << static_cast<int>(*queuedPriority);
+    addWorker();
+    // The new worker picks up the track after it has become idle
+    m_workers.back().resumeThread();
 }
 
 TrackAnalysisScheduler::~TrackAnalysisScheduler() {
     kLogger.debug() << "Destroying";
+    auto& schedulers = instances();
+    schedulers.erase(std::remove(schedulers.begin(), schedulers.end(), this),
+            schedulers.end());
 }
 
 void TrackAnalysisScheduler::emitProgressOrFinished() {
@@ -99,6 +157,9 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
         m_currentTrackProgress = kAnalyzerProgressUnknown;
         m_currentTrackNumber = 0;
         m_dequeuedTracksCount = 0;
+        if (m_pAnalysisProgress) {
+            m_pAnalysisProgress->forceSet(0.0);
+        }
         emit finished();
         return;
     }
@@ -168,9 +229,16 @@ void TrackAnalysisScheduler::emitProgressOrFinished() {
         }
     }
     const int totalTracksCount =
-            m_dequeuedTracksCount + static_cast<int>(m_queuedTrackIds.size());
+            m_dequeuedTracksCount + queuedTracksCount();
     DEBUG_ASSERT(m_currentTrackNumber <= m_dequeuedTracksCount);
     DEBUG_ASSERT(m_dequeuedTracksCount <= totalTracksCount);
+    if (m_pAnalysisProgress && totalTracksCount > 0) {
+        // The current track number starts at 1
+        const double completedTracks =
+                math_max(0, m_currentTrackNumber - 1) +
+                math_max(kAnalyzerProgressNone, m_currentTrackProgress);
+        m_pAnalysisProgress->forceSet(math_min(1.0, completedTracks / totalTracksCount));
+    }
     emit progress(
             m_currentTrackProgress,
             m_currentTrackNumber,
@@ -199,7 +267,9 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
         DEBUG_ASSERT(!trackId.isValid());
         DEBUG_ASSERT(analyzerProgress == kAnalyzerProgressUnknown);
         worker.onAnalyzerProgress(analyzerProgress);
+        worker.onTrackDone();
         submitNextTrack(&worker);
+        updatePreemption();
         break;
     case AnalyzerThreadState::Busy:
         DEBUG_ASSERT(trackId.isValid());
@@ -219,6 +289,9 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
                     || (analyzerProgress == kAnalyzerProgressUnknown)); // failure
             m_pendingTrackIds.erase(trackId);
             worker.onAnalyzerProgress(analyzerProgress);
+            worker.onTrackDone();
+            updatePreemption();
+            updateQueueDepth();
             emit trackProgress(trackId, analyzerProgress);
         }
         break;
@@ -234,14 +307,15 @@ void TrackAnalysisScheduler::onWorkerThreadProgress(
     emitProgressOrFinished();
 }
 
-bool TrackAnalysisScheduler::scheduleTrackById(TrackId trackId) {
+bool TrackAnalysisScheduler::scheduleTrackById(TrackId trackId, Priority priority) {
     VERIFY_OR_DEBUG_ASSERT(trackId.isValid()) {
         qWarning()
                 << "Cannot schedule track with invalid id"
                 << trackId;
         return false;
     }
-    m_queuedTrackIds.push_back(trackId);
+    m_queuedTrackIds[static_cast<int>(priority)].push_back(trackId);
+    updateQueueDepth();
     // Don't wake up the suspended thread now to avoid race conditions
     // if multiple threads are added in a row by calling this function
     // multiple times. The caller is responsible to finish the scheduling
@@ -249,10 +323,11 @@ bool TrackAnalysisScheduler::scheduleTrackById(TrackId trackId) {
     return true;
 }
 
-int TrackAnalysisScheduler::scheduleTracksById(const QList<TrackId>& trackIds) {
+int TrackAnalysisScheduler::scheduleTracksById(
+        const QList<TrackId>& trackIds, Priority priority) {
     int scheduledCount = 0;
     for (auto trackId: trackIds) {
-        if (scheduleTrackById(std::move(trackId))) {
+        if (scheduleTrackById(std::move(trackId), priority)) {
             ++scheduledCount;
         }
     }
@@ -261,6 +336,7 @@ int TrackAnalysisScheduler::scheduleTracksById(const QList<TrackId>& trackIds) {
 
 void TrackAnalysisScheduler::suspend() {
     kLogger.debug() << "Suspending";
+    m_suspended = true;
     for (auto& worker: m_workers) {
         worker.suspendThread();
     }
@@ -268,23 +344,194 @@ void TrackAnalysisScheduler::suspend() {
 
 void TrackAnalysisScheduler::resume() {
     kLogger.debug() << "Resuming";
+    m_suspended = false;
+    // Newly scheduled tracks might preempt running workers
+    updatePreemption();
     for (auto& worker: m_workers) {
-        worker.resumeThread();
+        if (!worker.isPreempted()) {
+            worker.resumeThread();
+        }
+    }
+}
+
+std::optional<TrackAnalysisScheduler::Priority>
+TrackAnalysisScheduler::highestQueuedPriority() const {
+    for (int priority = 0; priority < kPriorityCount; ++priority) {
+        if (!m_queuedTrackIds[priority].empty()) {
+            return static_cast<Priority>(priority);
+        }
+    }
+    return std::nullopt;
+}
+
+int TrackAnalysisScheduler::queuedTracksCount() const {
+    int count = 0;
+    for (const auto& queue : m_queuedTrackIds) {
+        count += static_cast<int>(queue.size());
+    }
+    return count;
+}
+
+void TrackAnalysisScheduler::updateQueueDepth() {
+    if (m_pAnalysisQueueDepth) {
+        m_pAnalysisQueueDepth->forceSet(
+                queuedTracksCount() + static_cast<int>(m_pendingTrackIds.size()));
+    }
+}
+
+// static
+std::vector<bool> TrackAnalysisScheduler::selectPreemptedWorkers(
+        const std::vector<std::optional<Priority>>& trackPriorities,
+        std::optional<Priority> queuedTrackPriority,
+        int maxActiveWorkers) {
+    std::vector<std::size_t> busyWorkers;
+    for (std::size_t i = 0; i < trackPriorities.size(); ++i) {
+        if (trackPriorities[i]) {
+            busyWorkers.push_back(i);
+        }
+    }
+    // Workers with the same priority keep their order to prevent
+    // that they take turns
+    std::stable_sort(busyWorkers.begin(),
+            busyWorkers.end(),
+            [&trackPriorities](std::size_t lhs, std::size_t rhs) {
+                return *trackPriorities[lhs] < *trackPriorities[rhs];
+            });
+    std::vector<bool> preempted(trackPriorities.size(), false);
+    int freeSlots = maxActiveWorkers;
+    for (const auto i : busyWorkers) {
+        if (queuedTrackPriority && *queuedTrackPriority < *trackPriorities[i]) {
+            // Reserve a slot for the queued track
+            --freeSlots;
+            queuedTrackPriority.reset();
+        }
+        preempted[i] = freeSlots <= 0;
+        --freeSlots;
+    }
+    return preempted;
+}
+
+// static
+int TrackAnalysisScheduler::maxActiveWorkersOfAllSchedulers() {
+    int maxActiveWorkers = 0;
+    for (const auto* pScheduler : instances()) {
+        maxActiveWorkers = math_max(maxActiveWorkers, pScheduler->m_maxActiveWorkers);
+    }
+    return maxActiveWorkers;
+}
+
+bool TrackAnalysisScheduler::canAnalyzeTrack(Priority priority) const {
+    int activeWorkers = 0;
+    int activeWorkersOfAllSchedulers = 0;
+    for (const auto* pScheduler : instances()) {
+        for (const auto& worker : pScheduler->m_workers) {
+            if (worker && worker.hasTrack() && worker.trackPriority() <= priority) {
+                ++activeWorkersOfAllSchedulers;
+                if (pScheduler == this) {
+                    ++activeWorkers;
+                }
+            }
+        }
+    }
+    return activeWorkers < m_maxActiveWorkers &&
+            activeWorkersOfAllSchedulers < maxActiveWorkersOfAllSchedulers();
+}
+
+void TrackAnalysisScheduler::updatePreemption() {
+    addReservedWorkerOnDemand();
+    // Busy workers of all schedulers
+    std::vector<std::pair<TrackAnalysisScheduler*, Worker*>> workers;
+    std::vector<std::optional<Priority>> trackPriorities;
+    std::optional<Priority> queuedTrackPriority;
+    for (auto* pScheduler : instances()) {
+        bool hasIdleWorker = false;
+        for (auto& worker : pScheduler->m_workers) {
+            workers.emplace_back(pScheduler, &worker);
+            // Only busy workers are preempted. Idle workers must remain
+            // available for picking up the next track with a high priority.
+            if (worker && worker.hasTrack()) {
+                trackPriorities.push_back(worker.trackPriority());
+            } else {
+                trackPriorities.push_back(std::nullopt);
+                hasIdleWorker = hasIdleWorker || static_cast<bool>(worker);
+            }
+        }
+        const auto priority = hasIdleWorker
+                ? pScheduler->highestQueuedPriority()
+                : std::nullopt;
+        if (priority && (!queuedTrackPriority || *priority < *queuedTrackPriority)) {
+            queuedTrackPriority = priority;
+        }
+    }
+    const auto preemptedWorkers = selectPreemptedWorkers(
+            trackPriorities,
+            queuedTrackPriority,
+            maxActiveWorkersOfAllSchedulers());
+    for (std::size_t i = 0; i < workers.size(); ++i) {
+        workers[i].first->setWorkerPreempted(workers[i].second, preemptedWorkers[i]);
+    }
+}
+
+void TrackAnalysisScheduler::setWorkerPreempted(Worker* worker, bool preempt) {
+    DEBUG_ASSERT(worker);
+    if (!*worker) {
+        return;
+    }
+    if (preempt == worker->isPreempted()) {
+        return;
+    }
+    worker->setPreempted(preempt);
+    if (m_suspended) {
+        // Resumed later
+        return;
+    }
+    if (preempt) {
+        kLogger.debug()
+                << "Preempting worker thread"
+                << worker->thread()->id();
+        worker->suspendThread();
+    } else {
+        kLogger.debug()
+                << "Resuming preempted worker thread"
+                << worker->thread()->id();
+        worker->resumeThread();
     }
 }
 
 bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
     DEBUG_ASSERT(worker);
-    while (!m_queuedTrackIds.empty()) {
-        TrackId nextTrackId = m_queuedTrackIds.front();
+    for (int priority = 0; priority < kPriorityCount; ++priority) {
+        if (!m_queuedTrackIds[priority].empty() &&
+                !canAnalyzeTrack(static_cast<Priority>(priority))) {
+            // All active workers analyze tracks with the same or a
+            // higher priority. Tracks in the following queues have an
+            // even lower priority.
+            return false;
+        }
+        if (submitNextTrack(worker, static_cast<Priority>(priority))) {
+            return true;
+        }
+        if (!m_queuedTrackIds[priority].empty()) {
+            // The worker is busy
+            return false;
+        }
+    }
+    return false;
+}
+
+bool TrackAnalysisScheduler::submitNextTrack(Worker* worker, Priority priority) {
+    DEBUG_ASSERT(worker);
+    auto& queuedTrackIds = m_queuedTrackIds[static_cast<int>(priority)];
+    while (!queuedTrackIds.empty()) {
+        TrackId nextTrackId = queuedTrackIds.front();
         DEBUG_ASSERT(nextTrackId.isValid());
         if (nextTrackId.isValid()) {
             TrackPointer nextTrack =
                     m_pEnvironment->loadTrackById(nextTrackId);
             if (nextTrack) {
                 if (m_pendingTrackIds.insert(nextTrackId).second) {
-                    if (worker->submitNextTrack(std::move(nextTrack))) {
-                        m_queuedTrackIds.pop_front();
+                    if (worker->submitNextTrack(std::move(nextTrack), priority)) {
+                        queuedTrackIds.pop_front();
                         ++m_dequeuedTracksCount;
                         return true;
                     } else {
@@ -315,8 +562,9 @@ bool TrackAnalysisScheduler::submitNextTrack(Worker* worker) {
                     << nextTrackId;
         }
         // Skip this track
-        m_queuedTrackIds.pop_front();
+        queuedTrackIds.pop_front();
         ++m_dequeuedTracksCount;
+        updateQueueDepth();
     }
     return false;
 }
@@ -328,7 +576,14 @@ void TrackAnalysisScheduler::stop() {
     }
     // The worker threads are still running at this point
     // and m_workers must not be modified!
-    m_queuedTrackIds.clear();
+    for (auto& queuedTrackIds : m_queuedTrackIds) {
+        queuedTrackIds.clear();
+    }
     m_pendingTrackIds.clear();
     DEBUG_ASSERT((allTracksFinished()));
+    // The scheduler cannot be restarted. Release the controls now to
+    // allow creating a new scheduler for the same group before this
+    // one has been deleted.
+    m_pAnalysisProgress.reset();
+    m_pAnalysisQueueDepth.reset();
 }
@@ -1,14 +1,20 @@
 #pragma once
 
+#include <gtest/gtest_prod.h>
+
 #include <QList>
+#include <array>
 #include <deque>
 #include <memory>
+#include <optional>
 #include <set>
 #include <vector>
 
 #include "analyzer/analyzerthread.h"
 #include "util/db/dbconnectionpool.h"
 
+class ControlObject;
+
 /// Callbacks for triggering side-effects in the outer context of
 /// TrackAnalysisScheduler.
 ///
@@ -32,25 +38,51 @@ class TrackAnalysisScheduler : public QObject {
         NullPointer();
     };
 
+    // Each priority has its own queue. Idle workers always pick the next
+    // track from the queue with the highest priority. Only numWorkerThreads
+    // workers analyze tracks at the same time, preferring tracks with a
+    // higher priority. Workers with the lowest priorities are suspended at
+    // the next chunk boundary when a track with a higher priority arrives.
+    // If all workers are busy an additional worker thread is started on
+    // demand for analyzing this track.
+    //
+    // The workers of all schedulers compete for the same CPU cores. Tracks
+    // loaded into decks by one scheduler therefore also preempt the batch
+    // analysis of another scheduler.
+    enum class Priority {
+        // Tracks loaded into decks
+        DeckLoad = 0,
+        // Tracks loaded into samplers or preview decks
+        Preview = 1,
+        // Tracks selected for batch analysis
+        Batch = 2,
+    };
+    static constexpr int kPriorityCount = 3;
+
+    // The progress and the number of queued or pending tracks are
+    // published as the controls "analysis_progress" and
+    // "analysis_queue_depth" of the given group.
     static Pointer createInstance(
             std::unique_ptr<const TrackAnalysisSchedulerEnvironment> pEnvironment,
             int numWorkerThreads,
             const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
             const UserSettingsPointer& pConfig,
-            AnalyzerModeFlags modeFlags);
+            AnalyzerModeFlags modeFlags,
+            const QString& group);
 
     /*private*/ TrackAnalysisScheduler(
             std::unique_ptr<const TrackAnalysisSchedulerEnvironment> pEnvironment,
             int numWorkerThreads,
             const mixxx::DbConnectionPoolPtr& pDbConnectionPool,
             const UserSettingsPointer& pUserSettings,
-            AnalyzerModeFlags modeFlags);
+            AnalyzerModeFlags modeFlags,
+            const QString& group);
     ~TrackAnalysisScheduler() override;
 
     // Schedule single or multiple tracks. After all tracks have been scheduled
     // the caller must invoke resume() once.
-    bool scheduleTrackById(TrackId trackId);
-    int scheduleTracksById(const QList<TrackId>& trackIds);
+    bool scheduleTrackById(TrackId trackId, Priority priority = Priority::Batch);
+    int scheduleTracksById(const QList<TrackId>& trackIds, Priority priority = Priority::Batch);
 
   public slots:
     void suspend();
@@ -81,7 +113,10 @@ class TrackAnalysisScheduler : public QObject {
       public:
         explicit Worker(AnalyzerThread::Pointer thread = AnalyzerThread::NullPointer())
             : m_thread(std::move(thread)),
-              m_analyzerProgress(kAnalyzerProgressUnknown) {
+              m_analyzerProgress(kAnalyzerProgressUnknown),
+              m_hasTrack(false),
+              m_trackPriority(Priority::Batch),
+              m_preempted(false) {
         }
         Worker(const Worker&) = delete;
         Worker(Worker&&) = default;
@@ -99,10 +134,35 @@ class TrackAnalysisScheduler : public QObject {
             return m_analyzerProgress;
         }
 
-        bool submitNextTrack(TrackPointer track) {
+        bool submitNextTrack(TrackPointer track, Priority priority) {
             DEBUG_ASSERT(track);
             DEBUG_ASSERT(m_thread);
-            return m_thread->submitNextTrack(std::move(track));
+            if (!m_thread->submitNextTrack(std::move(track))) {
+                return false;
+            }
+            m_hasTrack = true;
+            m_trackPriority = priority;
+            return true;
+        }
+
+        // The priority of the track that is currently analyzed
+        bool hasTrack() const {
+            return m_hasTrack;
+        }
+        Priority trackPriority() const {
+            DEBUG_ASSERT(m_hasTrack);
+            return m_trackPriority;
+        }
+        void onTrackDone() {
+            m_hasTrack = false;
+        }
+
+        // Suspended in favor of tracks with a higher priority
+        bool isPreempted() const {
+            return m_preempted;
+        }
+        void setPreempted(bool preempted) {
+            m_preempted = preempted;
         }
 
         void suspendThread() {
@@ -132,26 +192,87 @@ class TrackAnalysisScheduler : public QObject {
             DEBUG_ASSERT(m_thread);
             m_thread.reset();
             m_analyzerProgress = kAnalyzerProgressUnknown;
+            m_hasTrack = false;
         }
 
       private:
         AnalyzerThread::Pointer m_thread;
         AnalyzerProgress m_analyzerProgress;
+        bool m_hasTrack;
+        Priority m_trackPriority;
+        bool m_preempted;
     };
 
+    // All existing schedulers, only accessed from the host thread
+    static std::vector<TrackAnalysisScheduler*>& instances();
+
+    void addWorker();
+    // Starts the additional worker thread if a queued track has a higher
+    // priority than all busy workers
+    void addReservedWorkerOnDemand();
+
     bool submitNextTrack(Worker* worker);
+    bool submitNextTrack(Worker* worker, Priority priority);
     void emitProgressOrFinished();
 
+    // Suspends or resumes the workers of all schedulers depending on the
+    // priority of their tracks
+    void updatePreemption();
+    void setWorkerPreempted(Worker* worker, bool preempt);
+    void updateQueueDepth();
+
+    // Returns for each worker if it needs to be preempted. Only the
+    // maxActiveWorkers busy workers with the highest priorities may
+    // analyze their tracks. A queued track that is about to be picked
+    // up by an idle worker takes one of these slots if its priority is
+    // higher than that of a busy worker. Workers are idle if they have
+    // no track priority.
+    static std::vector<bool> selectPreemptedWorkers(
+            const std::vector<std::optional<Priority>>& trackPriorities,
+            std::optional<Priority> queuedTrackPriority,
+            int maxActiveWorkers);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, preemptNothingWhileNotSaturated);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, preemptOneWorkerForQueuedTrack);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, preemptWorkersWithLowestPriority);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, submitTracksInOrderOfLanes);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, deckLoadPreemptsBatchOfOtherScheduler);
+    FRIEND_TEST(TrackAnalysisSchedulerTest, startReservedWorkerOnDemand);
+
+    // A track with the given priority may only be analyzed if it will not
+    // be preempted immediately, see selectPreemptedWorkers()
+    bool canAnalyzeTrack(Priority priority) const;
+    // The number of workers of all schedulers that may analyze tracks
+    // at the same time
+    static int maxActiveWorkersOfAllSchedulers();
+
+    std::optional<Priority> highestQueuedPriority() const;
+    int queuedTracksCount() const;
+
     bool allTracksFinished() const {
-        return m_queuedTrackIds.empty() &&
+        return queuedTracksCount() == 0 &&
                 m_pendingTrackIds.empty();
     }
 
     const std::unique_ptr<const TrackAnalysisSchedulerEnvironment> m_pEnvironment;
 
+    // Needed for starting the additional worker on demand
+    const mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
+    const UserSettingsPointer m_pConfig;
+    const AnalyzerModeFlags m_modeFlags;
+
     std::vector<Worker> m_workers;
 
-    std::deque<TrackId> m_queuedTrackIds;
+    // The number of workers that may analyze tracks at the same time
+    const int m_maxActiveWorkers;
+
+    // Indexed by Priority
+    std::array<std::deque<TrackId>, kPriorityCount> m_queuedTrackIds;
+
+    // Explicitly suspended, see suspend()/resume()
+    bool m_suspended;
+
+    std::unique_ptr<ControlObject> m_pAnalysisProgress;
+    std::unique_ptr<ControlObject> m_pAnalysisQueueDepth;
 
     // Tracks that have already been submitted to workers
     // and not yet reported back as finished.
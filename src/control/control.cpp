@@ -277,6 +277,7 @@ void ControlDoublePrivate::setInner(double value, QObject* pSender) {
         return;
     }
     m_value.setValue(value);
+    m_changeCount.fetchAndAddRelease(1);
     emit valueChanged(value, pSender);
 
     if (m_bTrack) {
@@ -89,6 +89,11 @@ class ControlDoublePrivate : public QObject {
     double get() const {
         return m_value.getValue();
     }
+    // Gets a counter that is incremented on every change of the value. It
+    // allows to poll for changes without receiving valueChanged().
+    int changeCount() const {
+        return atomicLoadAcquire(m_changeCount);
+    }
     // Resets the control value to its default.
     void reset();
 
@@ -202,6 +207,8 @@ class ControlDoublePrivate : public QObject {
     ControlValueAtomic<double> m_value;
     // The default control value.
     ControlValueAtomic<double> m_defaultValue;
+    // Incremented after every change of m_value.
+    QAtomicInt m_changeCount;
 
     QSharedPointer<ControlNumericBehavior> m_pBehavior;
 };
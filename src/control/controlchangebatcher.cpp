@@ -0,0 +1,91 @@
+#include "control/controlchangebatcher.h"
+
+#include <QHash>
+#include <QPointer>
+#include <QVector>
+
+#include "control/control.h"
+#include "control/controlproxy.h"
+#include "util/assert.h"
+
+namespace {
+
+struct Subscription {
+    QSharedPointer<ControlDoublePrivate> pControl;
+    int lastChangeCount;
+    QVector<ControlProxy*> proxies;
+};
+
+bool s_enabled = false;
+
+/// The subscriptions are grouped by control, so that every control is
+/// polled only once per tick, no matter how many widgets are connected to it.
+QHash<ControlDoublePrivate*, Subscription> s_subscriptions;
+
+} // namespace
+
+// static
+bool ControlChangeBatcher::isEnabled() {
+    return s_enabled;
+}
+
+// static
+void ControlChangeBatcher::setEnabled(bool enabled) {
+    s_enabled = enabled;
+}
+
+// static
+void ControlChangeBatcher::subscribe(ControlProxy* pProxy,
+        const QSharedPointer<ControlDoublePrivate>& pControl) {
+    VERIFY_OR_DEBUG_ASSERT(pProxy && pControl) {
+        return;
+    }
+    auto it = s_subscriptions.find(pControl.data());
+    if (it == s_subscriptions.end()) {
+        it = s_subscriptions.insert(pControl.data(),
+                Subscription{pControl, pControl->changeCount(), {}});
+    }
+    DEBUG_ASSERT(!it->proxies.contains(pProxy));
+    it->proxies.append(pProxy);
+}
+
+// static
+void ControlChangeBatcher::unsubscribe(ControlProxy* pProxy, ControlDoublePrivate* pControl) {
+    const auto it = s_subscriptions.find(pControl);
+    VERIFY_OR_DEBUG_ASSERT(it != s_subscriptions.end()) {
+        return;
+    }
+    it->proxies.removeOne(pProxy);
+    if (it->proxies.isEmpty()) {
+        s_subscriptions.erase(it);
+    }
+}
+
+// static
+int ControlChangeBatcher::deliverChanges() {
+    // Collect the proxies before notifying them, because the receivers might
+    // create or delete widgets and thereby modify the subscriptions.
+    QVector<QPointer<ControlProxy>> changedProxies;
+    for (auto& subscription : s_subscriptions) {
+        const int changeCount = subscription.pControl->changeCount();
+        if (changeCount == subscription.lastChangeCount) {
+            continue;
+        }
+        subscription.lastChangeCount = changeCount;
+        for (ControlProxy* pProxy : qAsConst(subscription.proxies)) {
+            changedProxies.append(pProxy);
+        }
+    }
+
+    for (const auto& pProxy : qAsConst(changedProxies)) {
+        if (pProxy) {
+            pProxy->emitValueChanged();
+        }
+    }
+    return changedProxies.size();
+}
+
+// static
+int ControlChangeBatcher::numSubscribedControls() {
+    return s_subscriptions.size();
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <QSharedPointer>
+
+class ControlDoublePrivate;
+class ControlProxy;
+
+/// Delivers value changes of controls to ControlProxys once per GUI tick
+/// instead of once per set().
+///
+/// A proxy that is connected with ControlProxy::connectValueChangedBatched()
+/// does not receive the valueChanged() signal of its control, which would
+/// be posted as an event to the main thread for every single set() from the
+/// engine or controller threads. Instead, deliverChanges() polls the change
+/// counters of all subscribed controls and makes every proxy whose control
+/// has changed since the last tick emit valueChanged() once with the current
+/// value. Intermediate values are dropped, so this must only be used for
+/// receivers that display the value, i.e. skin widgets.
+///
+/// Batching is enabled while a GuiTick exists, which calls deliverChanges()
+/// from the main thread. All functions must be called from the main thread.
+class ControlChangeBatcher {
+  public:
+    static bool isEnabled();
+    static void setEnabled(bool enabled);
+
+    static void subscribe(ControlProxy* pProxy,
+            const QSharedPointer<ControlDoublePrivate>& pControl);
+    static void unsubscribe(ControlProxy* pProxy, ControlDoublePrivate* pControl);
+
+    /// Lets all proxies of controls that have changed since the previous
+    /// call emit valueChanged(). Returns the number of notified proxies.
+    static int deliverChanges();
+
+    static int numSubscribedControls();
+};
@@ -7,7 +7,9 @@ ControlObjectScript::ControlObjectScript(
         : ControlProxy(key, pParent, ControlFlag::AllowMissingOrInvalid),
           m_logger(logger),
           m_proxy(key, logger, this),
-          m_skipSuperseded(false) {
+          m_skipSuperseded(false),
+          m_batched(false),
+          m_lastChangeCount(0) {
 }
 
 bool ControlObjectScript::addScriptConnection(const ScriptConnection& conn) {
@@ -15,23 +17,9 @@ bool ControlObjectScript::addScriptConnection(const ScriptConnection& conn) {
         // Only connect the slots when they are actually needed
         // by script connections.
         m_skipSuperseded = conn.skipSuperseded;
-        if (conn.skipSuperseded) {
-            connect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    &m_proxy,
-                    &CompressingProxy::slotValueChanged,
-                    Qt::QueuedConnection);
-            connect(&m_proxy,
-                    &CompressingProxy::signalValueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged,
-                    Qt::DirectConnection);
-        } else {
-            connect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged,
-                    Qt::QueuedConnection);
+        m_lastChangeCount = m_pControl->changeCount();
+        if (!m_batched) {
+            connectValueChanged();
         }
         connect(this,
                 &ControlObjectScript::trigger,
@@ -42,25 +30,18 @@ bool ControlObjectScript::addScriptConnection(const ScriptConnection& conn) {
         // At least one callback function is already connected to this CO
         if (conn.skipSuperseded == false && m_skipSuperseded == true) {
             // Disconnect proxy if this is first callback function connected with skipSuperseded false
-            m_skipSuperseded = false;
             qCWarning(m_logger) << conn.key.group + ", " + conn.key.item +
                             "is connected to different callback functions with "
                             "differing state of the skipSuperseded. Disable "
                             "skipping of superseded events for all these "
                             "callback functions.";
-            disconnect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    &m_proxy,
-                    &CompressingProxy::slotValueChanged);
-            disconnect(&m_proxy,
-                    &CompressingProxy::signalValueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged);
-            connect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged,
-                    Qt::QueuedConnection);
+            if (!m_batched) {
+                disconnectValueChanged();
+            }
+            m_skipSuperseded = false;
+            if (!m_batched) {
+                connectValueChanged();
+            }
         }
     }
 
@@ -94,20 +75,8 @@ bool ControlObjectScript::removeScriptConnection(const ScriptConnection& conn) {
     }
     if (m_scriptConnections.isEmpty()) {
         // no ScriptConnections left, so disconnect signals
-        if (m_skipSuperseded) {
-            disconnect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    &m_proxy,
-                    &CompressingProxy::slotValueChanged);
-            disconnect(&m_proxy,
-                    &CompressingProxy::signalValueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged);
-        } else {
-            disconnect(m_pControl.data(),
-                    &ControlDoublePrivate::valueChanged,
-                    this,
-                    &ControlObjectScript::slotValueChanged);
+        if (!m_batched) {
+            disconnectValueChanged();
         }
         disconnect(this,
                 &ControlObjectScript::trigger,
@@ -117,6 +86,74 @@ bool ControlObjectScript::removeScriptConnection(const ScriptConnection& conn) {
     return success;
 }
 
+void ControlObjectScript::connectValueChanged() {
+    if (m_skipSuperseded) {
+        connect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                &m_proxy,
+                &CompressingProxy::slotValueChanged,
+                Qt::QueuedConnection);
+        connect(&m_proxy,
+                &CompressingProxy::signalValueChanged,
+                this,
+                &ControlObjectScript::slotValueChanged,
+                Qt::DirectConnection);
+    } else {
+        connect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                this,
+                &ControlObjectScript::slotValueChanged,
+                Qt::QueuedConnection);
+    }
+}
+
+void ControlObjectScript::disconnectValueChanged() {
+    if (m_skipSuperseded) {
+        disconnect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                &m_proxy,
+                &CompressingProxy::slotValueChanged);
+        disconnect(&m_proxy,
+                &CompressingProxy::signalValueChanged,
+                this,
+                &ControlObjectScript::slotValueChanged);
+    } else {
+        disconnect(m_pControl.data(),
+                &ControlDoublePrivate::valueChanged,
+                this,
+                &ControlObjectScript::slotValueChanged);
+    }
+}
+
+void ControlObjectScript::setBatched(bool batched) {
+    if (batched == m_batched) {
+        return;
+    }
+    m_batched = batched;
+    if (m_scriptConnections.isEmpty()) {
+        return;
+    }
+    if (batched) {
+        disconnectValueChanged();
+        m_lastChangeCount = m_pControl->changeCount();
+    } else {
+        connectValueChanged();
+    }
+}
+
+bool ControlObjectScript::deliverBatchedChange() {
+    if (!m_batched || m_scriptConnections.isEmpty()) {
+        return false;
+    }
+    const int changeCount = m_pControl->changeCount();
+    if (changeCount == m_lastChangeCount) {
+        return false;
+    }
+    m_lastChangeCount = changeCount;
+    slotValueChanged(get(), this);
+    return true;
+}
+
 void ControlObjectScript::disconnectAllConnectionsToFunction(const QJSValue& function) {
     // Make a local copy of m_scriptConnections because items are removed within the loop.
     const QVector<ScriptConnection> connections = m_scriptConnections;
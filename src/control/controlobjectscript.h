@@ -26,6 +26,18 @@ class ControlObjectScript : public ControlProxy {
             return m_scriptConnections.first(); };
     void disconnectAllConnectionsToFunction(const QJSValue& function);
 
+    /// In batched mode the script connections are not called for every
+    /// change of the control, but only from deliverBatchedChange().
+    void setBatched(bool batched);
+    bool isBatched() const {
+        return m_batched;
+    }
+
+    /// Calls the script connections once with the current value if the
+    /// control has changed since the previous call. Returns true if they
+    /// have been called.
+    bool deliverBatchedChange();
+
     // Called from update();
     void emitValueChanged() override {
         emit trigger(get(), this);
@@ -41,8 +53,13 @@ class ControlObjectScript : public ControlProxy {
     virtual void slotValueChanged(double v, QObject*);
 
   private:
+    void connectValueChanged();
+    void disconnectValueChanged();
+
     QVector<ScriptConnection> m_scriptConnections;
     const RuntimeLoggingCategory m_logger;
     CompressingProxy m_proxy;
     bool m_skipSuperseded; // This flag is combined for all connections of this Control Object
+    bool m_batched;
+    int m_lastChangeCount;
 };
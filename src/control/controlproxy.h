@@ -5,6 +5,7 @@
 #include <QString>
 
 #include "control/control.h"
+#include "control/controlchangebatcher.h"
 #include "preferences/usersettings.h"
 #include "util/platform.h"
 
@@ -100,6 +101,30 @@ class ControlProxy : public QObject {
         return true;
     }
 
+    /// Connects like connectValueChanged() with a direct connection, but the
+    /// receiver is notified at most once per GUI tick with the latest value
+    /// by ControlChangeBatcher. Falls back to connectValueChanged() if
+    /// batching is disabled. Must be called from the main thread.
+    template<typename Receiver, typename Slot>
+    bool connectValueChangedBatched(Receiver receiver, Slot func) {
+        if (!ControlChangeBatcher::isEnabled()) {
+            return connectValueChanged(receiver, func);
+        }
+        if (!valid()) {
+            return false;
+        }
+
+        if (!connect(this, &ControlProxy::valueChanged, receiver, func, Qt::DirectConnection)) {
+            return false;
+        }
+
+        if (!m_subscribedToBatcher) {
+            ControlChangeBatcher::subscribe(this, m_pControl);
+            m_subscribedToBatcher = true;
+        }
+        return true;
+    }
+
     /// Called from update();
     virtual void emitValueChanged() {
         emit valueChanged(get());
@@ -186,4 +211,7 @@ class ControlProxy : public QObject {
   protected:
     /// Pointer to connected control.
     QSharedPointer<ControlDoublePrivate> m_pControl;
+
+  private:
+    bool m_subscribedToBatcher;
 };
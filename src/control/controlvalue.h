@@ -2,6 +2,7 @@
 
 #include <QAtomicInt>
 #include <QObject>
+#include <atomic>
 #include <limits>
 
 #include "util/assert.h"
@@ -165,3 +166,28 @@ class ControlValueAtomic : public ControlValueAtomicBase<T, cRingSize, sizeof(T)
   public:
     ControlValueAtomic() = default;
 };
+
+// Specialized template for double, the type of all control values that is
+// read by hundreds of widgets and the engine. std::atomic<double> is lock-free
+// on all supported architectures, so reading and writing is a single atomic
+// load and store instead of a walk through the ring buffer.
+template<int cRingSize>
+class ControlValueAtomic<double, cRingSize> {
+  public:
+    ControlValueAtomic()
+            : m_value(0.0) {
+    }
+
+    inline double getValue() const {
+        return m_value.load(std::memory_order_acquire);
+    }
+
+    inline void setValue(double value) {
+        m_value.store(value, std::memory_order_release);
+    }
+
+  private:
+    static_assert(std::atomic<double>::is_always_lock_free,
+            "ControlValueAtomic<double> requires lock-free atomic doubles");
+    std::atomic<double> m_value;
+};
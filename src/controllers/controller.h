@@ -59,6 +59,15 @@ class Controller : public QObject {
 
     virtual bool matchMapping(const MappingInfo& mapping) = 0;
 
+    /// Between these calls, output that the script sends is collected and
+    /// sent together by endOutputBatch(). Subclasses that support it only
+    /// send the latest message for each LED or report. Used for batched
+    /// script connections, see ControllerScriptInterfaceLegacy.
+    virtual void beginOutputBatch() {
+    }
+    virtual void endOutputBatch() {
+    }
+
   signals:
     /// Emitted when the controller is opened or closed.
     void openChanged(bool bOpen);
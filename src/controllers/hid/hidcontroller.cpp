@@ -19,7 +19,8 @@ HidController::HidController(
         : Controller(deviceInfo.formatName()),
           m_deviceInfo(std::move(deviceInfo)),
           m_pHidDevice(nullptr),
-          m_pollingBufferIndex(0) {
+          m_pollingBufferIndex(0),
+          m_outputBatchActive(false) {
     setDeviceCategory(mixxx::hid::DeviceCategory::guessFromDeviceInfo(m_deviceInfo));
 
     // All HID devices are full-duplex
@@ -127,6 +128,9 @@ int HidController::close() {
     // Stop controller engine here to ensure it's done before the device is closed
     //  in case it has any final parting messages
     stopEngine();
+    m_outputBatchActive = false;
+    m_outputBatch.clear();
+    m_outputBatchIndices.clear();
 
     // Close device
     qCInfo(m_logBase) << "Closing device";
@@ -231,7 +235,56 @@ void HidController::sendBytes(const QByteArray& data) {
     sendBytesReport(data, 0);
 }
 
+void HidController::beginOutputBatch() {
+    m_outputBatchActive = true;
+}
+
+void HidController::endOutputBatch() {
+    m_outputBatchActive = false;
+    flushOutputBatch();
+}
+
+void HidController::setOutputReportCoalesced(unsigned int reportID, bool coalesced) {
+    if (coalesced) {
+        m_coalescedOutputReportIds.insert(reportID);
+    } else {
+        m_coalescedOutputReportIds.remove(reportID);
+    }
+}
+
+void HidController::flushOutputBatch() {
+    for (const auto& report : qAsConst(m_outputBatch)) {
+        sendBytesReport(report.second, report.first);
+    }
+    m_outputBatch.clear();
+    m_outputBatchIndices.clear();
+}
+
 void HidController::sendBytesReport(QByteArray data, unsigned int reportID) {
+    if (m_outputBatchActive) {
+        if (m_coalescedOutputReportIds.contains(reportID)) {
+            const auto it = m_outputBatchIndices.constFind(reportID);
+            if (it != m_outputBatchIndices.constEnd()) {
+                m_outputBatch[it.value()].second = data;
+                return;
+            }
+            m_outputBatchIndices.insert(reportID, m_outputBatch.size());
+            m_outputBatch.append(qMakePair(reportID, data));
+            return;
+        }
+        // Devices may distinguish reports with the same ID by a header
+        // in the data and expect them in the order they have been sent.
+        // Only a report that repeats the previous one is redundant.
+        const auto report = qMakePair(reportID, data);
+        if (m_outputBatch.isEmpty() || m_outputBatch.last() != report) {
+            m_outputBatch.append(report);
+        }
+        return;
+    }
+    writeOutputReport(std::move(data), reportID);
+}
+
+void HidController::writeOutputReport(QByteArray data, unsigned int reportID) {
     // Append the Report ID to the beginning of data[] per the API..
     data.prepend(reportID);
 
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QSet>
+
 #include "controllers/controller.h"
 #include "controllers/hid/hiddevice.h"
 #include "controllers/hid/legacyhidcontrollermapping.h"
@@ -29,9 +34,27 @@ class HidController final : public Controller {
 
     bool matchMapping(const MappingInfo& mapping) override;
 
+    /// While a batch is open, output reports are collected in order and
+    /// written to the device when the batch is closed. A report that
+    /// repeats the previous one byte by byte is only sent once.
+    ///
+    /// Reports with an ID for which coalescing has been enabled are
+    /// expected to contain the full state of the device. Only the last
+    /// of them is sent at the position of the first one in the batch.
+    void beginOutputBatch() override;
+    void endOutputBatch() override;
+
+    /// Disabled by default, because some devices send partial updates
+    /// with the same report ID that are distinguished by a header in the
+    /// data.
+    void setOutputReportCoalesced(unsigned int reportID, bool coalesced);
+
   protected:
     void sendReport(QList<int> data, unsigned int length, unsigned int reportID);
 
+    /// Writes the report to the device
+    virtual void writeOutputReport(QByteArray data, unsigned int reportID);
+
   private slots:
     int open() override;
     int close() override;
@@ -47,6 +70,7 @@ class HidController final : public Controller {
     void sendBytes(const QByteArray& data) override;
     void sendBytesReport(QByteArray data, unsigned int reportID);
     void sendFeatureReport(const QByteArray& reportData, unsigned int reportID);
+    void flushOutputBatch();
 
     // getInputReport receives an input report on request.
     // This can be used on startup to initialize the knob positions in Mixxx
@@ -77,6 +101,13 @@ class HidController final : public Controller {
     int m_lastPollSize;
     int m_pollingBufferIndex;
 
+    bool m_outputBatchActive;
+    // Pairs of report ID and data
+    QList<QPair<unsigned int, QByteArray>> m_outputBatch;
+    QSet<unsigned int> m_coalescedOutputReportIds;
+    // Index into m_outputBatch of the report for each coalesced report ID
+    QHash<unsigned int, int> m_outputBatchIndices;
+
     friend class HidControllerJSProxy;
 };
 
@@ -96,6 +127,10 @@ class HidControllerJSProxy : public ControllerJSProxy {
         m_pHidController->sendReport(data, length, reportID);
     }
 
+    Q_INVOKABLE void setOutputReportCoalesced(unsigned int reportID, bool coalesced) {
+        m_pHidController->setOutputReportCoalesced(reportID, coalesced);
+    }
+
     Q_INVOKABLE QByteArray getInputReport(
             unsigned int reportID) {
         return m_pHidController->getInputReport(reportID);
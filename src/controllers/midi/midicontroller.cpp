@@ -1,5 +1,7 @@
 #include "controllers/midi/midicontroller.h"
 
+#include <optional>
+
 #include "control/controlobject.h"
 #include "controllers/defs_controllers.h"
 #include "controllers/midi/midiutils.h"
@@ -10,8 +12,56 @@
 #include "util/math.h"
 #include "util/screensaver.h"
 
+namespace {
+
+/// Control changes of the (N)RPN protocol. A parameter number is selected
+/// with the first and then changed with the others, so each message must
+/// be sent.
+bool isParameterNumberControl(unsigned char control) {
+    switch (control) {
+    case 6:   // Data Entry MSB
+    case 38:  // Data Entry LSB
+    case 96:  // Data Increment
+    case 97:  // Data Decrement
+    case 98:  // NRPN LSB
+    case 99:  // NRPN MSB
+    case 100: // RPN LSB
+    case 101: // RPN MSB
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Returns the key of the LED that a short message changes, if the message
+/// may be replaced by a later one with the same key.
+std::optional<uint16_t> outputBatchKey(unsigned char status, unsigned char byte1) {
+    const unsigned char channel = MidiUtils::channelFromStatus(status);
+    switch (MidiUtils::opCodeFromStatus(status)) {
+    case MidiOpCode::NoteOff:
+    case MidiOpCode::NoteOn:
+        // Note Off and Note On for the same note switch the same LED
+        return MidiKey(MidiUtils::statusFromOpCodeAndChannel(
+                               MidiOpCode::NoteOn, channel),
+                byte1)
+                .key;
+    case MidiOpCode::ControlChange:
+        if (isParameterNumberControl(byte1)) {
+            return std::nullopt;
+        }
+        return MidiKey(status, byte1).key;
+    case MidiOpCode::PolyphonicKeyPressure:
+        return MidiKey(status, byte1).key;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
 MidiController::MidiController(const QString& deviceName)
-        : Controller(deviceName) {
+        : Controller(deviceName),
+          m_outputBatchActive(false) {
     setDeviceCategory(tr("MIDI Controller"));
 }
 
@@ -41,6 +91,9 @@ std::shared_ptr<LegacyControllerMapping> MidiController::cloneMapping() {
 }
 
 int MidiController::close() {
+    m_outputBatchActive = false;
+    m_outputBatch.clear();
+    m_outputBatchIndices.clear();
     destroyOutputHandlers();
     return 0;
 }
@@ -51,6 +104,56 @@ bool MidiController::matchMapping(const MappingInfo& mapping) {
     return false;
 }
 
+void MidiController::beginOutputBatch() {
+    m_outputBatchActive = true;
+}
+
+void MidiController::endOutputBatch() {
+    flushOutputBatch();
+    m_outputBatchActive = false;
+}
+
+void MidiController::sendOrQueueShortMsg(unsigned char status,
+        unsigned char byte1,
+        unsigned char byte2) {
+    if (!m_outputBatchActive) {
+        sendShortMsg(status, byte1, byte2);
+        return;
+    }
+    const auto key = outputBatchKey(status, byte1);
+    if (key) {
+        const auto it = m_outputBatchIndices.constFind(*key);
+        if (it != m_outputBatchIndices.constEnd()) {
+            MidiShortMessage& queuedMessage = m_outputBatch[it.value()];
+            queuedMessage.status = status;
+            queuedMessage.byte2 = byte2;
+            return;
+        }
+        m_outputBatchIndices.insert(*key, m_outputBatch.size());
+    }
+    m_outputBatch.append(MidiShortMessage{status, byte1, byte2});
+}
+
+void MidiController::flushOutputBatch() {
+    if (m_outputBatch.isEmpty()) {
+        return;
+    }
+    sendShortMsgs(m_outputBatch);
+    m_outputBatch.clear();
+    m_outputBatchIndices.clear();
+}
+
+void MidiController::sendShortMsgs(const QVector<MidiShortMessage>& messages) {
+    for (const auto& message : messages) {
+        sendShortMsg(message.status, message.byte1, message.byte2);
+    }
+}
+
+void MidiController::send(const QList<int>& data, unsigned int length) {
+    flushOutputBatch();
+    Controller::send(data, length);
+}
+
 bool MidiController::applyMapping() {
     // Handles the engine
     bool result = Controller::applyMapping();
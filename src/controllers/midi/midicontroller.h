@@ -37,6 +37,13 @@ class MidiController : public Controller {
 
     bool matchMapping(const MappingInfo& mapping) override;
 
+    /// While a batch is open, short messages sent by the script are queued.
+    /// A Note On/Off or CC message replaces a queued message for the same note
+    /// or control number on the same channel, so that only the latest state
+    /// of each LED is sent when the batch is closed.
+    void beginOutputBatch() override;
+    void endOutputBatch() override;
+
   signals:
     void messageReceived(unsigned char status, unsigned char control, unsigned char value);
 
@@ -45,6 +52,13 @@ class MidiController : public Controller {
             unsigned char byte1,
             unsigned char byte2) = 0;
 
+    /// Sends the queued messages of an output batch in order. Subclasses
+    /// may override this to hand them to the device with a single call.
+    virtual void sendShortMsgs(const QVector<MidiShortMessage>& messages);
+
+    /// Flushes queued short messages first to keep the order of the output.
+    void send(const QList<int>& data, unsigned int length = 0) override;
+
     /// Alias for send()
     /// The length parameter is here for backwards compatibility for when scripts
     /// were required to specify it.
@@ -71,6 +85,11 @@ class MidiController : public Controller {
     void commitTemporaryInputMappings();
 
   private:
+    void sendOrQueueShortMsg(unsigned char status,
+            unsigned char byte1,
+            unsigned char byte2);
+    void flushOutputBatch();
+
     void processInputMapping(
             const MidiInputMapping& mapping,
             unsigned char status,
@@ -93,6 +112,11 @@ class MidiController : public Controller {
     SoftTakeoverCtrl m_st;
     QList<QPair<MidiInputMapping, unsigned char>> m_fourteen_bit_queued_mappings;
 
+    bool m_outputBatchActive;
+    QVector<MidiShortMessage> m_outputBatch;
+    // Index into m_outputBatch of the queued message for each note or control
+    QHash<uint16_t, int> m_outputBatchIndices;
+
     // So it can access sendShortMsg()
     friend class MidiOutputHandler;
     friend class MidiControllerTest;
@@ -113,7 +137,7 @@ class MidiControllerJSProxy : public ControllerJSProxy {
     Q_INVOKABLE void sendShortMsg(unsigned char status,
             unsigned char byte1,
             unsigned char byte2) {
-        m_pMidiController->sendShortMsg(status, byte1, byte2);
+        m_pMidiController->sendOrQueueShortMsg(status, byte1, byte2);
     }
 
     Q_INVOKABLE void sendSysexMsg(const QList<int>& data, unsigned int length = 0) {
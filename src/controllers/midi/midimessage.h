@@ -178,6 +178,13 @@ struct MidiKey {
     };
 };
 
+/// A complete short (i.e. non-SysEx) message that is sent to a device.
+struct MidiShortMessage {
+    unsigned char status;
+    unsigned char byte1;
+    unsigned char byte2;
+};
+
 struct MidiInputMapping {
     MidiInputMapping() {
     }
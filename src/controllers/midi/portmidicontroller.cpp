@@ -1,5 +1,7 @@
 #include "controllers/midi/portmidicontroller.h"
 
+#include <QVarLengthArray>
+
 #include "controllers/midi/midiutils.h"
 #include "moc_portmidicontroller.cpp"
 
@@ -223,6 +225,38 @@ void PortMidiController::sendShortMsg(unsigned char status, unsigned char byte1,
     }
 }
 
+void PortMidiController::sendShortMsgs(const QVector<MidiShortMessage>& messages) {
+    if (m_pOutputDevice.isNull() || !m_pOutputDevice->isOpen()) {
+        return;
+    }
+
+    // The output stream is opened with zero latency, so PortMidi ignores
+    // the timestamps and sends all events at once.
+    QVarLengthArray<PmEvent, 64> events;
+    events.reserve(messages.size());
+    for (const auto& message : messages) {
+        PmEvent event;
+        event.message = Pm_Message(message.status, message.byte1, message.byte2);
+        event.timestamp = 0;
+        events.append(event);
+    }
+
+    PmError err = m_pOutputDevice->write(events.data(), events.size());
+    if (err == pmNoError) {
+        for (const auto& message : messages) {
+            qCDebug(m_logOutput) << MidiUtils::formatMidiOpCode(getName(),
+                    message.status,
+                    message.byte1,
+                    message.byte2,
+                    MidiUtils::channelFromStatus(message.status),
+                    MidiUtils::opCodeFromStatus(message.status));
+        }
+    } else {
+        qCWarning(m_logOutput) << "Error sending" << messages.size() << "short messages";
+        qCWarning(m_logOutput) << "PortMidi error:" << Pm_GetErrorText(err);
+    }
+}
+
 void PortMidiController::sendBytes(const QByteArray& data) {
     // PortMidi does not receive a length argument for the buffer we provide to
     // Pm_WriteSysEx. Instead, it scans for a MidiOpCode::EndOfExclusive byte
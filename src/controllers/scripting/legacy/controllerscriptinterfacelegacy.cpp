@@ -2,6 +2,7 @@
 
 #include "control/controlobject.h"
 #include "control/controlobjectscript.h"
+#include "controllers/controller.h"
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 #include "controllers/scripting/legacy/scriptconnectionjsproxy.h"
 #include "mixer/playermanager.h"
@@ -16,11 +17,14 @@ constexpr int kDecks = 16;
 // timer.
 constexpr int kScratchTimerMs = 1;
 const double kAlphaBetaDt = kScratchTimerMs / 1000.0;
+
+constexpr int kMinConnectionBatchingIntervalMillis = 10;
 } // anonymous namespace
 
 ControllerScriptInterfaceLegacy::ControllerScriptInterfaceLegacy(
         ControllerScriptEngineLegacy* m_pEngine, const RuntimeLoggingCategory& logger)
-        : m_pScriptEngineLegacy(m_pEngine),
+        : m_connectionBatchingTimerId(0),
+          m_pScriptEngineLegacy(m_pEngine),
           m_logger(logger) {
     // Pre-allocate arrays for average number of virtual decks
     m_intervalAccumulator.resize(kDecks);
@@ -91,6 +95,7 @@ ControlObjectScript* ControllerScriptInterfaceLegacy::getControlObjectScript(
         // create COT
         coScript = new ControlObjectScript(key, m_logger, this);
         if (coScript->valid()) {
+            coScript->setBatched(m_connectionBatchingTimerId != 0);
             m_controlCache.insert(key, coScript);
         } else {
             delete coScript;
@@ -480,9 +485,93 @@ void ControllerScriptInterfaceLegacy::stopTimer(int timerId) {
     m_timers.remove(timerId);
 }
 
+void ControllerScriptInterfaceLegacy::setConnectionBatching(
+        int intervalMillis, const QJSValue& frameCallback) {
+    if (!frameCallback.isUndefined() && !frameCallback.isNull() &&
+            !frameCallback.isCallable()) {
+        m_pScriptEngineLegacy->throwJSError(
+                "Invalid frame callback provided to "
+                "engine.setConnectionBatching. It must be a function.");
+        return;
+    }
+
+    if (m_connectionBatchingTimerId != 0) {
+        killTimer(m_connectionBatchingTimerId);
+        m_connectionBatchingTimerId = 0;
+    }
+    m_connectionBatchingCallback = QJSValue();
+
+    if (intervalMillis > 0) {
+        if (intervalMillis < kMinConnectionBatchingIntervalMillis) {
+            qCWarning(m_logger) << "Connection batching interval of"
+                                << intervalMillis
+                                << "ms is too short. Setting to the minimum of"
+                                << kMinConnectionBatchingIntervalMillis << "ms.";
+            intervalMillis = kMinConnectionBatchingIntervalMillis;
+        }
+        m_connectionBatchingTimerId = startTimer(intervalMillis);
+        if (m_connectionBatchingTimerId == 0) {
+            qCWarning(m_logger) << "Connection batching timer could not be created";
+        } else {
+            qCDebug(m_logger) << "Delivering connections every"
+                              << intervalMillis << "ms";
+        }
+        m_connectionBatchingCallback = frameCallback;
+    }
+
+    // Changes that are pending when batching is switched off are not
+    // delivered, the connections see the next change of the control.
+    const bool batched = m_connectionBatchingTimerId != 0;
+    for (ControlObjectScript* coScript : qAsConst(m_controlCache)) {
+        coScript->setBatched(batched);
+    }
+}
+
+void ControllerScriptInterfaceLegacy::deliverBatchedConnections() {
+    Controller* pController = m_pScriptEngineLegacy->m_pController;
+    if (pController) {
+        pController->beginOutputBatch();
+    }
+
+    // Copy the controls first, because the callbacks might look up new
+    // controls and thereby modify the cache.
+    const QList<ControlObjectScript*> controls = m_controlCache.values();
+    QList<ControlObjectScript*> changedControls;
+    for (ControlObjectScript* coScript : controls) {
+        if (coScript->deliverBatchedChange()) {
+            changedControls.append(coScript);
+        }
+    }
+
+    // Copy the callback, the script might replace it from within the call
+    const QJSValue frameCallback = m_connectionBatchingCallback;
+    const auto pJsEngine = m_pScriptEngineLegacy->jsEngine();
+    if (!changedControls.isEmpty() && frameCallback.isCallable() && pJsEngine) {
+        QJSValue changes = pJsEngine->newArray(changedControls.size());
+        for (int i = 0; i < changedControls.size(); ++i) {
+            const ControlObjectScript* coScript = changedControls.at(i);
+            QJSValue change = pJsEngine->newObject();
+            change.setProperty(QStringLiteral("group"), coScript->getKey().group);
+            change.setProperty(QStringLiteral("name"), coScript->getKey().item);
+            change.setProperty(QStringLiteral("value"), coScript->get());
+            changes.setProperty(i, change);
+        }
+        m_pScriptEngineLegacy->executeFunction(frameCallback, QJSValueList{changes});
+    }
+
+    if (pController) {
+        pController->endOutputBatch();
+    }
+}
+
 void ControllerScriptInterfaceLegacy::timerEvent(QTimerEvent* event) {
     int timerId = event->timerId();
 
+    if (timerId == m_connectionBatchingTimerId) {
+        deliverBatchedConnections();
+        return;
+    }
+
     // See if this is a scratching timer
     if (m_scratchTimers.contains(timerId)) {
         scratchProcess(timerId);
@@ -47,6 +47,16 @@ class ControllerScriptInterfaceLegacy : public QObject {
     Q_INVOKABLE void log(const QString& message);
     Q_INVOKABLE int beginTimer(int interval, QJSValue scriptCode, bool oneShot = false);
     Q_INVOKABLE void stopTimer(int timerId);
+    /// Delivers the changes of all connected controls once every
+    /// intervalMillis instead of calling the connections for every single
+    /// change. Each connection is called at most once per interval with the
+    /// latest value, followed by the optional frameCallback, which receives
+    /// an array of {group, name, value} objects for all changed controls.
+    /// MIDI and HID output that the callbacks send is coalesced and sent to
+    /// the device at the end of the interval. An interval of 0 switches back
+    /// to immediate delivery.
+    Q_INVOKABLE void setConnectionBatching(int intervalMillis,
+            const QJSValue& frameCallback = QJSValue());
     Q_INVOKABLE void scratchEnable(int deck,
             int intervalsPerRev,
             double rpm,
@@ -76,6 +86,7 @@ class ControllerScriptInterfaceLegacy : public QObject {
             bool skipSuperseded = false);
     QHash<ConfigKey, ControlObjectScript*> m_controlCache;
     ControlObjectScript* getControlObjectScript(const QString& group, const QString& name);
+    void deliverBatchedConnections();
 
     SoftTakeoverCtrl m_st;
 
@@ -85,6 +96,9 @@ class ControllerScriptInterfaceLegacy : public QObject {
     };
     QHash<int, TimerInfo> m_timers;
 
+    int m_connectionBatchingTimerId;
+    QJSValue m_connectionBatchingCallback;
+
     QVarLengthArray<int> m_intervalAccumulator;
     QVarLengthArray<mixxx::Duration> m_lastMovement;
     QVarLengthArray<double> m_dx, m_rampTo, m_rampFactor;
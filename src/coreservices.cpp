@@ -14,6 +14,8 @@
 #include "database/mixxxdb.h"
 #include "effects/effectsmanager.h"
 #include "engine/enginemaster.h"
+#include "engine/engineprofiler.h"
+#include "engine/enginetracewriter.h"
 #include "library/coverartcache.h"
 #include "library/library.h"
 #include "library/trackcollection.h"
@@ -116,6 +118,11 @@ CoreServices::CoreServices(const CmdlineArgs& args, QApplication* pApp)
     if (m_cmdlineArgs.getDeveloper()) {
         StatsManager::createInstance();
     }
+    // The trace writer must enable tracing before the engine is started
+    if (m_cmdlineArgs.getEngineTraceEnabled()) {
+        m_pEngineTraceWriter = std::make_unique<EngineTraceWriter>(
+                m_cmdlineArgs.getEngineTracePath());
+    }
     mixxx::Translations::initializeTranslations(
             m_pSettingsManager->settings(), pApp, m_cmdlineArgs.getLocale());
     initializeKeyboard();
@@ -135,6 +142,9 @@ CoreServices::~CoreServices() {
         StatsManager::destroy();
     }
 
+    // Writes the events that have been recorded until the engine stopped
+    m_pEngineTraceWriter.reset();
+
     // HACK: Save config again. We saved it once before doing some dangerous
     // stuff. We only really want to save it here, but the first one was just
     // a precaution. The earlier one can be removed when stuff is more stable
@@ -581,6 +591,9 @@ void CoreServices::finalize() {
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting EngineMaster";
     CLEAR_AND_CHECK_DELETED(m_pEngine);
 
+    // The engine profiler is always recording, not only while tracing
+    EngineProfiler::logStatistics();
+
     qDebug() << t.elapsed(false).debugMillisWithUnit() << "deleting EffectsManager";
     CLEAR_AND_CHECK_DELETED(m_pEffectsManager);
 
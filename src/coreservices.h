@@ -15,6 +15,7 @@ class CmdlineArgs;
 class KeyboardEventFilter;
 class EffectsManager;
 class EngineMaster;
+class EngineTraceWriter;
 class SoundManager;
 class PlayerManager;
 class RecordingManager;
@@ -153,6 +154,8 @@ class CoreServices : public QObject {
 
     std::unique_ptr<ControlPushButton> m_pTouchShift;
 
+    std::unique_ptr<EngineTraceWriter> m_pEngineTraceWriter;
+
     Timer m_runtime_timer;
     const CmdlineArgs& m_cmdlineArgs;
     bool m_isInitialized;
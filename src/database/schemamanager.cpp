@@ -213,7 +213,6 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
         }
 
         QString description = eDescription.text();
-        QString sql = eSql.text();
 
         kLogger.info()
                 << "Upgrading database schema to version"
@@ -222,36 +221,47 @@ SchemaManager::Result SchemaManager::upgradeToSchemaVersion(
 
         SqlTransaction transaction(m_settingsDao.database());
 
-        // TODO(XXX) We can't have semicolons in schema.xml for anything other
-        // than statement separators.
-        QStringList sqlStatements = sql.split(";");
+        bool result = true;
+        for (; result && !eSql.isNull(); eSql = eSql.nextSiblingElement("sql")) {
+            // Optional statements depend on features of SQLite that
+            // might not be available, e.g. virtual table modules.
+            const bool optional = eSql.attribute("optional") == "true";
 
-        QStringListIterator it(sqlStatements);
+            // TODO(XXX) We can't have semicolons in schema.xml for anything other
+            // than statement separators.
+            QStringList sqlStatements = eSql.text().split(";");
 
-        bool result = true;
-        while (result && it.hasNext()) {
-            QString statement = it.next().trimmed();
-            if (statement.isEmpty()) {
-                // skip blank lines
-                continue;
-            }
-            FwdSqlQuery query(m_settingsDao.database(), statement);
-            result = query.isPrepared() && query.execPrepared();
-            if (!result &&
-                    query.hasDuplicateColumnNameError()) {
-                // New columns may have already been added during a previous
-                // migration to a different (= preceding) schema version. This
-                // is a very common situation during development when switching
-                // between schema versions. Since SQLite only allows to add new
-                // columns if they do not yet exist, we need to account for and
-                // handle those errors here after they occurred.
-                // If the remaining migration finishes without other errors this
-                // is probably ok.
-                kLogger.info()
-                        << "Safely ignoring failed statement"
-                        << statement
-                        << "while re-applying a schema migration";
-                result = true;
+            QStringListIterator it(sqlStatements);
+
+            while (result && it.hasNext()) {
+                QString statement = it.next().trimmed();
+                if (statement.isEmpty()) {
+                    // skip blank lines
+                    continue;
+                }
+                FwdSqlQuery query(m_settingsDao.database(), statement);
+                result = query.isPrepared() && query.execPrepared();
+                if (!result && optional) {
+                    kLogger.warning()
+                            << "Skipping failed optional statement"
+                            << statement;
+                    result = true;
+                } else if (!result &&
+                        query.hasDuplicateColumnNameError()) {
+                    // New columns may have already been added during a previous
+                    // migration to a different (= preceding) schema version. This
+                    // is a very common situation during development when switching
+                    // between schema versions. Since SQLite only allows to add new
+                    // columns if they do not yet exist, we need to account for and
+                    // handle those errors here after they occurred.
+                    // If the remaining migration finishes without other errors this
+                    // is probably ok.
+                    kLogger.info()
+                            << "Safely ignoring failed statement"
+                            << statement
+                            << "while re-applying a schema migration";
+                    result = true;
+                }
             }
         }
 
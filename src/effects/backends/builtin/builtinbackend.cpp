@@ -72,14 +72,17 @@ BuiltInBackend::~BuiltInBackend() {
 void BuiltInBackend::registerEffectInner(
         const QString& id,
         EffectManifestPointer pManifest,
-        EffectProcessorInstantiator instantiator) {
+        EffectProcessorInstantiator instantiator,
+        EffectStatePoolReserver statePoolReserver,
+        EffectStatePoolRefiller statePoolRefiller) {
     VERIFY_OR_DEBUG_ASSERT(!m_registeredEffects.contains(id)) {
         return;
     }
 
     pManifest->setBackendType(getType());
 
-    m_registeredEffects[id] = RegisteredEffect{pManifest, instantiator};
+    m_registeredEffects[id] = RegisteredEffect{
+            pManifest, instantiator, statePoolReserver, statePoolRefiller};
     m_effectIds.append(id);
 }
 
@@ -102,6 +105,19 @@ const QList<EffectManifestPointer> BuiltInBackend::getManifests() const {
     return list;
 }
 
+void BuiltInBackend::reserveStatePools(int numStates,
+        const mixxx::EngineParameters& engineParameters) const {
+    for (const auto& registeredEffect : m_registeredEffects) {
+        registeredEffect.statePoolReserver(numStates, engineParameters);
+    }
+}
+
+void BuiltInBackend::refillStatePools() const {
+    for (const auto& registeredEffect : m_registeredEffects) {
+        registeredEffect.statePoolRefiller();
+    }
+}
+
 bool BuiltInBackend::canInstantiateEffect(const QString& effectId) const {
     return m_registeredEffects.contains(effectId);
 }
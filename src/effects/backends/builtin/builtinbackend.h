@@ -19,6 +19,9 @@ class BuiltInBackend : public EffectsBackend {
     std::unique_ptr<EffectProcessor> createProcessor(
             const EffectManifestPointer pManifest) const;
     bool canInstantiateEffect(const QString& effectId) const;
+    void reserveStatePools(int numStates,
+            const mixxx::EngineParameters& engineParameters) const override;
+    void refillStatePools() const override;
 
   private:
     QString debugString() const {
@@ -26,15 +29,22 @@ class BuiltInBackend : public EffectsBackend {
     }
 
     typedef std::unique_ptr<EffectProcessor> (*EffectProcessorInstantiator)();
+    typedef void (*EffectStatePoolReserver)(
+            int numStates, const mixxx::EngineParameters& engineParameters);
+    typedef void (*EffectStatePoolRefiller)();
 
     struct RegisteredEffect {
         EffectManifestPointer pManifest;
         EffectProcessorInstantiator instantiator;
+        EffectStatePoolReserver statePoolReserver;
+        EffectStatePoolRefiller statePoolRefiller;
     };
 
     void registerEffectInner(const QString& id,
             EffectManifestPointer pManifest,
-            EffectProcessorInstantiator instantiator);
+            EffectProcessorInstantiator instantiator,
+            EffectStatePoolReserver statePoolReserver,
+            EffectStatePoolRefiller statePoolRefiller);
 
     template<typename EffectProcessorImpl>
     void registerEffect() {
@@ -44,7 +54,9 @@ class BuiltInBackend : public EffectsBackend {
                 []() {
                     return static_cast<std::unique_ptr<EffectProcessor>>(
                             std::make_unique<EffectProcessorImpl>());
-                });
+                },
+                &EffectProcessorImpl::reserveStatePool,
+                &EffectProcessorImpl::refillStatePool);
     };
 
     QMap<QString, RegisteredEffect> m_registeredEffects;
@@ -5,6 +5,7 @@
 #include <QPair>
 #include <QString>
 
+#include "effects/backends/effectstatepool.h"
 #include "effects/defs.h"
 #include "engine/channelhandle.h"
 #include "engine/effects/groupfeaturestate.h"
@@ -49,8 +50,19 @@
 /// without wasting a lot of memory. (EffectStates could be (de)allocated when toggling
 /// the enable switches for EffectSlots as well, but the memory savings would be
 /// relatively small compared to the additional code complexity.)
+///
+/// To keep those allocations out of the moment the user loads an effect or
+/// toggles a routing switch, EffectStates of built-in effects are taken from
+/// an EffectStatePool for their type. The pools are sized at startup and
+/// refilled on the main thread after the taken states have been sent to the
+/// engine.
 class EffectState {
   public:
+    /// Subclasses whose states depend on more than the EngineParameters,
+    /// e.g. because they are bound to a specific EffectProcessorImpl,
+    /// must set this to false.
+    static constexpr bool kUseStatePool = true;
+
     EffectState(const mixxx::EngineParameters& engineParameters) {
         // Subclasses should call engineParametersChanged here.
         Q_UNUSED(engineParameters);
@@ -141,6 +153,27 @@ class EffectProcessorImpl : public EffectProcessor {
     /// static QString getId();
     /// static EffectManifestPointer getManifest();
 
+    /// Called from the main thread at startup to keep numStates
+    /// EffectStates ready that are shared by all instances of this effect.
+    static void reserveStatePool(int numStates,
+            const mixxx::EngineParameters& engineParameters) {
+        if constexpr (EffectSpecificState::kUseStatePool) {
+            EffectStatePool<EffectSpecificState>::instance().reserve(
+                    numStates, engineParameters);
+        } else {
+            Q_UNUSED(numStates);
+            Q_UNUSED(engineParameters);
+        }
+    }
+
+    /// Called from the main thread after EffectStates have been sent
+    /// to the engine to replace them in the pool.
+    static void refillStatePool() {
+        if constexpr (EffectSpecificState::kUseStatePool) {
+            EffectStatePool<EffectSpecificState>::instance().refill();
+        }
+    }
+
     /// This is the only non-static method that subclasses need to implement.
     virtual void processChannel(EffectSpecificState* channelState,
             const CSAMPLE* pInput,
@@ -166,7 +199,12 @@ class EffectProcessorImpl : public EffectProcessor {
                            << "EffectState should have been preallocated in the"
                               "main thread.";
             }
-            pState = createSpecificState(engineParameters);
+            if constexpr (EffectSpecificState::kUseStatePool) {
+                // The EffectStatePool must not be accessed from the audio thread
+                pState = new EffectSpecificState(engineParameters);
+            } else {
+                pState = createSpecificState(engineParameters);
+            }
             m_channelStateMatrix[inputHandle][outputHandle] = pState;
         }
         processChannel(pState, pInput, pOutput, engineParameters, enableState, groupFeatures);
@@ -288,7 +326,13 @@ class EffectProcessorImpl : public EffectProcessor {
     /// subclasses for built-in effects should not.
     virtual EffectSpecificState* createSpecificState(
             const mixxx::EngineParameters& engineParameters) {
-        EffectSpecificState* pState = new EffectSpecificState(engineParameters);
+        EffectSpecificState* pState;
+        if constexpr (EffectSpecificState::kUseStatePool) {
+            pState = EffectStatePool<EffectSpecificState>::instance().acquire(
+                    engineParameters);
+        } else {
+            pState = new EffectSpecificState(engineParameters);
+        }
         if (kEffectDebugOutput) {
             qDebug() << this << "EffectProcessorImpl creating EffectState" << pState;
         }
@@ -8,6 +8,9 @@
 #include "effects/defs.h"
 
 class EffectProcessor;
+namespace mixxx {
+class EngineParameters;
+} // namespace mixxx
 
 /// EffectsBackend is an abstract base class that enumerates available effects
 /// which are identified by EffectManifests. EffectsBackends create an
@@ -34,6 +37,18 @@ class EffectsBackend {
     virtual std::unique_ptr<EffectProcessor> createProcessor(
             const EffectManifestPointer pManifest) const = 0;
 
+    /// Keeps numStates EffectStates ready for every effect of this backend.
+    /// Backends whose EffectStates can't be shared between EffectProcessors
+    /// don't need to implement this.
+    virtual void reserveStatePools(int numStates,
+            const mixxx::EngineParameters& engineParameters) const {
+        Q_UNUSED(numStates);
+        Q_UNUSED(engineParameters);
+    }
+    /// Replaces the EffectStates that have been taken from the pools
+    virtual void refillStatePools() const {
+    }
+
     static EffectBackendType backendTypeFromString(const QString& typeName);
     static QString backendTypeToString(EffectBackendType backendType);
     /// Use this when showing the string in the GUI
@@ -7,6 +7,7 @@
 #include "effects/backends/lv2/lv2backend.h"
 #endif
 #include "effects/presets/effectpreset.h"
+#include "engine/effects/engineeffect.h"
 
 EffectsBackendManager::EffectsBackendManager() {
     m_pNumEffectsAvailable = std::make_unique<ControlObject>(
@@ -114,3 +115,16 @@ std::unique_ptr<EffectProcessor> EffectsBackendManager::createProcessor(
     }
     return pBackend->createProcessor(pManifest);
 }
+
+void EffectsBackendManager::reserveStatePools(int numStates) {
+    const auto engineParameters = EngineEffect::stateEngineParameters();
+    for (const auto& pBackend : std::as_const(m_effectsBackends)) {
+        pBackend->reserveStatePools(numStates, engineParameters);
+    }
+}
+
+void EffectsBackendManager::refillStatePools() {
+    for (const auto& pBackend : std::as_const(m_effectsBackends)) {
+        pBackend->refillStatePools();
+    }
+}
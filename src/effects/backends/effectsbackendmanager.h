@@ -21,6 +21,11 @@ class EffectsBackendManager {
 
     std::unique_ptr<EffectProcessor> createProcessor(const EffectManifestPointer pManifest);
 
+    /// Keeps numStates EffectStates ready for every effect, see EffectStatePool
+    void reserveStatePools(int numStates);
+    /// Must be called after EffectStates have been created for the engine
+    void refillStatePools();
+
   private:
     void addBackend(EffectsBackendPointer pEffectsBackend);
 
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QVector>
+
+#include "engine/engine.h"
+#include "util/assert.h"
+#include "util/class.h"
+
+/// EffectStatePool keeps freshly constructed EffectStates of one type ready
+/// for use, so that enabling an EffectChain for another input channel does
+/// not construct states, including large buffers like the delay line of the
+/// Echo effect, at the moment the user takes that action.
+///
+/// All EffectStates of one type are interchangeable because they are
+/// constructed only from the EngineParameters, so there is one pool per
+/// EffectSpecificState type that is shared by all EffectProcessorImpl
+/// instances of that effect. The pools of all built-in effects are sized
+/// once at startup by EffectsManager.
+///
+/// States that have been taken with acquire() are replaced by refill()
+/// after they have been sent to the engine. States that are no longer used
+/// by the engine are deleted and don't return to the pool.
+///
+/// The pool must only be used from the main thread. The audio thread never
+/// takes states from it.
+template<typename EffectSpecificState>
+class EffectStatePool {
+  public:
+    static EffectStatePool& instance() {
+        static EffectStatePool s_instance;
+        return s_instance;
+    }
+
+    ~EffectStatePool() {
+        qDeleteAll(m_freeStates);
+    }
+
+    /// Keeps numStates states for engineParameters ready. States for other
+    /// EngineParameters are discarded.
+    void reserve(int numStates, const mixxx::EngineParameters& engineParameters) {
+        DEBUG_ASSERT(numStates >= 0);
+        if (!isCompatible(engineParameters)) {
+            qDeleteAll(m_freeStates);
+            m_freeStates.clear();
+            m_sampleRate = engineParameters.sampleRate();
+            m_framesPerBuffer = engineParameters.framesPerBuffer();
+        }
+        m_capacity = numStates;
+        while (m_freeStates.size() > m_capacity) {
+            delete m_freeStates.takeLast();
+        }
+        refill();
+    }
+
+    /// Constructs the states that have been taken since the last refill
+    void refill() {
+        m_freeStates.reserve(m_capacity);
+        while (m_freeStates.size() < m_capacity) {
+            m_freeStates.append(new EffectSpecificState(
+                    mixxx::EngineParameters(m_sampleRate, m_framesPerBuffer)));
+        }
+    }
+
+    /// Returns a fresh state. It is only constructed here if the pool is
+    /// exhausted or has been filled for different EngineParameters.
+    EffectSpecificState* acquire(const mixxx::EngineParameters& engineParameters) {
+        if (!m_freeStates.isEmpty() && isCompatible(engineParameters)) {
+            return m_freeStates.takeLast();
+        }
+        return new EffectSpecificState(engineParameters);
+    }
+
+    int capacity() const {
+        return m_capacity;
+    }
+
+    int numFreeStates() const {
+        return m_freeStates.size();
+    }
+
+  private:
+    EffectStatePool()
+            : m_capacity(0),
+              m_framesPerBuffer(0) {
+    }
+
+    bool isCompatible(const mixxx::EngineParameters& engineParameters) const {
+        return m_sampleRate == engineParameters.sampleRate() &&
+                m_framesPerBuffer == engineParameters.framesPerBuffer();
+    }
+
+    QVector<EffectSpecificState*> m_freeStates;
+    int m_capacity;
+    mixxx::audio::SampleRate m_sampleRate;
+    SINT m_framesPerBuffer;
+
+    DISALLOW_COPY_AND_ASSIGN(EffectStatePool);
+};
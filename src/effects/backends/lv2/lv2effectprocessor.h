@@ -11,6 +11,10 @@
 // Refer to EffectProcessor for documentation
 class LV2EffectGroupState final : public EffectState {
   public:
+    // The plugin instance is connected to the ports of the LV2EffectProcessor
+    // that created it.
+    static constexpr bool kUseStatePool = false;
+
     LV2EffectGroupState(const mixxx::EngineParameters& engineParameters)
             : EffectState(engineParameters),
               m_pInstance(nullptr) {
@@ -417,6 +417,10 @@ void EffectChain::enableForInputChannel(const ChannelHandleAndGroup& handleGroup
 
     m_pMessenger->writeRequest(request);
 
+    // The engine has received the states, so the pools can be refilled
+    // without delaying the request
+    m_pEffectsManager->getBackendManager()->refillStatePools();
+
     m_enabledInputChannels.insert(handleGroup);
 }
 
@@ -157,6 +157,9 @@ void EffectSlot::addToEngine() {
     request->AddEffectToChain.pEffect = m_pEngineEffect;
     request->AddEffectToChain.iIndex = m_iEffectNumber;
     m_pMessenger->writeRequest(request);
+
+    // Replace the states that the new effect has taken from the pool
+    m_pBackendManager->refillStatePools();
 }
 
 void EffectSlot::removeFromEngine() {
@@ -193,12 +196,8 @@ void EffectSlot::updateEngineState() {
 }
 
 void EffectSlot::fillEffectStatesMap(EffectStatesMap* pStatesMap) const {
-    //TODO: get actual configuration of engine
-    const mixxx::EngineParameters engineParameters(
-            mixxx::audio::SampleRate(96000),
-            MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
-
     if (isLoaded()) {
+        const auto engineParameters = EngineEffect::stateEngineParameters();
         for (const auto& outputChannel :
                 m_pEffectsManager->registeredOutputChannels()) {
             pStatesMap->insert(outputChannel.handle(),
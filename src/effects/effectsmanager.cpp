@@ -64,6 +64,7 @@ EffectsManager::~EffectsManager() {
     m_effectChainSlotsByGroup.clear();
 
     m_pMessenger->processEffectsResponses();
+    m_pBackendManager->reserveStatePools(0);
 }
 
 void EffectsManager::setup() {
@@ -72,6 +73,13 @@ void EffectsManager::setup() {
     addOutputEffectChain();
     // EQ and QuickEffect chain slots are initialized when PlayerManager creates decks.
     readEffectsXml();
+
+    // Keep enough EffectStates ready to load any effect into an effect unit
+    // that is enabled for all decks. The pools are sized once and refilled
+    // whenever states have been taken from them.
+    m_pBackendManager->reserveStatePools(
+            m_equalizerEffectChains.size() *
+            m_registeredOutputChannels.size());
 }
 
 void EffectsManager::registerInputChannel(const ChannelHandleAndGroup& handle_group) {
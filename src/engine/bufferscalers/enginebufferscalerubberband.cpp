@@ -15,13 +15,6 @@
 
 using RubberBand::RubberBandStretcher;
 
-namespace {
-
-// This is the default increment from RubberBand 1.8.1.
-size_t kRubberBandBlockSize = 256;
-
-}  // namespace
-
 EngineBufferScaleRubberBand::EngineBufferScaleRubberBand(
         ReadAheadManager* pReadAheadManager)
         : m_pReadAheadManager(pReadAheadManager),
@@ -109,16 +102,23 @@ void EngineBufferScaleRubberBand::onSampleRateChanged() {
         m_pRubberBand.reset();
         return;
     }
-    m_pRubberBand = std::make_unique<RubberBandStretcher>(
-            getOutputSignal().getSampleRate(),
-            getOutputSignal().getChannelCount(),
+    m_pRubberBand = createStretcher(getOutputSignal());
+}
+
+// static
+std::unique_ptr<RubberBandStretcher> EngineBufferScaleRubberBand::createStretcher(
+        const mixxx::audio::SignalInfo& signal) {
+    auto pRubberBand = std::make_unique<RubberBandStretcher>(
+            signal.getSampleRate(),
+            signal.getChannelCount(),
             RubberBandStretcher::OptionProcessRealTime);
-    m_pRubberBand->setMaxProcessSize(kRubberBandBlockSize);
+    pRubberBand->setMaxProcessSize(kBlockSize);
     // Setting the time ratio to a very high value will cause RubberBand
     // to preallocate buffers large enough to (almost certainly)
     // avoid memory reallocations during playback.
-    m_pRubberBand->setTimeRatio(2.0);
-    m_pRubberBand->setTimeRatio(1.0);
+    pRubberBand->setTimeRatio(2.0);
+    pRubberBand->setTimeRatio(1.0);
+    return pRubberBand;
 }
 
 void EngineBufferScaleRubberBand::clear() {
@@ -143,6 +143,11 @@ SINT EngineBufferScaleRubberBand::retrieveAndDeinterleave(
     return received_frames;
 }
 
+SINT EngineBufferScaleRubberBand::getNextSamples(
+        double dRate, CSAMPLE* pBuffer, SINT requestedSamples) {
+    return m_pReadAheadManager->getNextSamples(dRate, pBuffer, requestedSamples);
+}
+
 void EngineBufferScaleRubberBand::deinterleaveAndProcess(
         const CSAMPLE* pBuffer, SINT frames, bool flush) {
 
@@ -194,16 +199,16 @@ double EngineBufferScaleRubberBand::scaleBuffer(
             // where it can report 0 samples needed forever which leads us to an
             // infinite loop. To work around this, we check if available() is
             // zero. If it is, then we submit a fixed block size of
-            // kRubberBandBlockSize.
+            // kBlockSize.
             int available = m_pRubberBand->available();
             if (available == 0) {
-                iLenFramesRequired = kRubberBandBlockSize;
+                iLenFramesRequired = kBlockSize;
             }
         }
         //qDebug() << "iLenFramesRequired" << iLenFramesRequired;
 
         if (remaining_frames > 0 && iLenFramesRequired > 0) {
-            SINT iAvailSamples = m_pReadAheadManager->getNextSamples(
+            SINT iAvailSamples = getNextSamples(
                         // The value doesn't matter here. All that matters is we
                         // are going forward or backward.
                         (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio,
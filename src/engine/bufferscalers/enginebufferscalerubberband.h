@@ -1,5 +1,6 @@
 #pragma once
 
+#include "audio/signalinfo.h"
 #include "engine/bufferscalers/enginebufferscale.h"
 #include "util/memory.h"
 
@@ -28,21 +29,33 @@ class EngineBufferScaleRubberBand : public EngineBufferScale {
     // Flush buffer.
     void clear() override;
 
-  private:
+    // This is the default increment from RubberBand 1.8.1.
+    static constexpr SINT kBlockSize = 256;
+
+    // Creates a stretcher for real-time processing of the signal with
+    // process() calls of at most kBlockSize frames.
+    static std::unique_ptr<RubberBand::RubberBandStretcher> createStretcher(
+            const mixxx::audio::SignalInfo& signal);
+
+  protected:
     // Reset RubberBand library with new audio signal
     void onSampleRateChanged() override;
 
-    void deinterleaveAndProcess(const CSAMPLE* pBuffer, SINT frames, bool flush);
-    SINT retrieveAndDeinterleave(CSAMPLE* pBuffer, SINT frames);
+    // Fetches the unscaled samples that are fed into the stretcher
+    virtual SINT getNextSamples(double dRate, CSAMPLE* pBuffer, SINT requestedSamples);
 
     // The read-ahead manager that we use to fetch samples
     ReadAheadManager* m_pReadAheadManager;
 
     std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBand;
 
-    CSAMPLE* m_retrieve_buffer[2];
-    CSAMPLE* m_buffer_back;
-
     // Holds the playback direction
     bool m_bBackwards;
+
+  private:
+    void deinterleaveAndProcess(const CSAMPLE* pBuffer, SINT frames, bool flush);
+    SINT retrieveAndDeinterleave(CSAMPLE* pBuffer, SINT frames);
+
+    CSAMPLE* m_retrieve_buffer[2];
+    CSAMPLE* m_buffer_back;
 };
@@ -0,0 +1,316 @@
+#include "engine/bufferscalers/enginebufferscalerubberbandlookahead.h"
+
+#include <rubberband/RubberBandStretcher.h>
+
+#include <cmath>
+
+#include "moc_enginebufferscalerubberbandlookahead.cpp"
+#include "util/defs.h"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+constexpr SINT kInputBufferFrames = 1 << 16;
+
+// The duration of the stretched audio that is queued by the worker
+constexpr double kLookAheadSeconds = 0.3;
+
+// The input of a callback is fed to the worker at most this many times to
+// fill the look-ahead gradually. This also gives the CachingReader time to
+// load the chunks ahead of the play position after seeks.
+constexpr SINT kMaxFeedFactor = 4;
+
+} // anonymous namespace
+
+EngineBufferScaleRubberBandLookAhead::EngineBufferScaleRubberBandLookAhead(
+        const QString& group,
+        ReadAheadManager* pReadAheadManager)
+        : EngineBufferScaleRubberBand(pReadAheadManager),
+          m_worker(group),
+          m_bWorkerBound(false),
+          m_state(State::Inline),
+          m_generation(0),
+          m_workerBaseRate(0.0),
+          m_workerTempoRatio(0.0),
+          m_workerPitchRatio(0.0),
+          m_inputBuffer(kInputBufferFrames * mixxx::kEngineChannelCount),
+          m_crossfadeBuffer(MAX_BUFFER_LEN) {
+    resetInput();
+    m_worker.start(QThread::HighPriority);
+}
+
+EngineBufferScaleRubberBandLookAhead::~EngineBufferScaleRubberBandLookAhead() {
+    m_worker.quitWait();
+}
+
+void EngineBufferScaleRubberBandLookAhead::bindWorkers(
+        EngineWorkerScheduler* pWorkerScheduler) {
+    m_worker.setScheduler(pWorkerScheduler);
+    m_bWorkerBound = true;
+}
+
+void EngineBufferScaleRubberBandLookAhead::onSampleRateChanged() {
+    EngineBufferScaleRubberBand::onSampleRateChanged();
+    resetInput();
+}
+
+void EngineBufferScaleRubberBandLookAhead::clear() {
+    EngineBufferScaleRubberBand::clear();
+    // The input that has been read ahead of the play position is dropped,
+    // so it needs to be read again. Otherwise the audio would jump ahead
+    // by the look-ahead and no longer match the play position.
+    m_pReadAheadManager->rewindToPlayposition();
+    resetInput();
+}
+
+void EngineBufferScaleRubberBandLookAhead::resetInput() {
+    // The worker is reset with the next callback
+    m_state = State::Inline;
+    m_inputEndFrame = 0;
+    m_inlineInputFrame = 0;
+    m_workerInputFrame = 0;
+    m_workerStartFrame = 0;
+    m_workerOutputFrames = 0;
+    m_playedFrames = 0.0;
+}
+
+bool EngineBufferScaleRubberBandLookAhead::workerParametersMatch() const {
+    return m_dBaseRate == m_workerBaseRate &&
+            m_dTempoRatio == m_workerTempoRatio &&
+            m_dPitchRatio == m_workerPitchRatio;
+}
+
+SINT EngineBufferScaleRubberBandLookAhead::retainedInputFrame() const {
+    // The input at the play position is needed for restarting the
+    // inline stretcher
+    SINT frame = math_min(static_cast<SINT>(m_playedFrames), m_inputEndFrame);
+    if (m_state != State::LookAhead) {
+        frame = math_min(frame, m_inlineInputFrame);
+    }
+    if (m_state != State::Inline) {
+        frame = math_min(frame, m_workerInputFrame);
+    }
+    return math_max(frame, static_cast<SINT>(0));
+}
+
+SINT EngineBufferScaleRubberBandLookAhead::readInput(SINT endFrame) {
+    // Only the direction matters
+    const double rate = (m_bBackwards ? -1.0 : 1.0) * m_dBaseRate * m_dTempoRatio;
+    const SINT bufferEndFrame = retainedInputFrame() + kInputBufferFrames;
+    while (m_inputEndFrame < endFrame) {
+        const SINT offset = m_inputEndFrame % kInputBufferFrames;
+        const SINT frames = math_min(
+                math_min(endFrame, bufferEndFrame) - m_inputEndFrame,
+                kInputBufferFrames - offset);
+        if (frames <= 0) {
+            break;
+        }
+        const SINT samples = EngineBufferScaleRubberBand::getNextSamples(rate,
+                m_inputBuffer.data(getOutputSignal().frames2samples(offset)),
+                getOutputSignal().frames2samples(frames));
+        const SINT readFrames = getOutputSignal().samples2frames(samples);
+        if (readFrames <= 0) {
+            break;
+        }
+        m_inputEndFrame += readFrames;
+    }
+    return m_inputEndFrame;
+}
+
+void EngineBufferScaleRubberBandLookAhead::copyInput(
+        CSAMPLE* pBuffer, SINT startFrame, SINT frames) const {
+    DEBUG_ASSERT(startFrame >= 0);
+    DEBUG_ASSERT(startFrame + frames <= m_inputEndFrame);
+    const SINT offset = startFrame % kInputBufferFrames;
+    const SINT firstFrames = math_min(frames, kInputBufferFrames - offset);
+    SampleUtil::copy(pBuffer,
+            m_inputBuffer.data(getOutputSignal().frames2samples(offset)),
+            getOutputSignal().frames2samples(firstFrames));
+    if (firstFrames < frames) {
+        SampleUtil::copy(pBuffer + getOutputSignal().frames2samples(firstFrames),
+                m_inputBuffer.data(),
+                getOutputSignal().frames2samples(frames - firstFrames));
+    }
+}
+
+SINT EngineBufferScaleRubberBandLookAhead::getNextSamples(
+        double dRate, CSAMPLE* pBuffer, SINT requestedSamples) {
+    if (!m_bWorkerBound) {
+        return EngineBufferScaleRubberBand::getNextSamples(
+                dRate, pBuffer, requestedSamples);
+    }
+    const SINT frames = getOutputSignal().samples2frames(requestedSamples);
+    const SINT endFrame = math_min(
+            readInput(m_inlineInputFrame + frames),
+            m_inlineInputFrame + frames);
+    const SINT availableFrames = endFrame - m_inlineInputFrame;
+    if (availableFrames <= 0) {
+        return 0;
+    }
+    copyInput(pBuffer, m_inlineInputFrame, availableFrames);
+    m_inlineInputFrame = endFrame;
+    return getOutputSignal().frames2samples(availableFrames);
+}
+
+void EngineBufferScaleRubberBandLookAhead::requestWorkerReset() {
+    const double pitchScale = fabs(m_dBaseRate * m_dPitchRatio);
+    if (pitchScale <= 0) {
+        return;
+    }
+    const int generation = m_generation + 1;
+    if (!m_worker.reset(generation,
+                getOutputSignal(),
+                1.0 / (m_dBaseRate * m_dTempoRatio),
+                pitchScale)) {
+        // Too many pending requests, try again with the next callback
+        return;
+    }
+    m_generation = generation;
+    m_workerBaseRate = m_dBaseRate;
+    m_workerTempoRatio = m_dTempoRatio;
+    m_workerPitchRatio = m_dPitchRatio;
+    // Start at the input position of the inline stretcher. Their output
+    // is aligned after the latency of the stretcher has passed.
+    m_workerStartFrame = m_inlineInputFrame;
+    m_workerInputFrame = m_inlineInputFrame;
+    m_state = State::Resetting;
+}
+
+void EngineBufferScaleRubberBandLookAhead::feedWorker(SINT outputFrames) {
+    const double rate = m_dBaseRate * m_dTempoRatio;
+    const auto lookAheadFrames = static_cast<SINT>(
+            kLookAheadSeconds * getOutputSignal().getSampleRate() * rate);
+    const SINT targetFrame = static_cast<SINT>(m_playedFrames) +
+            math_min(lookAheadFrames, kInputBufferFrames / 2);
+    const SINT maxFrames = kMaxFeedFactor *
+            (static_cast<SINT>(std::ceil(rate * outputFrames)) +
+                    EngineBufferScaleRubberBand::kBlockSize);
+    const SINT frames = math_min(
+            math_min(targetFrame - m_workerInputFrame, maxFrames),
+            m_worker.inputFramesWritable());
+    if (frames <= 0) {
+        return;
+    }
+    const SINT endFrame = math_min(
+            readInput(m_workerInputFrame + frames),
+            m_workerInputFrame + frames);
+    while (m_workerInputFrame < endFrame) {
+        const SINT offset = m_workerInputFrame % kInputBufferFrames;
+        const SINT chunkFrames = math_min(
+                endFrame - m_workerInputFrame,
+                kInputBufferFrames - offset);
+        const SINT writtenFrames = m_worker.writeInput(
+                m_inputBuffer.data(getOutputSignal().frames2samples(offset)),
+                chunkFrames);
+        m_workerInputFrame += writtenFrames;
+        if (writtenFrames < chunkFrames) {
+            break;
+        }
+    }
+}
+
+void EngineBufferScaleRubberBandLookAhead::tryHandOverToWorker(
+        CSAMPLE* pOutputBuffer, SINT iOutputBufferSize) {
+    const SINT frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    // The output of the worker that corresponds to the output of the
+    // inline stretcher for this callback
+    const auto startFrame = static_cast<SINT>(std::round(
+            (m_playedFrames - m_workerStartFrame) / (m_dBaseRate * m_dTempoRatio)));
+    if (startFrame > m_workerOutputFrames) {
+        m_workerOutputFrames += m_worker.discardOutput(startFrame - m_workerOutputFrames);
+    }
+    // The output of both stretchers is delayed by their latency.
+    // The initial output of the worker doesn't match the output of the
+    // inline stretcher that has been running before.
+    if (m_workerOutputFrames != startFrame ||
+            startFrame < static_cast<SINT>(m_pRubberBand->getLatency())) {
+        return;
+    }
+    const auto lookAheadFrames = static_cast<SINT>(
+            kLookAheadSeconds * getOutputSignal().getSampleRate());
+    if (m_worker.outputFramesAvailable() < frames + lookAheadFrames / 2) {
+        return;
+    }
+
+    SampleUtil::copy(m_crossfadeBuffer.data(), pOutputBuffer, iOutputBufferSize);
+    m_workerOutputFrames += m_worker.readOutput(pOutputBuffer, frames);
+    SampleUtil::linearCrossfadeBuffersIn(
+            pOutputBuffer, m_crossfadeBuffer.data(), iOutputBufferSize);
+    m_state = State::LookAhead;
+}
+
+double EngineBufferScaleRubberBandLookAhead::fallBackToInline(
+        CSAMPLE* pOutputBuffer, SINT iOutputBufferSize) {
+    const SINT frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    // Fade out the output of the worker that is still available, like
+    // EngineBuffer does for seeks
+    const SINT fadeOutFrames = m_worker.readOutput(m_crossfadeBuffer.data(), frames);
+    SampleUtil::clear(
+            m_crossfadeBuffer.data(getOutputSignal().frames2samples(fadeOutFrames)),
+            getOutputSignal().frames2samples(frames - fadeOutFrames));
+
+    // Restart the inline stretcher at the play position
+    m_pRubberBand->reset();
+    m_inlineInputFrame = math_min(static_cast<SINT>(m_playedFrames), m_inputEndFrame);
+    m_state = State::Inline;
+    const double framesRead = EngineBufferScaleRubberBand::scaleBuffer(
+            pOutputBuffer, iOutputBufferSize);
+
+    SampleUtil::linearCrossfadeBuffersIn(
+            pOutputBuffer, m_crossfadeBuffer.data(), iOutputBufferSize);
+    return framesRead;
+}
+
+double EngineBufferScaleRubberBandLookAhead::scaleBuffer(
+        CSAMPLE* pOutputBuffer,
+        SINT iOutputBufferSize) {
+    if (!m_bWorkerBound || m_dBaseRate == 0.0 || m_dTempoRatio == 0.0) {
+        return EngineBufferScaleRubberBand::scaleBuffer(
+                pOutputBuffer, iOutputBufferSize);
+    }
+
+    const SINT frames = getOutputSignal().samples2frames(iOutputBufferSize);
+    double framesRead;
+    if (m_state == State::LookAhead) {
+        if (workerParametersMatch() && m_worker.outputFramesAvailable() >= frames) {
+            m_worker.readOutput(pOutputBuffer, frames);
+            // Same as EngineBufferScaleRubberBand, see there
+            framesRead = m_dBaseRate * m_dTempoRatio * frames;
+        } else {
+            // The rate or pitch has changed or the worker fell behind
+            framesRead = fallBackToInline(pOutputBuffer, iOutputBufferSize);
+        }
+    } else {
+        if (m_state != State::Inline &&
+                (!workerParametersMatch() ||
+                        m_inlineInputFrame - m_workerInputFrame >
+                                kInputBufferFrames / 4)) {
+            // The worker has been reset with outdated parameters or
+            // doesn't keep up with the inline stretcher
+            m_state = State::Inline;
+        }
+        framesRead = EngineBufferScaleRubberBand::scaleBuffer(
+                pOutputBuffer, iOutputBufferSize);
+        if (m_state == State::Priming) {
+            tryHandOverToWorker(pOutputBuffer, iOutputBufferSize);
+        }
+    }
+    m_playedFrames += framesRead;
+
+    if (m_state == State::Inline) {
+        requestWorkerReset();
+    }
+    if (m_state == State::Resetting && m_worker.isReset(m_generation)) {
+        // Discard the output from before the reset
+        m_worker.discardOutput(m_worker.outputFramesAvailable());
+        m_workerOutputFrames = 0;
+        m_state = State::Priming;
+    }
+    if (m_state == State::Priming || m_state == State::LookAhead) {
+        feedWorker(frames);
+    }
+    m_worker.workReady();
+
+    return framesRead;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/bufferscalers/rubberbandworker.h"
+#include "util/samplebuffer.h"
+
+class EngineWorkerScheduler;
+
+// Uses librubberband to scale audio on a RubberBandWorker thread a few
+// hundred milliseconds ahead of the play position. This class is not
+// thread safe.
+//
+// All unscaled input that is read from the ReadAheadManager passes through
+// a ring buffer that starts at the play position. The worker is fed from
+// this buffer ahead of the play position and the inline stretcher of
+// EngineBufferScaleRubberBand is used whenever the worker cannot deliver:
+// * After clear(), i.e. after seeks, until the worker has been primed
+// * After changes of the rate or pitch, because the stretched audio that
+//   is already queued is discarded and the inline stretcher restarts
+//   from the play position
+// * If the worker falls behind
+// The inline and the worker output are crossfaded when switching between
+// them. Decks with continuously changing rates, e.g. while ramping the
+// pitch bend, keep using the inline stretcher.
+//
+// Without a bound EngineWorkerScheduler this behaves exactly like
+// EngineBufferScaleRubberBand.
+class EngineBufferScaleRubberBandLookAhead : public EngineBufferScaleRubberBand {
+    Q_OBJECT
+  public:
+    EngineBufferScaleRubberBandLookAhead(
+            const QString& group,
+            ReadAheadManager* pReadAheadManager);
+    ~EngineBufferScaleRubberBandLookAhead() override;
+
+    void bindWorkers(EngineWorkerScheduler* pWorkerScheduler);
+
+    double scaleBuffer(
+            CSAMPLE* pOutputBuffer,
+            SINT iOutputBufferSize) override;
+
+    // Flush buffer.
+    void clear() override;
+
+  protected:
+    void onSampleRateChanged() override;
+
+    // Reads from the ring buffer at the position of the inline stretcher
+    SINT getNextSamples(double dRate, CSAMPLE* pBuffer, SINT requestedSamples) override;
+
+  private:
+    enum class State {
+        // Only the inline stretcher is used
+        Inline,
+        // Waiting for the worker to acknowledge the reset
+        Resetting,
+        // Feeding the worker while the inline stretcher is used
+        Priming,
+        // Only the worker is used
+        LookAhead,
+    };
+
+    bool workerParametersMatch() const;
+    void resetInput();
+    SINT retainedInputFrame() const;
+    /// Reads from the ReadAheadManager into the ring buffer until
+    /// the given frame and returns the end of the available input
+    SINT readInput(SINT endFrame);
+    void copyInput(CSAMPLE* pBuffer, SINT startFrame, SINT frames) const;
+
+    void requestWorkerReset();
+    void feedWorker(SINT outputFrames);
+    void tryHandOverToWorker(CSAMPLE* pOutputBuffer, SINT iOutputBufferSize);
+    double fallBackToInline(CSAMPLE* pOutputBuffer, SINT iOutputBufferSize);
+
+    RubberBandWorker m_worker;
+    bool m_bWorkerBound;
+
+    State m_state;
+    // Identifies the most recent reset request of the worker
+    int m_generation;
+    // The parameters of the most recent reset request
+    double m_workerBaseRate;
+    double m_workerTempoRatio;
+    double m_workerPitchRatio;
+
+    // Ring buffer with the unscaled input. All positions are frame counts
+    // since the last reset of the input.
+    mixxx::SampleBuffer m_inputBuffer;
+    SINT m_inputEndFrame;
+    SINT m_inlineInputFrame;
+    SINT m_workerInputFrame;
+    // The input position of the first output frame of the worker
+    SINT m_workerStartFrame;
+    // The number of output frames of the worker that have been
+    // consumed or discarded since the reset was acknowledged
+    SINT m_workerOutputFrames;
+    double m_playedFrames;
+
+    mixxx::SampleBuffer m_crossfadeBuffer;
+};
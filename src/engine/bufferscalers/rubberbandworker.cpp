@@ -0,0 +1,152 @@
+#include "engine/bufferscalers/rubberbandworker.h"
+
+#include <rubberband/RubberBandStretcher.h>
+
+#include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "moc_rubberbandworker.cpp"
+#include "util/math.h"
+#include "util/sample.h"
+
+namespace {
+
+// Enough for a few hundred milliseconds of input and output at the
+// highest supported sample rates
+constexpr int kInputFIFOFrames = 1 << 15;
+constexpr int kOutputFIFOFrames = 1 << 16;
+
+constexpr SINT kRetrieveFrames = 4 * EngineBufferScaleRubberBand::kBlockSize;
+
+} // anonymous namespace
+
+RubberBandWorker::RubberBandWorker(const QString& group)
+        : m_group(group),
+          m_resetRequestFIFO(8),
+          m_inputFIFO(kInputFIFOFrames * mixxx::kEngineChannelCount),
+          m_outputFIFO(kOutputFIFOFrames * mixxx::kEngineChannelCount),
+          m_generation(0),
+          m_interleavedBuffer(kRetrieveFrames * mixxx::kEngineChannelCount) {
+    for (auto& channelBuffer : m_channelBuffers) {
+        mixxx::SampleBuffer(kRetrieveFrames).swap(channelBuffer);
+    }
+}
+
+RubberBandWorker::~RubberBandWorker() = default;
+
+bool RubberBandWorker::reset(int generation,
+        const mixxx::audio::SignalInfo& signal,
+        double timeRatio,
+        double pitchScale) {
+    const ResetRequest request = {generation, signal, timeRatio, pitchScale};
+    return m_resetRequestFIFO.write(&request, 1) == 1;
+}
+
+SINT RubberBandWorker::writeInput(const CSAMPLE* pBuffer, SINT frames) {
+    return m_inputFIFO.write(pBuffer,
+                   static_cast<int>(frames * mixxx::kEngineChannelCount)) /
+            mixxx::kEngineChannelCount;
+}
+
+SINT RubberBandWorker::readOutput(CSAMPLE* pBuffer, SINT frames) {
+    return m_outputFIFO.read(pBuffer,
+                   static_cast<int>(frames * mixxx::kEngineChannelCount)) /
+            mixxx::kEngineChannelCount;
+}
+
+SINT RubberBandWorker::discardOutput(SINT frames) {
+    return m_outputFIFO.flushReadData(
+                   static_cast<int>(frames * mixxx::kEngineChannelCount)) /
+            mixxx::kEngineChannelCount;
+}
+
+void RubberBandWorker::run() {
+    QThread::currentThread()->setObjectName(
+            QStringLiteral("RubberBandWorker %1").arg(m_group));
+
+    while (!m_stop.loadAcquire()) {
+        processResetRequests();
+        if (!processBlock()) {
+            // Wait for more input, free space in the output FIFO
+            // or a reset
+            waitForWork();
+        }
+    }
+}
+
+void RubberBandWorker::quitWait() {
+    m_stop = 1;
+    m_semaRun.release();
+    wait();
+}
+
+void RubberBandWorker::processResetRequests() {
+    // Only the most recent request matters
+    ResetRequest request;
+    bool pending = false;
+    while (m_resetRequestFIFO.read(&request, 1) == 1) {
+        pending = true;
+    }
+    if (!pending) {
+        return;
+    }
+
+    if (!m_pRubberBand || m_signal != request.signal) {
+        // The allocations are the reason why this is not done
+        // in the engine thread
+        m_signal = request.signal;
+        m_pRubberBand = EngineBufferScaleRubberBand::createStretcher(m_signal);
+    } else {
+        m_pRubberBand->reset();
+    }
+    m_pRubberBand->setTimeRatio(request.timeRatio);
+    m_pRubberBand->setPitchScale(request.pitchScale);
+
+    // The engine thread doesn't write any input until the reset
+    // has been acknowledged
+    m_inputFIFO.flushReadData(m_inputFIFO.readAvailable());
+    m_generation.store(request.generation, std::memory_order_release);
+}
+
+bool RubberBandWorker::processBlock() {
+    if (!m_pRubberBand) {
+        return false;
+    }
+
+    // Retrieve all output before processing more input to keep the
+    // internal buffers of the stretcher small
+    const int available = m_pRubberBand->available();
+    if (available > 0) {
+        const SINT frames = math_min(
+                math_min(static_cast<SINT>(available), kRetrieveFrames),
+                static_cast<SINT>(m_outputFIFO.writeAvailable() /
+                        mixxx::kEngineChannelCount));
+        if (frames <= 0) {
+            // The output FIFO is full
+            return false;
+        }
+        float* const channels[] = {m_channelBuffers[0].data(), m_channelBuffers[1].data()};
+        const SINT retrieved = m_pRubberBand->retrieve(channels, frames);
+        SampleUtil::interleaveBuffer(m_interleavedBuffer.data(),
+                m_channelBuffers[0].data(),
+                m_channelBuffers[1].data(),
+                retrieved);
+        m_outputFIFO.write(m_interleavedBuffer.data(),
+                static_cast<int>(retrieved * mixxx::kEngineChannelCount));
+        return retrieved > 0;
+    }
+
+    const SINT frames = math_min(
+            static_cast<SINT>(m_inputFIFO.readAvailable() / mixxx::kEngineChannelCount),
+            EngineBufferScaleRubberBand::kBlockSize);
+    if (frames <= 0) {
+        return false;
+    }
+    m_inputFIFO.read(m_interleavedBuffer.data(),
+            static_cast<int>(frames * mixxx::kEngineChannelCount));
+    SampleUtil::deinterleaveBuffer(m_channelBuffers[0].data(),
+            m_channelBuffers[1].data(),
+            m_interleavedBuffer.data(),
+            frames);
+    const float* const channels[] = {m_channelBuffers[0].data(), m_channelBuffers[1].data()};
+    m_pRubberBand->process(channels, frames, false);
+    return true;
+}
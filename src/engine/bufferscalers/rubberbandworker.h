@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+#include "audio/signalinfo.h"
+#include "engine/engine.h"
+#include "engine/engineworker.h"
+#include "util/fifo.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+namespace RubberBand {
+class RubberBandStretcher;
+} // namespace RubberBand
+
+/// Time-stretches an interleaved stereo signal with RubberBand on its own
+/// thread, see EngineBufferScaleRubberBandLookAhead.
+///
+/// The engine thread writes the unscaled samples into the input FIFO and
+/// reads the stretched samples from the output FIFO. The parameters of the
+/// stretcher are only changed by reset(), which discards all pending input.
+/// The engine thread must not write any input until the reset has been
+/// acknowledged and must then discard all output that is still available.
+class RubberBandWorker : public EngineWorker {
+    Q_OBJECT
+  public:
+    explicit RubberBandWorker(const QString& group);
+    ~RubberBandWorker() override;
+
+    /// Requests a reset of the stretcher that is identified by the
+    /// generation. Returns false if too many requests are pending.
+    bool reset(int generation,
+            const mixxx::audio::SignalInfo& signal,
+            double timeRatio,
+            double pitchScale);
+    /// Returns true if the reset with the given generation has been
+    /// processed and no older input or parameters are in use.
+    bool isReset(int generation) const {
+        return m_generation.load(std::memory_order_acquire) == generation;
+    }
+
+    SINT inputFramesWritable() const {
+        return m_inputFIFO.writeAvailable() / mixxx::kEngineChannelCount;
+    }
+    SINT writeInput(const CSAMPLE* pBuffer, SINT frames);
+
+    SINT outputFramesAvailable() const {
+        return m_outputFIFO.readAvailable() / mixxx::kEngineChannelCount;
+    }
+    SINT readOutput(CSAMPLE* pBuffer, SINT frames);
+    SINT discardOutput(SINT frames);
+
+    // Runs the stretcher until all input has been processed or the output
+    // FIFO is full. Woken by the EngineWorkerScheduler.
+    void run() override;
+
+    void quitWait();
+
+  private:
+    struct ResetRequest {
+        int generation;
+        mixxx::audio::SignalInfo signal;
+        double timeRatio;
+        double pitchScale;
+    };
+
+    void processResetRequests();
+    /// Returns false if no progress could be made
+    bool processBlock();
+
+    const QString m_group;
+
+    // Thread-safe FIFOs for communication between the engine callback and
+    // the worker thread.
+    FIFO<ResetRequest> m_resetRequestFIFO;
+    FIFO<CSAMPLE> m_inputFIFO;
+    FIFO<CSAMPLE> m_outputFIFO;
+
+    std::atomic<int> m_generation;
+    QAtomicInt m_stop;
+
+    // Only accessed by the worker thread
+    mixxx::audio::SignalInfo m_signal;
+    std::unique_ptr<RubberBand::RubberBandStretcher> m_pRubberBand;
+    mixxx::SampleBuffer m_interleavedBuffer;
+    mixxx::SampleBuffer m_channelBuffers[mixxx::kEngineChannelCount];
+};
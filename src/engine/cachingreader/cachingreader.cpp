@@ -2,6 +2,7 @@
 
 #include <QFileInfo>
 #include <QtDebug>
+#include <algorithm>
 
 #include "control/controlobject.h"
 #include "moc_cachingreader.cpp"
@@ -22,6 +23,32 @@ mixxx::Logger kLogger("CachingReader");
 // TODO() Do we suffer cache misses if we use an audio buffer of above 23 ms?
 constexpr SINT kDefaultHintFrames = 1024;
 
+// This is the hint frameCount that is adopted in case of Hint::kFrameCountJumpTarget.
+// It covers the largest audio buffer plus the look ahead of the scalers right
+// after a jump. After that the ReadAheadManager will have requested the
+// following chunks. It matches 93 ms @ 44.1 kHz.
+constexpr SINT kJumpTargetHintFrames = 4096;
+
+// The minimum number of free slots in the request FIFO that are reserved
+// for urgent read requests. Read requests for background hints are postponed
+// until the next callback if the FIFO is filled beyond that.
+constexpr int kReservedChunkReadRequests = 4;
+
+constexpr int kNumHintPriorityClasses = 4;
+
+int hintPriorityClass(const Hint& hint) {
+    if (hint.priority <= Hint::kPriorityPlayPosition) {
+        return 0;
+    }
+    if (hint.priority <= Hint::kPriorityLoop) {
+        return 1;
+    }
+    if (hint.priority < Hint::kPriorityBackground) {
+        return 2;
+    }
+    return 3;
+}
+
 // With CachingReaderChunk::kFrames = 8192 each chunk consumes
 // 8192 frames * 2 channels/frame * 4-bytes per sample = 65 kB.
 //
@@ -33,17 +60,69 @@ constexpr SINT kDefaultHintFrames = 1024;
 // CachingReader must be multiplied by the number of decks to calculate
 // the total amount!
 //
+// The number of chunks can be configured per deck with the keys
+// "cache_chunks" (the initial and minimum number of chunks) and
+// "cache_chunks_max" (the upper bound for the adaptive cache size and
+// the memory budget for keeping a whole track in memory).
+//
 // NOTE(uklotzde, 2019-09-05): Reduce this number to just few chunks
-// (kNumberOfCachedChunksInMemory = 1, 2, 3, ...) for testing purposes
+// (cache_chunks = 1, 2, 3, ...) for testing purposes
 // to verify that the MRU/LRU cache works as expected. Even though
 // massive drop outs are expected to occur Mixxx should run reliably!
-constexpr SINT kNumberOfCachedChunksInMemory = 80;
+constexpr SINT kDefaultNumberOfCachedChunksInMemory = 80;
+
+// 4 * 80 chunks -> 20 MB, i.e. about 55 s of audio @ 48 kHz
+constexpr SINT kDefaultMaxNumberOfCachedChunksInMemory = 4 * kDefaultNumberOfCachedChunksInMemory;
+
+// The number of hit/miss lookups that are accumulated before reporting
+// them to the StatsManager.
+constexpr int kChunkLookupsPerStatsReport = 256;
+
+constexpr SINT kInvalidChunkIndex = -1;
+
+SINT configuredNumberOfChunks(
+        const UserSettingsPointer& pConfig,
+        const QString& group) {
+    if (!pConfig) {
+        return kDefaultNumberOfCachedChunksInMemory;
+    }
+    const SINT chunks = pConfig->getValue(
+            ConfigKey(group, QStringLiteral("cache_chunks")),
+            static_cast<int>(kDefaultNumberOfCachedChunksInMemory));
+    return math_max(chunks, static_cast<SINT>(1));
+}
+
+SINT configuredMaxNumberOfChunks(
+        const UserSettingsPointer& pConfig,
+        const QString& group) {
+    const SINT minChunks = configuredNumberOfChunks(pConfig, group);
+    if (!pConfig) {
+        return math_max(kDefaultMaxNumberOfCachedChunksInMemory, minChunks);
+    }
+    const SINT maxChunks = pConfig->getValue(
+            ConfigKey(group, QStringLiteral("cache_chunks_max")),
+            static_cast<int>(kDefaultMaxNumberOfCachedChunksInMemory));
+    return math_max(maxChunks, minChunks);
+}
+
+bool configuredWholeTrackResident(
+        const UserSettingsPointer& pConfig,
+        const QString& group) {
+    if (!pConfig) {
+        return false;
+    }
+    return pConfig->getValue(
+            ConfigKey(group, QStringLiteral("cache_whole_track")), false);
+}
 
 } // anonymous namespace
 
 CachingReader::CachingReader(const QString& group,
         UserSettingsPointer config)
         : m_pConfig(config),
+          m_cacheSize(configuredNumberOfChunks(config, group),
+                  configuredMaxNumberOfChunks(config, group)),
+          m_wholeTrackResident(configuredWholeTrackResident(config, group)),
           // Limit the number of in-flight requests to the worker. This should
           // prevent to overload the worker when it is not able to fetch those
           // requests from the FIFO timely. Otherwise outdated requests pile up
@@ -53,27 +132,29 @@ CachingReader::CachingReader(const QString& group,
           // buffer, where new requests replace old requests when full. Those
           // old requests need to be returned immediately to the CachingReader
           // that must take ownership and free them!!!
-          m_chunkReadRequestFIFO(kNumberOfCachedChunksInMemory / 4),
+          m_chunkReadRequestFIFO(kDefaultNumberOfCachedChunksInMemory / 4),
           // The capacity of the back channel must be equal to the number of
           // allocated chunks, because the worker use writeBlocking(). Otherwise
           // the worker could get stuck in a hot loop!!!
-          m_readerStatusUpdateFIFO(kNumberOfCachedChunksInMemory),
+          m_readerStatusUpdateFIFO(m_cacheSize.maxChunks()),
           m_state(STATE_IDLE),
           m_mruCachingReaderChunk(nullptr),
           m_lruCachingReaderChunk(nullptr),
-          m_sampleBuffer(CachingReaderChunk::kSamples * kNumberOfCachedChunksInMemory),
+          m_recentlyEvictedChunks(
+                  roundUpToPowerOf2(2 * static_cast<int>(m_cacheSize.maxChunks())),
+                  EvictedChunk{kInvalidChunkIndex, 0}),
+          m_evictedChunkCount(0),
+          m_cacheHits(0),
+          m_cacheMisses(0),
+          m_cacheHitCounter(QStringLiteral("CachingReader %1 cache hits").arg(group)),
+          m_cacheMissCounter(QStringLiteral("CachingReader %1 cache misses").arg(group)),
           m_worker(group, &m_chunkReadRequestFIFO, &m_readerStatusUpdateFIFO) {
-    m_allocatedCachingReaderChunks.reserve(kNumberOfCachedChunksInMemory);
-    // Divide up the allocated raw memory buffer into total_chunks
-    // chunks. Initialize each chunk to hold nothing and add it to the free
-    // list.
-    for (SINT i = 0; i < kNumberOfCachedChunksInMemory; ++i) {
-        CachingReaderChunkForOwner* c =
-                new CachingReaderChunkForOwner(
-                        mixxx::SampleBuffer::WritableSlice(
-                                m_sampleBuffer,
-                                CachingReaderChunk::kSamples * i,
-                                CachingReaderChunk::kSamples));
+    m_allocatedCachingReaderChunks.reserve(m_cacheSize.maxChunks());
+    // Initialize each chunk to hold nothing and add it to the free list.
+    // The sample memory of a chunk is allocated by the worker when the
+    // chunk is read for the first time.
+    for (SINT i = 0; i < m_cacheSize.maxChunks(); ++i) {
+        CachingReaderChunkForOwner* c = new CachingReaderChunkForOwner();
         m_chunks.push_back(c);
         m_freeChunks.push_back(c);
     }
@@ -102,7 +183,9 @@ void CachingReader::freeChunkFromList(CachingReaderChunkForOwner* pChunk) {
             &m_mruCachingReaderChunk,
             &m_lruCachingReaderChunk);
     pChunk->free();
-    m_freeChunks.push_back(pChunk);
+    // Reuse recently freed chunks first to keep the set of memory pages
+    // that are actually used as small as possible.
+    m_freeChunks.push_front(pChunk);
 }
 
 void CachingReader::freeChunk(CachingReaderChunkForOwner* pChunk) {
@@ -137,7 +220,8 @@ void CachingReader::freeAllChunks() {
 }
 
 CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
-    if (m_freeChunks.empty()) {
+    if (m_freeChunks.empty() ||
+            m_allocatedCachingReaderChunks.size() >= m_cacheSize.chunks()) {
         return nullptr;
     }
     CachingReaderChunkForOwner* pChunk = m_freeChunks.front();
@@ -152,13 +236,18 @@ CachingReaderChunkForOwner* CachingReader::allocateChunk(SINT chunkIndex) {
 
 CachingReaderChunkForOwner* CachingReader::allocateChunkExpireLRU(SINT chunkIndex) {
     auto* pChunk = allocateChunk(chunkIndex);
-    if (!pChunk) {
-        if (m_lruCachingReaderChunk) {
-            freeChunk(m_lruCachingReaderChunk);
-            pChunk = allocateChunk(chunkIndex);
-        } else {
+    // More than one chunk needs to be expired after the cache has shrunk
+    while (!pChunk) {
+        if (!m_lruCachingReaderChunk) {
             kLogger.warning() << "No cached LRU chunk available for freeing";
+            break;
         }
+        const SINT evictedChunkIndex = m_lruCachingReaderChunk->getIndex();
+        m_recentlyEvictedChunks[evictedChunkIndex &
+                (m_recentlyEvictedChunks.size() - 1)] =
+                EvictedChunk{evictedChunkIndex, ++m_evictedChunkCount};
+        freeChunk(m_lruCachingReaderChunk);
+        pChunk = allocateChunk(chunkIndex);
     }
     if (kLogger.traceEnabled()) {
         kLogger.trace() << "allocateChunkExpireLRU" << chunkIndex << pChunk;
@@ -166,6 +255,34 @@ CachingReaderChunkForOwner* CachingReader::allocateChunkExpireLRU(SINT chunkInde
     return pChunk;
 }
 
+bool CachingReader::wasRecentlyEvicted(SINT chunkIndex) const {
+    const EvictedChunk& evictedChunk = m_recentlyEvictedChunks[chunkIndex &
+            (m_recentlyEvictedChunks.size() - 1)];
+    return evictedChunk.chunkIndex == chunkIndex &&
+            m_evictedChunkCount - evictedChunk.evictionNumber <
+            m_cacheSize.maxChunks();
+}
+
+void CachingReader::recordChunkLookup(CachingReaderCacheSize::Lookup lookup) {
+    if (lookup == CachingReaderCacheSize::Lookup::Hit) {
+        ++m_cacheHits;
+    } else {
+        ++m_cacheMisses;
+    }
+    if (m_cacheHits + m_cacheMisses >= kChunkLookupsPerStatsReport) {
+        m_cacheHitCounter += m_cacheHits;
+        m_cacheMissCounter += m_cacheMisses;
+        m_cacheHits = 0;
+        m_cacheMisses = 0;
+    }
+    if (m_cacheSize.recordLookup(lookup) && kLogger.debugEnabled()) {
+        kLogger.debug()
+                << "Adjusted cache size to"
+                << m_cacheSize.chunks()
+                << "chunks";
+    }
+}
+
 CachingReaderChunkForOwner* CachingReader::lookupChunk(SINT chunkIndex) {
     // Defaults to nullptr if it's not in the hash.
     auto* pChunk = m_allocatedCachingReaderChunks.value(chunkIndex, nullptr);
@@ -275,6 +392,22 @@ void CachingReader::process() {
                 }
                 // Reset the readable frame index range
                 m_readableFrameIndexRange = update.readableFrameIndexRange();
+                // Start over with the configured cache size
+                m_cacheSize.reset();
+                std::fill(m_recentlyEvictedChunks.begin(),
+                        m_recentlyEvictedChunks.end(),
+                        EvictedChunk{kInvalidChunkIndex, 0});
+                if (m_wholeTrackResident && !m_readableFrameIndexRange.empty()) {
+                    const SINT trackChunks = CachingReaderChunk::indexForFrame(
+                                                     m_readableFrameIndexRange.end() - 1) +
+                            1;
+                    if (m_cacheSize.pinToTrack(trackChunks)) {
+                        kLogger.debug()
+                                << "Keeping all"
+                                << trackChunks
+                                << "chunks of the track in memory";
+                    }
+                }
                 m_state.storeRelease(STATE_TRACK_LOADED);
             } else {
                 DEBUG_ASSERT(update.status == TRACK_UNLOADED);
@@ -423,6 +556,7 @@ CachingReader::ReadResult CachingReader::read(SINT startSample, SINT numSamples,
                 mixxx::IndexRange bufferedFrameIndexRange;
                 const CachingReaderChunkForOwner* const pChunk = lookupChunkAndFreshen(chunkIndex);
                 if (pChunk && (pChunk->getState() == CachingReaderChunkForOwner::READY)) {
+                    recordChunkLookup(CachingReaderCacheSize::Lookup::Hit);
                     if (reverse) {
                         bufferedFrameIndexRange =
                                 pChunk->readBufferedSampleFramesReverse(
@@ -513,81 +647,107 @@ void CachingReader::hintAndMaybeWake(const HintVector& hintList) {
     }
 
     // For every chunk that the hints indicated, check if it is in the cache. If
-    // any are not, then wake.
+    // any are not, then wake. Hints are served by priority, so that read
+    // requests for the play position are queued before those for cues and
+    // background hints. Sorting is not necessary, because there are only a
+    // few priority classes.
     bool shouldWake = false;
-
-    for (const auto& hint: hintList) {
-        SINT hintFrame = hint.frame;
-        SINT hintFrameCount = hint.frameCount;
-
-        // Handle some special length values
-        if (hintFrameCount == Hint::kFrameCountForward) {
-        	hintFrameCount = kDefaultHintFrames;
-        } else if (hintFrameCount == Hint::kFrameCountBackward) {
-        	hintFrame -= kDefaultHintFrames;
-        	hintFrameCount = kDefaultHintFrames;
-            if (hintFrame < 0) {
-            	hintFrameCount += hintFrame;
-                if (hintFrameCount <= 0) {
-                    continue;
-                }
-                hintFrame = 0;
+    for (int priorityClass = 0; priorityClass < kNumHintPriorityClasses; ++priorityClass) {
+        for (const auto& hint : hintList) {
+            if (hintPriorityClass(hint) == priorityClass) {
+                shouldWake |= hintChunks(hint);
             }
         }
+    }
 
-        VERIFY_OR_DEBUG_ASSERT(hintFrameCount >= 0) {
-            kLogger.warning() << "CachingReader: Ignoring negative hint length.";
-            continue;
-        }
+    // If there are chunks to be read, wake up.
+    if (shouldWake) {
+        m_worker.workReady();
+    }
+}
 
-        const auto readableFrameIndexRange = intersect(
-                m_readableFrameIndexRange,
-                mixxx::IndexRange::forward(hintFrame, hintFrameCount));
-        if (readableFrameIndexRange.empty()) {
-            continue;
+bool CachingReader::hintChunks(const Hint& hint) {
+    SINT hintFrame = hint.frame;
+    SINT hintFrameCount = hint.frameCount;
+
+    // Handle some special length values
+    if (hintFrameCount == Hint::kFrameCountForward) {
+        hintFrameCount = kDefaultHintFrames;
+    } else if (hintFrameCount == Hint::kFrameCountJumpTarget) {
+        hintFrameCount = kJumpTargetHintFrames;
+    } else if (hintFrameCount == Hint::kFrameCountBackward) {
+        hintFrame -= kDefaultHintFrames;
+        hintFrameCount = kDefaultHintFrames;
+        if (hintFrame < 0) {
+            hintFrameCount += hintFrame;
+            if (hintFrameCount <= 0) {
+                return false;
+            }
+            hintFrame = 0;
         }
+    }
+
+    VERIFY_OR_DEBUG_ASSERT(hintFrameCount >= 0) {
+        kLogger.warning() << "CachingReader: Ignoring negative hint length.";
+        return false;
+    }
+
+    const auto readableFrameIndexRange = intersect(
+            m_readableFrameIndexRange,
+            mixxx::IndexRange::forward(hintFrame, hintFrameCount));
+    if (readableFrameIndexRange.empty()) {
+        return false;
+    }
 
-        const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
-        const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
-        for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
-            CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
+    const bool background = hint.priority >= Hint::kPriorityBackground;
+    bool requested = false;
+    const int firstChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.start());
+    const int lastChunkIndex = CachingReaderChunk::indexForFrame(readableFrameIndexRange.end() - 1);
+    for (int chunkIndex = firstChunkIndex; chunkIndex <= lastChunkIndex; ++chunkIndex) {
+        CachingReaderChunkForOwner* pChunk = lookupChunk(chunkIndex);
+        if (!pChunk) {
+            if (background &&
+                    m_chunkReadRequestFIFO.writeAvailable() <= kReservedChunkReadRequests) {
+                // Try again in one of the next callbacks when the worker
+                // has caught up with the more urgent requests.
+                continue;
+            }
+            recordChunkLookup(wasRecentlyEvicted(chunkIndex)
+                            ? CachingReaderCacheSize::Lookup::Redecode
+                            : CachingReaderCacheSize::Lookup::Miss);
+            requested = true;
+            pChunk = allocateChunkExpireLRU(chunkIndex);
             if (!pChunk) {
-                shouldWake = true;
-                pChunk = allocateChunkExpireLRU(chunkIndex);
-                if (!pChunk) {
-                    kLogger.warning()
-                            << "Failed to allocate chunk"
-                            << chunkIndex
-                            << "for read request";
-                    continue;
-                }
-                // Do not insert the allocated chunk into the MRU/LRU list,
-                // because it will be handed over to the worker immediately
-                CachingReaderChunkReadRequest request;
-                request.giveToWorker(pChunk);
-                if (kLogger.traceEnabled()) {
-                    kLogger.trace()
-                            << "Requesting read of chunk"
-                            << request.chunk;
-                }
-                if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
-                    kLogger.warning()
-                            << "Failed to submit read request for chunk"
-                            << chunkIndex;
-                    // Revoke the chunk from the worker and free it
-                    pChunk->takeFromWorker();
-                    freeChunk(pChunk);
-                }
-            } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
-                // This will cause the chunk to be 'freshened' in the cache. The
-                // chunk will be moved to the end of the LRU list.
-                freshenChunk(pChunk);
+                kLogger.warning()
+                        << "Failed to allocate chunk"
+                        << chunkIndex
+                        << "for read request";
+                continue;
             }
+            // Do not insert the allocated chunk into the MRU/LRU list,
+            // because it will be handed over to the worker immediately
+            CachingReaderChunkReadRequest request;
+            request.giveToWorker(pChunk);
+            if (kLogger.traceEnabled()) {
+                kLogger.trace()
+                        << "Requesting read of chunk"
+                        << request.chunk
+                        << "with priority"
+                        << hint.priority;
+            }
+            if (m_chunkReadRequestFIFO.write(&request, 1) != 1) {
+                kLogger.warning()
+                        << "Failed to submit read request for chunk"
+                        << chunkIndex;
+                // Revoke the chunk from the worker and free it
+                pChunk->takeFromWorker();
+                freeChunk(pChunk);
+            }
+        } else if (pChunk->getState() == CachingReaderChunkForOwner::READY) {
+            // This will cause the chunk to be 'freshened' in the cache. The
+            // chunk will be moved to the end of the LRU list.
+            freshenChunk(pChunk);
         }
     }
-
-    // If there are chunks to be read, wake up.
-    if (shouldWake) {
-        m_worker.workReady();
-    }
+    return requested;
 }
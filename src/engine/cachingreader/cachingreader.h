@@ -6,11 +6,14 @@
 #include <QVarLengthArray>
 #include <QVector>
 #include <list>
+#include <vector>
 
+#include "engine/cachingreader/cachingreadercachesize.h"
 #include "engine/cachingreader/cachingreaderworker.h"
 #include "engine/engineworker.h"
 #include "preferences/usersettings.h"
 #include "track/track_decl.h"
+#include "util/counter.h"
 #include "util/fifo.h"
 #include "util/types.h"
 
@@ -23,16 +26,29 @@ typedef struct Hint {
     // If a range of frames should be present, use frameCount to indicate that the
     // range (frame, frame + frameCount) should be present in memory.
     SINT frameCount;
-    // Currently unused -- but in the future could be used to prioritize certain
-    // hints over others. A priority of 1 is the highest priority and should be
-    // used for samples that will be read imminently. Hints for samples that
-    // have the potential to be read (i.e. a cue point) should be issued with
-    // priority >10.
+    // Hints are served in order of their priority, lowest value first. A
+    // priority of 1 is the highest priority and should be used for samples
+    // that will be read imminently. Hints for samples that have the potential
+    // to be read (i.e. a cue point) should be issued with priority >= 10.
+    // Read requests for background hints are only submitted while the worker
+    // is not busy with more urgent requests.
     int priority;
 
+    // The samples around the play position
+    static constexpr int kPriorityPlayPosition = 1;
+    // The start of an active loop, which will be reached soon
+    static constexpr int kPriorityLoop = 2;
+    // Positions the user can jump to instantly, e.g. cues and hotcues
+    static constexpr int kPriorityJumpTarget = 10;
+    // Positions that might be needed later, e.g. intro/outro cues for AutoDJ
+    static constexpr int kPriorityBackground = 20;
+
     // for the default frame count in forward direction
     static constexpr SINT kFrameCountForward = 0;
     static constexpr SINT kFrameCountBackward = -1;
+    // for the frame count that is read right after jumping to the frame,
+    // until the hints of the ReadAheadManager take over
+    static constexpr SINT kFrameCountJumpTarget = -2;
 
 } Hint;
 
@@ -67,6 +83,12 @@ typedef QVarLengthArray<Hint, 512> HintVector;
 // least-recently-used list. When a chunk needs to be allocated and there are no
 // free chunks then the least recently used chunk is free'd (see
 // allocateChunkExpireLRU).
+//
+// The number of chunks that are kept in memory is configurable per deck and
+// adapts to the observed miss rate (see CachingReaderCacheSize). The sample
+// memory of a chunk is allocated by the worker when the chunk is read for the
+// first time, so memory only grows with the chunks that are actually used
+// and is never allocated by the engine thread.
 class CachingReader : public QObject {
     Q_OBJECT
 
@@ -117,6 +139,11 @@ class CachingReader : public QObject {
   private:
     const UserSettingsPointer m_pConfig;
 
+    // The number of chunks that are currently allowed to be allocated.
+    // Must be initialized before the FIFOs and buffers that depend on it.
+    CachingReaderCacheSize m_cacheSize;
+    const bool m_wholeTrackResident;
+
     // Thread-safe FIFOs for communication between the engine callback and
     // reader thread.
     FIFO<CachingReaderChunkReadRequest> m_chunkReadRequestFIFO;
@@ -147,6 +174,14 @@ class CachingReader : public QObject {
     // Gets a chunk from the free list, frees the LRU CachingReaderChunk if none available.
     CachingReaderChunkForOwner* allocateChunkExpireLRU(SINT chunkIndex);
 
+    // Updates the hit/miss statistics and the adaptive cache size.
+    void recordChunkLookup(CachingReaderCacheSize::Lookup lookup);
+
+    // Freshens the chunks covered by the hint or requests to read them.
+    // Returns true if a read request has been submitted.
+    bool hintChunks(const Hint& hint);
+    bool wasRecentlyEvicted(SINT chunkIndex) const;
+
     enum State {
         STATE_IDLE,
         STATE_TRACK_LOADING,
@@ -170,11 +205,25 @@ class CachingReader : public QObject {
     CachingReaderChunkForOwner* m_mruCachingReaderChunk;
     CachingReaderChunkForOwner* m_lruCachingReaderChunk;
 
-    // The raw memory buffer which is divided up into chunks.
-    mixxx::SampleBuffer m_sampleBuffer;
-
     // The readable frame index range as reported by the worker.
     mixxx::IndexRange m_readableFrameIndexRange;
 
+    // Direct-mapped hash table of the most recently evicted chunks
+    // for detecting chunks that need to be decoded again. An entry is
+    // replaced by a newer eviction with the same hash and expires after
+    // maxChunks() subsequent evictions.
+    struct EvictedChunk {
+        SINT chunkIndex;
+        SINT evictionNumber;
+    };
+    std::vector<EvictedChunk> m_recentlyEvictedChunks;
+    SINT m_evictedChunkCount;
+
+    // Hit/miss statistics that are reported to the StatsManager in batches.
+    int m_cacheHits;
+    int m_cacheMisses;
+    Counter m_cacheHitCounter;
+    Counter m_cacheMissCounter;
+
     CachingReaderWorker m_worker;
 };
@@ -0,0 +1,80 @@
+#include "engine/cachingreader/cachingreadercachesize.h"
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// Grow the cache if more than 1 out of 64 lookups needed to decode
+// an evicted chunk again.
+constexpr int kGrowRedecodesPerWindow = CachingReaderCacheSize::kLookupsPerWindow / 64;
+
+// Only shrink after no evicted chunk was needed again for a long time in
+// a row, to avoid oscillating between two sizes.
+constexpr int kShrinkAfterWindowsWithoutRedecodes = 8;
+
+} // anonymous namespace
+
+CachingReaderCacheSize::CachingReaderCacheSize(SINT minChunks, SINT maxChunks)
+        : m_minChunks(math_max(minChunks, static_cast<SINT>(1))),
+          m_maxChunks(math_max(maxChunks, m_minChunks)),
+          m_chunks(m_minChunks),
+          m_pinned(false),
+          m_lookups(0),
+          m_redecodes(0),
+          m_windowsWithoutRedecodes(0) {
+}
+
+bool CachingReaderCacheSize::pinToTrack(SINT trackChunks) {
+    if (trackChunks <= 0 || trackChunks > m_maxChunks) {
+        return false;
+    }
+    m_chunks = math_max(trackChunks, m_minChunks);
+    m_pinned = true;
+    return true;
+}
+
+void CachingReaderCacheSize::reset() {
+    m_chunks = m_minChunks;
+    m_pinned = false;
+    m_lookups = 0;
+    m_redecodes = 0;
+    m_windowsWithoutRedecodes = 0;
+}
+
+bool CachingReaderCacheSize::recordLookup(Lookup lookup) {
+    if (m_pinned) {
+        return false;
+    }
+    ++m_lookups;
+    if (lookup == Lookup::Redecode) {
+        ++m_redecodes;
+    }
+    if (m_lookups < kLookupsPerWindow) {
+        return false;
+    }
+    const SINT oldChunks = m_chunks;
+    adapt();
+    m_lookups = 0;
+    m_redecodes = 0;
+    return m_chunks != oldChunks;
+}
+
+void CachingReaderCacheSize::adapt() {
+    DEBUG_ASSERT(!m_pinned);
+    if (m_redecodes > kGrowRedecodesPerWindow) {
+        m_windowsWithoutRedecodes = 0;
+        // Grow by 25%
+        m_chunks = math_min(m_chunks + math_max(m_chunks / 4, static_cast<SINT>(1)),
+                m_maxChunks);
+    } else if (m_redecodes == 0) {
+        if (++m_windowsWithoutRedecodes >= kShrinkAfterWindowsWithoutRedecodes) {
+            m_windowsWithoutRedecodes = 0;
+            // Shrink by 12.5%
+            m_chunks = math_max(m_chunks - math_max(m_chunks / 8, static_cast<SINT>(1)),
+                    m_minChunks);
+        }
+    } else {
+        m_windowsWithoutRedecodes = 0;
+    }
+}
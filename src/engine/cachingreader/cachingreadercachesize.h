@@ -0,0 +1,71 @@
+#pragma once
+
+#include "util/types.h"
+
+// CachingReaderCacheSize decides how many chunks a CachingReader may keep
+// in memory. The size adapts to the observed cache miss rate within the
+// range [minChunks, maxChunks]: It grows while evicted chunks need to be
+// decoded again and again (e.g. for long loops, backspins or hotcue jumps)
+// and slowly shrinks back when the working set fits into the cache.
+//
+// If the whole track fits into maxChunks the size can be pinned to the
+// length of the track, i.e. no chunk of the track will ever be evicted.
+//
+// The class is not thread-safe and must only be used from the engine thread.
+class CachingReaderCacheSize {
+  public:
+    // The number of chunk lookups that are evaluated at once
+    static constexpr int kLookupsPerWindow = 1024;
+
+    enum class Lookup {
+        // The chunk was found in the cache
+        Hit,
+        // The chunk has never been decoded before, e.g. during normal
+        // playback. A bigger cache would not have helped.
+        Miss,
+        // The chunk has been evicted from the cache before and needs to
+        // be decoded again. A bigger cache might have avoided this.
+        Redecode,
+    };
+
+    CachingReaderCacheSize(SINT minChunks, SINT maxChunks);
+
+    SINT minChunks() const {
+        return m_minChunks;
+    }
+    SINT maxChunks() const {
+        return m_maxChunks;
+    }
+    // The number of chunks that should currently be kept in memory
+    SINT chunks() const {
+        return m_chunks;
+    }
+
+    bool isPinned() const {
+        return m_pinned;
+    }
+
+    // Keep all trackChunks chunks of the current track in memory. Returns
+    // false and keeps adapting if the track does not fit into maxChunks.
+    bool pinToTrack(SINT trackChunks);
+
+    // Reset the size to minChunks and resume adapting, e.g. when a new
+    // track is loaded.
+    void reset();
+
+    // Record the result of a chunk lookup. Returns true if the size has
+    // changed as a consequence.
+    bool recordLookup(Lookup lookup);
+
+  private:
+    void adapt();
+
+    const SINT m_minChunks;
+    const SINT m_maxChunks;
+    SINT m_chunks;
+    bool m_pinned;
+
+    int m_lookups;
+    int m_redecodes;
+    int m_windowsWithoutRedecodes;
+};
@@ -3,6 +3,7 @@
 #include <QtDebug>
 
 #include "sources/audiosourcestereoproxy.h"
+#include "engine/cachingreader/cachingreadersharedcache.h"
 #include "engine/engine.h"
 #include "util/math.h"
 #include "util/sample.h"
@@ -30,11 +31,17 @@ const SINT CachingReaderChunk::kFrames = 8192; // ~ 170 ms at 48 kHz
 const SINT CachingReaderChunk::kSamples =
         CachingReaderChunk::frames2samples(CachingReaderChunk::kFrames);
 
-CachingReaderChunk::CachingReaderChunk(
-        mixxx::SampleBuffer::WritableSlice sampleBuffer)
-        : m_index(kInvalidChunkIndex),
-          m_sampleBuffer(std::move(sampleBuffer)) {
-    DEBUG_ASSERT(m_sampleBuffer.length() == kSamples);
+CachingReaderChunk::CachingReaderChunk()
+        : m_index(kInvalidChunkIndex) {
+}
+
+mixxx::SampleBuffer::WritableSlice CachingReaderChunk::writableSampleBuffer() {
+    // Invoked from the worker thread, never from the engine thread.
+    // Shared buffers are read-only and must not be overwritten.
+    if (!m_pSampleBuffer || m_pSampleBuffer.use_count() > 1) {
+        m_pSampleBuffer = std::make_shared<mixxx::SampleBuffer>(kSamples);
+    }
+    return mixxx::SampleBuffer::WritableSlice(*m_pSampleBuffer);
 }
 
 void CachingReaderChunk::init(SINT index) {
@@ -73,12 +80,47 @@ mixxx::IndexRange CachingReaderChunk::bufferSampleFrames(
             audioSourceProxy.readSampleFrames(
                     mixxx::WritableSampleFrames(
                             sourceFrameIndexRange,
-                            mixxx::SampleBuffer::WritableSlice(m_sampleBuffer)));
+                            writableSampleBuffer()));
     DEBUG_ASSERT(m_bufferedSampleFrames.frameIndexRange().empty() ||
             m_bufferedSampleFrames.frameIndexRange().isSubrangeOf(sourceFrameIndexRange));
     return m_bufferedSampleFrames.frameIndexRange();
 }
 
+mixxx::IndexRange CachingReaderChunk::bufferSharedSampleFrames(
+        CachingReaderSharedCache* pSharedCache,
+        const QString& trackKey) {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    DEBUG_ASSERT(pSharedCache);
+    const auto sharedFrameIndexRange =
+            pSharedCache->read(trackKey, m_index, &m_pSampleBuffer);
+    if (sharedFrameIndexRange.empty()) {
+        // Keep the current buffer for decoding
+        m_bufferedSampleFrames = mixxx::ReadableSampleFrames();
+        return m_bufferedSampleFrames.frameIndexRange();
+    }
+    m_bufferedSampleFrames = mixxx::ReadableSampleFrames(
+            sharedFrameIndexRange,
+            mixxx::SampleBuffer::ReadableSlice(
+                    m_pSampleBuffer->data(),
+                    frames2samples(sharedFrameIndexRange.length())));
+    return m_bufferedSampleFrames.frameIndexRange();
+}
+
+void CachingReaderChunk::shareBufferedSampleFrames(
+        CachingReaderSharedCache* pSharedCache,
+        const QString& trackKey) const {
+    DEBUG_ASSERT(m_index != kInvalidChunkIndex);
+    DEBUG_ASSERT(pSharedCache);
+    if (m_bufferedSampleFrames.frameIndexRange().empty()) {
+        return;
+    }
+    pSharedCache->write(
+            trackKey,
+            m_index,
+            m_bufferedSampleFrames.frameIndexRange(),
+            m_pSampleBuffer);
+}
+
 mixxx::IndexRange CachingReaderChunk::readBufferedSampleFrames(
         CSAMPLE* sampleBuffer,
         const mixxx::IndexRange& frameIndexRange) const {
@@ -119,9 +161,8 @@ mixxx::IndexRange CachingReaderChunk::readBufferedSampleFramesReverse(
     return copyableFrameIndexRange;
 }
 
-CachingReaderChunkForOwner::CachingReaderChunkForOwner(
-        mixxx::SampleBuffer::WritableSlice sampleBuffer)
-        : CachingReaderChunk(std::move(sampleBuffer)),
+CachingReaderChunkForOwner::CachingReaderChunkForOwner()
+        : CachingReaderChunk(),
           m_state(FREE),
           m_pPrev(nullptr),
           m_pNext(nullptr) {
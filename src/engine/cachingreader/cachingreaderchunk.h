@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+
 #include "sources/audiosource.h"
 
+class CachingReaderSharedCache;
+
 // A Chunk is a memory-resident section of audio that has been cached.
 // Each chunk holds a fixed number kFrames of frames with samples for
 // kChannels.
@@ -51,11 +55,23 @@ public:
             const mixxx::AudioSourcePointer& pAudioSource) const;
 
     // Read sample frames from the audio source and return the
-    // range of frames that have been read.
+    // range of frames that have been read. The memory of the chunk
+    // is allocated on first use, i.e. only by the worker thread.
     mixxx::IndexRange bufferSampleFrames(
             const mixxx::AudioSourcePointer& pAudioSource,
             mixxx::SampleBuffer::WritableSlice tempOutputBuffer);
 
+    // Reference sample frames that have already been decoded by another
+    // worker for the same track in the shared cache and return the
+    // range of frames that are available.
+    mixxx::IndexRange bufferSharedSampleFrames(
+            CachingReaderSharedCache* pSharedCache,
+            const QString& trackKey);
+    // Offer the buffered sample frames to other workers
+    void shareBufferedSampleFrames(
+            CachingReaderSharedCache* pSharedCache,
+            const QString& trackKey) const;
+
     mixxx::IndexRange readBufferedSampleFrames(
             CSAMPLE* sampleBuffer,
             const mixxx::IndexRange& frameIndexRange) const;
@@ -64,8 +80,7 @@ public:
             const mixxx::IndexRange& frameIndexRange) const;
 
 protected:
-    explicit CachingReaderChunk(
-            mixxx::SampleBuffer::WritableSlice sampleBuffer);
+    CachingReaderChunk();
     virtual ~CachingReaderChunk() = default;
 
     void init(SINT index);
@@ -75,11 +90,17 @@ private:
         return m_index * kFrames;
     }
 
+    // Returns a sample buffer that is not shared with any other chunk
+    mixxx::SampleBuffer::WritableSlice writableSampleBuffer();
+
     SINT m_index;
 
-    // The worker thread will fill the sample buffer and
-    // set the corresponding frame index range.
-    mixxx::SampleBuffer::WritableSlice m_sampleBuffer;
+    // The worker thread will allocate and fill the sample buffer
+    // and set the corresponding frame index range. The buffer might
+    // be shared read-only with other chunks of the same track. It is
+    // only replaced by the worker, so that the engine thread never
+    // releases the last reference when freeing the chunk.
+    std::shared_ptr<mixxx::SampleBuffer> m_pSampleBuffer;
     mixxx::ReadableSampleFrames m_bufferedSampleFrames;
 };
 
@@ -88,8 +109,7 @@ private:
 // the worker thread is in control.
 class CachingReaderChunkForOwner: public CachingReaderChunk {
 public:
-    explicit CachingReaderChunkForOwner(
-            mixxx::SampleBuffer::WritableSlice sampleBuffer);
+    CachingReaderChunkForOwner();
     ~CachingReaderChunkForOwner() override = default;
 
     void init(SINT index);
@@ -0,0 +1,125 @@
+#include "engine/cachingreader/cachingreadersharedcache.h"
+
+#include <utility>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+#include "util/assert.h"
+#include "util/compatibility/qmutex.h"
+
+// static
+CachingReaderSharedCache* CachingReaderSharedCache::global() {
+    static CachingReaderSharedCache s_instance;
+    return &s_instance;
+}
+
+CachingReaderSharedCache::CachingReaderSharedCache(int capacityChunks)
+        : m_capacityChunks(capacityChunks) {
+    DEBUG_ASSERT(m_capacityChunks >= 0);
+}
+
+int CachingReaderSharedCache::size() const {
+    const auto locker = lockMutex(&m_mutex);
+    return static_cast<int>(m_lru.size());
+}
+
+void CachingReaderSharedCache::acquireTrack(
+        const QString& trackKey, const mixxx::IndexRange& frameIndexRange) {
+    VERIFY_OR_DEBUG_ASSERT(!trackKey.isEmpty()) {
+        return;
+    }
+    const auto locker = lockMutex(&m_mutex);
+    Track& track = m_tracks[trackKey];
+    if (track.frameIndexRange != frameIndexRange) {
+        // The file has been modified while it was loaded
+        discardChunks(&track);
+        track.frameIndexRange = frameIndexRange;
+    }
+    ++track.refCount;
+}
+
+void CachingReaderSharedCache::releaseTrack(const QString& trackKey) {
+    const auto locker = lockMutex(&m_mutex);
+    auto trackIt = m_tracks.find(trackKey);
+    VERIFY_OR_DEBUG_ASSERT(trackIt != m_tracks.end()) {
+        return;
+    }
+    DEBUG_ASSERT(trackIt->refCount > 0);
+    if (--trackIt->refCount > 0) {
+        return;
+    }
+    discardChunks(&(*trackIt));
+    m_tracks.erase(trackIt);
+}
+
+mixxx::IndexRange CachingReaderSharedCache::read(
+        const QString& trackKey,
+        SINT chunkIndex,
+        SampleBufferPointer* ppSamples) {
+    DEBUG_ASSERT(ppSamples);
+    const auto locker = lockMutex(&m_mutex);
+    const auto trackIt = m_tracks.find(trackKey);
+    if (trackIt == m_tracks.end()) {
+        return mixxx::IndexRange();
+    }
+    const auto chunkIt = trackIt->chunks.find(chunkIndex);
+    if (chunkIt == trackIt->chunks.end()) {
+        return mixxx::IndexRange();
+    }
+    // Mark as most recently used
+    m_lru.splice(m_lru.end(), m_lru, chunkIt->lruPos);
+    *ppSamples = chunkIt->pSamples;
+    return chunkIt->frameIndexRange;
+}
+
+void CachingReaderSharedCache::write(
+        const QString& trackKey,
+        SINT chunkIndex,
+        const mixxx::IndexRange& frameIndexRange,
+        SampleBufferPointer pSamples) {
+    if (m_capacityChunks <= 0 || frameIndexRange.empty()) {
+        return;
+    }
+    DEBUG_ASSERT(frameIndexRange.length() <= CachingReaderChunk::kFrames);
+    VERIFY_OR_DEBUG_ASSERT(pSamples &&
+            pSamples->size() >=
+                    CachingReaderChunk::frames2samples(frameIndexRange.length())) {
+        return;
+    }
+
+    const auto locker = lockMutex(&m_mutex);
+    const auto trackIt = m_tracks.find(trackKey);
+    VERIFY_OR_DEBUG_ASSERT(trackIt != m_tracks.end()) {
+        return;
+    }
+    if (trackIt->chunks.contains(chunkIndex)) {
+        // Another worker has been faster
+        return;
+    }
+    if (static_cast<int>(m_lru.size()) >= m_capacityChunks) {
+        evictLeastRecentlyUsed();
+    }
+    ChunkEntry entry;
+    entry.frameIndexRange = frameIndexRange;
+    entry.pSamples = std::move(pSamples);
+    entry.lruPos = m_lru.insert(m_lru.end(), ChunkKey{trackKey, chunkIndex});
+    trackIt->chunks.insert(chunkIndex, entry);
+}
+
+void CachingReaderSharedCache::discardChunks(Track* pTrack) {
+    for (const auto& entry : std::as_const(pTrack->chunks)) {
+        m_lru.erase(entry.lruPos);
+    }
+    pTrack->chunks.clear();
+}
+
+void CachingReaderSharedCache::evictLeastRecentlyUsed() {
+    DEBUG_ASSERT(!m_lru.empty());
+    const ChunkKey& key = m_lru.front();
+    const auto trackIt = m_tracks.find(key.trackKey);
+    VERIFY_OR_DEBUG_ASSERT(trackIt != m_tracks.end()) {
+        m_lru.pop_front();
+        return;
+    }
+    trackIt->chunks.remove(key.chunkIndex);
+    m_lru.pop_front();
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <QHash>
+#include <QMutex>
+#include <QString>
+#include <list>
+#include <memory>
+
+#include "util/indexrange.h"
+#include "util/samplebuffer.h"
+#include "util/types.h"
+
+// CachingReaderSharedCache is a process-wide cache of decoded chunks that
+// is shared by the CachingReaderWorkers of all decks, samplers and preview
+// decks. If the same track is loaded into multiple players only the first
+// worker that needs a chunk decodes it, all other workers reference the
+// same sample buffer instead of decoding or copying it again.
+//
+// Sample buffers are reference counted and must not be modified after they
+// have been shared. A buffer may only be reused for decoding other samples
+// when the caller holds the only reference.
+//
+// Tracks are reference counted: Each worker acquires the track when it
+// opens the audio source and releases it when closing the audio source.
+// The decoded chunks of a track are discarded as soon as the last worker
+// has released it. The total number of chunks is bounded, the least
+// recently used chunks are evicted first.
+//
+// The cache is only accessed by the worker threads and never by the engine
+// thread. All functions are thread-safe.
+class CachingReaderSharedCache {
+  public:
+    // 16 MB with the default chunk size
+    static constexpr int kDefaultCapacityChunks = 256;
+
+    // The process-wide instance
+    static CachingReaderSharedCache* global();
+
+    explicit CachingReaderSharedCache(int capacityChunks = kDefaultCapacityChunks);
+
+    int capacityChunks() const {
+        return m_capacityChunks;
+    }
+
+    // The number of chunks that are currently cached for all tracks
+    int size() const;
+
+    // Increments the reference count of the track. The frame index range
+    // of the opened audio source is used to detect if the file has been
+    // modified in the meantime. In this case all chunks that have been
+    // decoded before are discarded.
+    void acquireTrack(const QString& trackKey, const mixxx::IndexRange& frameIndexRange);
+
+    // Decrements the reference count of the track and discards all of
+    // its chunks when it is no longer used.
+    void releaseTrack(const QString& trackKey);
+
+    typedef std::shared_ptr<mixxx::SampleBuffer> SampleBufferPointer;
+
+    // Stores a reference to the decoded samples of a chunk in *ppSamples.
+    // Returns the range of frames that are available or an empty range
+    // and leaves *ppSamples untouched if the chunk is not cached.
+    mixxx::IndexRange read(
+            const QString& trackKey,
+            SINT chunkIndex,
+            SampleBufferPointer* ppSamples);
+
+    // Offers the decoded samples of a chunk to other workers. The buffer
+    // is shared without copying and must not be modified afterwards.
+    // The track must have been acquired before.
+    void write(
+            const QString& trackKey,
+            SINT chunkIndex,
+            const mixxx::IndexRange& frameIndexRange,
+            SampleBufferPointer pSamples);
+
+  private:
+    struct ChunkKey {
+        QString trackKey;
+        SINT chunkIndex;
+    };
+
+    // Chunks are referenced by the hash of their track and by the LRU list.
+    // The list is ordered from the least to the most recently used chunk.
+    typedef std::list<ChunkKey> LruList;
+    struct ChunkEntry {
+        mixxx::IndexRange frameIndexRange;
+        SampleBufferPointer pSamples;
+        LruList::iterator lruPos;
+    };
+    struct Track {
+        int refCount = 0;
+        mixxx::IndexRange frameIndexRange;
+        QHash<SINT, ChunkEntry> chunks;
+    };
+
+    void discardChunks(Track* pTrack);
+    void evictLeastRecentlyUsed();
+
+    const int m_capacityChunks;
+
+    mutable QMutex m_mutex;
+    QHash<QString, Track> m_tracks;
+    LruList m_lru;
+};
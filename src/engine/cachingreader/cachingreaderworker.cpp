@@ -4,6 +4,7 @@
 #include <QtDebug>
 
 #include "control/controlobject.h"
+#include "engine/cachingreader/cachingreadersharedcache.h"
 #include "moc_cachingreaderworker.cpp"
 #include "sources/soundsourceproxy.h"
 #include "track/track.h"
@@ -44,16 +45,28 @@ ReaderStatusUpdate CachingReaderWorker::processReadRequest(
         return result;
     }
 
-    // Try to read the data required for the chunk from the audio source
-    const mixxx::IndexRange bufferedFrameIndexRange = pChunk->bufferSampleFrames(
-            m_pAudioSource,
-            mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
-    DEBUG_ASSERT(!m_pAudioSource ||
-            bufferedFrameIndexRange.isSubrangeOf(m_pAudioSource->frameIndexRange()));
-    // The readable frame range might have changed
-    chunkFrameIndexRange = intersect(chunkFrameIndexRange, m_pAudioSource->frameIndexRange());
-    DEBUG_ASSERT(bufferedFrameIndexRange.empty() ||
-            bufferedFrameIndexRange.isSubrangeOf(chunkFrameIndexRange));
+    // Another deck or sampler with the same track might have decoded
+    // the chunk already
+    CachingReaderSharedCache* const pSharedCache = CachingReaderSharedCache::global();
+    mixxx::IndexRange bufferedFrameIndexRange =
+            pChunk->bufferSharedSampleFrames(pSharedCache, m_sharedTrackKey);
+    if (bufferedFrameIndexRange != chunkFrameIndexRange) {
+        // Try to read the data required for the chunk from the audio source
+        bufferedFrameIndexRange = pChunk->bufferSampleFrames(
+                m_pAudioSource,
+                mixxx::SampleBuffer::WritableSlice(m_tempReadBuffer));
+        DEBUG_ASSERT(!m_pAudioSource ||
+                bufferedFrameIndexRange.isSubrangeOf(m_pAudioSource->frameIndexRange()));
+        // The readable frame range might have changed
+        chunkFrameIndexRange = intersect(chunkFrameIndexRange, m_pAudioSource->frameIndexRange());
+        DEBUG_ASSERT(bufferedFrameIndexRange.empty() ||
+                bufferedFrameIndexRange.isSubrangeOf(chunkFrameIndexRange));
+        // Only share complete chunks
+        if (!bufferedFrameIndexRange.empty() &&
+                bufferedFrameIndexRange == chunkFrameIndexRange) {
+            pChunk->shareBufferedSampleFrames(pSharedCache, m_sharedTrackKey);
+        }
+    }
 
     ReaderStatus status = bufferedFrameIndexRange.empty() ? CHUNK_READ_EOF : CHUNK_READ_SUCCESS;
     if (bufferedFrameIndexRange != chunkFrameIndexRange) {
@@ -111,7 +124,7 @@ void CachingReaderWorker::run() {
             m_pReaderStatusFIFO->writeBlocking(&update, 1);
         } else {
             Event::end(m_tag);
-            m_semaRun.acquire();
+            waitForWork();
             Event::start(m_tag);
         }
     }
@@ -129,6 +142,10 @@ void CachingReaderWorker::closeAudioSource() {
     discardAllPendingRequests();
     // Closes open file handles of the old track.
     m_pAudioSource.reset();
+    if (!m_sharedTrackKey.isEmpty()) {
+        CachingReaderSharedCache::global()->releaseTrack(m_sharedTrackKey);
+        m_sharedTrackKey.clear();
+    }
 
     // This function has to be called with the engine stopped only
     // to avoid collecting new requests for the old track
@@ -195,6 +212,12 @@ void CachingReaderWorker::loadTrack(const TrackPointer& pTrack) {
         return;
     }
 
+    // Share decoded chunks with all other players that have loaded
+    // the same file
+    m_sharedTrackKey = pTrack->getLocation();
+    CachingReaderSharedCache::global()->acquireTrack(
+            m_sharedTrackKey, m_pAudioSource->frameIndexRange());
+
     // Adjust the internal buffer
     const SINT tempReadBufferSize =
             m_pAudioSource->getSignalInfo().frames2samples(
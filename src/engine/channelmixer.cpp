@@ -1,5 +1,6 @@
 #include "engine/channelmixer.h"
 
+#include "engine/engineprofiler.h"
 #include "util/sample.h"
 #include "util/timer.h"
 
@@ -20,6 +21,8 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
     //     B) Applies gain to the temporary buffer
     //     C) Processes effects on the temporary buffer
     //     D) Mixes the temporary buffer into pOutput
+    //    Channels without any active effect chain for outputHandle skip A-C
+    //    and are mixed into pOutput with the gain applied in a single pass.
     // The original channel input buffers are not modified.
     SampleUtil::clear(pOutput, iBufferSize);
     ScopedTimer t("EngineMaster::applyEffectsAndMixChannels");
@@ -34,6 +37,8 @@ void ChannelMixer::applyEffectsAndMixChannels(const EngineMaster::GainCalculator
             newGain = gainCalculator.getGain(pChannelInfo);
         }
         gainCache.m_gain = newGain;
+        EngineProfiler::Scope profilerScope(
+                EngineProfiler::Stage::ChannelEffects, pChannelInfo->m_index);
         pEngineEffectsManager->processPostFaderAndMix(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
@@ -76,6 +81,8 @@ void ChannelMixer::applyEffectsInPlaceAndMixChannels(
             newGain = gainCalculator.getGain(pChannelInfo);
         }
         gainCache.m_gain = newGain;
+        EngineProfiler::Scope profilerScope(
+                EngineProfiler::Stage::ChannelEffects, pChannelInfo->m_index);
         pEngineEffectsManager->processPostFaderInPlace(pChannelInfo->m_handle,
                 outputHandle,
                 pChannelInfo->m_pBuffer,
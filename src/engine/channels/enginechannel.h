@@ -57,6 +57,23 @@ class EngineChannel : public EngineObject {
     }
 
     virtual void process(CSAMPLE* pOut, const int iBufferSize) = 0;
+    // process() split into three steps for EngineMaster's parallel channel
+    // processing. beginProcess() and finishProcess() run on the engine
+    // thread in channel order. processConcurrently() may run on an
+    // EngineThreadPool worker at the same time as other channels and must
+    // only touch state that is owned by this channel. By default all work
+    // is done in beginProcess().
+    virtual void beginProcess(CSAMPLE* pOut, const int iBufferSize) {
+        process(pOut, iBufferSize);
+    }
+    virtual void processConcurrently(CSAMPLE* pOut, const int iBufferSize) {
+        Q_UNUSED(pOut);
+        Q_UNUSED(iBufferSize);
+    }
+    virtual void finishProcess(CSAMPLE* pOut, const int iBufferSize) {
+        Q_UNUSED(pOut);
+        Q_UNUSED(iBufferSize);
+    }
     virtual void collectFeatures(GroupFeatureState* pGroupFeatures) const = 0;
     virtual void postProcess(const int iBuffersize) = 0;
 
@@ -25,7 +25,8 @@ EngineDeck::EngineDeck(
           m_pPassing(new ControlPushButton(ConfigKey(getGroup(), "passthrough"))),
           // Need a +1 here because the CircularBuffer only allows its size-1
           // items to be held at once (it keeps a blank spot open persistently)
-          m_wasActive(false) {
+          m_wasActive(false),
+          m_bufferSource(BufferSource::EngineBuffer) {
     m_pInputConfigured->setReadOnly();
     // Set up passthrough utilities and fields
     m_pPassing->setButtonMode(ControlPushButton::POWERWINDOW);
@@ -49,9 +50,16 @@ EngineDeck::~EngineDeck() {
 }
 
 void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
+    beginProcess(pOut, iBufferSize);
+    processConcurrently(pOut, iBufferSize);
+    finishProcess(pOut, iBufferSize);
+}
+
+void EngineDeck::beginProcess(CSAMPLE* pOut, const int iBufferSize) {
     // Feed the incoming audio through if passthrough is active
     const CSAMPLE* sampleBuffer = m_sampleBuffer; // save pointer on stack
     if (isPassthroughActive() && sampleBuffer) {
+        m_bufferSource = BufferSource::Passthrough;
         SampleUtil::copy(pOut, sampleBuffer, iBufferSize);
         m_bPassthroughWasActive = true;
         m_sampleBuffer = nullptr;
@@ -59,16 +67,39 @@ void EngineDeck::process(CSAMPLE* pOut, const int iBufferSize) {
     } else {
         // If passthrough is no longer enabled, zero out the buffer
         if (m_bPassthroughWasActive) {
+            m_bufferSource = BufferSource::Silence;
             SampleUtil::clear(pOut, iBufferSize);
             m_bPassthroughWasActive = false;
             return;
         }
 
         // Process the raw audio
-        m_pBuffer->process(pOut, iBufferSize);
-        m_pPregain->setSpeedAndScratching(m_pBuffer->getSpeed(), m_pBuffer->getScratching());
+        m_bufferSource = BufferSource::EngineBuffer;
+        m_pBuffer->beginProcess(pOut, iBufferSize);
         m_bPassthroughWasActive = false;
     }
+}
+
+void EngineDeck::processConcurrently(CSAMPLE* pOut, const int iBufferSize) {
+    // Only the scaling of the track, which is the expensive part, runs
+    // concurrently. Pregain, effects and the VU meter update controls
+    // and shared engine state.
+    if (m_bufferSource == BufferSource::EngineBuffer) {
+        m_pBuffer->processConcurrently(pOut, iBufferSize);
+    }
+}
+
+void EngineDeck::finishProcess(CSAMPLE* pOut, const int iBufferSize) {
+    switch (m_bufferSource) {
+    case BufferSource::Silence:
+        return;
+    case BufferSource::Passthrough:
+        break;
+    case BufferSource::EngineBuffer:
+        m_pBuffer->finishProcess(iBufferSize);
+        m_pPregain->setSpeedAndScratching(m_pBuffer->getSpeed(), m_pBuffer->getScratching());
+        break;
+    }
 
     // Apply pregain
     m_pPregain->process(pOut, iBufferSize);
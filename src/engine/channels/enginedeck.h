@@ -32,6 +32,9 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     virtual ~EngineDeck();
 
     virtual void process(CSAMPLE* pOutput, const int iBufferSize);
+    void beginProcess(CSAMPLE* pOutput, const int iBufferSize) override;
+    void processConcurrently(CSAMPLE* pOutput, const int iBufferSize) override;
+    void finishProcess(CSAMPLE* pOutput, const int iBufferSize) override;
     virtual void collectFeatures(GroupFeatureState* pGroupFeatures) const;
     virtual void postProcess(const int iBufferSize);
 
@@ -78,4 +81,14 @@ class EngineDeck : public EngineChannel, public AudioDestination {
     bool m_bPassthroughIsActive;
     bool m_bPassthroughWasActive;
     bool m_wasActive;
+
+    enum class BufferSource {
+        Passthrough,
+        EngineBuffer,
+        // Passthrough has just been disabled and the buffer is cleared
+        Silence,
+    };
+    // The source of the buffer that is being processed, set by
+    // beginProcess()
+    BufferSource m_bufferSource;
 };
@@ -1160,14 +1160,16 @@ void CueControl::hotcueEndPositionChanged(
 }
 
 void CueControl::hintReader(HintVector* pHintList) {
+    // Hotcues and the main cue can be jumped to at any time, so they need
+    // to be available immediately without waiting for the reader.
     Hint cueHint;
+    cueHint.frameCount = Hint::kFrameCountJumpTarget;
+    cueHint.priority = Hint::kPriorityJumpTarget;
     const auto mainCuePosition =
             mixxx::audio::FramePos::fromEngineSamplePosMaybeInvalid(
                     m_pCuePoint->get());
     if (mainCuePosition.isValid()) {
         cueHint.frame = static_cast<SINT>(mainCuePosition.toLowerFrameBoundary().value());
-        cueHint.frameCount = Hint::kFrameCountForward;
-        cueHint.priority = 10;
         pHintList->append(cueHint);
     }
 
@@ -1178,8 +1180,22 @@ void CueControl::hintReader(HintVector* pHintList) {
         const mixxx::audio::FramePos position = pControl->getPosition();
         if (position.isValid()) {
             cueHint.frame = static_cast<SINT>(position.toLowerFrameBoundary().value());
-            cueHint.frameCount = Hint::kFrameCountForward;
-            cueHint.priority = 10;
+            pHintList->append(cueHint);
+        }
+    }
+
+    // The intro and outro cues are used by AutoDJ to start the next track
+    // and to place the transition. They are served after all other hints.
+    cueHint.priority = Hint::kPriorityBackground;
+    for (const auto* pPositionControl : {m_pIntroStartPosition,
+                 m_pIntroEndPosition,
+                 m_pOutroStartPosition,
+                 m_pOutroEndPosition}) {
+        const auto position =
+                mixxx::audio::FramePos::fromEngineSamplePosMaybeInvalid(
+                        pPositionControl->get());
+        if (position.isValid()) {
+            cueHint.frame = static_cast<SINT>(position.toLowerFrameBoundary().value());
             pHintList->append(cueHint);
         }
     }
@@ -478,22 +478,22 @@ void LoopingControl::hintReader(HintVector* pHintList) {
     LoopInfo loopInfo = m_loopInfo.getValue();
     Hint loop_hint;
     // If the loop is enabled, then this is high priority because we will loop
-    // sometime potentially very soon! The current audio itself is priority 1,
-    // but we will issue ourselves at priority 2.
+    // sometime potentially very soon! The current audio itself is priority
+    // kPriorityPlayPosition, but we will issue ourselves at kPriorityLoop.
     if (m_bLoopingEnabled) {
         // If we're looping, hint the loop in and loop out, in case we reverse
         // into it. We could save information from process to tell which
         // direction we're going in, but that this is much simpler, and hints
         // aren't that bad to make anyway.
         if (loopInfo.startPosition.isValid()) {
-            loop_hint.priority = 2;
+            loop_hint.priority = Hint::kPriorityLoop;
             loop_hint.frame = static_cast<SINT>(
                     loopInfo.startPosition.toLowerFrameBoundary().value());
-            loop_hint.frameCount = Hint::kFrameCountForward;
+            loop_hint.frameCount = Hint::kFrameCountJumpTarget;
             pHintList->append(loop_hint);
         }
         if (loopInfo.endPosition.isValid()) {
-            loop_hint.priority = 10;
+            loop_hint.priority = Hint::kPriorityJumpTarget;
             loop_hint.frame = static_cast<SINT>(
                     loopInfo.endPosition.toUpperFrameBoundary().value());
             loop_hint.frameCount = Hint::kFrameCountBackward;
@@ -501,10 +501,11 @@ void LoopingControl::hintReader(HintVector* pHintList) {
         }
     } else {
         if (loopInfo.startPosition.isValid()) {
-            loop_hint.priority = 10;
+            // Reloop jumps to the loop start
+            loop_hint.priority = Hint::kPriorityJumpTarget;
             loop_hint.frame = static_cast<SINT>(
                     loopInfo.startPosition.toLowerFrameBoundary().value());
-            loop_hint.frameCount = Hint::kFrameCountForward;
+            loop_hint.frameCount = Hint::kFrameCountJumpTarget;
             pHintList->append(loop_hint);
         }
     }
@@ -30,11 +30,9 @@ EngineEffect::EngineEffect(EffectManifestPointer pManifest,
 
     m_pProcessor->loadEngineEffectParameters(m_parametersById);
 
-    //TODO: get actual configuration of engine
-    const mixxx::EngineParameters engineParameters(
-            mixxx::audio::SampleRate(96000),
-            MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
-    m_pProcessor->initialize(activeInputChannels, registeredOutputChannels, engineParameters);
+    m_pProcessor->initialize(activeInputChannels,
+            registeredOutputChannels,
+            stateEngineParameters());
     m_effectRampsFromDry = pManifest->effectRampsFromDry();
 }
 
@@ -46,6 +44,14 @@ EngineEffect::~EngineEffect() {
     m_parameters.clear();
 }
 
+// static
+mixxx::EngineParameters EngineEffect::stateEngineParameters() {
+    //TODO: get actual configuration of engine
+    return mixxx::EngineParameters(
+            mixxx::audio::SampleRate(96000),
+            MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
+}
+
 EffectState* EngineEffect::createState(const mixxx::EngineParameters& engineParameters) {
     VERIFY_OR_DEBUG_ASSERT(m_pProcessor) {
         return new EffectState(engineParameters);
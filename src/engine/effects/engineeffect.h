@@ -31,6 +31,11 @@ class EngineEffect final : public EffectsRequestHandler {
     /// Called in main thread by EffectSlot
     ~EngineEffect();
 
+    /// The EngineParameters for allocating EffectStates in the main thread.
+    /// They cover the highest sample rate and the largest buffer size that
+    /// the engine might process.
+    static mixxx::EngineParameters stateEngineParameters();
+
     /// Called in main thread to allocate an EffectState
     EffectState* createState(const mixxx::EngineParameters& engineParameters);
 
@@ -77,13 +77,17 @@ bool EngineEffectChain::removeEffect(EngineEffect* pEffect, int iIndex) {
 bool EngineEffectChain::updateParameters(const EffectsRequest& message) {
     // TODO(rryan): Parameter interpolation.
     m_mixMode = message.SetEffectChainParameters.mix_mode;
-    m_dMix = static_cast<CSAMPLE>(message.SetEffectChainParameters.mix);
 
     if (m_enableState != EffectEnableState::Disabled && !message.SetEffectParameters.enabled) {
         m_enableState = EffectEnableState::Disabling;
     } else if (m_enableState == EffectEnableState::Disabled && message.SetEffectParameters.enabled) {
         m_enableState = EffectEnableState::Enabling;
+        // process() is skipped while the chain is disabled, so the mix knob
+        // of the last callback has not been tracked.
+        resetOldMixKnob();
     }
+
+    m_dMix = static_cast<CSAMPLE>(message.SetEffectChainParameters.mix);
     return true;
 }
 
@@ -163,6 +167,9 @@ bool EngineEffectChain::enableForInputChannel(const ChannelHandle* inputHandle,
             return false;
         }
         outputChannelStatus.enableState = EffectEnableState::Enabling;
+        // process() is skipped while the chain is disabled for the channel,
+        // so the mix knob of the last callback has not been tracked.
+        outputChannelStatus.oldMixKnob = m_dMix;
     }
     for (int i = 0; i < m_effects.size(); ++i) {
         if (m_effects[i] != nullptr) {
@@ -220,6 +227,36 @@ void EngineEffectChain::deleteStatesForInputChannel(const ChannelHandle* inputCh
     }
 }
 
+bool EngineEffectChain::isActiveForChannel(const ChannelHandle& inputHandle,
+        const ChannelHandle& outputHandle) {
+    // The intermediate enabling/disabling states need to be passed to
+    // process() once to settle.
+    if (m_enableState == EffectEnableState::Enabling ||
+            m_enableState == EffectEnableState::Disabling) {
+        return true;
+    }
+    const EffectEnableState channelEnableState =
+            m_chainStatusForChannelMatrix[inputHandle][outputHandle].enableState;
+    switch (channelEnableState) {
+    case EffectEnableState::Enabling:
+    case EffectEnableState::Disabling:
+        return true;
+    case EffectEnableState::Enabled:
+        return m_enableState == EffectEnableState::Enabled;
+    case EffectEnableState::Disabled:
+        break;
+    }
+    return false;
+}
+
+void EngineEffectChain::resetOldMixKnob() {
+    for (auto&& outputMap : m_chainStatusForChannelMatrix) {
+        for (auto&& outputChannelStatus : outputMap) {
+            outputChannelStatus.oldMixKnob = m_dMix;
+        }
+    }
+}
+
 EngineEffectChain::ChannelStatus& EngineEffectChain::getChannelStatus(
         const ChannelHandle& inputHandle,
         const ChannelHandle& outputHandle) {
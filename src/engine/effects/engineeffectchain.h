@@ -44,6 +44,13 @@ class EngineEffectChain final : public EffectsRequestHandler {
             const unsigned int sampleRate,
             const GroupFeatureState& groupFeatures);
 
+    /// called from audio thread
+    /// Returns false if process() would neither modify the signal nor any
+    /// state for this combination of input and output channel, so the
+    /// caller can skip it.
+    bool isActiveForChannel(const ChannelHandle& inputHandle,
+            const ChannelHandle& outputHandle);
+
     /// called from main thread
     void deleteStatesForInputChannel(const ChannelHandle* channel);
 
@@ -67,6 +74,7 @@ class EngineEffectChain final : public EffectsRequestHandler {
     bool enableForInputChannel(const ChannelHandle* inputHandle,
             EffectStatesMapArray* statesForEffectsInChain);
     bool disableForInputChannel(const ChannelHandle* inputHandle);
+    void resetOldMixKnob();
 
     // Gets or creates a ChannelStatus entry in m_channelStatus for the provided
     // handle.
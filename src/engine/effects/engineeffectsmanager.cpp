@@ -1,10 +1,20 @@
 #include "engine/effects/engineeffectsmanager.h"
 
+#include <QVarLengthArray>
+
 #include "engine/effects/engineeffect.h"
 #include "engine/effects/engineeffectchain.h"
 #include "util/defs.h"
 #include "util/sample.h"
 
+namespace {
+
+// The number of chains per signal processing stage that can be processed
+// without allocating memory on the heap
+constexpr int kPreallocatedChains = 32;
+
+} // anonymous namespace
+
 EngineEffectsManager::EngineEffectsManager(EffectsResponsePipe* pResponsePipe)
         : m_pResponsePipe(pResponsePipe),
           m_buffer1(MAX_BUFFER_LEN),
@@ -166,32 +176,43 @@ void EngineEffectsManager::processInner(
         const GroupFeatureState& groupFeatures,
         const CSAMPLE_GAIN oldGain,
         const CSAMPLE_GAIN newGain) {
-    const QList<EngineEffectChain*>& chains = m_chainsByStage.value(stage);
+    // Only pass the signal through the chains that would process it. When
+    // no effects are enabled for this routing, the channel is mixed directly
+    // without a detour through the intermediate buffers.
+    QVarLengthArray<EngineEffectChain*, kPreallocatedChains> activeChains;
+    const auto chainsIt = m_chainsByStage.constFind(stage);
+    if (chainsIt != m_chainsByStage.constEnd()) {
+        for (EngineEffectChain* pChain : chainsIt.value()) {
+            if (pChain && pChain->isActiveForChannel(inputHandle, outputHandle)) {
+                activeChains.append(pChain);
+            }
+        }
+    }
 
     if (pIn == pOut) {
         // Gain and effects are applied to the buffer in place,
         // modifying the original input buffer
         SampleUtil::applyRampingGain(pIn, oldGain, newGain, numSamples);
-        for (EngineEffectChain* pChain : chains) {
-            if (pChain) {
-                if (pChain->process(inputHandle,
-                            outputHandle,
-                            pIn,
-                            pOut,
-                            numSamples,
-                            sampleRate,
-                            groupFeatures)) {
-                }
-            }
+        for (EngineEffectChain* pChain : std::as_const(activeChains)) {
+            pChain->process(inputHandle,
+                    outputHandle,
+                    pIn,
+                    pOut,
+                    numSamples,
+                    sampleRate,
+                    groupFeatures);
         }
+    } else if (activeChains.isEmpty()) {
+        // Do not modify the input buffer and mix it into pOut in a single pass.
+        // ChannelMixer::applyEffectsAndMixChannels uses this to mix channels
+        // into pOut regardless of whether any effects are processed.
+        SampleUtil::addWithRampingGain(pOut, pIn, oldGain, newGain, numSamples);
     } else {
         // Do not modify the input buffer.
         // 1. Copy input buffer to a temporary buffer
         // 2. Apply gain to temporary buffer
         // 2. Process temporary buffer with each effect chain in series
         // 3. Mix the temporary buffer into pOut
-        //    ChannelMixer::applyEffectsAndMixChannels use
-        //    this to mix channels into pOut regardless of whether any effects were processed.
         CSAMPLE* pIntermediateInput = m_buffer1.data();
         if (oldGain == CSAMPLE_GAIN_ONE && newGain == CSAMPLE_GAIN_ONE) {
             // Avoid an unnecessary copy. EngineEffectChain::process does not modify the
@@ -202,25 +223,23 @@ void EngineEffectsManager::processInner(
         }
 
         CSAMPLE* pIntermediateOutput;
-        for (EngineEffectChain* pChain : chains) {
-            if (pChain) {
-                // Select an unused intermediate buffer for the next output
-                if (pIntermediateInput == m_buffer1.data()) {
-                    pIntermediateOutput = m_buffer2.data();
-                } else {
-                    pIntermediateOutput = m_buffer1.data();
-                }
+        for (EngineEffectChain* pChain : std::as_const(activeChains)) {
+            // Select an unused intermediate buffer for the next output
+            if (pIntermediateInput == m_buffer1.data()) {
+                pIntermediateOutput = m_buffer2.data();
+            } else {
+                pIntermediateOutput = m_buffer1.data();
+            }
 
-                if (pChain->process(inputHandle,
-                            outputHandle,
-                            pIntermediateInput,
-                            pIntermediateOutput,
-                            numSamples,
-                            sampleRate,
-                            groupFeatures)) {
-                    // Output of this chain becomes the input of the next chain.
-                    pIntermediateInput = pIntermediateOutput;
-                }
+            if (pChain->process(inputHandle,
+                        outputHandle,
+                        pIntermediateInput,
+                        pIntermediateOutput,
+                        numSamples,
+                        sampleRate,
+                        groupFeatures)) {
+                // Output of this chain becomes the input of the next chain.
+                pIntermediateInput = pIntermediateOutput;
             }
         }
         // pIntermediateInput is the output of the last processed chain. It would
@@ -9,6 +9,7 @@
 #include "control/controlpushbutton.h"
 #include "engine/bufferscalers/enginebufferscalelinear.h"
 #include "engine/bufferscalers/enginebufferscalerubberband.h"
+#include "engine/bufferscalers/enginebufferscalerubberbandlookahead.h"
 #include "engine/bufferscalers/enginebufferscalest.h"
 #include "engine/cachingreader/cachingreader.h"
 #include "engine/channels/enginechannel.h"
@@ -91,6 +92,8 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_pRepeat(nullptr),
           m_startButton(nullptr),
           m_endButton(nullptr),
+          m_pScaleRBLookAhead(nullptr),
+          m_pWorkerScheduler(nullptr),
           m_bScalerOverride(false),
           m_iSeekPhaseQueued(0),
           m_iEnableSyncQueued(SYNC_REQUEST_NONE),
@@ -98,7 +101,8 @@ EngineBuffer::EngineBuffer(const QString& group,
           m_bPlayAfterLoading(false),
           m_pCrossfadeBuffer(SampleUtil::alloc(MAX_BUFFER_LEN)),
           m_bCrossfadeReady(false),
-          m_iLastBufferSize(0) {
+          m_iLastBufferSize(0),
+          m_curBuffer{BufferSource::None, false, false, mixxx::audio::kInvalidFramePos} {
     // This should be a static assertion, but isValid() is not constexpr.
     DEBUG_ASSERT(kInitialPlayPosition.isValid());
 
@@ -268,6 +272,8 @@ EngineBuffer::EngineBuffer(const QString& group,
     m_pScaleRB = new EngineBufferScaleRubberBand(m_pReadAheadManager);
     if (m_pKeylockEngine->get() == SOUNDTOUCH) {
         m_pScaleKeylock = m_pScaleST;
+    } else if (m_pKeylockEngine->get() == RUBBERBAND_LOOKAHEAD) {
+        m_pScaleKeylock = getOrCreateScaleRBLookAhead();
     } else {
         m_pScaleKeylock = m_pScaleRB;
     }
@@ -321,6 +327,7 @@ EngineBuffer::~EngineBuffer() {
     delete m_pScaleLinear;
     delete m_pScaleST;
     delete m_pScaleRB;
+    delete m_pScaleRBLookAhead.loadAcquire();
 
     delete m_pKeylock;
     delete m_pEject;
@@ -332,6 +339,27 @@ EngineBuffer::~EngineBuffer() {
 
 void EngineBuffer::bindWorkers(EngineWorkerScheduler* pWorkerScheduler) {
     m_pReader->setScheduler(pWorkerScheduler);
+    m_pWorkerScheduler = pWorkerScheduler;
+    auto* pScaleRBLookAhead = m_pScaleRBLookAhead.loadAcquire();
+    if (pScaleRBLookAhead) {
+        pScaleRBLookAhead->bindWorkers(pWorkerScheduler);
+    }
+}
+
+EngineBufferScaleRubberBandLookAhead* EngineBuffer::getOrCreateScaleRBLookAhead() {
+    auto* pScaleRBLookAhead = m_pScaleRBLookAhead.loadAcquire();
+    if (pScaleRBLookAhead) {
+        return pScaleRBLookAhead;
+    }
+    // Each instance runs a worker thread and allocates large buffers,
+    // so it is only created for decks that actually use it
+    pScaleRBLookAhead = new EngineBufferScaleRubberBandLookAhead(
+            m_group, m_pReadAheadManager);
+    if (m_pWorkerScheduler) {
+        pScaleRBLookAhead->bindWorkers(m_pWorkerScheduler);
+    }
+    m_pScaleRBLookAhead.storeRelease(pScaleRBLookAhead);
+    return pScaleRBLookAhead;
 }
 
 void EngineBuffer::enableIndependentPitchTempoScaling(bool bEnable,
@@ -800,13 +828,15 @@ void EngineBuffer::slotKeylockEngineChanged(double dIndex) {
     KeylockEngine engine = static_cast<KeylockEngine>(iEngine);
     if (engine == SOUNDTOUCH) {
         m_pScaleKeylock = m_pScaleST;
+    } else if (engine == RUBBERBAND_LOOKAHEAD) {
+        m_pScaleKeylock = getOrCreateScaleRBLookAhead();
     } else {
         m_pScaleKeylock = m_pScaleRB;
     }
 }
 
-void EngineBuffer::processTrackLocked(
-        CSAMPLE* pOutput, const int iBufferSize, mixxx::audio::SampleRate sampleRate) {
+void EngineBuffer::beginProcessTrackLocked(
+        const int iBufferSize, mixxx::audio::SampleRate sampleRate) {
     ScopedTimer t("EngineBuffer::process_pauselock");
 
     m_trackSampleRateOld = mixxx::audio::SampleRate::fromDouble(m_pTrackSampleRate->get());
@@ -1005,8 +1035,8 @@ void EngineBuffer::processTrackLocked(
     }
 
     const mixxx::audio::FramePos trackEndPosition = getTrackEndPosition();
-    bool atEnd = m_playPosition >= trackEndPosition;
-    bool backwards = rate < 0;
+    const bool atEnd = m_playPosition >= trackEndPosition;
+    const bool backwards = rate < 0;
 
     bool bCurBufferPaused = false;
     if (atEnd && !backwards) {
@@ -1021,8 +1051,14 @@ void EngineBuffer::processTrackLocked(
 
     m_rate_old = rate;
 
+    m_curBuffer.paused = bCurBufferPaused;
+    m_curBuffer.scratching = is_scratching;
+    m_curBuffer.trackEndPosition = trackEndPosition;
+}
+
+void EngineBuffer::scaleTrackLocked(CSAMPLE* pOutput, const int iBufferSize) {
     // If the buffer is not paused, then scale the audio.
-    if (!bCurBufferPaused) {
+    if (!m_curBuffer.paused) {
         // Perform scaling of Reader buffer into buffer.
         const auto framesRead = m_pScale->scaleBuffer(pOutput, iBufferSize);
 
@@ -1066,6 +1102,13 @@ void EngineBuffer::processTrackLocked(
             SampleUtil::clear(pOutput, iBufferSize);
         }
     }
+}
+
+void EngineBuffer::finishProcessTrackLocked(const int iBufferSize) {
+    const double rate = m_rate_old;
+    const bool is_scratching = m_curBuffer.scratching;
+    const mixxx::audio::FramePos trackEndPosition = m_curBuffer.trackEndPosition;
+    const bool backwards = rate < 0;
 
     for (const auto& pControl: qAsConst(m_engineControls)) {
         pControl->setFrameInfo(m_playPosition, trackEndPosition, m_trackSampleRateOld);
@@ -1076,7 +1119,7 @@ void EngineBuffer::processTrackLocked(
 
     // Handle repeat mode
     const bool atStart = m_playPosition <= mixxx::audio::kStartFramePos;
-    atEnd = m_playPosition >= trackEndPosition;
+    const bool atEnd = m_playPosition >= trackEndPosition;
 
     bool repeat_enabled = m_pRepeat->toBool();
 
@@ -1100,8 +1143,15 @@ void EngineBuffer::processTrackLocked(
 }
 
 void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
+    beginProcess(pOutput, iBufferSize);
+    processConcurrently(pOutput, iBufferSize);
+    finishProcess(iBufferSize);
+}
+
+void EngineBuffer::beginProcess(CSAMPLE* pOutput, const int iBufferSize) {
     // Bail if we receive a buffer size with incomplete sample frames. Assert in debug builds.
     VERIFY_OR_DEBUG_ASSERT((iBufferSize % kSamplesPerFrame) == 0) {
+        m_curBuffer.source = BufferSource::None;
         return;
     }
     m_pReader->process();
@@ -1109,8 +1159,9 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
     // - Lookup new reader information
     // - Calculate current rate
     // - Scale the audio with m_pScale, copy the resulting samples into the
-    //   output buffer
+    //   output buffer (processConcurrently())
     // - Give EngineControl's a chance to do work / request seeks, etc
+    //   (finishProcess())
     // - Process repeat mode if we're at the end or beginning of a track
     // - Set last sample value (m_fLastSampleValue) so that rampOut works? Other
     //   miscellaneous upkeep issues.
@@ -1123,12 +1174,16 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
     m_pScaleLinear->setSampleRate(m_sampleRate);
     m_pScaleST->setSampleRate(m_sampleRate);
     m_pScaleRB->setSampleRate(m_sampleRate);
+    auto* pScaleRBLookAhead = m_pScaleRBLookAhead.loadAcquire();
+    if (pScaleRBLookAhead) {
+        pScaleRBLookAhead->setSampleRate(m_sampleRate);
+    }
 
     bool bTrackLoading = m_iTrackLoading.loadAcquire() != 0;
     if (!bTrackLoading && m_pause.tryLock()) {
-        processTrackLocked(pOutput, iBufferSize, m_sampleRate);
-        // release the pauselock
-        m_pause.unlock();
+        // The pauselock is released by finishProcess()
+        m_curBuffer.source = BufferSource::Track;
+        beginProcessTrackLocked(iBufferSize, m_sampleRate);
     } else {
         // We are loading a new Track
 
@@ -1146,18 +1201,39 @@ void EngineBuffer::process(CSAMPLE* pOutput, const int iBufferSize) {
         // is handled. For now we apply a rectangular Gain change here which
         // may click.
 
+        m_curBuffer.source = BufferSource::Silence;
         SampleUtil::clear(pOutput, iBufferSize);
 
         m_rate_old = 0;
         m_speed_old = 0;
         m_scratching_old = false;
     }
+}
+
+void EngineBuffer::processConcurrently(CSAMPLE* pOutput, const int iBufferSize) {
+    if (m_curBuffer.source == BufferSource::Track) {
+        scaleTrackLocked(pOutput, iBufferSize);
+    }
 
 #ifdef __SCALER_DEBUG__
     for (int i=0; i<iBufferSize; i+=2) {
         writer << pOutput[i] << "\n";
     }
 #endif
+}
+
+void EngineBuffer::finishProcess(const int iBufferSize) {
+    switch (m_curBuffer.source) {
+    case BufferSource::None:
+        return;
+    case BufferSource::Silence:
+        break;
+    case BufferSource::Track:
+        finishProcessTrackLocked(iBufferSize);
+        // release the pauselock
+        m_pause.unlock();
+        break;
+    }
 
     m_pSyncControl->updateAudible();
 
@@ -1395,7 +1471,7 @@ void EngineBuffer::hintReader(const double dRate) {
     if (m_bSlipEnabledProcessing) {
         Hint hint;
         hint.frame = static_cast<SINT>(m_slipPosition.toLowerFrameBoundary().value());
-        hint.priority = 1;
+        hint.priority = Hint::kPriorityPlayPosition;
         if (m_dSlipRate >= 0) {
             hint.frameCount = Hint::kFrameCountForward;
         } else {
@@ -1429,6 +1505,13 @@ void EngineBuffer::addControl(EngineControl* pControl) {
     pControl->setEngineBuffer(this);
 }
 
+bool EngineBuffer::canProcessConcurrently() const {
+    return !m_pSyncControl->isSynchronized() &&
+            atomicLoadRelaxed(m_iEnableSyncQueued) == SYNC_REQUEST_NONE &&
+            atomicLoadRelaxed(m_iSyncModeQueued) == static_cast<int>(SyncMode::Invalid) &&
+            atomicLoadRelaxed(m_pChannelToCloneFrom) == nullptr;
+}
+
 bool EngineBuffer::isTrackLoaded() const {
     if (m_pCurrentTrack) {
         return true;
@@ -42,6 +42,7 @@ class EngineBufferScale;
 class EngineBufferScaleLinear;
 class EngineBufferScaleST;
 class EngineBufferScaleRubberBand;
+class EngineBufferScaleRubberBandLookAhead;
 class EngineSync;
 class EngineWorkerScheduler;
 class VisualPlayPosition;
@@ -77,6 +78,7 @@ class EngineBuffer : public EngineObject {
     enum KeylockEngine {
         SOUNDTOUCH,
         RUBBERBAND,
+        RUBBERBAND_LOOKAHEAD,
         KEYLOCK_ENGINE_COUNT,
     };
 
@@ -113,6 +115,14 @@ class EngineBuffer : public EngineObject {
 
     // The process methods all run in the audio callback.
     void process(CSAMPLE* pOut, const int iBufferSize);
+    /// process() split into three steps for EngineMaster's parallel channel
+    /// processing. beginProcess() and finishProcess() run on the engine
+    /// thread. processConcurrently() only scales the audio of this deck,
+    /// reading from its own ReadAheadManager and CachingReader, and may run
+    /// on an EngineThreadPool worker at the same time as other decks.
+    void beginProcess(CSAMPLE* pOut, const int iBufferSize);
+    void processConcurrently(CSAMPLE* pOut, const int iBufferSize);
+    void finishProcess(const int iBufferSize);
     void processSlip(int iBufferSize);
     void postProcess(const int iBufferSize);
 
@@ -121,6 +131,12 @@ class EngineBuffer : public EngineObject {
     mixxx::audio::FramePos queuedSeekPosition() const;
 
     bool isTrackLoaded() const;
+
+    /// Returns false if processing the next buffer may touch EngineSync or
+    /// another deck, i.e. if the deck is synchronized or has pending sync or
+    /// clone requests. Such decks must be processed with process() before
+    /// the steps of the other decks are interleaved.
+    bool canProcessConcurrently() const;
     TrackPointer getLoadedTrack() const;
 
     mixxx::audio::FramePos getExactPlayPos() const;
@@ -147,6 +163,8 @@ class EngineBuffer : public EngineObject {
             return tr("Soundtouch (faster)");
         case RUBBERBAND:
             return tr("Rubberband (better)");
+        case RUBBERBAND_LOOKAHEAD:
+            return tr("Rubberband (look-ahead thread)");
         default:
             return tr("Unknown (bad value)");
         }
@@ -203,6 +221,8 @@ class EngineBuffer : public EngineObject {
     void enableIndependentPitchTempoScaling(bool bEnable,
                                             const int iBufferSize);
 
+    EngineBufferScaleRubberBandLookAhead* getOrCreateScaleRBLookAhead();
+
     void updateIndicators(double rate, int iBufferSize);
 
     void hintReader(const double rate);
@@ -235,9 +255,10 @@ class EngineBuffer : public EngineObject {
     bool updateIndicatorsAndModifyPlay(bool newPlay, bool oldPlay);
     void verifyPlay();
     void notifyTrackLoaded(TrackPointer pNewTrack, TrackPointer pOldTrack);
-    void processTrackLocked(CSAMPLE* pOutput,
-            const int iBufferSize,
+    void beginProcessTrackLocked(const int iBufferSize,
             mixxx::audio::SampleRate sampleRate);
+    void scaleTrackLocked(CSAMPLE* pOutput, const int iBufferSize);
+    void finishProcessTrackLocked(const int iBufferSize);
 
     // Holds the name of the control group
     const QString m_group;
@@ -370,9 +391,10 @@ class EngineBuffer : public EngineObject {
     FRIEND_TEST(EngineBufferTest, ReadFadeOut);
     FRIEND_TEST(EngineBufferTest, RateTempTest);
     FRIEND_TEST(EngineBufferTest, RatePermTest);
+    FRIEND_TEST(EngineBufferE2ETest, RubberbandLookAheadClearKeepsPlayPosition);
     EngineBufferScale* m_pScaleVinyl;
     // The keylock engine is configurable, so it could flip flop between
-    // ScaleST and ScaleRB during a single callback.
+    // ScaleST, ScaleRB and ScaleRBLookAhead during a single callback.
     EngineBufferScale* volatile m_pScaleKeylock;
 
     // Object used for vinyl-style interpolation scaling of the audio
@@ -380,6 +402,9 @@ class EngineBuffer : public EngineObject {
     // Objects used for pitch-indep time stretch (key lock) scaling of the audio
     EngineBufferScaleST* m_pScaleST;
     EngineBufferScaleRubberBand* m_pScaleRB;
+    // Created when the look-ahead keylock engine is selected for the first time
+    QAtomicPointer<EngineBufferScaleRubberBandLookAhead> m_pScaleRBLookAhead;
+    EngineWorkerScheduler* m_pWorkerScheduler;
 
     // Indicates whether the scaler has changed since the last process()
     bool m_bScalerChanged;
@@ -415,6 +440,24 @@ class EngineBuffer : public EngineObject {
     bool m_bCrossfadeReady;
     int m_iLastBufferSize;
 
+    enum class BufferSource {
+        // The buffer size was invalid and nothing has been processed
+        None,
+        // A track is loading and the buffer has been cleared
+        Silence,
+        // m_pause is locked and the track is played
+        Track,
+    };
+    // The buffer that is being processed, passed from beginProcess() to
+    // processConcurrently() and finishProcess()
+    struct CurrentBuffer {
+        BufferSource source;
+        bool paused;
+        bool scratching;
+        mixxx::audio::FramePos trackEndPosition;
+    };
+    CurrentBuffer m_curBuffer;
+
     QSharedPointer<VisualPlayPosition> m_visualPlayPos;
 };
 
@@ -14,7 +14,9 @@
 #include "engine/effects/engineeffectsmanager.h"
 #include "engine/enginebuffer.h"
 #include "engine/enginedelay.h"
+#include "engine/engineprofiler.h"
 #include "engine/enginetalkoverducking.h"
+#include "engine/enginethreadpool.h"
 #include "engine/enginevumeter.h"
 #include "engine/engineworkerscheduler.h"
 #include "engine/enginexfader.h"
@@ -66,6 +68,16 @@ EngineMaster::EngineMaster(
     m_pWorkerScheduler = new EngineWorkerScheduler(this);
     m_pWorkerScheduler->start(QThread::HighPriority);
 
+    // Parallel processing of channels is opt-in. The engine thread takes part
+    // in the processing, so n threads means n - 1 additional workers.
+    const int channelProcessingThreads = pConfig->getValue(
+            ConfigKey(group, "channel_processing_threads"), 1);
+    if (channelProcessingThreads > 1) {
+        m_pChannelThreadPool = std::make_unique<EngineThreadPool>(
+                channelProcessingThreads - 1);
+    }
+    m_iChannelTaskBufferSize = 0;
+
     // Master sample rate
     m_pMasterSampleRate = new ControlObject(ConfigKey(group, "samplerate"), true, true);
     m_pMasterSampleRate->set(44100.);
@@ -241,6 +253,7 @@ EngineMaster::~EngineMaster() {
         SampleUtil::free(m_pOutputBusBuffers[o]);
     }
 
+    m_pChannelThreadPool.reset();
     delete m_pWorkerScheduler;
 
     for (int i = 0; i < m_channels.size(); ++i) {
@@ -272,6 +285,7 @@ const CSAMPLE* EngineMaster::getSidechainBuffer() const {
 void EngineMaster::processChannels(int iBufferSize) {
     // Update internal sync lock rate.
     m_pEngineSync->onCallbackStart(m_sampleRate, m_iBufferSize);
+    EngineProfiler::Scope profilerScope(EngineProfiler::Stage::Channels);
 
     m_activeBusChannels[EngineChannel::LEFT].clear();
     m_activeBusChannels[EngineChannel::CENTER].clear();
@@ -280,7 +294,6 @@ void EngineMaster::processChannels(int iBufferSize) {
     m_activeTalkoverChannels.clear();
     m_activeChannels.clear();
 
-    //ScopedTimer timer("EngineMaster::processChannels");
     EngineChannel* pLeaderChannel = m_pEngineSync->getLeaderChannel();
     // Reserve the first place for the master channel which
     // should be processed first
@@ -353,17 +366,13 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 
     // Now that the list is built and ordered, do the processing.
-    for (int i = activeChannelsStartIndex;
-             i < m_activeChannels.size(); ++i) {
-        ChannelInfo* pChannelInfo = m_activeChannels[i];
-        EngineChannel* pChannel = pChannelInfo->m_pChannel;
-        pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
-
-        // Collect metadata for effects
-        if (m_pEngineEffectsManager) {
-            GroupFeatureState features;
-            pChannel->collectFeatures(&features);
-            pChannelInfo->m_features = features;
+    if (m_pChannelThreadPool) {
+        processActiveChannelsInParallel(activeChannelsStartIndex, iBufferSize);
+    } else {
+        for (int i = activeChannelsStartIndex;
+                i < m_activeChannels.size();
+                ++i) {
+            processChannel(m_activeChannels[i], iBufferSize);
         }
     }
 
@@ -384,6 +393,72 @@ void EngineMaster::processChannels(int iBufferSize) {
     }
 }
 
+void EngineMaster::processChannel(ChannelInfo* pChannelInfo, int iBufferSize) {
+    EngineProfiler::Scope profilerScope(
+            EngineProfiler::Stage::Channel, pChannelInfo->m_index);
+    pChannelInfo->m_pChannel->process(pChannelInfo->m_pBuffer, iBufferSize);
+    collectFeatures(pChannelInfo);
+}
+
+void EngineMaster::collectFeatures(ChannelInfo* pChannelInfo) {
+    // Collect metadata for effects
+    if (m_pEngineEffectsManager) {
+        GroupFeatureState features;
+        pChannelInfo->m_pChannel->collectFeatures(&features);
+        pChannelInfo->m_features = features;
+    }
+}
+
+void EngineMaster::processActiveChannelsInParallel(
+        int activeChannelsStartIndex, int iBufferSize) {
+    m_concurrentChannels.clear();
+    for (int i = activeChannelsStartIndex; i < m_activeChannels.size(); ++i) {
+        ChannelInfo* pChannelInfo = m_activeChannels[i];
+        EngineBuffer* pBuffer = pChannelInfo->m_pChannel->getEngineBuffer();
+        if (i == 0 || (pBuffer && !pBuffer->canProcessConcurrently())) {
+            // The sync leader is always processed first, before any of
+            // the followers read its state. Synchronized decks are
+            // processed completely before the steps of the other channels
+            // are interleaved.
+            processChannel(pChannelInfo, iBufferSize);
+        } else {
+            m_concurrentChannels.append(pChannelInfo);
+        }
+    }
+    if (m_concurrentChannels.isEmpty()) {
+        return;
+    }
+
+    // Only processConcurrently() runs on the workers. All channels are
+    // prepared and finished on the engine thread in channel order, because
+    // these steps update controls and shared engine state like effects and
+    // the VU meters.
+    for (ChannelInfo* pChannelInfo : std::as_const(m_concurrentChannels)) {
+        pChannelInfo->m_pChannel->beginProcess(pChannelInfo->m_pBuffer, iBufferSize);
+    }
+    m_iChannelTaskBufferSize = iBufferSize;
+    m_pChannelThreadPool->run(&EngineMaster::processChannelTask,
+            this,
+            m_concurrentChannels.size());
+    for (ChannelInfo* pChannelInfo : std::as_const(m_concurrentChannels)) {
+        EngineChannel* pChannel = pChannelInfo->m_pChannel;
+        pChannel->finishProcess(pChannelInfo->m_pBuffer, iBufferSize);
+        collectFeatures(pChannelInfo);
+    }
+}
+
+// static
+void EngineMaster::processChannelTask(void* pContext, int index) {
+    auto* pEngineMaster = static_cast<EngineMaster*>(pContext);
+    ChannelInfo* pChannelInfo = pEngineMaster->m_concurrentChannels[index];
+    // Only the concurrent part of the channel is recorded here, on the
+    // thread that runs it
+    EngineProfiler::Scope profilerScope(
+            EngineProfiler::Stage::Channel, pChannelInfo->m_index);
+    pChannelInfo->m_pChannel->processConcurrently(
+            pChannelInfo->m_pBuffer, pEngineMaster->m_iChannelTaskBufferSize);
+}
+
 void EngineMaster::process(const int iBufferSize) {
     static bool haveSetName = false;
     if (!haveSetName) {
@@ -391,6 +466,7 @@ void EngineMaster::process(const int iBufferSize) {
         haveSetName = true;
     }
     //Trace t("EngineMaster::process");
+    EngineProfiler::Scope profilerScope(EngineProfiler::Stage::Callback);
 
     bool masterEnabled = m_pMasterEnabled->toBool();
     bool boothEnabled = m_pBoothEnabled->toBool();
@@ -450,6 +526,7 @@ void EngineMaster::process(const int iBufferSize) {
             if (m_activeHeadphoneChannels.size() == 1) {
                 headphoneFeatures = m_activeHeadphoneChannels.at(0)->m_features;
             }
+            EngineProfiler::Scope profilerScope(EngineProfiler::Stage::BusEffects);
             m_pEngineEffectsManager->processPostFaderInPlace(
                     m_headphoneHandle.handle(),
                     m_headphoneHandle.handle(),
@@ -476,6 +553,7 @@ void EngineMaster::process(const int iBufferSize) {
     // We have no metadata for mixed effect buses, so use an empty GroupFeatureState.
     GroupFeatureState busFeatures;
     if (m_pEngineEffectsManager) {
+        EngineProfiler::Scope profilerScope(EngineProfiler::Stage::BusEffects);
         m_pEngineEffectsManager->processPostFaderInPlace(
                 m_busTalkoverHandle.handle(),
                 m_masterHandle.handle(),
@@ -531,6 +609,7 @@ void EngineMaster::process(const int iBufferSize) {
 
     // Process crossfader orientation bus channel effects
     if (m_pEngineEffectsManager) {
+        EngineProfiler::Scope profilerScope(EngineProfiler::Stage::BusEffects);
         m_pEngineEffectsManager->processPostFaderInPlace(
                 m_busCrossfaderLeftHandle.handle(),
                 m_masterHandle.handle(),
@@ -708,6 +787,7 @@ void EngineMaster::process(const int iBufferSize) {
         // EngineSideChain::receiveBuffer has copied the input buffer to m_pSidechainMix
         // via before (called by SoundManager::pushInputBuffers())
         if (m_pEngineSideChain) {
+            EngineProfiler::Scope profilerScope(EngineProfiler::Stage::Sidechain);
             m_pEngineSideChain->writeSamples(m_pSidechainMix, iFrames);
         }
 
@@ -717,6 +797,7 @@ void EngineMaster::process(const int iBufferSize) {
             GroupFeatureState masterFeatures;
             masterFeatures.has_gain = true;
             masterFeatures.gain = m_pMasterGain->get();
+            EngineProfiler::Scope profilerScope(EngineProfiler::Stage::BusEffects);
             m_pEngineEffectsManager->processPostFaderInPlace(
                     m_masterOutputHandle.handle(),
                     m_masterHandle.handle(),
@@ -768,15 +849,21 @@ void EngineMaster::process(const int iBufferSize) {
 
     // We're close to the end of the callback. Wake up the engine worker
     // scheduler so that it runs the workers.
+    EngineProfiler::Scope wakeWorkersProfilerScope(EngineProfiler::Stage::WakeWorkers);
     m_pWorkerScheduler->runWorkers();
 }
 
+void EngineMaster::waitForIdleWorkers() {
+    m_pWorkerScheduler->runWorkersAndWaitUntilIdle();
+}
+
 void EngineMaster::applyMasterEffects() {
     // Apply master effects
     if (m_pEngineEffectsManager) {
         GroupFeatureState masterFeatures;
         masterFeatures.has_gain = true;
         masterFeatures.gain = m_pMasterGain->get();
+        EngineProfiler::Scope profilerScope(EngineProfiler::Stage::BusEffects);
         m_pEngineEffectsManager->processPostFaderInPlace(m_masterHandle.handle(),
                 m_masterHandle.handle(),
                 m_pMaster,
@@ -787,6 +874,7 @@ void EngineMaster::applyMasterEffects() {
 }
 
 void EngineMaster::processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphones) {
+    EngineProfiler::Scope profilerScope(EngineProfiler::Stage::Headphones);
     // Add master mix to headphones
     SampleUtil::addWithRampingGain(m_pHead, m_pMaster,
                                    m_headphoneMasterGainOld,
@@ -816,6 +904,7 @@ void EngineMaster::addChannel(EngineChannel* pChannel) {
     pChannel->setChannelIndex(pChannelInfo->m_index);
     pChannelInfo->m_pChannel = pChannel;
     const QString& group = pChannel->getGroup();
+    EngineProfiler::setChannelName(pChannelInfo->m_index, group);
     pChannelInfo->m_handle = m_pChannelHandleFactory->getOrCreateHandle(group);
     pChannelInfo->m_pVolumeControl = new ControlAudioTaperPot(
             ConfigKey(group, "volume"), -20, 0, 1);
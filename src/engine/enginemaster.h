@@ -2,6 +2,7 @@
 
 #include <QObject>
 #include <QVarLengthArray>
+#include <memory>
 
 #include "audio/types.h"
 #include "control/controlobject.h"
@@ -30,6 +31,7 @@ class GuiTick;
 class EngineSync;
 class EngineTalkoverDucking;
 class EngineDelay;
+class EngineThreadPool;
 
 // The number of channels to pre-allocate in various structures in the
 // engine. Prevents memory allocation in EngineMaster::addChannel.
@@ -68,6 +70,11 @@ class EngineMaster : public QObject, public AudioSource {
     void onInputDisconnected(const AudioInput& input);
 
     void process(const int iBufferSize);
+    // Runs the engine workers that have been scheduled by process() and
+    // blocks until they are done, e.g. until the chunks that have been
+    // requested by the caching readers are available. Only for rendering
+    // faster than real time.
+    void waitForIdleWorkers();
 
     // Add an EngineChannel to the mixing engine. This is not thread safe --
     // only call it before the engine has started mixing.
@@ -262,6 +269,19 @@ class EngineMaster : public QObject, public AudioSource {
     // respective output.
     void processChannels(int iBufferSize);
 
+    // Processes a single active channel and collects its features for the
+    // effects.
+    void processChannel(ChannelInfo* pChannelInfo, int iBufferSize);
+    void collectFeatures(ChannelInfo* pChannelInfo);
+
+    // Processes the active channels starting at activeChannelsStartIndex.
+    // The sync leader and channels that might touch EngineSync or other decks
+    // are processed first with EngineChannel::process(). Of all other
+    // channels only EngineChannel::processConcurrently() is distributed over
+    // m_pChannelThreadPool.
+    void processActiveChannelsInParallel(int activeChannelsStartIndex, int iBufferSize);
+    static void processChannelTask(void* pContext, int index);
+
     ChannelHandleFactoryPointer m_pChannelHandleFactory;
     void applyMasterEffects();
     void processHeadphones(const CSAMPLE_GAIN masterMixGainInHeadphones);
@@ -284,8 +304,16 @@ class EngineMaster : public QObject, public AudioSource {
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeHeadphoneChannels;
     QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_activeTalkoverChannels;
 
+    // Optional pool for processing independent channels concurrently. Only
+    // created if enabled in the user settings.
+    std::unique_ptr<EngineThreadPool> m_pChannelThreadPool;
+    // Pre-allocated task list for m_pChannelThreadPool. Task i runs
+    // EngineChannel::processConcurrently() of m_concurrentChannels[i].
+    QVarLengthArray<ChannelInfo*, kPreallocatedChannels> m_concurrentChannels;
+
     mixxx::audio::SampleRate m_sampleRate;
     unsigned int m_iBufferSize;
+    int m_iChannelTaskBufferSize;
 
     // Mixing buffers for each output.
     CSAMPLE* m_pOutputBusBuffers[3];
@@ -0,0 +1,352 @@
+#include "engine/engineprofiler.h"
+
+#include <QMutex>
+#include <cmath>
+#include <memory>
+
+#include "rigtorp/SPSCQueue.h"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+#include "util/math.h"
+
+namespace {
+
+using Stage = EngineProfiler::Stage;
+
+const mixxx::Logger kLogger("EngineProfiler");
+
+// One histogram per stage followed by the histograms of the stages that
+// are recorded per channel
+constexpr int kHistogramCount =
+        EngineProfiler::kStageCount + 2 * EngineProfiler::kMaxChannels;
+
+// About 100 ms of events of a busy engine thread
+constexpr size_t kTraceEventQueueSize = 1 << 13;
+
+struct Histogram {
+    std::atomic<quint64> count;
+    std::atomic<quint64> sumNanos;
+    std::atomic<quint64> maxNanos;
+    std::array<std::atomic<quint32>, EngineProfiler::kBucketCount> buckets;
+};
+
+struct ThreadSlot {
+    std::array<Histogram, kHistogramCount> histograms;
+    std::unique_ptr<rigtorp::SPSCQueue<EngineProfiler::TraceEvent>> pTraceEvents;
+    std::atomic<quint64> droppedTraceEvents;
+    std::atomic<bool> inUse;
+    // Incremented whenever the slot is released
+    std::atomic<quint32> generation;
+};
+
+// Zero-initialized static storage that is never allocated by
+// a real-time thread
+ThreadSlot s_threadSlots[EngineProfiler::kMaxThreads];
+std::atomic<bool> s_tracingEnabled;
+
+QMutex s_channelNamesMutex;
+QVector<QString> s_channelNames;
+
+// Each value has only a single writer, the thread that owns the slot,
+// and doesn't need an atomic read-modify-write operation.
+template<typename T>
+inline void addRelaxed(std::atomic<T>* pValue, T delta) {
+    pValue->store(pValue->load(std::memory_order_relaxed) + delta,
+            std::memory_order_relaxed);
+}
+
+// The slot of the calling thread, set by registerThread(). A trivial
+// type with a constant initializer doesn't need to be initialized lazily
+// and is therefore safe to access from a real-time thread.
+struct ThreadRegistration {
+    int slotIndex;
+    quint32 generation;
+};
+thread_local ThreadRegistration t_threadRegistration = {-1, 0};
+
+// Xruns of threads without a slot, e.g. the callback threads of sound
+// devices that are not the clock reference
+std::atomic<quint64> s_unregisteredXruns;
+
+// Returns the slot of the calling thread or nullptr if it is not
+// registered or its slot has been released by unregisterThread()
+ThreadSlot* registeredThreadSlot() {
+    const ThreadRegistration registration = t_threadRegistration;
+    if (registration.slotIndex < 0) {
+        return nullptr;
+    }
+    ThreadSlot& slot = s_threadSlots[registration.slotIndex];
+    if (!slot.inUse.load(std::memory_order_relaxed) ||
+            slot.generation.load(std::memory_order_relaxed) !=
+                    registration.generation) {
+        return nullptr;
+    }
+    return &slot;
+}
+
+int histogramIndex(Stage stage, int channel) {
+    if (!EngineProfiler::isPerChannel(stage) || channel < 0) {
+        return static_cast<int>(stage);
+    }
+    const int ordinal = stage == Stage::Channel ? 0 : 1;
+    return EngineProfiler::kStageCount +
+            ordinal * EngineProfiler::kMaxChannels +
+            math_min(channel, EngineProfiler::kMaxChannels - 1);
+}
+
+int bucketIndex(qint64 nanos) {
+    int index = 0;
+    while (nanos > 1 && index < EngineProfiler::kBucketCount - 1) {
+        nanos >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+} // anonymous namespace
+
+// static
+int EngineProfiler::registerThread() {
+    if (registeredThreadSlot()) {
+        return t_threadRegistration.slotIndex;
+    }
+    for (int i = 0; i < kMaxThreads; ++i) {
+        bool inUse = false;
+        if (s_threadSlots[i].inUse.compare_exchange_strong(
+                    inUse, true, std::memory_order_acquire)) {
+            t_threadRegistration = {i,
+                    s_threadSlots[i].generation.load(std::memory_order_relaxed)};
+            return i;
+        }
+    }
+    // Threads beyond the limit are not recorded
+    t_threadRegistration = {-1, 0};
+    return -1;
+}
+
+// static
+void EngineProfiler::unregisterThread() {
+    if (registeredThreadSlot()) {
+        unregisterThread(t_threadRegistration.slotIndex);
+    }
+    t_threadRegistration = {-1, 0};
+}
+
+// static
+void EngineProfiler::unregisterThread(int slotIndex) {
+    if (slotIndex < 0 || slotIndex >= kMaxThreads) {
+        return;
+    }
+    ThreadSlot& slot = s_threadSlots[slotIndex];
+    // The recorded histograms and events of the slot are kept for the
+    // next thread
+    slot.generation.fetch_add(1, std::memory_order_relaxed);
+    slot.inUse.store(false, std::memory_order_release);
+}
+
+// static
+void EngineProfiler::record(Stage stage, int channel, qint64 startNanos, qint64 endNanos) {
+    ThreadSlot* const pSlot = registeredThreadSlot();
+    if (!pSlot) {
+        if (stage == Stage::Xrun) {
+            s_unregisteredXruns.fetch_add(1, std::memory_order_relaxed);
+        }
+        return;
+    }
+    ThreadSlot& slot = *pSlot;
+    const int slotIndex = t_threadRegistration.slotIndex;
+    const qint64 durationNanos = math_max(endNanos - startNanos, static_cast<qint64>(0));
+    const auto duration = static_cast<quint64>(durationNanos);
+
+    Histogram& histogram = slot.histograms[histogramIndex(stage, channel)];
+    addRelaxed(&histogram.count, static_cast<quint64>(1));
+    addRelaxed(&histogram.sumNanos, duration);
+    if (duration > histogram.maxNanos.load(std::memory_order_relaxed)) {
+        histogram.maxNanos.store(duration, std::memory_order_relaxed);
+    }
+    addRelaxed(&histogram.buckets[bucketIndex(durationNanos)], static_cast<quint32>(1));
+
+    if (s_tracingEnabled.load(std::memory_order_acquire)) {
+        if (!slot.pTraceEvents->try_emplace(
+                    TraceEvent{stage, channel, slotIndex, startNanos, durationNanos})) {
+            addRelaxed(&slot.droppedTraceEvents, static_cast<quint64>(1));
+        }
+    }
+}
+
+QString EngineProfiler::StageStatistics::name() const {
+    if (channel < 0) {
+        return stageName(stage);
+    }
+    return stageName(stage) + QChar(' ') + channelName(channel);
+}
+
+qint64 EngineProfiler::StageStatistics::percentileNanos(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const auto target = static_cast<quint64>(std::ceil(percentile * count));
+    quint64 cumulative = 0;
+    for (int i = 0; i < kBucketCount; ++i) {
+        cumulative += buckets[i];
+        if (cumulative >= target) {
+            const qint64 upperBound = (static_cast<qint64>(1) << (i + 1)) - 1;
+            return math_min(upperBound, static_cast<qint64>(maxNanos));
+        }
+    }
+    return static_cast<qint64>(maxNanos);
+}
+
+// static
+QVector<EngineProfiler::StageStatistics> EngineProfiler::statistics() {
+    QVector<StageStatistics> result;
+    for (int i = 0; i < kHistogramCount; ++i) {
+        StageStatistics stats;
+        if (i < kStageCount) {
+            stats.stage = static_cast<Stage>(i);
+        } else {
+            const int perChannelIndex = i - kStageCount;
+            stats.stage = perChannelIndex < kMaxChannels ? Stage::Channel : Stage::ChannelEffects;
+            stats.channel = perChannelIndex % kMaxChannels;
+        }
+        for (const auto& slot : s_threadSlots) {
+            const Histogram& histogram = slot.histograms[i];
+            stats.count += histogram.count.load(std::memory_order_relaxed);
+            stats.sumNanos += histogram.sumNanos.load(std::memory_order_relaxed);
+            stats.maxNanos = math_max(stats.maxNanos,
+                    histogram.maxNanos.load(std::memory_order_relaxed));
+            for (int bucket = 0; bucket < kBucketCount; ++bucket) {
+                stats.buckets[bucket] +=
+                        histogram.buckets[bucket].load(std::memory_order_relaxed);
+            }
+        }
+        if (i == static_cast<int>(Stage::Xrun)) {
+            // Xruns have no duration and fall into the first bucket
+            const quint64 xruns = s_unregisteredXruns.load(std::memory_order_relaxed);
+            stats.count += xruns;
+            stats.buckets[0] += xruns;
+        }
+        if (stats.count > 0) {
+            result.append(stats);
+        }
+    }
+    return result;
+}
+
+// static
+void EngineProfiler::logStatistics() {
+    const auto allStatistics = statistics();
+    for (const auto& stats : allStatistics) {
+        kLogger.info() << stats.name()
+                       << "count" << stats.count
+                       << "avg" << stats.averageNanos() << "ns"
+                       << "p99" << stats.percentileNanos(0.99) << "ns"
+                       << "max" << stats.maxNanos << "ns";
+    }
+}
+
+// static
+void EngineProfiler::reset() {
+    for (auto& slot : s_threadSlots) {
+        for (auto& histogram : slot.histograms) {
+            histogram.count.store(0, std::memory_order_relaxed);
+            histogram.sumNanos.store(0, std::memory_order_relaxed);
+            histogram.maxNanos.store(0, std::memory_order_relaxed);
+            for (auto& bucket : histogram.buckets) {
+                bucket.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+    s_unregisteredXruns.store(0, std::memory_order_relaxed);
+}
+
+// static
+QString EngineProfiler::stageName(Stage stage) {
+    switch (stage) {
+    case Stage::Callback:
+        return QStringLiteral("Callback");
+    case Stage::Channels:
+        return QStringLiteral("Channels");
+    case Stage::Channel:
+        return QStringLiteral("Channel");
+    case Stage::ChannelEffects:
+        return QStringLiteral("ChannelEffects");
+    case Stage::BusEffects:
+        return QStringLiteral("BusEffects");
+    case Stage::Headphones:
+        return QStringLiteral("Headphones");
+    case Stage::Sidechain:
+        return QStringLiteral("Sidechain");
+    case Stage::WakeWorkers:
+        return QStringLiteral("WakeWorkers");
+    case Stage::Xrun:
+        return QStringLiteral("Xrun");
+    }
+    DEBUG_ASSERT(!"unreachable");
+    return QString();
+}
+
+// static
+void EngineProfiler::setChannelName(int channel, const QString& group) {
+    VERIFY_OR_DEBUG_ASSERT(channel >= 0) {
+        return;
+    }
+    const auto locker = lockMutex(&s_channelNamesMutex);
+    if (s_channelNames.size() <= channel) {
+        s_channelNames.resize(channel + 1);
+    }
+    s_channelNames[channel] = group;
+}
+
+// static
+QString EngineProfiler::channelName(int channel) {
+    const auto locker = lockMutex(&s_channelNamesMutex);
+    if (channel >= 0 && channel < s_channelNames.size() &&
+            !s_channelNames[channel].isEmpty()) {
+        return s_channelNames[channel];
+    }
+    return QStringLiteral("Channel %1").arg(channel);
+}
+
+// static
+void EngineProfiler::enableTracing() {
+    if (s_tracingEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    for (auto& slot : s_threadSlots) {
+        slot.pTraceEvents = std::make_unique<rigtorp::SPSCQueue<TraceEvent>>(
+                kTraceEventQueueSize);
+    }
+    s_tracingEnabled.store(true, std::memory_order_release);
+}
+
+// static
+bool EngineProfiler::isTracingEnabled() {
+    return s_tracingEnabled.load(std::memory_order_acquire);
+}
+
+// static
+int EngineProfiler::readTraceEvents(QVector<TraceEvent>* pEvents) {
+    if (!isTracingEnabled()) {
+        return 0;
+    }
+    int count = 0;
+    for (const auto& slot : s_threadSlots) {
+        auto* pQueue = slot.pTraceEvents.get();
+        while (const TraceEvent* pEvent = pQueue->front()) {
+            pEvents->append(*pEvent);
+            pQueue->pop();
+            ++count;
+        }
+    }
+    return count;
+}
+
+// static
+quint64 EngineProfiler::droppedTraceEvents() {
+    quint64 count = 0;
+    for (const auto& slot : s_threadSlots) {
+        count += slot.droppedTraceEvents.load(std::memory_order_relaxed);
+    }
+    return count;
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+#include "util/class.h"
+
+/// Measures the duration of the stages of the engine callback.
+///
+/// Recording is lock-free and doesn't allocate, so it is always enabled.
+/// Each recording thread claims one of kMaxThreads slots with
+/// registerThread() when it starts and is the only writer of the histograms
+/// in its slot. Stages recorded by threads without a slot are ignored,
+/// except for xruns which are only counted. The histograms are summed up
+/// by statistics(), which may be called from any thread, and are logged
+/// by logStatistics() when Mixxx shuts down.
+///
+/// If tracing has been enabled before the engine is started, each stage is
+/// also queued as an event for an EngineTraceWriter.
+///
+/// Stages are nested, e.g. the Channel stages are part of the Channels
+/// stage which in turn is part of the Callback stage.
+class EngineProfiler {
+  public:
+    enum class Stage {
+        // The whole EngineMaster::process()
+        Callback,
+        // Processing of all channels including sync
+        Channels,
+        // Processing of a single channel
+        Channel,
+        // Gain and effects of a channel while it is mixed into a bus
+        ChannelEffects,
+        // Effects of the headphone, talkover, crossfader and master buses
+        BusEffects,
+        Headphones,
+        Sidechain,
+        // Waking up the engine worker scheduler at the end of the callback,
+        // not the work done by the workers
+        WakeWorkers,
+        // An underflow of a sound device, recorded without a duration
+        Xrun,
+    };
+    static constexpr int kStageCount = static_cast<int>(Stage::Xrun) + 1;
+
+    /// Channels with a higher index share the histograms of the last one
+    static constexpr int kMaxChannels = 128;
+    static constexpr int kMaxThreads = 16;
+    /// Bucket i counts the durations in [2^i, 2^(i+1)) ns
+    static constexpr int kBucketCount = 32;
+
+    struct StageStatistics {
+        StageStatistics()
+                : stage(Stage::Callback),
+                  channel(-1),
+                  count(0),
+                  sumNanos(0),
+                  maxNanos(0),
+                  buckets{} {
+        }
+
+        /// The name of the stage followed by the group of the channel
+        QString name() const;
+
+        /// Returns the upper bound of the bucket that contains the
+        /// given percentile, e.g. 0.99
+        qint64 percentileNanos(double percentile) const;
+        qint64 averageNanos() const {
+            return count > 0 ? static_cast<qint64>(sumNanos / count) : 0;
+        }
+
+        Stage stage;
+        // -1 for stages that are not recorded per channel
+        int channel;
+        quint64 count;
+        quint64 sumNanos;
+        quint64 maxNanos;
+        std::array<quint64, kBucketCount> buckets;
+    };
+
+    struct TraceEvent {
+        Stage stage;
+        int channel;
+        int thread;
+        qint64 startNanos;
+        qint64 durationNanos;
+    };
+
+    static qint64 now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count();
+    }
+
+    static bool isPerChannel(Stage stage) {
+        return stage == Stage::Channel || stage == Stage::ChannelEffects;
+    }
+
+    /// Claims a slot for the calling thread, which must happen before it
+    /// records any stage. Lock-free and doesn't allocate, but should be
+    /// called once when the thread starts. Registering a thread again has
+    /// no effect. Returns the index of the slot or -1 if all slots are in
+    /// use.
+    static int registerThread();
+    /// Releases the slot of the calling thread
+    static void unregisterThread();
+    /// Releases the slot with the index returned by registerThread() on
+    /// behalf of a thread that can't do it itself, e.g. the callback
+    /// thread of a closed sound device. The thread must have stopped
+    /// recording.
+    static void unregisterThread(int slotIndex);
+
+    static void record(Stage stage, int channel, qint64 startNanos, qint64 endNanos);
+    static void recordXrun() {
+        const qint64 nanos = now();
+        record(Stage::Xrun, -1, nanos, nanos);
+    }
+
+    /// Records the lifetime of the scope
+    class Scope final {
+      public:
+        explicit Scope(Stage stage, int channel = -1)
+                : m_stage(stage),
+                  m_channel(channel),
+                  m_startNanos(now()) {
+        }
+        ~Scope() {
+            record(m_stage, m_channel, m_startNanos, now());
+        }
+
+      private:
+        const Stage m_stage;
+        const int m_channel;
+        const qint64 m_startNanos;
+
+        DISALLOW_COPY_AND_ASSIGN(Scope);
+    };
+
+    /// Returns the statistics of all stages and channels that have been
+    /// recorded at least once, summed up over all threads.
+    static QVector<StageStatistics> statistics();
+    /// Logs the statistics of all stages
+    static void logStatistics();
+    /// Clears all histograms. Not synchronized with recording threads.
+    static void reset();
+
+    static QString stageName(Stage stage);
+    /// Stores the group of the channel with the index for reports
+    static void setChannelName(int channel, const QString& group);
+    static QString channelName(int channel);
+
+    /// Allocates the event queues, which must happen before any thread
+    /// records a stage.
+    static void enableTracing();
+    static bool isTracingEnabled();
+    /// Reads the queued events of all threads. Must only be called by
+    /// a single reader thread.
+    static int readTraceEvents(QVector<TraceEvent>* pEvents);
+    /// The number of events that have been dropped because the queue
+    /// of the recording thread was full.
+    static quint64 droppedTraceEvents();
+};
@@ -0,0 +1,141 @@
+#include "engine/enginethreadpool.h"
+
+#include <QtDebug>
+#include <algorithm>
+
+#ifdef __LINUX__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "engine/engineprofiler.h"
+#include "util/assert.h"
+
+namespace {
+
+// Number of busy-wait iterations while joining before the calling thread
+// starts to yield its time slice. Channel processing typically finishes
+// within a few microseconds of each other, so we rarely get past this.
+constexpr int kJoinSpinCount = 4096;
+
+} // anonymous namespace
+
+class EngineThreadPool::WorkerThread : public QThread {
+  public:
+    WorkerThread(EngineThreadPool* pPool, int participant)
+            : m_pPool(pPool),
+              m_participant(participant),
+              m_doneGeneration(0),
+              m_quit(false) {
+        setObjectName(QStringLiteral("EngineThreadPool %1").arg(participant));
+    }
+
+    ~WorkerThread() override {
+        m_quit.store(true, std::memory_order_relaxed);
+        m_semaRun.release();
+        wait();
+    }
+
+    void wake() {
+        m_semaRun.release();
+    }
+
+    bool isDone(int generation) const {
+        return m_doneGeneration.load(std::memory_order_acquire) == generation;
+    }
+
+  protected:
+    void run() override {
+#ifdef __LINUX__
+        // Leave the first core to the audio callback thread
+        const int numCpus = QThread::idealThreadCount();
+        if (numCpus > 1) {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(m_participant % numCpus, &cpuSet);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet)) {
+                qWarning() << objectName() << "Failed to set CPU affinity";
+            }
+        }
+        struct sched_param spm = {0};
+        spm.sched_priority = 1;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &spm)) {
+            qWarning() << objectName() << "Failed bumping priority";
+        }
+#endif
+        EngineProfiler::registerThread();
+        while (true) {
+            m_semaRun.acquire();
+            if (m_quit.load(std::memory_order_relaxed)) {
+                EngineProfiler::unregisterThread();
+                return;
+            }
+            m_pPool->runAssignedTasks(m_participant);
+            m_doneGeneration.store(m_pPool->m_generation, std::memory_order_release);
+        }
+    }
+
+  private:
+    EngineThreadPool* const m_pPool;
+    const int m_participant;
+    QSemaphore m_semaRun;
+    std::atomic<int> m_doneGeneration;
+    std::atomic<bool> m_quit;
+};
+
+EngineThreadPool::EngineThreadPool(int numWorkers)
+        : m_task(nullptr),
+          m_pContext(nullptr),
+          m_numTasks(0),
+          m_generation(0) {
+    DEBUG_ASSERT(numWorkers >= 0);
+    m_workers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        // Participant 0 is the thread calling run()
+        m_workers.push_back(std::make_unique<WorkerThread>(this, i + 1));
+        m_workers.back()->start(QThread::TimeCriticalPriority);
+    }
+}
+
+EngineThreadPool::~EngineThreadPool() {
+    // The WorkerThread destructors stop and join the threads
+    m_workers.clear();
+}
+
+void EngineThreadPool::run(Task task, void* pContext, int numTasks) {
+    VERIFY_OR_DEBUG_ASSERT(task) {
+        return;
+    }
+    if (numTasks <= 0) {
+        return;
+    }
+    m_task = task;
+    m_pContext = pContext;
+    m_numTasks = numTasks;
+    ++m_generation;
+
+    // Only wake the workers that actually have something to do
+    const int numParticipants = numWorkers() + 1;
+    const int numActiveWorkers = std::min(numTasks, numParticipants) - 1;
+    for (int i = 0; i < numActiveWorkers; ++i) {
+        m_workers[i]->wake();
+    }
+
+    runAssignedTasks(0);
+
+    for (int i = 0; i < numActiveWorkers; ++i) {
+        int spinCount = 0;
+        while (!m_workers[i]->isDone(m_generation)) {
+            if (++spinCount > kJoinSpinCount) {
+                QThread::yieldCurrentThread();
+            }
+        }
+    }
+}
+
+void EngineThreadPool::runAssignedTasks(int participant) {
+    const int numParticipants = numWorkers() + 1;
+    for (int i = participant; i < m_numTasks; i += numParticipants) {
+        m_task(m_pContext, i);
+    }
+}
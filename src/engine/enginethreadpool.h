@@ -0,0 +1,54 @@
+#pragma once
+
+#include <QSemaphore>
+#include <QThread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/// EngineThreadPool distributes independent pieces of work from the audio
+/// callback over a small, fixed set of real-time worker threads and returns
+/// once all of them are done (fork/join).
+///
+/// Work items are assigned round-robin: item i is run by participant
+/// i % (numWorkers() + 1), where participant 0 is the calling thread itself.
+/// The assignment only depends on the number of items, so the same item is
+/// always processed by the same thread for a given workload.
+///
+/// Forking only releases one semaphore per worker. The join is a lock-free
+/// barrier: the calling thread spins on the per-worker generation counters
+/// and never blocks on a mutex that a worker could hold.
+class EngineThreadPool {
+  public:
+    typedef void (*Task)(void* pContext, int index);
+
+    /// Starts numWorkers worker threads. Each worker is pinned to its own
+    /// CPU core (if supported by the platform) and runs with real-time
+    /// priority.
+    explicit EngineThreadPool(int numWorkers);
+    ~EngineThreadPool();
+
+    int numWorkers() const {
+        return static_cast<int>(m_workers.size());
+    }
+
+    /// Runs task(pContext, i) for all i in [0, numTasks) and returns after
+    /// all of them have finished. Task 0 is always run on the calling thread.
+    /// Must not be called concurrently from multiple threads.
+    void run(Task task, void* pContext, int numTasks);
+
+  private:
+    class WorkerThread;
+
+    void runAssignedTasks(int participant);
+
+    std::vector<std::unique_ptr<WorkerThread>> m_workers;
+
+    // The current job. Only written by the thread calling run() while all
+    // workers are idle. Workers read it after acquiring their semaphore,
+    // which provides the required happens-before relationship.
+    Task m_task;
+    void* m_pContext;
+    int m_numTasks;
+    int m_generation;
+};
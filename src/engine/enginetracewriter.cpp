@@ -0,0 +1,144 @@
+#include "engine/enginetracewriter.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include "moc_enginetracewriter.cpp"
+#include "util/compatibility/qmutex.h"
+#include "util/logger.h"
+
+namespace {
+
+mixxx::Logger kLogger("EngineTraceWriter");
+
+constexpr unsigned long kWriteIntervalMillis = 100;
+
+// All events are written as part of this process
+constexpr int kProcessId = 1;
+
+double toTraceMicros(qint64 nanos) {
+    return nanos / 1000.0;
+}
+
+QString traceEventName(const EngineProfiler::TraceEvent& event) {
+    if (event.channel >= 0) {
+        return EngineProfiler::stageName(event.stage) + QChar(' ') +
+                EngineProfiler::channelName(event.channel);
+    }
+    return EngineProfiler::stageName(event.stage);
+}
+
+} // anonymous namespace
+
+EngineTraceWriter::EngineTraceWriter(const QString& filePath)
+        : m_file(filePath),
+          m_startNanos(EngineProfiler::now()),
+          m_writtenEvents(0),
+          m_stop(false) {
+    EngineProfiler::enableTracing();
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        kLogger.warning()
+                << "Could not open engine trace file for writing:"
+                << m_file.fileName();
+        return;
+    }
+    m_file.write("{\"traceEvents\":[\n");
+    setObjectName(QStringLiteral("EngineTraceWriter"));
+    start(QThread::LowPriority);
+}
+
+EngineTraceWriter::~EngineTraceWriter() {
+    {
+        const auto locker = lockMutex(&m_mutex);
+        m_stop.store(true);
+        m_stopCondition.wakeAll();
+    }
+    wait();
+    if (!m_file.isOpen()) {
+        return;
+    }
+    // Flush the events that have been recorded during shutdown
+    writeEvents();
+    writeStatistics();
+    m_file.close();
+    kLogger.info()
+            << "Wrote" << m_writtenEvents << "events to" << m_file.fileName();
+}
+
+void EngineTraceWriter::run() {
+    while (!m_stop.load()) {
+        writeEvents();
+        const auto locker = lockMutex(&m_mutex);
+        if (!m_stop.load()) {
+            m_stopCondition.wait(&m_mutex, kWriteIntervalMillis);
+        }
+    }
+}
+
+void EngineTraceWriter::writeEvents() {
+    m_events.clear();
+    EngineProfiler::readTraceEvents(&m_events);
+    for (const auto& event : std::as_const(m_events)) {
+        QJsonObject object{
+                {QStringLiteral("name"), traceEventName(event)},
+                {QStringLiteral("cat"), EngineProfiler::stageName(event.stage)},
+                {QStringLiteral("pid"), kProcessId},
+                {QStringLiteral("tid"), event.thread},
+                {QStringLiteral("ts"), toTraceMicros(event.startNanos - m_startNanos)},
+        };
+        if (event.stage == EngineProfiler::Stage::Xrun) {
+            object.insert(QStringLiteral("ph"), QStringLiteral("i"));
+            // Draw the instant event across all threads
+            object.insert(QStringLiteral("s"), QStringLiteral("p"));
+        } else {
+            object.insert(QStringLiteral("ph"), QStringLiteral("X"));
+            object.insert(QStringLiteral("dur"), toTraceMicros(event.durationNanos));
+        }
+        writeJson(object);
+    }
+}
+
+void EngineTraceWriter::writeJson(const QJsonObject& object) {
+    if (m_writtenEvents > 0) {
+        m_file.write(",\n");
+    }
+    m_file.write(QJsonDocument(object).toJson(QJsonDocument::Compact));
+    ++m_writtenEvents;
+}
+
+void EngineTraceWriter::writeStatistics() {
+    for (int thread = 0; thread < EngineProfiler::kMaxThreads; ++thread) {
+        writeJson(QJsonObject{
+                {QStringLiteral("name"), QStringLiteral("thread_name")},
+                {QStringLiteral("ph"), QStringLiteral("M")},
+                {QStringLiteral("pid"), kProcessId},
+                {QStringLiteral("tid"), thread},
+                {QStringLiteral("args"),
+                        QJsonObject{{QStringLiteral("name"),
+                                QStringLiteral("Engine thread %1").arg(thread)}}},
+        });
+    }
+
+    QJsonArray stages;
+    const auto statistics = EngineProfiler::statistics();
+    for (const auto& stats : statistics) {
+        // The count of the stages will exceed the precision of a double
+        // only after centuries of uptime
+        stages.append(QJsonObject{
+                {QStringLiteral("name"), stats.name()},
+                {QStringLiteral("count"), static_cast<double>(stats.count)},
+                {QStringLiteral("avgNanos"), stats.averageNanos()},
+                {QStringLiteral("p50Nanos"), stats.percentileNanos(0.5)},
+                {QStringLiteral("p99Nanos"), stats.percentileNanos(0.99)},
+                {QStringLiteral("maxNanos"), static_cast<qint64>(stats.maxNanos)},
+        });
+    }
+    const QJsonObject otherData{
+            {QStringLiteral("stages"), stages},
+            {QStringLiteral("droppedEvents"),
+                    static_cast<double>(EngineProfiler::droppedTraceEvents())},
+    };
+    m_file.write("\n],\n\"otherData\":");
+    m_file.write(QJsonDocument(otherData).toJson(QJsonDocument::Compact));
+    m_file.write("}\n");
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <QFile>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <atomic>
+
+#include "engine/engineprofiler.h"
+#include "util/class.h"
+
+/// Periodically reads the events of the EngineProfiler and writes them to
+/// a file in the Chrome trace event format, which can be opened with
+/// chrome://tracing or https://ui.perfetto.dev.
+///
+/// Tracing is enabled when the writer is constructed, so it must be created
+/// before the engine starts. The histograms of all stages are written to
+/// the file when the writer is destroyed.
+class EngineTraceWriter : public QThread {
+    Q_OBJECT
+  public:
+    explicit EngineTraceWriter(const QString& filePath);
+    ~EngineTraceWriter() override;
+
+  protected:
+    void run() override;
+
+  private:
+    void writeEvents();
+    void writeJson(const QJsonObject& object);
+    void writeStatistics();
+
+    QFile m_file;
+    const qint64 m_startNanos;
+    int m_writtenEvents;
+    QVector<EngineProfiler::TraceEvent> m_events;
+
+    std::atomic<bool> m_stop;
+    QMutex m_mutex;
+    QWaitCondition m_stopCondition;
+
+    DISALLOW_COPY_AND_ASSIGN(EngineTraceWriter);
+};
@@ -2,9 +2,13 @@
 
 #include "engine/engineworkerscheduler.h"
 #include "moc_engineworker.cpp"
+#include "util/math.h"
 
 EngineWorker::EngineWorker()
-    : m_pScheduler(nullptr) {
+        : m_pScheduler(nullptr),
+          m_wakeUps(0),
+          m_waitingAfterWakeUps(0),
+          m_consumedWakeUps(0) {
     m_notReady.test_and_set();
 }
 
@@ -30,6 +34,17 @@ void EngineWorker::workReady() {
 
 void EngineWorker::wakeIfReady() {
     if (!m_notReady.test_and_set()) {
+        m_wakeUps.fetch_add(1, std::memory_order_release);
         m_semaRun.release();
     }
 }
+
+void EngineWorker::waitForWork() {
+    m_waitingAfterWakeUps.store(m_consumedWakeUps, std::memory_order_release);
+    m_semaRun.acquire();
+    // Pending wake ups may have been released more than once before
+    // they are acquired, which just results in another pass of the worker.
+    m_consumedWakeUps = math_min(m_consumedWakeUps + 1,
+            m_wakeUps.load(std::memory_order_acquire));
+    m_waitingAfterWakeUps.store(-1, std::memory_order_release);
+}
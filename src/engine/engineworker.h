@@ -24,10 +24,29 @@ class EngineWorker : public QThread {
     void workReady();
     void wakeIfReady();
 
+    // Returns true if the worker has finished all work that it has been
+    // woken up for by wakeIfReady() and waits in waitForWork().
+    bool isIdle() const {
+        return m_waitingAfterWakeUps.load(std::memory_order_acquire) ==
+                m_wakeUps.load(std::memory_order_acquire);
+    }
+
   protected:
+    // Blocks the worker thread until it is woken up. Subclasses that are
+    // driven by the scheduler should use this instead of acquiring
+    // m_semaRun directly, so that isIdle() is accurate.
+    void waitForWork();
+
     QSemaphore m_semaRun;
 
   private:
     EngineWorkerScheduler* m_pScheduler;
     std::atomic_flag m_notReady;
+
+    // The number of times the worker has been woken up by wakeIfReady()
+    std::atomic<int> m_wakeUps;
+    // The wake ups that the worker had consumed when it started waiting,
+    // -1 while it is working. Only written by the worker thread.
+    std::atomic<int> m_waitingAfterWakeUps;
+    int m_consumedWakeUps;
 };
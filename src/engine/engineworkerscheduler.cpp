@@ -39,6 +39,21 @@ void EngineWorkerScheduler::runWorkers() {
     }
 }
 
+void EngineWorkerScheduler::runWorkersAndWaitUntilIdle() {
+    m_bWakeScheduler = false;
+    // Holding the mutex prevents the scheduler thread from waking workers
+    // concurrently.
+    const auto locker = lockMutex(&m_mutex);
+    for (const auto& pWorker : m_workers) {
+        pWorker->wakeIfReady();
+    }
+    for (const auto& pWorker : m_workers) {
+        while (!pWorker->isIdle()) {
+            QThread::yieldCurrentThread();
+        }
+    }
+}
+
 void EngineWorkerScheduler::run() {
     static const QString tag("EngineWorkerScheduler");
     while (!m_bQuit) {
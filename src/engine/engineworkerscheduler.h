@@ -20,6 +20,11 @@ class EngineWorkerScheduler : public QThread {
 
     void addWorker(EngineWorker* pWorker);
     void runWorkers();
+    // Wakes the ready workers from the calling thread instead of the
+    // scheduler thread and blocks until all workers are idle. Only for
+    // rendering faster than real time, never call this from a real-time
+    // audio callback.
+    void runWorkersAndWaitUntilIdle();
     void workerReady();
 
   protected:
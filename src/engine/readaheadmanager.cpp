@@ -188,6 +188,14 @@ void ReadAheadManager::notifySeek(double seekPosition) {
     // }
 }
 
+void ReadAheadManager::rewindToPlayposition() {
+    if (m_readAheadLog.empty()) {
+        // Everything that has been read has also been consumed
+        return;
+    }
+    notifySeek(m_readAheadLog.front().virtualPlaypositionStart);
+}
+
 void ReadAheadManager::hintReader(double dRate, HintVector* pHintList) {
     bool in_reverse = dRate < 0;
     Hint current_position;
@@ -216,7 +224,7 @@ void ReadAheadManager::hintReader(double dRate, HintVector* pHintList) {
     }
 
     // top priority, we need to read this data immediately
-    current_position.priority = 1;
+    current_position.priority = Hint::kPriorityPlayPosition;
     pHintList->append(current_position);
 }
 
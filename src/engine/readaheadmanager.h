@@ -51,6 +51,11 @@ class ReadAheadManager {
         notifySeek(position.toEngineSamplePos());
     }
 
+    /// Seeks back to the play position, i.e. the start of the samples that
+    /// have been read but not consumed yet according to the read log. Used
+    /// by scalers that discard the input they have read ahead.
+    void rewindToPlayposition();
+
     /// hintReader allows the ReadAheadManager to provide hints to the reader to
     /// indicate that the given portion of a song is about to be read.
     virtual void hintReader(double dRate, HintVector* hintList);
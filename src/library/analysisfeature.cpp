@@ -139,7 +139,8 @@ void AnalysisFeature::analyzeTracks(const QList<TrackId>& trackIds) {
                 << "analyzer threads";
         m_pTrackAnalysisScheduler = m_pLibrary->createTrackAnalysisScheduler(
                 numAnalyzerThreads,
-                getAnalyzerModeFlags(m_pConfig));
+                getAnalyzerModeFlags(m_pConfig),
+                QStringLiteral("[Library]"));
 
         connect(m_pTrackAnalysisScheduler.get(),
                 &TrackAnalysisScheduler::progress,
@@ -28,6 +28,7 @@ BaseTrackCache::BaseTrackCache(TrackCollection* pTrackCollection,
           m_pQueryParser(new SearchQueryParser(pTrackCollection)),
           m_bIndexBuilt(false),
           m_bIsCaching(isCaching),
+          m_trackInfo(m_columnCount),
           m_database(pTrackCollection->database()) {
     m_searchColumns << "artist"
                     << "album"
@@ -91,7 +92,7 @@ void BaseTrackCache::slotTracksRemoved(const QSet<TrackId>& trackIds) {
         qDebug() << this << "slotTracksRemoved" << trackIds.size();
     }
     for (const auto& trackId : qAsConst(trackIds)) {
-        m_trackInfo.remove(trackId);
+        m_trackInfo.removeRow(trackId);
         m_dirtyTracks.remove(trackId);
     }
 }
@@ -128,6 +129,10 @@ void BaseTrackCache::setSearchColumns(const QStringList& columns) {
     m_searchColumns = columns;
 }
 
+void BaseTrackCache::setSearchIndex(const TrackSearchIndex* pSearchIndex) {
+    m_pQueryParser->setSearchIndex(pSearchIndex);
+}
+
 const TrackPointer& BaseTrackCache::getRecentTrack(TrackId trackId) const {
     DEBUG_ASSERT(m_bIsCaching);
     // Only refresh the recently used track if the identifiers
@@ -218,13 +223,15 @@ bool BaseTrackCache::updateTrackInIndex(
 
     TrackId trackId = pTrack->getId();
     if (trackId.isValid()) {
-        // m_trackInfo[id] will insert a QVector<QVariant> into the
-        // m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        // preallocate memory for all columns at once
-        record.resize(numColumns);
+        // Inserts a new row with null values if the track is not
+        // cached yet
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
-            getTrackValueForColumn(pTrack, i, record[i]);
+            // Values of columns that are not available from the track
+            // object remain unchanged
+            QVariant trackValue = m_trackInfo.value(row, i);
+            getTrackValueForColumn(pTrack, i, trackValue);
+            m_trackInfo.setValue(row, i, trackValue);
         }
         if (m_bIsCaching) {
             replaceRecentTrack(std::move(trackId), std::move(pTrack));
@@ -266,19 +273,15 @@ bool BaseTrackCache::updateIndexWithQuery(const QString& queryString) {
     while (query.next()) {
         TrackId trackId(query.value(idColumn));
 
-        //m_trackInfo[id] will insert a QVector<QVariant> into the
-        //m_trackInfo HashTable with the key "id"
-        QVector<QVariant>& record = m_trackInfo[trackId];
-        record.resize(numColumns);
-
+        const int row = m_trackInfo.insertRow(trackId);
         for (int i = 0; i < numColumns; ++i) {
             if (fieldIndex(ColumnCache::COLUMN_TRACKLOCATIONSTABLE_LOCATION) == i) {
                 // Database stores all locations with Qt separators: "/"
                 // Here we want to cache the display string with native separators.
                 QString location = query.value(i).toString();
-                record[i] = QDir::toNativeSeparators(location);
+                m_trackInfo.setValue(row, i, QDir::toNativeSeparators(location));
             } else {
-                record[i] = query.value(i);
+                m_trackInfo.setValue(row, i, query.value(i));
             }
         }
     }
@@ -444,11 +447,10 @@ QVariant BaseTrackCache::data(TrackId trackId, int column) const {
     // TODO(rryan) this code is flawed for columns that contains row-specific
     // metadata. Currently the upper-levels will not delegate row-specific
     // columns to this method, but there should still be a check here I think.
-    if (!result.isValid()) {
-        auto it = m_trackInfo.constFind(trackId);
-        if (it != m_trackInfo.constEnd()) {
-            const QVector<QVariant>& fields = it.value();
-            result = fields.value(column, result);
+    if (!result.isValid() && column >= 0 && column < m_trackInfo.columnCount()) {
+        const int row = m_trackInfo.row(trackId);
+        if (row >= 0) {
+            result = m_trackInfo.value(row, column);
         }
     }
     return result;
@@ -501,8 +503,14 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
         filter.prepend("WHERE ");
     }
 
+    // Sorting the cached values by their precomputed sort keys is much
+    // faster than sorting in SQL with a custom collation function.
+    QVector<TrackInfoTable::SortKey> sortKeys;
+    const bool sortCached = !orderByClause.isEmpty() &&
+            sortKeysOfColumns(sortColumns, columnOffset, &sortKeys);
+
     QString queryString = QString("SELECT %1 FROM %2 %3 %4")
-            .arg(m_idColumn, m_tableName, filter, orderByClause);
+            .arg(m_idColumn, m_tableName, filter, sortCached ? QString() : orderByClause);
 
     if (sDebug) {
         qDebug() << this << "select() executing:" << queryString;
@@ -533,9 +541,26 @@ void BaseTrackCache::filterAndSort(const QSet<TrackId>& trackIds,
     }
 
     while (query.next()) {
-        TrackId trackId(query.value(idColumn));
-        (*trackToIndex)[trackId] = m_trackOrder.size();
-        m_trackOrder.append(trackId);
+        m_trackOrder.append(TrackId(query.value(idColumn)));
+    }
+
+    if (sortCached) {
+        // Load the values of tracks that have been added to the database
+        // by other means. Otherwise they could not be sorted by their values.
+        QSet<TrackId> uncachedTrackIds;
+        for (const auto& trackId : qAsConst(m_trackOrder)) {
+            if (!m_trackInfo.contains(trackId)) {
+                uncachedTrackIds.insert(trackId);
+            }
+        }
+        updateTracksInIndex(uncachedTrackIds);
+        m_trackInfo.sortTrackIds(&m_trackOrder,
+                sortKeys,
+                m_collator,
+                m_columnCache.keyNotation());
+    }
+    for (int i = 0; i < m_trackOrder.size(); ++i) {
+        (*trackToIndex)[m_trackOrder[i]] = i;
     }
 
     // At this point, the original set of tracks have been divided into two
@@ -678,24 +703,50 @@ int BaseTrackCache::findSortInsertionPoint(TrackPointer pTrack,
     return min;
 }
 
+TrackInfoTable::Collation BaseTrackCache::collationOfColumn(int column) const {
+    if (column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
+            column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
+            column == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)) {
+        return TrackInfoTable::Collation::Numeric;
+    } else if (column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
+        return TrackInfoTable::Collation::MusicalKey;
+    } else {
+        return TrackInfoTable::Collation::Lexicographic;
+    }
+}
+
+bool BaseTrackCache::sortKeysOfColumns(const QList<SortColumn>& sortColumns,
+        const int columnOffset,
+        QVector<TrackInfoTable::SortKey>* pSortKeys) const {
+    for (const auto& sortColumn : sortColumns) {
+        const int column = sortColumn.m_column - columnOffset;
+        if (column < 0 || column >= m_trackInfo.columnCount() ||
+                column == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_PREVIEW)) {
+            // Only sortable in SQL
+            return false;
+        }
+        pSortKeys->append(TrackInfoTable::SortKey{
+                column, collationOfColumn(column), sortColumn.m_order});
+    }
+    return true;
+}
+
 int BaseTrackCache::compareColumnValues(int sortColumn,
         Qt::SortOrder sortOrder,
         const QVariant& val1,
         const QVariant& val2) const {
     int result = 0;
 
-    if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_YEAR) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TRACKNUMBER) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_DURATION) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BITRATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_BPM) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_REPLAYGAIN) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_SAMPLERATE) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_CHANNELS) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_TIMESPLAYED) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_RATING) ||
-            sortColumn == fieldIndex(ColumnCache::COLUMN_PLAYLISTTRACKSTABLE_POSITION)
-    ) {
+    const TrackInfoTable::Collation collation = collationOfColumn(sortColumn);
+    if (collation == TrackInfoTable::Collation::Numeric) {
         // Sort as floats.
         double delta = val1.toDouble() - val2.toDouble();
 
@@ -706,7 +757,7 @@ int BaseTrackCache::compareColumnValues(int sortColumn,
         } else {
             result = -1;
         }
-    } else if (sortColumn == fieldIndex(ColumnCache::COLUMN_LIBRARYTABLE_KEY)) {
+    } else if (collation == TrackInfoTable::Collation::MusicalKey) {
         KeyUtils::KeyNotation keyNotation = m_columnCache.keyNotation();
 
         int key1 = KeyUtils::keyToCircleOfFifthsOrder(
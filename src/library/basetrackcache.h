@@ -11,6 +11,7 @@
 #include <memory>
 
 #include "library/columncache.h"
+#include "library/trackinfotable.h"
 #include "track/track_decl.h"
 #include "track/trackid.h"
 #include "util/class.h"
@@ -18,6 +19,7 @@
 
 class SearchQueryParser;
 class TrackCollection;
+class TrackSearchIndex;
 
 class SortColumn {
   public:
@@ -74,6 +76,8 @@ class BaseTrackCache : public QObject {
     virtual void ensureCached(TrackId trackId);
     virtual void ensureCached(const QSet<TrackId>& trackIds);
     virtual void setSearchColumns(const QStringList& columns);
+    // Only applicable if the table is a view of the library table
+    void setSearchIndex(const TrackSearchIndex* pSearchIndex);
 
   signals:
     void tracksChanged(const QSet<TrackId>& trackIds);
@@ -103,6 +107,10 @@ class BaseTrackCache : public QObject {
                                const QList<SortColumn>& sortColumns,
                                const int columnOffset,
                                const QVector<TrackId>& trackIds) const;
+    TrackInfoTable::Collation collationOfColumn(int column) const;
+    bool sortKeysOfColumns(const QList<SortColumn>& sortColumns,
+            const int columnOffset,
+            QVector<TrackInfoTable::SortKey>* pSortKeys) const;
     int compareColumnValues(int sortColumn,
             Qt::SortOrder sortOrder,
             const QVariant& val1,
@@ -147,7 +155,7 @@ class BaseTrackCache : public QObject {
 
     bool m_bIndexBuilt;
     bool m_bIsCaching;
-    QHash<TrackId, QVector<QVariant>> m_trackInfo;
+    TrackInfoTable m_trackInfo;
     QSqlDatabase m_database;
 
     DISALLOW_COPY_AND_ASSIGN(BaseTrackCache);
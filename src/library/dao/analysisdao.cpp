@@ -11,11 +11,17 @@
 
 const QString AnalysisDao::s_analysisTableName = "track_analysis";
 
-// For a track that takes 1.2MB to store the big waveform, the default
-// compression level (-1) takes the size down to about 600KB. The difference
-// between the default and 9 (the max) was only about 1-2KB for a lot of extra
-// CPU time so I think we should stick with the default. rryan 4/3/2012
-constexpr int kCompressionLevel = -1;
+namespace {
+
+int dataChecksum(const QByteArray& data) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    return qChecksum(data);
+#else
+    return qChecksum(data.constData(), data.length());
+#endif
+}
+
+} // anonymous namespace
 
 AnalysisDao::AnalysisDao(UserSettingsPointer pConfig)
         : m_pConfig(pConfig) {
@@ -84,21 +90,20 @@ QList<AnalysisDao::AnalysisInfo> AnalysisDao::loadAnalysesFromQuery(TrackId trac
         int checksum = query->value(dataChecksumColumn).toInt();
         QString dataPath = analysisPath.absoluteFilePath(
             QString::number(info.analysisId));
-        const QByteArray compressedData = loadDataFromFile(dataPath);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-        const int file_checksum = qChecksum(
-                compressedData);
-#else
-        const int file_checksum = qChecksum(
-                compressedData.constData(),
-                compressedData.length());
-#endif
+        const QByteArray fileData = loadDataFromFile(dataPath);
+        const int file_checksum = dataChecksum(fileData);
         if (checksum != file_checksum) {
             qDebug() << "WARNING: Corrupt analysis loaded from" << dataPath
-                     << "length" << compressedData.length();
+                     << "length" << fileData.length();
             continue;
         }
-        info.data = qUncompress(compressedData);
+        if (Waveform::hasBinaryFormat(fileData)) {
+            // Used as is, without inflating or parsing
+            info.data = fileData;
+        } else {
+            info.data = migrateLegacyData(
+                    info.analysisId, dataPath, qUncompress(fileData));
+        }
         bytes += info.data.length();
         analyses.append(info);
     }
@@ -120,15 +125,8 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
     PerformanceTimer time;
     time.start();
 
-    const QByteArray compressedData = qCompress(info->data, kCompressionLevel);
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    const int checksum = qChecksum(
-            compressedData);
-#else
-    const int checksum = qChecksum(
-            compressedData.constData(),
-            compressedData.length());
-#endif
+    // The data is stored uncompressed, so that loading it is a plain read
+    const int checksum = dataChecksum(info->data);
     QSqlQuery query(m_database);
     if (info->analysisId == -1) {
         query.prepare(QString(
@@ -172,19 +170,47 @@ bool AnalysisDao::saveAnalysis(AnalysisDao::AnalysisInfo* info) {
 
     QString dataPath = getAnalysisStoragePath().absoluteFilePath(
         QString::number(info->analysisId));
-    if (!saveDataToFile(dataPath, compressedData)) {
+    if (!saveDataToFile(dataPath, info->data)) {
         qDebug() << "WARNING: Couldn't save analysis data to file" << dataPath;
         return false;
     }
 
     qDebug() << "AnalysisDAO saved analysis" << info->analysisId
-             << QString("%1 (%2 compressed)").arg(QString::number(info->data.length()),
-                                                  QString::number(compressedData.length()))
-             << "bytes for track"
+             << info->data.length() << "bytes for track"
              << info->trackId << "in" << time.elapsed().debugMillisWithUnit();
     return true;
 }
 
+QByteArray AnalysisDao::migrateLegacyData(
+        int analysisId, const QString& dataPath, const QByteArray& legacyData) {
+    // Older versions stored the analyses as compressed protobuf messages,
+    // which need to be inflated and parsed on every load. Convert them to the
+    // binary format on their first load.
+    const Waveform waveform(legacyData);
+    if (!waveform.isValid()) {
+        // Let the caller deal with the data like before
+        return legacyData;
+    }
+    const QByteArray data = waveform.toByteArray();
+
+    QSqlQuery query(m_database);
+    query.prepare(QString(
+        "UPDATE %1 SET data_checksum = :data_checksum "
+        "WHERE id = :analysisId").arg(s_analysisTableName));
+    query.bindValue(":analysisId", analysisId);
+    query.bindValue(":data_checksum", dataChecksum(data));
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query) << "couldn't update migrated analysis";
+        return data;
+    }
+    // If the file can't be written, the checksum does not match on the next
+    // load and the analysis is done again.
+    if (!saveDataToFile(dataPath, data)) {
+        qDebug() << "WARNING: Couldn't save migrated analysis data to file" << dataPath;
+    }
+    return data;
+}
+
 bool AnalysisDao::deleteAnalysis(const int analysisId) {
     if (analysisId == -1) {
         return false;
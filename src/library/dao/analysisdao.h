@@ -63,6 +63,10 @@ class AnalysisDao : public DAO {
     bool saveDataToFile(const QString& fileName, const QByteArray& data) const;
     bool deleteFile(const QString& filename) const;
     QList<AnalysisInfo> loadAnalysesFromQuery(TrackId trackId, QSqlQuery* query);
+    // Converts the data of an analysis that has been stored by an older
+    // version to the current format and stores it again.
+    QByteArray migrateLegacyData(
+            int analysisId, const QString& dataPath, const QByteArray& legacyData);
 
     const UserSettingsPointer m_pConfig;
 };
@@ -144,6 +144,27 @@ void LibraryHashDAO::invalidateAllDirectories() {
     }
 }
 
+void LibraryHashDAO::invalidateDirectory(const QString& dirPath, bool includeSubdirectories) {
+    QSqlQuery query(m_database);
+    if (includeSubdirectories) {
+        query.prepare("UPDATE LibraryHashes "
+                      "SET needs_verification=1 "
+                      "WHERE directory_path=:directory_path "
+                      "OR INSTR(directory_path,:directory_path_prefix)=1");
+        // The trailing '/' excludes siblings with the same prefix
+        query.bindValue(":directory_path_prefix", dirPath + QChar('/'));
+    } else {
+        query.prepare("UPDATE LibraryHashes "
+                      "SET needs_verification=1 "
+                      "WHERE directory_path=:directory_path");
+    }
+    query.bindValue(":directory_path", dirPath);
+    if (!query.exec()) {
+        LOG_FAILED_QUERY(query)
+                << "Couldn't mark directory" << dirPath << "as needing verification.";
+    }
+}
+
 void LibraryHashDAO::markUnverifiedDirectoriesAsDeleted() {
     //qDebug() << "LibraryHashDAO::markUnverifiedDirectoriesAsDeleted"
     //<< QThread::currentThread() << m_database.connectionName();
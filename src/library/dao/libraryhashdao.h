@@ -19,6 +19,7 @@ class LibraryHashDAO : public DAO {
                              int dir_deleted);
     void markAsExisting(const QString& dirPath);
     void invalidateAllDirectories();
+    void invalidateDirectory(const QString& dirPath, bool includeSubdirectories);
     void markUnverifiedDirectoriesAsDeleted();
     void removeDeletedDirectoryHashes();
     void updateDirectoryStatuses(const QStringList& dirPaths,
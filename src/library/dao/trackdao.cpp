@@ -61,6 +61,23 @@ void markTrackLocationsAsDeleted(const QSqlDatabase& database, const QString& di
     }
 }
 
+/// Synchronize the track's metadata with the corresponding source
+/// file when loading a track or after the file has been modified.
+SoundSourceProxy::UpdateTrackFromSourceMode implicitUpdateTrackFromSourceMode(
+        const UserSettingsPointer& pConfig) {
+    if (pConfig &&
+            pConfig->getValueString(
+                           mixxx::library::prefs::kSyncTrackMetadataConfigKey)
+                            .toInt() == 1) {
+        // An implicit re-import and update is performed if the
+        // user has enabled export of file tags in the preferences.
+        // Either they want to keep their file tags synchronized or
+        // not, no exceptions!
+        return SoundSourceProxy::UpdateTrackFromSourceMode::Newer;
+    }
+    return SoundSourceProxy::UpdateTrackFromSourceMode::Once;
+}
+
 QString joinTrackIdList(const QSet<TrackId>& trackIds) {
     QStringList trackIdList;
     trackIdList.reserve(trackIds.size());
@@ -113,6 +130,11 @@ TrackDAO::~TrackDAO() {
     addTracksFinish(true);
 }
 
+void TrackDAO::initialize(const QSqlDatabase& database) {
+    DAO::initialize(database);
+    m_searchIndex.initialize(database);
+}
+
 void TrackDAO::finish() {
     qDebug() << "TrackDAO::finish()";
 
@@ -198,10 +220,6 @@ QList<TrackId> TrackDAO::resolveTrackIds(
     }
 
     if (flags & ResolveTrackIdFlag::AddMissing) {
-        // Prepare to add tracks to the database.
-        // This also begins an SQL transaction.
-        addTracksPrepare();
-
         // Any tracks not already in the database need to be added.
         query.prepare("SELECT location FROM playlist_import "
                 "WHERE NOT EXISTS (SELECT location FROM track_locations "
@@ -210,13 +228,12 @@ QList<TrackId> TrackDAO::resolveTrackIds(
             LOG_FAILED_QUERY(query);
         }
         const int locationColumn = query.record().indexOf("location");
+        QList<mixxx::FileAccess> missingFiles;
         while (query.next()) {
-            QString location = query.value(locationColumn).toString();
-            addTracksAddFile(location, true);
+            const QString location = query.value(locationColumn).toString();
+            missingFiles.append(mixxx::FileAccess(mixxx::FileInfo(location)));
         }
-
-        // Finish adding tracks to the database.
-        addTracksFinish();
+        addTracks(missingFiles, true);
     }
 
     query.prepare(
@@ -276,6 +293,33 @@ QSet<QString> TrackDAO::getAllTrackLocations() const {
     return locations;
 }
 
+QHash<QString, TrackFileStat> TrackDAO::getAllTrackLocationFileStats() const {
+    QHash<QString, TrackFileStat> fileStats;
+    QSqlQuery query(m_database);
+    query.setForwardOnly(true);
+    query.prepare("SELECT track_locations.location, track_locations.filesize, "
+                  "track_locations.fs_last_modified_ms FROM track_locations "
+                  "INNER JOIN library on library.location = track_locations.id");
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query);
+    }
+
+    const int locationColumn = query.record().indexOf("location");
+    const int filesizeColumn = query.record().indexOf("filesize");
+    const int lastModifiedColumn = query.record().indexOf("fs_last_modified_ms");
+    while (query.next()) {
+        const QVariant lastModified = query.value(lastModifiedColumn);
+        fileStats.insert(
+                query.value(locationColumn).toString(),
+                lastModified.isNull()
+                        ? TrackFileStat()
+                        : TrackFileStat(
+                                  query.value(filesizeColumn).toLongLong(),
+                                  lastModified.toLongLong()));
+    }
+    return fileStats;
+}
+
 // Some code (eg. drag and drop) needs to just get a track's location, and it's
 // not worth retrieving a whole Track.
 QString TrackDAO::getTrackLocation(TrackId trackId) const {
@@ -370,9 +414,11 @@ void TrackDAO::addTracksPrepare() {
 
     m_pQueryTrackLocationInsert->prepare("INSERT INTO track_locations "
             "("
-            "location,directory,filename,filesize,fs_deleted,needs_verification"
+            "location,directory,filename,filesize,fs_last_modified_ms,"
+            "fs_deleted,needs_verification"
             ") VALUES ("
-            ":location,:directory,:filename,:filesize,:fs_deleted,:needs_verification"
+            ":location,:directory,:filename,:filesize,:fs_last_modified_ms,"
+            ":fs_deleted,:needs_verification"
             ")");
 
     m_pQueryTrackLocationSelect->prepare("SELECT id FROM track_locations WHERE location=:location");
@@ -484,6 +530,17 @@ void TrackDAO::addTracksPrepare() {
             "WHERE location=:location");
 }
 
+void TrackDAO::addTracksCommit() {
+    VERIFY_OR_DEBUG_ASSERT(m_pTransaction) {
+        return;
+    }
+    m_pTransaction->commit();
+    m_pTransaction = std::make_unique<SqlTransaction>(m_database);
+
+    emit tracksAdded(m_tracksAddedSet);
+    m_tracksAddedSet.clear();
+}
+
 void TrackDAO::addTracksFinish(bool rollback) {
     if (m_pTransaction) {
         if (rollback) {
@@ -513,6 +570,8 @@ bool insertTrackLocation(
     pTrackLocationInsert->bindValue(":directory", fileInfo.locationPath());
     pTrackLocationInsert->bindValue(":filename", fileInfo.fileName());
     pTrackLocationInsert->bindValue(":filesize", fileInfo.sizeInBytes());
+    pTrackLocationInsert->bindValue(":fs_last_modified_ms",
+            fileInfo.lastModified().toMSecsSinceEpoch());
     pTrackLocationInsert->bindValue(":fs_deleted", 0);
     pTrackLocationInsert->bindValue(":needs_verification", 0);
     if (pTrackLocationInsert->exec()) {
@@ -811,9 +870,35 @@ TrackId TrackDAO::addTracksAddTrack(const TrackPointer& pTrack, bool unremove) {
     return trackId;
 }
 
+QList<TrackPointer> TrackDAO::addTracks(
+        const QList<mixxx::FileAccess>& fileAccesses,
+        QList<SoundSourceProxy::NewTrackImport> newTrackImports,
+        bool unremove) {
+    VERIFY_OR_DEBUG_ASSERT(newTrackImports.isEmpty() ||
+            newTrackImports.size() == fileAccesses.size()) {
+        newTrackImports.clear();
+    }
+    addTracksPrepare();
+    QList<TrackPointer> tracks;
+    tracks.reserve(fileAccesses.size());
+    for (int i = 0; i < fileAccesses.size(); ++i) {
+        auto pTrack = addTracksAddFile(fileAccesses[i],
+                unremove,
+                newTrackImports.isEmpty()
+                        ? SoundSourceProxy::NewTrackImport()
+                        : std::move(newTrackImports[i]));
+        if (pTrack) {
+            tracks.append(std::move(pTrack));
+        }
+    }
+    addTracksFinish();
+    return tracks;
+}
+
 TrackPointer TrackDAO::addTracksAddFile(
         const mixxx::FileAccess& fileAccess,
-        bool unremove) {
+        bool unremove,
+        SoundSourceProxy::NewTrackImport newTrackImport) {
     // Check that track is a supported extension.
     // TODO(uklotzde): The following check can be skipped if
     // the track is already in the library. A refactoring is
@@ -860,10 +945,10 @@ TrackPointer TrackDAO::addTracksAddFile(
     // object is known and has been updated in the cache.
 
     // Initially (re-)import the metadata for the newly created track
-    // from the file.
-    SoundSourceProxy(pTrack).updateTrackFromSource(
+    // from the file if it has not been imported in advance.
+    SoundSourceProxy(pTrack).updateNewTrackFromImport(
             m_pConfig,
-            SoundSourceProxy::UpdateTrackFromSourceMode::Once);
+            std::move(newTrackImport));
     if (!pTrack->checkSourceSynchronized()) {
         qWarning() << "TrackDAO::addTracksAddFile:"
                 << "Failed to parse track metadata from file"
@@ -1501,22 +1586,9 @@ TrackPointer TrackDAO::getTrackById(TrackId trackId) const {
         // file. This import might have never been completed successfully
         // before, so just check and try for every track that has been
         // freshly loaded from the database.
-        auto updateTrackFromSourceMode =
-                SoundSourceProxy::UpdateTrackFromSourceMode::Once;
-        if (m_pConfig &&
-                m_pConfig->getValueString(
-                                 mixxx::library::prefs::kSyncTrackMetadataConfigKey)
-                                .toInt() == 1) {
-            // An implicit re-import and update is performed if the
-            // user has enabled export of file tags in the preferences.
-            // Either they want to keep their file tags synchronized or
-            // not, no exceptions!
-            updateTrackFromSourceMode =
-                    SoundSourceProxy::UpdateTrackFromSourceMode::Newer;
-        }
         SoundSourceProxy(pTrack).updateTrackFromSource(
                 m_pConfig,
-                updateTrackFromSourceMode);
+                implicitUpdateTrackFromSourceMode(m_pConfig));
         if (kLogger.debugEnabled() && pTrack->isDirty()) {
             kLogger.debug()
                     << "Updated track metadata from file tags:"
@@ -1601,24 +1673,12 @@ TrackPointer TrackDAO::getTrackByRef(
     return getTrackById(trackId);
 }
 
-// Saves a track's info back to the database
-bool TrackDAO::updateTrack(const Track& track) const {
-    const TrackId trackId = track.getId();
-    DEBUG_ASSERT(trackId.isValid());
-
-    qDebug() << "TrackDAO:"
-             << "Updating track in database"
-             << trackId
-             << track.getFileInfo();
-
-    SqlTransaction transaction(m_database);
-    // PerformanceTimer time;
-    // time.start();
-
-    QSqlQuery query(m_database);
+namespace {
 
+void prepareTrackLibraryUpdate(QSqlQuery* pTrackLibraryUpdate) {
+    DEBUG_ASSERT(pTrackLibraryUpdate);
     // Update everything but "location", since that's what we identify the track by.
-    query.prepare(
+    pTrackLibraryUpdate->prepare(
             "UPDATE library SET "
             "artist=:artist,"
             "title=:title,"
@@ -1665,37 +1725,93 @@ bool TrackDAO::updateTrack(const Track& track) const {
             "coverart_digest=:coverart_digest,"
             "coverart_hash=:coverart_hash "
             "WHERE id=:track_id");
+}
+
+} // anonymous namespace
 
-    query.bindValue(":track_id", trackId.toVariant());
+// Saves a track's info back to the database
+bool TrackDAO::updateTrack(const Track& track) const {
+    SqlTransaction transaction(m_database);
+    // PerformanceTimer time;
+    // time.start();
+
+    QSqlQuery query(m_database);
+    prepareTrackLibraryUpdate(&query);
+    if (!updateTrack(&query, track)) {
+        return false;
+    }
+    transaction.commit();
+
+    //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
+    //time.start();
+    return true;
+}
+
+void TrackDAO::saveTracks(const QList<TrackPointer>& tracks) const {
+    SqlTransaction transaction(m_database);
+
+    // Binding the values of the next track to the same prepared statement
+    // is much cheaper than preparing the statement again for each track.
+    QSqlQuery query(m_database);
+    prepareTrackLibraryUpdate(&query);
+    QList<Track*> updatedTracks;
+    updatedTracks.reserve(tracks.size());
+    for (const auto& pTrack : tracks) {
+        VERIFY_OR_DEBUG_ASSERT(pTrack) {
+            continue;
+        }
+        DEBUG_ASSERT(pTrack->isDirty());
+        if (updateTrack(&query, *pTrack)) {
+            updatedTracks.append(pTrack.get());
+        }
+    }
+    if (!transaction.commit()) {
+        return;
+    }
+
+    // See saveTrack()
+    for (auto* const pTrack : qAsConst(updatedTracks)) {
+        pTrack->markClean();
+        emit mixxx::thisAsNonConst(this)->trackClean(pTrack->getId());
+    }
+}
+
+bool TrackDAO::updateTrack(
+        QSqlQuery* pTrackLibraryUpdate,
+        const Track& track) const {
+    DEBUG_ASSERT(pTrackLibraryUpdate);
+    const TrackId trackId = track.getId();
+    DEBUG_ASSERT(trackId.isValid());
+
+    qDebug() << "TrackDAO:"
+             << "Updating track in database"
+             << trackId
+             << track.getFileInfo();
+
+    pTrackLibraryUpdate->bindValue(":track_id", trackId.toVariant());
 
     const auto trackRecord = track.getRecord();
     bindTrackLibraryValues(
-            &query,
+            pTrackLibraryUpdate,
             trackRecord,
             track.getBeats());
 
-    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
-        LOG_FAILED_QUERY(query);
+    VERIFY_OR_DEBUG_ASSERT(pTrackLibraryUpdate->exec()) {
+        LOG_FAILED_QUERY(*pTrackLibraryUpdate);
         return false;
     }
 
-    if (query.numRowsAffected() == 0) {
+    if (pTrackLibraryUpdate->numRowsAffected() == 0) {
         qWarning() << "updateTrack had no effect: trackId" << trackId << "invalid";
         return false;
     }
 
-    //qDebug() << "Update track took : " << time.elapsed().formatMillisWithUnit() << "Now updating cues";
-    //time.start();
     m_analysisDao.saveTrackAnalyses(
             trackId,
             track.getWaveform(),
             track.getWaveformSummary());
     m_cueDao.saveTrackCues(
             trackId, track.getCuePoints());
-    transaction.commit();
-
-    //qDebug() << "Update track in database took: " << time.elapsed().formatMillisWithUnit();
-    //time.start();
     return true;
 }
 
@@ -1714,6 +1830,62 @@ void TrackDAO::invalidateTrackLocationsInLibrary() const {
     }
 }
 
+void TrackDAO::invalidateTrackLocationsInDirectory(
+        const QDir& dir,
+        bool includeSubdirectories) const {
+    QSqlQuery query(m_database);
+    if (includeSubdirectories) {
+        query.prepare(QStringLiteral(
+                "UPDATE track_locations SET needs_verification=1 "
+                "WHERE INSTR(location,:locationPathPrefix)=1"));
+        query.bindValue(":locationPathPrefix", locationPathPrefixFromRootDir(dir));
+    } else {
+        query.prepare(QStringLiteral(
+                "UPDATE track_locations SET needs_verification=1 "
+                "WHERE directory=:directory"));
+        query.bindValue(":directory", mixxx::FileInfo(dir).location());
+    }
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query)
+                << "Couldn't mark tracks in" << dir << "as needing verification.";
+    }
+}
+
+void TrackDAO::updateTrackLocationFileStat(
+        const QString& location,
+        const TrackFileStat& fileStat) const {
+    QSqlQuery query(m_database);
+    query.prepare("UPDATE track_locations "
+                  "SET filesize=:filesize, fs_last_modified_ms=:fs_last_modified_ms "
+                  "WHERE location=:location");
+    query.bindValue(":filesize", fileStat.sizeInBytes());
+    query.bindValue(":fs_last_modified_ms", fileStat.lastModifiedMillis());
+    query.bindValue(":location", location);
+    VERIFY_OR_DEBUG_ASSERT(query.exec()) {
+        LOG_FAILED_QUERY(query)
+                << "Couldn't update the size and modification time of" << location;
+    }
+}
+
+bool TrackDAO::updateTrackFromModifiedFile(const TrackRef& trackRef) const {
+    const auto updateMode = implicitUpdateTrackFromSourceMode(m_pConfig);
+    if (updateMode == SoundSourceProxy::UpdateTrackFromSourceMode::Once) {
+        // The metadata is only synchronized with modified files if
+        // the user has enabled it in the preferences. Otherwise the
+        // metadata in the library must not be overwritten.
+        return false;
+    }
+    const TrackPointer pTrack = getTrackByRef(trackRef);
+    if (!pTrack) {
+        return false;
+    }
+    SoundSourceProxy(pTrack).updateTrackFromSource(
+            m_pConfig,
+            updateMode);
+    // Modified tracks are saved when evicted from GlobalTrackCache
+    return pTrack->isDirty();
+}
+
 void TrackDAO::markTrackLocationsAsVerified(const QStringList& locations) const {
     //qDebug() << "TrackDAO::markTrackLocationsAsVerified" << QThread::currentThread() << m_database.connectionName();
 
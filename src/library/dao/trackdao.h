@@ -8,8 +8,11 @@
 #include <QString>
 
 #include "library/dao/dao.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/relocatedtrack.h"
+#include "library/trackfilestat.h"
 #include "preferences/usersettings.h"
+#include "sources/soundsourceproxy.h"
 #include "track/globaltrackcache.h"
 #include "util/class.h"
 #include "util/memory.h"
@@ -49,8 +52,14 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
             UserSettingsPointer pConfig);
     ~TrackDAO() override;
 
+    void initialize(const QSqlDatabase& database) override;
+
     void finish();
 
+    const TrackSearchIndex& searchIndex() const {
+        return m_searchIndex;
+    }
+
     QList<TrackId> resolveTrackIds(
             const QList<mixxx::FileInfo>& fileInfos,
             ResolveTrackIdFlags flags = ResolveTrackIdFlag::ResolveOnly);
@@ -65,6 +74,9 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     // Returns a set of all track locations in the library.
     QSet<QString> getAllTrackLocations() const;
+    // Returns the size and modification time of all track files in the
+    // library as stored when the files have been scanned.
+    QHash<QString, TrackFileStat> getAllTrackLocationFileStats() const;
     QString getTrackLocation(TrackId trackId) const;
 
     // Only used by friend class LibraryScanner, but public for testing!
@@ -76,6 +88,26 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     // Only used by friend class TrackCollection, but public for testing!
     void saveTrack(Track* pTrack) const;
 
+    /// Adds the tracks of many files within a single transaction, reusing
+    /// the prepared statements for all of them. The new tracks are
+    /// registered in GlobalTrackCache like those of addTracksAddFile().
+    /// Files that could not be added are omitted from the returned list.
+    QList<TrackPointer> addTracks(
+            const QList<mixxx::FileAccess>& fileAccesses,
+            bool unremove) {
+        return addTracks(fileAccesses, {}, unremove);
+    }
+    /// Variant of addTracks() for files whose metadata has been imported
+    /// in advance by SoundSourceProxy::importNewTrackFromFile(). The
+    /// imports are either empty or correspond to the files one by one.
+    QList<TrackPointer> addTracks(
+            const QList<mixxx::FileAccess>& fileAccesses,
+            QList<SoundSourceProxy::NewTrackImport> newTrackImports,
+            bool unremove);
+    /// Saves many dirty tracks like saveTrack(), but within a single
+    /// transaction that reuses one prepared statement for all of them.
+    void saveTracks(const QList<TrackPointer>& tracks) const;
+
     /// Update the play counter properties according to the corresponding
     /// aggregated properties obtained from the played history.
     bool updatePlayCounterFromPlayedHistory(
@@ -151,19 +183,33 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     TrackId addTracksAddTrack(
             const TrackPointer& pTrack,
             bool unremove);
+    // The metadata of new tracks is parsed from the file unless it
+    // has already been imported in advance.
     TrackPointer addTracksAddFile(
             const mixxx::FileAccess& fileAccess,
-            bool unremove);
+            bool unremove,
+            SoundSourceProxy::NewTrackImport newTrackImport =
+                    SoundSourceProxy::NewTrackImport());
     TrackPointer addTracksAddFile(
             const QString& filePath,
-            bool unremove) {
+            bool unremove,
+            SoundSourceProxy::NewTrackImport newTrackImport =
+                    SoundSourceProxy::NewTrackImport()) {
         return addTracksAddFile(
                 mixxx::FileAccess(mixxx::FileInfo(filePath)),
-                unremove);
+                unremove,
+                std::move(newTrackImport));
     }
+    // Commits all tracks that have been added so far and continues
+    // with a new transaction. A subsequent rollback only affects the
+    // tracks that are added afterwards.
+    void addTracksCommit();
     void addTracksFinish(bool rollback = false);
 
     bool updateTrack(const Track& track) const;
+    bool updateTrack(
+            QSqlQuery* pTrackLibraryUpdate,
+            const Track& track) const;
 
     void hideAllTracks(const QDir& rootDir) const;
 
@@ -186,6 +232,16 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
     void markTrackLocationsAsVerified(const QStringList& locations) const;
     void markTracksInDirectoriesAsVerified(const QStringList& directories) const;
     void invalidateTrackLocationsInLibrary() const;
+    void invalidateTrackLocationsInDirectory(
+            const QDir& dir,
+            bool includeSubdirectories) const;
+    void updateTrackLocationFileStat(
+            const QString& location,
+            const TrackFileStat& fileStat) const;
+    // Updates the metadata of a track after its file has been modified
+    // outside of Mixxx if synchronization of the track metadata with
+    // file tags is enabled. Returns true if the track has been modified.
+    bool updateTrackFromModifiedFile(const TrackRef& trackRef) const;
     void markUnverifiedTracksAsDeleted();
 
     bool verifyRemainingTracks(
@@ -207,6 +263,8 @@ class TrackDAO : public QObject, public virtual DAO, public virtual GlobalTrackC
 
     const UserSettingsPointer m_pConfig;
 
+    TrackSearchIndex m_searchIndex;
+
     std::unique_ptr<QSqlQuery> m_pQueryTrackLocationInsert;
     std::unique_ptr<QSqlQuery> m_pQueryTrackLocationSelect;
     std::unique_ptr<QSqlQuery> m_pQueryLibraryInsert;
@@ -0,0 +1,264 @@
+#include "library/dao/tracksearchindex.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "library/dao/trackschema.h"
+#include "library/queryutil.h"
+#include "util/db/dbconnection.h"
+#include "util/db/sqllikewildcards.h"
+#include "util/db/sqltransaction.h"
+#include "util/logger.h"
+
+namespace {
+
+const mixxx::Logger kLogger("TrackSearchIndex");
+
+const QString kSearchIndexTable = QStringLiteral("track_search");
+const QString kVersionTable = QStringLiteral("track_search_version");
+const QString kLibraryTable = QStringLiteral(LIBRARY_TABLE);
+const QString kTrackLocationsTable = QStringLiteral(TRACKLOCATIONS_TABLE);
+
+// The location is stored in the table track_locations
+const QStringList kIndexedLibraryColumns = {
+        LIBRARYTABLE_ARTIST,
+        LIBRARYTABLE_TITLE,
+        LIBRARYTABLE_ALBUM,
+        LIBRARYTABLE_ALBUMARTIST,
+        LIBRARYTABLE_COMPOSER,
+        LIBRARYTABLE_GENRE,
+        LIBRARYTABLE_GROUPING,
+        LIBRARYTABLE_COMMENT,
+};
+
+// The trigram tokenizer needs at least one trigram
+constexpr int kMinArgumentLength = 3;
+
+QString indexedColumns() {
+    return kIndexedLibraryColumns.join(QChar(',')) +
+            QChar(',') + TRACKLOCATIONSTABLE_LOCATION;
+}
+
+// The folded values of the indexed columns from the given row of the
+// library table, e.g. "NEW" in triggers
+QString foldedValues(const QString& row, const QString& location) {
+    QStringList values;
+    values.reserve(kIndexedLibraryColumns.size() + 1);
+    for (const auto& column : kIndexedLibraryColumns) {
+        values.append(mixxx::DbConnection::latinLow(
+                QStringLiteral("%1.%2").arg(row, column)));
+    }
+    values.append(mixxx::DbConnection::latinLow(location));
+    return values.join(QChar(','));
+}
+
+QString insertRowStatement(const QString& row) {
+    return QStringLiteral(
+            "INSERT INTO %1(rowid,%2) VALUES(%3.%4,%5)")
+            .arg(kSearchIndexTable,
+                    indexedColumns(),
+                    row,
+                    LIBRARYTABLE_ID,
+                    foldedValues(row,
+                            QStringLiteral(
+                                    "(SELECT %1 FROM %2 WHERE %3=%4.%5)")
+                                    .arg(TRACKLOCATIONSTABLE_LOCATION,
+                                            kTrackLocationsTable,
+                                            TRACKLOCATIONSTABLE_ID,
+                                            row,
+                                            LIBRARYTABLE_LOCATION)));
+}
+
+const QString kIncrementIndexVersionStatement =
+        QStringLiteral("UPDATE %1 SET index_version=index_version+1")
+                .arg(kVersionTable);
+
+const QString kIncrementLibraryVersionStatement =
+        QStringLiteral("UPDATE %1 SET library_version=library_version+1")
+                .arg(kVersionTable);
+
+} // anonymous namespace
+
+TrackSearchIndex::TrackSearchIndex()
+        : m_available(false) {
+}
+
+void TrackSearchIndex::initialize(const QSqlDatabase& database) {
+    m_database = database;
+    m_available = createIndex() && installTriggers() && populateIndex();
+    if (!m_available) {
+        kLogger.info()
+                << "Full-text search is not available, falling back to LIKE";
+    }
+}
+
+bool TrackSearchIndex::createIndex() {
+    // The table is created by the schema migration if SQLite supports
+    // it and is only created here if SQLite has been updated since.
+    // The values are folded before they are stored and the tokenizer
+    // must not fold them again.
+    QSqlQuery query(m_database);
+    if (!query.exec(QStringLiteral(
+                "CREATE VIRTUAL TABLE IF NOT EXISTS %1 USING fts5(%2,"
+                "tokenize='trigram case_sensitive 1')")
+                            .arg(kSearchIndexTable, indexedColumns()))) {
+        // Requires SQLite 3.34.0 or newer with FTS5 enabled
+        kLogger.info()
+                << "Failed to create the full-text search index:"
+                << query.lastError();
+        return false;
+    }
+    return true;
+}
+
+bool TrackSearchIndex::populateIndex() {
+    // Detect a new or outdated index, e.g. if the library has been
+    // modified by a connection without the temporary triggers
+    QSqlQuery query(m_database);
+    if (!query.exec(QStringLiteral(
+                "SELECT library_version=index_version FROM %1")
+                            .arg(kVersionTable))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    if (query.next() && query.value(0).toBool()) {
+        return true;
+    }
+
+    kLogger.info() << "Rebuilding the full-text search index";
+    SqlTransaction transaction(m_database);
+    if (!query.exec(QStringLiteral("DELETE FROM %1").arg(kSearchIndexTable))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    if (!query.exec(QStringLiteral(
+                "INSERT INTO %1(rowid,%2) SELECT %3.%4,%5 FROM %3 "
+                "LEFT JOIN %6 ON %3.%7=%6.%8")
+                            .arg(kSearchIndexTable,
+                                    indexedColumns(),
+                                    kLibraryTable,
+                                    LIBRARYTABLE_ID,
+                                    foldedValues(kLibraryTable,
+                                            QStringLiteral("%1.%2").arg(
+                                                    kTrackLocationsTable,
+                                                    TRACKLOCATIONSTABLE_LOCATION)),
+                                    kTrackLocationsTable,
+                                    LIBRARYTABLE_LOCATION,
+                                    TRACKLOCATIONSTABLE_ID))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    if (!query.exec(QStringLiteral("DELETE FROM %1").arg(kVersionTable)) ||
+            !query.exec(QStringLiteral(
+                    "INSERT INTO %1(library_version,index_version) VALUES(0,0)")
+                                .arg(kVersionTable))) {
+        LOG_FAILED_QUERY(query);
+        return false;
+    }
+    return transaction.commit();
+}
+
+bool TrackSearchIndex::installTriggers() {
+    struct Trigger {
+        QString name;
+        QString event;
+        QString table;
+        QString indexStatement;
+    };
+    QStringList columnsOfLibrary = kIndexedLibraryColumns;
+    columnsOfLibrary.append(LIBRARYTABLE_LOCATION);
+    const Trigger triggers[] = {
+            {QStringLiteral("insert"),
+                    QStringLiteral("INSERT"),
+                    kLibraryTable,
+                    insertRowStatement(QStringLiteral("NEW"))},
+            {QStringLiteral("update"),
+                    QStringLiteral("UPDATE OF ") + columnsOfLibrary.join(QChar(',')),
+                    kLibraryTable,
+                    QStringLiteral("DELETE FROM %1 WHERE rowid=OLD.%2; %3")
+                            .arg(kSearchIndexTable,
+                                    LIBRARYTABLE_ID,
+                                    insertRowStatement(QStringLiteral("NEW")))},
+            {QStringLiteral("delete"),
+                    QStringLiteral("DELETE"),
+                    kLibraryTable,
+                    QStringLiteral("DELETE FROM %1 WHERE rowid=OLD.%2")
+                            .arg(kSearchIndexTable, LIBRARYTABLE_ID)},
+            {QStringLiteral("relocate"),
+                    QStringLiteral("UPDATE OF ") + TRACKLOCATIONSTABLE_LOCATION,
+                    kTrackLocationsTable,
+                    QStringLiteral(
+                            "UPDATE %1 SET %2=%3 WHERE rowid IN "
+                            "(SELECT %4 FROM %5 WHERE %6=NEW.%7)")
+                            .arg(kSearchIndexTable,
+                                    TRACKLOCATIONSTABLE_LOCATION,
+                                    mixxx::DbConnection::latinLow(QStringLiteral("NEW.") +
+                                            TRACKLOCATIONSTABLE_LOCATION),
+                                    LIBRARYTABLE_ID,
+                                    kLibraryTable,
+                                    LIBRARYTABLE_LOCATION,
+                                    TRACKLOCATIONSTABLE_ID)},
+    };
+    // The persistent triggers only count the modifications of the library.
+    // They don't need the custom SQL functions and also fire for other
+    // applications that modify the database. The temporary triggers of
+    // each connection update the index and count its modifications.
+    QStringList statements;
+    for (const auto& trigger : triggers) {
+        statements.append(QStringLiteral(
+                "CREATE TRIGGER IF NOT EXISTS %1_version_%2 "
+                "AFTER %3 ON %4 BEGIN %5; END")
+                                  .arg(kSearchIndexTable,
+                                          trigger.name,
+                                          trigger.event,
+                                          trigger.table,
+                                          kIncrementLibraryVersionStatement));
+        statements.append(QStringLiteral(
+                "CREATE TEMP TRIGGER IF NOT EXISTS %1_%2 "
+                "AFTER %3 ON main.%4 BEGIN %5; %6; END")
+                                  .arg(kSearchIndexTable,
+                                          trigger.name,
+                                          trigger.event,
+                                          trigger.table,
+                                          trigger.indexStatement,
+                                          kIncrementIndexVersionStatement));
+    }
+    QSqlQuery query(m_database);
+    for (const auto& statement : statements) {
+        if (!query.exec(statement)) {
+            LOG_FAILED_QUERY(query);
+            return false;
+        }
+    }
+    return true;
+}
+
+QString TrackSearchIndex::formatQueryForTrackIdsContaining(
+        const QStringList& sqlColumns,
+        const QString& latinLowArgument) const {
+    if (!m_available ||
+            latinLowArgument.size() < kMinArgumentLength ||
+            sqlColumns.isEmpty()) {
+        return QString();
+    }
+    // Wildcards are only supported by LIKE
+    if (latinLowArgument.contains(kSqlLikeMatchAll) ||
+            latinLowArgument.contains(kSqlLikeMatchOne)) {
+        return QString();
+    }
+    for (const auto& sqlColumn : sqlColumns) {
+        if (sqlColumn != TRACKLOCATIONSTABLE_LOCATION &&
+                !kIndexedLibraryColumns.contains(sqlColumn)) {
+            return QString();
+        }
+    }
+    // Search for the argument as a phrase, i.e. a substring
+    QString phrase = latinLowArgument;
+    phrase.replace(QChar('"'), QStringLiteral("\"\""));
+    const QString match = QStringLiteral("{%1} : \"%2\"")
+                                  .arg(sqlColumns.join(QChar(' ')), phrase);
+    return QStringLiteral("%1 IN (SELECT rowid FROM %2 WHERE %2 MATCH %3)")
+            .arg(LIBRARYTABLE_ID,
+                    kSearchIndexTable,
+                    FieldEscaper(m_database).escapeString(match));
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+/// A full-text index of the text columns of all tracks in the library
+/// for substring searches that don't require scanning the whole table.
+///
+/// The index is an SQLite FTS5 table with the trigram tokenizer that
+/// contains the folded values of the columns, i.e. the same strings that
+/// are compared by the custom LIKE function. It is created on demand and
+/// only available if the SQLite library supports it. Otherwise searches
+/// fall back to LIKE.
+///
+/// The index is kept in sync by temporary triggers that are installed
+/// for each database connection of a TrackDAO. Temporary triggers don't
+/// break other applications that access the database without the custom
+/// SQL functions of Mixxx. Persistent triggers count all modifications
+/// of the library in a version stamp. The index is rebuilt if it has
+/// missed any of them.
+class TrackSearchIndex final {
+  public:
+    TrackSearchIndex();
+
+    /// Installs the triggers on the connection and rebuilds the index
+    /// if it is outdated.
+    void initialize(const QSqlDatabase& database);
+
+    bool isAvailable() const {
+        return m_available;
+    }
+
+    /// Returns a condition for the id column of the library that selects
+    /// all tracks with any of the columns containing the argument. The
+    /// argument must already be folded with makeStringLatinLow().
+    ///
+    /// Returns an empty string if the index cannot be used for the search,
+    /// e.g. for arguments with less than 3 characters or for columns that
+    /// are not indexed.
+    QString formatQueryForTrackIdsContaining(
+            const QStringList& sqlColumns,
+            const QString& latinLowArgument) const;
+
+  private:
+    bool createIndex();
+    bool populateIndex();
+    bool installTriggers();
+
+    QSqlDatabase m_database;
+    bool m_available;
+};
@@ -282,13 +282,15 @@ class TrackAnalysisSchedulerEnvironmentImpl final : public TrackAnalysisSchedule
 
 TrackAnalysisScheduler::Pointer Library::createTrackAnalysisScheduler(
         int numWorkerThreads,
-        AnalyzerModeFlags modeFlags) const {
+        AnalyzerModeFlags modeFlags,
+        const QString& group) const {
     return TrackAnalysisScheduler::createInstance(
             std::make_unique<const TrackAnalysisSchedulerEnvironmentImpl>(this),
             numWorkerThreads,
             m_pDbConnectionPool,
             m_pConfig,
-            modeFlags);
+            modeFlags,
+            group);
 }
 
 void Library::stopPendingTasks() {
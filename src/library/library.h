@@ -68,7 +68,8 @@ class Library: public QObject {
 
     TrackAnalysisScheduler::Pointer createTrackAnalysisScheduler(
             int numWorkerThreads,
-            AnalyzerModeFlags modeFlags) const;
+            AnalyzerModeFlags modeFlags,
+            const QString& group) const;
 
     void bindSearchboxWidget(WSearchLineEdit* pSearchboxWidget);
     void bindSidebarWidget(WLibrarySidebar* sidebarWidget);
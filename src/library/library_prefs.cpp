@@ -39,3 +39,13 @@ const ConfigKey mixxx::library::prefs::kSyncSeratoMetadataConfigKey =
         ConfigKey{
                 mixxx::library::prefs::kConfigGroup,
                 QStringLiteral("SeratoMetadataExport")};
+
+const ConfigKey mixxx::library::prefs::kScannerThreadCountConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("ScannerThreadCount")};
+
+const ConfigKey mixxx::library::prefs::kWatchDirectoriesConfigKey =
+        ConfigKey{
+                mixxx::library::prefs::kConfigGroup,
+                QStringLiteral("WatchDirectories")};
@@ -26,6 +26,18 @@ extern const ConfigKey kSyncSeratoMetadataConfigKey;
 
 extern const ConfigKey kSyncSeratoMetadataConfigKey;
 
+/// The number of threads for scanning directories and parsing
+/// file tags. 0 = one thread per CPU core.
+extern const ConfigKey kScannerThreadCountConfigKey;
+
+const int kScannerThreadCountDefault = 0;
+
+/// Rescan library directories automatically when files have been
+/// added, removed or modified. Only supported on Linux.
+extern const ConfigKey kWatchDirectoriesConfigKey;
+
+const bool kWatchDirectoriesDefault = false;
+
 } // namespace prefs
 
 } // namespace library
@@ -98,6 +98,7 @@ MixxxLibraryFeature::MixxxLibraryFeature(Library* pLibrary,
 
     BaseTrackCache* pBaseTrackCache = new BaseTrackCache(
             m_pTrackCollection, tableName, LIBRARYTABLE_ID, columns, true);
+    pBaseTrackCache->setSearchIndex(&m_pTrackCollection->getTrackDAO().searchIndex());
     m_pBaseTrackCache = QSharedPointer<BaseTrackCache>(pBaseTrackCache);
     m_pTrackCollection->connectTrackSource(m_pBaseTrackCache);
 
@@ -1,7 +1,9 @@
 #include "library/scanner/importfilestask.h"
 
+#include "library/coverartutils.h"
 #include "library/scanner/libraryscanner.h"
 #include "moc_importfilestask.cpp"
+#include "sources/soundsourceproxy.h"
 #include "util/timer.h"
 
 ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
@@ -23,6 +25,8 @@ ImportFilesTask::ImportFilesTask(LibraryScanner* pScanner,
 
 void ImportFilesTask::run() {
     ScopedTimer timer("ImportFilesTask::run");
+    // Caches the cover files of the directory
+    CoverInfoGuesser coverInfoGuesser;
     for (const QFileInfo& fileInfo: m_filesToImport) {
         // If a flag was raised telling us to cancel the library scan then stop.
         if (m_scannerGlobal->shouldCancel()) {
@@ -50,6 +54,13 @@ void ImportFilesTask::run() {
             }
             qDebug() << "Importing track" << trackLocation;
 
+            // Parse the file tags here on the worker thread. The track is
+            // then added to the database by the single writer on the
+            // LibraryScanner thread without parsing the file again.
+            m_scannerGlobal->addNewTrackImport(trackLocation,
+                    SoundSourceProxy::importNewTrackFromFile(
+                            mixxx::FileAccess(mixxx::FileInfo(fileInfo), m_pToken),
+                            &coverInfoGuesser));
             emit addNewTrack(trackLocation);
         }
     }
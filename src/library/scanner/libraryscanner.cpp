@@ -1,6 +1,9 @@
 #include "library/scanner/libraryscanner.h"
 
+#include <QFileInfo>
+
 #include "library/coverartutils.h"
+#include "library/library_prefs.h"
 #include "library/queryutil.h"
 #include "library/scanner/libraryscannerdlg.h"
 #include "library/scanner/recursivescandirectorytask.h"
@@ -13,14 +16,19 @@
 #include "util/db/dbconnectionpooler.h"
 #include "util/db/fwdsqlquery.h"
 #include "util/logger.h"
+#include "util/math.h"
 #include "util/performancetimer.h"
 #include "util/timer.h"
 #include "util/trace.h"
 
 namespace {
 
-// TODO(rryan) make configurable
-constexpr int kScannerThreadPoolSize = 1;
+// New tracks are committed in batches to make them visible while
+// scanning large libraries without paying for a commit per track.
+// If the scan fails only the tracks that have been added since the
+// last commit are rolled back. Cancelling keeps all added tracks,
+// the same as before.
+constexpr int kAddedTracksPerTransaction = 1000;
 
 mixxx::Logger kLogger("LibraryScanner");
 
@@ -92,16 +100,28 @@ void updateQueryPlannerStatisticsForDatabase(const QSqlDatabase& database) {
     }
 }
 
+int scannerThreadCount(const UserSettingsPointer& pConfig) {
+    const int threadCount = pConfig->getValue(
+            mixxx::library::prefs::kScannerThreadCountConfigKey,
+            mixxx::library::prefs::kScannerThreadCountDefault);
+    if (threadCount > 0) {
+        return threadCount;
+    }
+    return math_max(QThread::idealThreadCount(), 1);
+}
+
 } // anonymous namespace
 
 LibraryScanner::LibraryScanner(
         mixxx::DbConnectionPoolPtr pDbConnectionPool,
         const UserSettingsPointer& pConfig)
         : m_pDbConnectionPool(std::move(pDbConnectionPool)),
+          m_pConfig(pConfig),
           m_analysisDao(pConfig),
           m_trackDao(m_cueDao, m_playlistDao,
                   m_analysisDao, m_libraryHashDao,
                   pConfig),
+          m_tracksAddedSinceCommit(0),
           m_stateSema(1), // only one transaction is possible at a time
           m_state(IDLE) {
     // Move LibraryScanner to its own thread so that our signals/slots will
@@ -112,8 +132,6 @@ LibraryScanner::LibraryScanner(
     const int instanceId = s_instanceCounter.fetchAndAddAcquire(1) + 1;
     setObjectName(QString("LibraryScanner %1").arg(instanceId));
 
-    m_pool.setMaxThreadCount(kScannerThreadPoolSize);
-
     // Listen to signals from our public methods (invoked by other threads) and
     // connect them to our slots to run the command on the scanner thread.
     connect(this, &LibraryScanner::startScan, this, &LibraryScanner::slotStartScan);
@@ -182,9 +200,10 @@ void LibraryScanner::run() {
     kLogger.debug() << "Exiting thread";
 }
 
-void LibraryScanner::slotStartScan() {
-    kLogger.debug() << "slotStartScan()";
+void LibraryScanner::slotStartScan(const QStringList& directories) {
+    kLogger.debug() << "slotStartScan()" << directories;
     DEBUG_ASSERT(m_state == STARTING);
+    const bool partialScan = !directories.isEmpty();
 
     cleanUpDatabase(m_libraryHashDao.database());
 
@@ -198,7 +217,15 @@ void LibraryScanner::slotStartScan() {
     }
     changeScannerState(SCANNING);
 
-    QSet<QString> trackLocations = m_trackDao.getAllTrackLocations();
+    // Directories are scanned and files are parsed concurrently by the
+    // worker threads while all database writes are done on this thread.
+    m_pool.setMaxThreadCount(scannerThreadCount(m_pConfig));
+    kLogger.info()
+            << "Scanning library with"
+            << m_pool.maxThreadCount()
+            << "worker thread(s)";
+
+    QHash<QString, TrackFileStat> trackFileStats = m_trackDao.getAllTrackLocationFileStats();
     QHash<QString, mixxx::cache_key_t> directoryHashes = m_libraryHashDao.getDirectoryHashes();
     QRegularExpression extensionFilter(SoundSourceProxy::getSupportedFileNamesRegex());
     QRegularExpression coverExtensionFilter =
@@ -207,29 +234,54 @@ void LibraryScanner::slotStartScan() {
     QStringList directoryBlacklist = ScannerUtil::getDirectoryBlacklist();
 
     m_scannerGlobal = ScannerGlobalPointer(
-            new ScannerGlobal(trackLocations, directoryHashes, extensionFilter,
-                              coverExtensionFilter, directoryBlacklist));
+            new ScannerGlobal(trackFileStats,
+                    directoryHashes,
+                    extensionFilter,
+                    coverExtensionFilter,
+                    directoryBlacklist,
+                    partialScan));
 
     m_scannerGlobal->startTimer();
 
     emit scanStarted();
 
-    // First, we're going to mark all the directories that we've previously
-    // hashed as needing verification. As we search through the directory tree
-    // when we rescan, we'll mark any directory that does still exist as
-    // verified.
-    m_libraryHashDao.invalidateAllDirectories();
-
-    // Mark all the tracks in the library as needing verification of their
-    // existence. (ie. we want to check they're still on your hard drive where
-    // we think they are)
-    m_trackDao.invalidateTrackLocationsInLibrary();
+    QList<mixxx::FileInfo> scanRootDirs;
+    if (partialScan) {
+        // Only invalidate the directories and tracks that are rescanned.
+        // Missing directories are not scanned and everything beneath them
+        // needs to be verified.
+        for (const QString& directory : directories) {
+            const mixxx::FileInfo dirInfo(directory);
+            const bool dirExists = dirInfo.exists() && dirInfo.isDir();
+            m_libraryHashDao.invalidateDirectory(
+                    dirInfo.location(), !dirExists);
+            m_trackDao.invalidateTrackLocationsInDirectory(
+                    dirInfo.toQDir(), !dirExists);
+            scanRootDirs.append(dirInfo);
+        }
+    } else {
+        // First, we're going to mark all the directories that we've previously
+        // hashed as needing verification. As we search through the directory tree
+        // when we rescan, we'll mark any directory that does still exist as
+        // verified.
+        m_libraryHashDao.invalidateAllDirectories();
+
+        // Mark all the tracks in the library as needing verification of their
+        // existence. (ie. we want to check they're still on your hard drive where
+        // we think they are)
+        m_trackDao.invalidateTrackLocationsInLibrary();
+
+        scanRootDirs = m_libraryRootDirs;
+    }
 
     kLogger.debug() << "Recursively scanning library.";
 
     // Start scanning the library. This prepares insertion queries in TrackDAO
-    // (must be called before calling addTracksAdd) and begins a transaction.
+    // (must be called before calling addTracksAdd) and begins a transaction
+    // that is committed after every kAddedTracksPerTransaction new tracks.
     m_trackDao.addTracksPrepare();
+    DEBUG_ASSERT(m_scannedDirectories.isEmpty());
+    m_tracksAddedSinceCommit = 0;
 
     // First Scan all known directories we have a hash for.
     // In a second stage, we scan all new directories. This guarantees,
@@ -245,7 +297,7 @@ void LibraryScanner::slotStartScan() {
             this,
             &LibraryScanner::slotFinishHashedScan);
 
-    for (const mixxx::FileInfo& rootDir : qAsConst(m_libraryRootDirs)) {
+    for (const mixxx::FileInfo& rootDir : qAsConst(scanRootDirs)) {
         // Acquire a security bookmark for this directory if we are in a
         // sandbox. For speed we avoid opening security bookmarks when recursive
         // scanning so that relies on having an open bookmark for the containing
@@ -374,6 +426,12 @@ void LibraryScanner::cleanUpScan() {
 
     transaction.commit();
 
+    if (m_scannerGlobal->isPartialScan()) {
+        // Cover art of new tracks has already been guessed while
+        // importing the files.
+        return;
+    }
+
     kLogger.debug() << "Detecting cover art for unscanned files";
     QSet<TrackId> coverArtTracksChanged;
     m_trackDao.detectCoverArtForTracksWithoutCover(
@@ -403,15 +461,24 @@ void LibraryScanner::slotFinishUnhashedScan() {
     }
 
     // Finish adding the tracks -- rollback the transaction if the scan did not
-    // finish cleanly and the user did not cancel the transaction.
-    m_trackDao.addTracksFinish(!m_scannerGlobal->shouldCancel() &&
-                               !bScanFinishedCleanly);
+    // finish cleanly and the user did not cancel the transaction. Only the
+    // tracks since the last batch commit are rolled back. The hashes of
+    // their directories have not been committed yet, so these directories
+    // are scanned again next time.
+    const bool rollback = !m_scannerGlobal->shouldCancel() && !bScanFinishedCleanly;
+    if (rollback) {
+        m_scannedDirectories.clear();
+    } else {
+        saveScannedDirectoryHashes();
+    }
+    m_trackDao.addTracksFinish(rollback);
 
     if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
         cleanUpScan();
     }
 
-    if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly) {
+    if (!m_scannerGlobal->shouldCancel() && bScanFinishedCleanly &&
+            !m_scannerGlobal->isPartialScan()) {
         const auto dbConnection = mixxx::DbConnectionPooled(m_pDbConnectionPool);
         updateQueryPlannerStatisticsForDatabase(dbConnection);
     }
@@ -427,11 +494,13 @@ void LibraryScanner::slotFinishUnhashedScan() {
            "%d unchanged directories. "
            "%d changed/added directories. "
            "%d tracks verified from changed/added directories. "
+           "%d modified tracks. "
            "%d new tracks.",
             m_scannerGlobal->timerElapsed().formatNanosWithUnit().toLocal8Bit().constData(),
             static_cast<int>(m_scannerGlobal->verifiedDirectories().size()),
             m_scannerGlobal->numScannedDirectories(),
             static_cast<int>(m_scannerGlobal->verifiedTracks().size()),
+            m_scannerGlobal->numModifiedTracks(),
             static_cast<int>(m_scannerGlobal->addedTracks().size()));
 
     m_scannerGlobal.clear();
@@ -443,8 +512,19 @@ void LibraryScanner::slotFinishUnhashedScan() {
 
 void LibraryScanner::scan() {
     if (changeScannerState(STARTING)) {
-        emit startScan();
+        emit startScan(QStringList());
+    }
+}
+
+bool LibraryScanner::scanDirectories(const QStringList& directories) {
+    VERIFY_OR_DEBUG_ASSERT(!directories.isEmpty()) {
+        return false;
     }
+    if (!changeScannerState(STARTING)) {
+        return false;
+    }
+    emit startScan(directories);
+    return true;
 }
 
 // this is called after pressing the cancel button in the scanner
@@ -510,6 +590,10 @@ void LibraryScanner::queueTask(ScannerTask* pTask) {
             &ScannerTask::trackExists,
             this,
             &LibraryScanner::slotTrackExists);
+    connect(pTask,
+            &ScannerTask::trackFileModified,
+            this,
+            &LibraryScanner::slotTrackFileModified);
     connect(pTask,
             &ScannerTask::addNewTrack,
             this,
@@ -541,14 +625,38 @@ void LibraryScanner::slotDirectoryHashedAndScanned(const QString& directoryPath,
         m_scannerGlobal->directoryScanned();
     }
 
-    if (newDirectory) {
-        m_libraryHashDao.saveDirectoryHash(directoryPath, hash);
-    } else {
-        m_libraryHashDao.updateDirectoryHash(directoryPath, hash, 0);
+    if (!QFileInfo::exists(directoryPath)) {
+        // The directory has been removed while it was scanned. Storing
+        // a hash for it would prevent that its tracks are detected as
+        // missing.
+        kLogger.debug()
+                << "Not storing the hash of missing directory"
+                << directoryPath;
+        emit progressHashing(directoryPath);
+        return;
     }
+
+    // The tracks of the directory have all been added before, because the
+    // task emits this signal after addNewTrack() for each of them. But they
+    // might still be rolled back, so the hash is only stored when they are
+    // committed.
+    m_scannedDirectories.append(ScannedDirectory{directoryPath, newDirectory, hash});
     emit progressHashing(directoryPath);
 }
 
+void LibraryScanner::saveScannedDirectoryHashes() {
+    for (const auto& scannedDirectory : qAsConst(m_scannedDirectories)) {
+        if (scannedDirectory.newDirectory) {
+            m_libraryHashDao.saveDirectoryHash(
+                    scannedDirectory.path, scannedDirectory.hash);
+        } else {
+            m_libraryHashDao.updateDirectoryHash(
+                    scannedDirectory.path, scannedDirectory.hash, 0);
+        }
+    }
+    m_scannedDirectories.clear();
+}
+
 void LibraryScanner::slotDirectoryUnchanged(const QString& directoryPath) {
     ScopedTimer timer("LibraryScanner::slotDirectoryUnchanged");
     //kLogger.debug() << "slotDirectoryUnchanged" << directoryPath;
@@ -566,13 +674,34 @@ void LibraryScanner::slotTrackExists(const QString& trackPath) {
     }
 }
 
+void LibraryScanner::slotTrackFileModified(const QString& trackPath) {
+    //kLogger.debug() << "slotTrackFileModified" << trackPath;
+    ScopedTimer timer("LibraryScanner::slotTrackFileModified");
+    if (!m_scannerGlobal) {
+        return;
+    }
+    const mixxx::FileInfo fileInfo(trackPath);
+    m_trackDao.updateTrackLocationFileStat(
+            trackPath, TrackFileStat(fileInfo.asQFileInfo()));
+    if (!m_scannerGlobal->trackFileStatInDatabase(trackPath).isValid()) {
+        // The file stat has not been stored when the track was added
+        // and is only recorded now
+        return;
+    }
+    if (m_trackDao.updateTrackFromModifiedFile(TrackRef::fromFileInfo(fileInfo))) {
+        m_scannerGlobal->trackModified();
+    }
+}
+
 void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
     //kLogger.debug() << "slotAddNewTrack" << trackPath;
     ScopedTimer timer("LibraryScanner::addNewTrack");
     // For statistics tracking and to detect moved tracks
     TrackPointer pTrack = m_trackDao.addTracksAddFile(
             trackPath,
-            false);
+            false,
+            m_scannerGlobal ? m_scannerGlobal->takeNewTrackImport(trackPath)
+                            : SoundSourceProxy::NewTrackImport());
     if (pTrack) {
         DEBUG_ASSERT(!pTrack->isDirty());
         // The track's actual location might differ from the
@@ -586,6 +715,7 @@ void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
         // a new track in the database.
         emit trackAdded(pTrack);
         emit progressLoading(trackLocation);
+        ++m_tracksAddedSinceCommit;
     } else {
         // Acknowledge failed track addition
         // TODO(XXX): Is it really intended to acknowledge a failed
@@ -597,6 +727,11 @@ void LibraryScanner::slotAddNewTrack(const QString& trackPath) {
                 << "Failed to add track to library:"
                 << trackPath;
     }
+    if (m_tracksAddedSinceCommit >= kAddedTracksPerTransaction) {
+        saveScannedDirectoryHashes();
+        m_trackDao.addTracksCommit();
+        m_tracksAddedSinceCommit = 0;
+    }
 }
 
 bool LibraryScanner::changeScannerState(ScannerState newState) {
@@ -37,6 +37,11 @@ class LibraryScanner : public QThread {
     // in progress.
     void scan();
 
+    // Call from any thread to rescan only the given directories and
+    // their new subdirectories, e.g. after the directories have been
+    // modified. Returns false if a scan is already in progress.
+    bool scanDirectories(const QStringList& directories);
+
     // Call from any thread to cancel the scan.
     void slotCancel();
 
@@ -50,9 +55,9 @@ class LibraryScanner : public QThread {
     void tracksChanged(const QSet<TrackId>& changedTrackIds);
     void tracksRelocated(const QList<RelocatedTrack>& relocatedTracks);
 
-    // Emitted by scan() to invoke slotStartScan in the scanner thread's event
-    // loop.
-    void startScan();
+    // Emitted by scan() and scanDirectories() to invoke slotStartScan in the
+    // scanner thread's event loop. An empty list starts a full scan.
+    void startScan(const QStringList& directories);
 
   protected:
     void run() override;
@@ -61,7 +66,7 @@ class LibraryScanner : public QThread {
     void queueTask(ScannerTask* pTask);
 
   private slots:
-    void slotStartScan();
+    void slotStartScan(const QStringList& directories);
     void slotFinishHashedScan();
     void slotFinishUnhashedScan();
 
@@ -70,6 +75,7 @@ class LibraryScanner : public QThread {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void slotDirectoryUnchanged(const QString& directoryPath);
     void slotTrackExists(const QString& trackPath);
+    void slotTrackFileModified(const QString& trackPath);
     void slotAddNewTrack(const QString& trackPath);
 
   private:
@@ -96,8 +102,20 @@ class LibraryScanner : public QThread {
 
     void cleanUpScan();
 
+    // Stores the hashes of the directories that have been scanned since
+    // the previous commit in the current transaction.
+    void saveScannedDirectoryHashes();
+
+    struct ScannedDirectory {
+        QString path;
+        bool newDirectory;
+        mixxx::cache_key_t hash;
+    };
+
     mixxx::DbConnectionPoolPtr m_pDbConnectionPool;
 
+    const UserSettingsPointer m_pConfig;
+
     // The pool of threads used for worker tasks.
     QThreadPool m_pool;
 
@@ -112,6 +130,14 @@ class LibraryScanner : public QThread {
     // Global scanner state for scan currently in progress.
     ScannerGlobalPointer m_scannerGlobal;
 
+    // The hash of a directory is only stored together with its tracks.
+    // Otherwise the directory would not be scanned again after the tracks
+    // have been rolled back.
+    QList<ScannedDirectory> m_scannedDirectories;
+
+    // Successfully added tracks that have not been committed yet
+    int m_tracksAddedSinceCommit;
+
     // The Semaphore guards the state transitions queued to the
     // Qt even Queue in the way, that you cannot start a
     // new scan while the old one is canceled
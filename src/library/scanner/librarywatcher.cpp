@@ -0,0 +1,203 @@
+#include "library/scanner/librarywatcher.h"
+
+#include <QDirIterator>
+#include <QFile>
+#include <QSocketNotifier>
+
+#include "moc_librarywatcher.cpp"
+#include "util/assert.h"
+#include "util/logger.h"
+
+#ifdef __LINUX__
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace {
+
+const mixxx::Logger kLogger("LibraryWatcher");
+
+// Collect changes until no more changes happened for this period
+constexpr int kDebounceMillis = 2000;
+
+#ifdef __LINUX__
+constexpr uint32_t kWatchMask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE |
+        IN_MOVED_FROM | IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF |
+        IN_ONLYDIR;
+#endif
+
+} // anonymous namespace
+
+LibraryWatcher::LibraryWatcher(QObject* parent)
+        : QObject(parent),
+          m_fd(-1),
+          m_pNotifier(nullptr) {
+    m_debounceTimer.setSingleShot(true);
+    m_debounceTimer.setInterval(kDebounceMillis);
+    connect(&m_debounceTimer,
+            &QTimer::timeout,
+            this,
+            &LibraryWatcher::slotEmitModifiedDirectories);
+#ifdef __LINUX__
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        kLogger.warning()
+                << "Failed to initialize inotify:"
+                << strerror(errno);
+        return;
+    }
+    m_pNotifier = new QSocketNotifier(m_fd, QSocketNotifier::Read, this);
+    connect(m_pNotifier,
+            &QSocketNotifier::activated,
+            this,
+            &LibraryWatcher::slotReadEvents);
+#endif
+}
+
+LibraryWatcher::~LibraryWatcher() {
+#ifdef __LINUX__
+    if (m_fd >= 0) {
+        delete m_pNotifier;
+        // Closing the file descriptor removes all watches
+        close(m_fd);
+    }
+#endif
+}
+
+// static
+bool LibraryWatcher::isSupported() {
+#ifdef __LINUX__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LibraryWatcher::watchRootDirs(const QList<mixxx::FileInfo>& rootDirs) {
+    unwatchAll();
+    for (const auto& rootDir : rootDirs) {
+        watchDirectoryRecursively(rootDir.location());
+    }
+    kLogger.info()
+            << "Watching"
+            << m_watchedDirs.size()
+            << "directories";
+}
+
+void LibraryWatcher::unwatchAll() {
+#ifdef __LINUX__
+    for (auto it = m_watchedDirs.constBegin(); it != m_watchedDirs.constEnd(); ++it) {
+        inotify_rm_watch(m_fd, it.key());
+    }
+#endif
+    m_watchedDirs.clear();
+}
+
+void LibraryWatcher::watchDirectoryRecursively(const QString& dirPath) {
+#ifdef __LINUX__
+    if (m_fd < 0) {
+        return;
+    }
+    QStringList dirPaths{dirPath};
+    // Symbolic links to directories are not followed
+    QDirIterator it(dirPath,
+            QDir::Dirs | QDir::NoDotAndDotDot,
+            QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        dirPaths.append(it.next());
+    }
+    for (const auto& path : qAsConst(dirPaths)) {
+        const int wd = inotify_add_watch(
+                m_fd, QFile::encodeName(path).constData(), kWatchMask);
+        if (wd < 0) {
+            // Most likely the limit fs.inotify.max_user_watches
+            // has been exceeded
+            kLogger.warning()
+                    << "Failed to watch directory"
+                    << path
+                    << strerror(errno);
+            continue;
+        }
+        // The same watch descriptor is returned for a directory
+        // that is already watched
+        m_watchedDirs.insert(wd, path);
+    }
+#else
+    Q_UNUSED(dirPath);
+#endif
+}
+
+void LibraryWatcher::directoryModified(const QString& dirPath) {
+    m_modifiedDirs.insert(dirPath);
+    // Restart the timer
+    m_debounceTimer.start();
+}
+
+void LibraryWatcher::slotReadEvents() {
+#ifdef __LINUX__
+    alignas(struct inotify_event) char buffer[4096];
+    while (true) {
+        const ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            // EAGAIN if no more events are available
+            return;
+        }
+        for (const char* pEvent = buffer; pEvent < buffer + length;) {
+            const auto* event = reinterpret_cast<const struct inotify_event*>(pEvent);
+            pEvent += sizeof(struct inotify_event) + event->len;
+            if (event->mask & IN_Q_OVERFLOW) {
+                // Events have been lost, rescan everything
+                kLogger.warning() << "Event queue overflow";
+                for (const auto& dirPath : qAsConst(m_watchedDirs)) {
+                    directoryModified(dirPath);
+                }
+                continue;
+            }
+            const auto dirIt = m_watchedDirs.constFind(event->wd);
+            if (dirIt == m_watchedDirs.constEnd()) {
+                continue;
+            }
+            const QString dirPath = dirIt.value();
+            if (event->mask & IN_IGNORED) {
+                // The directory has been deleted or unmounted
+                m_watchedDirs.remove(event->wd);
+                continue;
+            }
+            if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                // The path of a moved directory is updated when the
+                // move is reported for the new parent directory, because
+                // inotify returns the existing watch descriptor.
+                directoryModified(dirPath);
+                continue;
+            }
+            directoryModified(dirPath);
+            if (!(event->mask & IN_ISDIR) || event->len == 0) {
+                continue;
+            }
+            const QString childPath = dirPath + QChar('/') +
+                    QFile::decodeName(event->name);
+            if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                watchDirectoryRecursively(childPath);
+            } else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                // Tracks in all subdirectories need to be verified
+                directoryModified(childPath);
+            }
+        }
+    }
+#endif
+}
+
+void LibraryWatcher::slotEmitModifiedDirectories() {
+    if (m_modifiedDirs.isEmpty()) {
+        return;
+    }
+    QStringList directories = m_modifiedDirs.values();
+    m_modifiedDirs.clear();
+    kLogger.debug()
+            << "Modified directories:"
+            << directories;
+    emit directoriesModified(directories);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QStringList>
+#include <QTimer>
+
+#include "util/fileinfo.h"
+
+class QSocketNotifier;
+
+/// Watches the library directories for added, removed and modified
+/// files and reports the affected directories for a partial rescan.
+///
+/// QFileSystemWatcher does not report modifications of files within a
+/// watched directory and would require a watch for each file. Instead
+/// inotify is used directly with one watch per directory, which is only
+/// available on Linux. On other platforms isSupported() returns false
+/// and the watcher does nothing.
+///
+/// Subsequent changes are collected until no more changes happened for
+/// a short time, i.e. copying an album only triggers a single rescan.
+class LibraryWatcher : public QObject {
+    Q_OBJECT
+  public:
+    explicit LibraryWatcher(QObject* parent = nullptr);
+    ~LibraryWatcher() override;
+
+    static bool isSupported();
+
+    /// Replaces all watches by watches for the given root directories
+    /// and all of their subdirectories.
+    void watchRootDirs(const QList<mixxx::FileInfo>& rootDirs);
+
+  signals:
+    /// Emitted with the locations of all directories that need to be
+    /// rescanned, including directories that have been removed.
+    void directoriesModified(const QStringList& directories);
+
+  private slots:
+    void slotReadEvents();
+    void slotEmitModifiedDirectories();
+
+  private:
+    void unwatchAll();
+    void watchDirectoryRecursively(const QString& dirPath);
+    void directoryModified(const QString& dirPath);
+
+    int m_fd;
+    QSocketNotifier* m_pNotifier;
+
+    // Watch descriptor -> directory location
+    QHash<int, QString> m_watchedDirs;
+
+    QSet<QString> m_modifiedDirs;
+    QTimer m_debounceTimer;
+};
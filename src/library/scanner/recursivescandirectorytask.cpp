@@ -60,6 +60,16 @@ void RecursiveScanDirectoryTask::run() {
                     supportedExtensionsRegex.match(fileName);
             if (supportedExtensionsMatch.hasMatch()) {
                 hasher.addData(currentFile.toUtf8());
+                // The directory listing doesn't change if a file is
+                // modified in place. Those files are detected by comparing
+                // the file stat with the one that has been stored when the
+                // file has last been scanned.
+                const QString trackLocation =
+                        mixxx::FileInfo(currentFileInfo).location();
+                if (m_scannerGlobal->trackFileModified(
+                            trackLocation, TrackFileStat(currentFileInfo))) {
+                    emit trackFileModified(trackLocation);
+                }
                 filesToImport.push_back(currentFileInfo);
             } else {
                 const QRegularExpressionMatch supportedCoverExtensionsMatch =
@@ -115,6 +125,13 @@ void RecursiveScanDirectoryTask::run() {
 
     // Process all of the sub-directories.
     for (const mixxx::FileInfo& dirInfo : dirsToScan) {
+        if (m_scannerGlobal->isPartialScan() &&
+                mixxx::isValidCacheKey(m_scannerGlobal->directoryHashInDatabase(
+                        dirInfo.location()))) {
+            // Subdirectories that have been scanned before are
+            // only rescanned when they have been modified.
+            continue;
+        }
         // Atomically test and mark the directory as scanned to avoid
         // that the same directory is scanned multiple times by different
         // tasks.
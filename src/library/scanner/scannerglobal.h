@@ -8,6 +8,8 @@
 #include <QSharedPointer>
 #include <QStringList>
 
+#include "library/trackfilestat.h"
+#include "sources/soundsourceproxy.h"
 #include "util/cache.h"
 #include "util/compatibility/qmutex.h"
 #include "util/fileaccess.h"
@@ -16,20 +18,26 @@
 
 class ScannerGlobal {
   public:
-    ScannerGlobal(const QSet<QString>& trackLocations,
+    // A partial scan only rescans the given directories and new
+    // subdirectories, but no subdirectories that have been scanned
+    // before.
+    ScannerGlobal(const QHash<QString, TrackFileStat>& trackFileStats,
             const QHash<QString, mixxx::cache_key_t>& directoryHashes,
             const QRegularExpression& supportedExtensionsMatcher,
             const QRegularExpression& supportedCoverExtensionsMatcher,
-            const QStringList& directoriesBlacklist)
-            : m_trackLocations(trackLocations),
+            const QStringList& directoriesBlacklist,
+            bool partialScan)
+            : m_trackFileStats(trackFileStats),
               m_directoryHashes(directoryHashes),
               m_supportedExtensionsMatcher(supportedExtensionsMatcher),
               m_supportedCoverExtensionsMatcher(supportedCoverExtensionsMatcher),
               m_directoriesBlacklist(directoriesBlacklist),
+              m_partialScan(partialScan),
               // Unless marked un-clean, we assume it will finish cleanly.
               m_scanFinishedCleanly(true),
               m_shouldCancel(false),
-              m_numScannedDirectories(0) {
+              m_numScannedDirectories(0),
+              m_numModifiedTracks(0) {
     }
 
     TaskWatcher& getTaskWatcher() {
@@ -38,7 +46,25 @@ class ScannerGlobal {
 
     // Returns whether the track already exists in the database.
     bool trackExistsInDatabase(const QString& trackLocation) const {
-        return m_trackLocations.contains(trackLocation);
+        return m_trackFileStats.contains(trackLocation);
+    }
+
+    // Returns the size and modification time of the file when it has
+    // last been scanned. The result is invalid if the track doesn't exist
+    // in the database or if the file stat has not been stored yet.
+    TrackFileStat trackFileStatInDatabase(const QString& trackLocation) const {
+        return m_trackFileStats.value(trackLocation);
+    }
+
+    // Returns whether the track exists in the database and its file has
+    // been modified since it has last been scanned.
+    bool trackFileModified(const QString& trackLocation, const TrackFileStat& fileStat) const {
+        const auto it = m_trackFileStats.constFind(trackLocation);
+        return it != m_trackFileStats.constEnd() && it.value() != fileStat;
+    }
+
+    bool isPartialScan() const {
+        return m_partialScan;
     }
 
     // Returns the directory hash if it exists or mixxx::invalidCacheKey() if it doesn't.
@@ -146,6 +172,20 @@ class ScannerGlobal {
         m_addedTracks << trackLocation;
     }
 
+    // Stores the metadata of a new track that has been parsed by a
+    // worker thread until the track is added to the database.
+    void addNewTrackImport(const QString& trackLocation,
+            SoundSourceProxy::NewTrackImport newTrackImport) {
+        const auto locker = lockMutex(&m_newTrackImportsMutex);
+        m_newTrackImports.insert(trackLocation, std::move(newTrackImport));
+    }
+
+    // Returns an unavailable import if the file has not been parsed before.
+    SoundSourceProxy::NewTrackImport takeNewTrackImport(const QString& trackLocation) {
+        const auto locker = lockMutex(&m_newTrackImportsMutex);
+        return m_newTrackImports.take(trackLocation);
+    }
+
     int numScannedDirectories() const {
         return m_numScannedDirectories;
     }
@@ -153,10 +193,17 @@ class ScannerGlobal {
         m_numScannedDirectories++;
     }
 
+    int numModifiedTracks() const {
+        return m_numModifiedTracks;
+    }
+    void trackModified() {
+        m_numModifiedTracks++;
+    }
+
   private:
     TaskWatcher m_watcher;
 
-    QSet<QString> m_trackLocations;
+    QHash<QString, TrackFileStat> m_trackFileStats;
     QHash<QString, mixxx::cache_key_t> m_directoryHashes;
 
     mutable QMutex m_supportedExtensionsMatcherMutex;
@@ -177,6 +224,11 @@ class ScannerGlobal {
     mutable QMutex m_directoriesUnhashedMutex;
     QList<mixxx::FileAccess> m_directoriesUnhashed;
 
+    // New tracks that have been parsed concurrently and are
+    // waiting to be added to the database.
+    mutable QMutex m_newTrackImportsMutex;
+    QHash<QString, SoundSourceProxy::NewTrackImport> m_newTrackImports;
+
     // Typically there are 1 to 2 entries in the blacklist so a O(n) search in a
     // QList may have better constant factors than a O(1) QSet check. However,
     // this has never been investigated.
@@ -191,12 +243,15 @@ class ScannerGlobal {
     // The list of tracks added by the scan.
     QStringList m_addedTracks;
 
+    const bool m_partialScan;
+
     volatile bool m_scanFinishedCleanly;
     volatile bool m_shouldCancel;
 
     // Stats tracking.
     PerformanceTimer m_timer;
     int m_numScannedDirectories;
+    int m_numModifiedTracks;
 };
 
 typedef QSharedPointer<ScannerGlobal> ScannerGlobalPointer;
@@ -23,6 +23,7 @@ class ScannerTask : public QObject, public QRunnable {
                                    bool newDirectory, mixxx::cache_key_t hash);
     void directoryUnchanged(const QString& directoryPath);
     void trackExists(const QString& filePath);
+    void trackFileModified(const QString& filePath);
     void addNewTrack(const QString& filePath);
 
     // Feedback to GUI
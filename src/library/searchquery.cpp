@@ -4,6 +4,7 @@
 #include <QtDebug>
 
 #include "library/dao/trackschema.h"
+#include "library/dao/tracksearchindex.h"
 #include "library/queryutil.h"
 #include "library/trackset/crate/crateschema.h"
 #include "track/keyutils.h"
@@ -162,10 +163,12 @@ QString NotNode::toSql() const {
 
 TextFilterNode::TextFilterNode(const QSqlDatabase& database,
         const QStringList& sqlColumns,
-        const QString& argument)
+        const QString& argument,
+        const TrackSearchIndex* pSearchIndex)
         : m_database(database),
           m_sqlColumns(sqlColumns),
-          m_argument(argument) {
+          m_argument(argument),
+          m_pSearchIndex(pSearchIndex) {
     mixxx::DbConnection::makeStringLatinLow(&m_argument);
 }
 
@@ -186,6 +189,17 @@ bool TextFilterNode::match(const TrackPointer& pTrack) const {
 }
 
 QString TextFilterNode::toSql() const {
+    // The index would also match a trailing space at the end of a value,
+    // which is excluded with LIKE below
+    const bool trailingSpace = m_argument.size() > 0 &&
+            m_argument[m_argument.size() - 1].isSpace();
+    if (m_pSearchIndex && !trailingSpace) {
+        const QString query = m_pSearchIndex->formatQueryForTrackIdsContaining(
+                m_sqlColumns, m_argument);
+        if (!query.isEmpty()) {
+            return query;
+        }
+    }
     FieldEscaper escaper(m_database);
     QString argument = m_argument;
     if (argument.size() > 0) {
@@ -14,6 +14,8 @@
 #include "util/assert.h"
 #include "util/memory.h"
 
+class TrackSearchIndex;
+
 const QString kMissingFieldSearchTerm = "\"\""; // "" searches for an empty string
 
 QVariant getTrackValueForColumn(const TrackPointer& pTrack, const QString& column);
@@ -74,9 +76,12 @@ class NotNode : public QueryNode {
 
 class TextFilterNode : public QueryNode {
   public:
+    /// The optional search index is used for the query if it
+    /// covers all columns.
     TextFilterNode(const QSqlDatabase& database,
             const QStringList& sqlColumns,
-            const QString& argument);
+            const QString& argument,
+            const TrackSearchIndex* pSearchIndex = nullptr);
 
     bool match(const TrackPointer& pTrack) const override;
     QString toSql() const override;
@@ -85,6 +90,7 @@ class TextFilterNode : public QueryNode {
     QSqlDatabase m_database;
     QStringList m_sqlColumns;
     QString m_argument;
+    const TrackSearchIndex* m_pSearchIndex;
 };
 
 class NullOrEmptyTextFilterNode : public QueryNode {
@@ -6,7 +6,8 @@ constexpr char kNegatePrefix[] = "-";
 constexpr char kFuzzyPrefix[] = "~";
 
 SearchQueryParser::SearchQueryParser(TrackCollection* pTrackCollection)
-    : m_pTrackCollection(pTrackCollection) {
+    : m_pTrackCollection(pTrackCollection),
+      m_pSearchIndex(nullptr) {
     m_textFilters << "artist"
                   << "album_artist"
                   << "album"
@@ -169,7 +170,9 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
                             m_pTrackCollection->database(),
-                            m_fieldToSqlColumns[field], argument);
+                            m_fieldToSqlColumns[field],
+                            argument,
+                            m_pSearchIndex);
                 }
             }
         } else if (numericFilterMatch.hasMatch()) {
@@ -237,12 +240,18 @@ void SearchQueryParser::parseTokens(QStringList tokens,
                     gNode->addNode(std::make_unique<CrateFilterNode>(
                                     &m_pTrackCollection->crates(), argument));
                     gNode->addNode(std::make_unique<TextFilterNode>(
-                                    m_pTrackCollection->database(), queryColumns, argument));
+                            m_pTrackCollection->database(),
+                            queryColumns,
+                            argument,
+                            m_pSearchIndex));
 
                     pNode = std::move(gNode);
                 } else {
                     pNode = std::make_unique<TextFilterNode>(
-                             m_pTrackCollection->database(), queryColumns, argument);
+                            m_pTrackCollection->database(),
+                            queryColumns,
+                            argument,
+                            m_pSearchIndex);
                 }
             }
         }
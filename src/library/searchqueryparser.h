@@ -19,6 +19,11 @@ class SearchQueryParser {
             const QStringList& searchColumns,
             const QString& extraFilter) const;
 
+    /// Text filters use the index for searching in the columns
+    /// of the internal library if set.
+    void setSearchIndex(const TrackSearchIndex* pSearchIndex) {
+        m_pSearchIndex = pSearchIndex;
+    }
 
   private:
     void parseTokens(QStringList tokens,
@@ -29,6 +34,7 @@ class SearchQueryParser {
                             QStringList* tokens) const;
 
     TrackCollection* m_pTrackCollection;
+    const TrackSearchIndex* m_pSearchIndex;
     QStringList m_textFilters;
     QStringList m_numericFilters;
     QStringList m_specialFilters;
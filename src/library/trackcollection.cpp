@@ -538,6 +538,12 @@ void TrackCollection::saveTrack(Track* pTrack) const {
     m_trackDao.saveTrack(pTrack);
 }
 
+void TrackCollection::saveTracks(const QList<TrackPointer>& tracks) const {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+
+    m_trackDao.saveTracks(tracks);
+}
+
 TrackPointer TrackCollection::getTrackById(
         TrackId trackId) const {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
@@ -3,6 +3,7 @@
 #include "library/externaltrackcollection.h"
 #include "library/library_prefs.h"
 #include "library/scanner/libraryscanner.h"
+#include "library/scanner/librarywatcher.h"
 #include "library/trackcollection.h"
 #include "moc_trackcollectionmanager.cpp"
 #include "sources/soundsourceproxy.h"
@@ -39,7 +40,8 @@ TrackCollectionManager::TrackCollectionManager(
         deleteTrackFn_t /*only-needed-for-testing*/ deleteTrackForTestingFn)
     : QObject(parent),
       m_pConfig(pConfig),
-      m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)) {
+      m_pInternalCollection(createInternalTrackCollection(this, pConfig, deleteTrackForTestingFn)),
+      m_pWatcher(nullptr) {
     const QSqlDatabase dbConnection = mixxx::DbConnectionPooled(pDbConnectionPool);
 
     // TODO(XXX): Add a checkbox in the library preferences for checking
@@ -123,6 +125,32 @@ TrackCollectionManager::TrackCollectionManager(
 
         kLogger.info() << "Starting library scanner thread";
         m_pScanner->start();
+
+        if (pConfig->getValue(mixxx::library::prefs::kWatchDirectoriesConfigKey,
+                    mixxx::library::prefs::kWatchDirectoriesDefault)) {
+            if (LibraryWatcher::isSupported()) {
+                m_pWatcher = new LibraryWatcher(this);
+                connect(m_pWatcher,
+                        &LibraryWatcher::directoriesModified,
+                        this,
+                        [this](const QStringList& directories) {
+                            for (const auto& directory : directories) {
+                                m_modifiedDirs.insert(directory);
+                            }
+                            rescanModifiedDirectories();
+                        });
+                // Retry when a running scan has finished
+                connect(m_pScanner.get(),
+                        &LibraryScanner::scanFinished,
+                        this,
+                        &TrackCollectionManager::rescanModifiedDirectories);
+                updateWatchedDirectories();
+            } else {
+                kLogger.warning()
+                        << "Watching library directories is not supported"
+                        << "on this platform";
+            }
+        }
     }
 }
 
@@ -174,6 +202,24 @@ void TrackCollectionManager::stopLibraryScan() {
     m_pScanner->slotCancel();
 }
 
+void TrackCollectionManager::updateWatchedDirectories() const {
+    if (!m_pWatcher) {
+        return;
+    }
+    m_pWatcher->watchRootDirs(m_pInternalCollection->loadRootDirs());
+}
+
+void TrackCollectionManager::rescanModifiedDirectories() {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+    if (m_modifiedDirs.isEmpty()) {
+        return;
+    }
+    DEBUG_ASSERT(m_pScanner);
+    if (m_pScanner->scanDirectories(m_modifiedDirs.values())) {
+        m_modifiedDirs.clear();
+    }
+}
+
 TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
         const TrackPointer& pTrack) const {
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
@@ -196,6 +242,58 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
     VERIFY_OR_DEBUG_ASSERT(pTrack) {
         return SaveTrackResult::Skipped;
     }
+    if (!beforeSaveTrack(pTrack, mode)) {
+        return SaveTrackResult::Skipped;
+    }
+
+    // This operation must be executed synchronously while the cache is
+    // locked to prevent that a new track is created from outdated
+    // metadata in the database before saving finished.
+    kLogger.debug()
+            << "Saving track"
+            << pTrack->getLocation()
+            << "in internal collection";
+    m_pInternalCollection->saveTrack(pTrack);
+    const auto res = pTrack->isDirty() ? SaveTrackResult::Failed : SaveTrackResult::Saved;
+
+    afterTrackSaved(*pTrack);
+    // After saving a track successfully the dirty flag must have been reset
+    DEBUG_ASSERT(!(res == SaveTrackResult::Saved && pTrack->isDirty()));
+    return res;
+}
+
+void TrackCollectionManager::saveTracks(
+        const QList<TrackPointer>& tracks) const {
+    DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
+    QList<TrackPointer> dirtyTracks;
+    dirtyTracks.reserve(tracks.size());
+    for (const auto& pTrack : tracks) {
+        VERIFY_OR_DEBUG_ASSERT(pTrack) {
+            continue;
+        }
+        if (beforeSaveTrack(pTrack.get(), TrackMetadataExportMode::Deferred)) {
+            dirtyTracks.append(pTrack);
+        }
+    }
+    if (dirtyTracks.isEmpty()) {
+        return;
+    }
+
+    kLogger.debug()
+            << "Saving"
+            << dirtyTracks.size()
+            << "track(s) in internal collection";
+    m_pInternalCollection->saveTracks(dirtyTracks);
+
+    for (const auto& pTrack : qAsConst(dirtyTracks)) {
+        afterTrackSaved(*pTrack);
+    }
+}
+
+bool TrackCollectionManager::beforeSaveTrack(
+        Track* pTrack,
+        TrackMetadataExportMode mode) const {
+    DEBUG_ASSERT(pTrack);
     DEBUG_ASSERT(pTrack->getDateAdded().isValid());
 
     // The track might have been marked for metadata export even
@@ -214,39 +312,29 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
         kLogger.debug()
                 << "Skip saving of missing track"
                 << fileInfo.location();
-        return SaveTrackResult::Skipped;
+        return false;
     }
 
     // The dirty flag is reset while saving the track in the internal
     // collection!
-    if (!pTrack->isDirty()) {
-        return SaveTrackResult::Skipped;
-    }
-
-    // This operation must be executed synchronously while the cache is
-    // locked to prevent that a new track is created from outdated
-    // metadata in the database before saving finished.
-    kLogger.debug()
-            << "Saving track"
-            << pTrack->getLocation()
-            << "in internal collection";
-    m_pInternalCollection->saveTrack(pTrack);
-    const auto res = pTrack->isDirty() ? SaveTrackResult::Failed : SaveTrackResult::Saved;
+    return pTrack->isDirty();
+}
 
+void TrackCollectionManager::afterTrackSaved(const Track& track) const {
     if (m_externalCollections.isEmpty()) {
-        return res;
+        return;
     }
-    if (pTrack->getId().isValid()) {
+    if (track.getId().isValid()) {
         // Track still exists in the internal collection/database
         kLogger.debug()
                 << "Saving modified track"
-                << pTrack->getLocation()
+                << track.getLocation()
                 << "in"
                 << m_externalCollections.size()
                 << "external collection(s)";
         for (const auto& externalTrackCollection : qAsConst(m_externalCollections)) {
             externalTrackCollection->saveTrack(
-                    *pTrack,
+                    track,
                     ExternalTrackCollection::ChangeHint::Modified);
         }
     } else {
@@ -254,18 +342,15 @@ TrackCollectionManager::SaveTrackResult TrackCollectionManager::saveTrack(
         // while it was cached in-memory
         kLogger.debug()
                 << "Purging deleted track"
-                << pTrack->getLocation()
+                << track.getLocation()
                 << "from"
                 << m_externalCollections.size()
                 << "external collection(s)";
         for (const auto& externalTrackCollection : qAsConst(m_externalCollections)) {
             externalTrackCollection->purgeTracks(
-                    QStringList{pTrack->getLocation()});
+                    QStringList{track.getLocation()});
         }
     }
-    // After saving a track successfully the dirty flag must have been reset
-    DEBUG_ASSERT(!(res == SaveTrackResult::Saved && pTrack->isDirty()));
-    return res;
 }
 
 void TrackCollectionManager::exportTrackMetadata(
@@ -309,13 +394,21 @@ void TrackCollectionManager::exportTrackMetadata(
 bool TrackCollectionManager::addDirectory(const mixxx::FileInfo& newDir) const {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
 
-    return m_pInternalCollection->addDirectory(newDir);
+    if (!m_pInternalCollection->addDirectory(newDir)) {
+        return false;
+    }
+    updateWatchedDirectories();
+    return true;
 }
 
 bool TrackCollectionManager::removeDirectory(const mixxx::FileInfo& oldDir) const {
     DEBUG_ASSERT_QOBJECT_THREAD_AFFINITY(this);
 
-    return m_pInternalCollection->removeDirectory(oldDir);
+    if (!m_pInternalCollection->removeDirectory(oldDir)) {
+        return false;
+    }
+    updateWatchedDirectories();
+    return true;
 }
 
 void TrackCollectionManager::relocateDirectory(const QString& oldDir, const QString& newDir) const {
@@ -328,6 +421,7 @@ void TrackCollectionManager::relocateDirectory(const QString& oldDir, const QStr
             << newDir;
     // TODO(XXX): Add error handling in TrackCollection::relocateDirectory()
     m_pInternalCollection->relocateDirectory(oldDir, newDir);
+    updateWatchedDirectories();
     if (m_externalCollections.isEmpty()) {
         return;
     }
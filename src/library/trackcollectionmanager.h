@@ -14,6 +14,7 @@
 #include "util/thread_affinity.h"
 
 class LibraryScanner;
+class LibraryWatcher;
 class TrackCollection;
 class ExternalTrackCollection;
 
@@ -90,6 +91,9 @@ class TrackCollectionManager: public QObject,
         Failed,
     };
     SaveTrackResult saveTrack(const TrackPointer& pTrack) const;
+    // Save many tracks like saveTrack(), but update the internal
+    // database within a single transaction.
+    void saveTracks(const QList<TrackPointer>& tracks) const;
 
   signals:
     void libraryScanStarted();
@@ -104,6 +108,9 @@ class TrackCollectionManager: public QObject,
     void afterTracksUpdated(const QSet<TrackId>& updatedTrackIds) const;
     void afterTracksRelocated(const QList<RelocatedTrack>& relocatedTracks) const;
 
+    void updateWatchedDirectories() const;
+    void rescanModifiedDirectories();
+
     // Callback for GlobalTrackCache
     void saveEvictedTrack(Track* pTrack) noexcept override;
 
@@ -115,6 +122,11 @@ class TrackCollectionManager: public QObject,
     SaveTrackResult saveTrack(
             Track* pTrack,
             TrackMetadataExportMode mode) const;
+    // Returns true if the track needs to be saved in the internal collection
+    bool beforeSaveTrack(
+            Track* pTrack,
+            TrackMetadataExportMode mode) const;
+    void afterTrackSaved(const Track& track) const;
     void exportTrackMetadata(
             Track* pTrack,
             TrackMetadataExportMode mode) const;
@@ -127,4 +139,9 @@ class TrackCollectionManager: public QObject,
 
     // TODO: Extract and decouple LibraryScanner from TrackCollectionManager
     std::unique_ptr<LibraryScanner> m_pScanner;
+
+    // Only available if enabled and supported
+    LibraryWatcher* m_pWatcher;
+    // Collected while a scan is in progress
+    QSet<QString> m_modifiedDirs;
 };
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QDateTime>
+#include <QFileInfo>
+
+/// The size and the modification time of a track file as stored in
+/// the database when the file has last been scanned.
+///
+/// Used for detecting files that have been modified outside of Mixxx
+/// without parsing them again.
+class TrackFileStat final {
+  public:
+    TrackFileStat()
+            : m_sizeInBytes(-1),
+              m_lastModifiedMillis(-1) {
+    }
+    TrackFileStat(
+            qint64 sizeInBytes,
+            qint64 lastModifiedMillis)
+            : m_sizeInBytes(sizeInBytes),
+              m_lastModifiedMillis(lastModifiedMillis) {
+    }
+    explicit TrackFileStat(const QFileInfo& fileInfo)
+            : m_sizeInBytes(fileInfo.size()),
+              m_lastModifiedMillis(fileInfo.lastModified().toMSecsSinceEpoch()) {
+    }
+
+    /// Both values are unknown for tracks that have been added
+    /// before the modification time has been stored.
+    bool isValid() const {
+        return m_lastModifiedMillis >= 0;
+    }
+
+    qint64 sizeInBytes() const {
+        return m_sizeInBytes;
+    }
+
+    /// In milliseconds since 1970-01-01T00:00:00.000 UTC
+    qint64 lastModifiedMillis() const {
+        return m_lastModifiedMillis;
+    }
+
+  private:
+    qint64 m_sizeInBytes;
+    qint64 m_lastModifiedMillis;
+};
+
+inline bool operator==(const TrackFileStat& lhs, const TrackFileStat& rhs) {
+    return lhs.sizeInBytes() == rhs.sizeInBytes() &&
+            lhs.lastModifiedMillis() == rhs.lastModifiedMillis();
+}
+
+inline bool operator!=(const TrackFileStat& lhs, const TrackFileStat& rhs) {
+    return !(lhs == rhs);
+}
@@ -0,0 +1,483 @@
+#include "library/trackinfotable.h"
+
+#include <QThread>
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "util/assert.h"
+#include "util/math.h"
+
+namespace {
+
+// Smaller inputs are sorted on the calling thread
+constexpr int kMinRowsPerSortThread = 16384;
+
+// Collating all strings again is cheaper than inserting more new
+// strings one by one into the existing ranks
+constexpr int kMaxNewStringsPerRankInsertionDivisor = 16;
+
+// Null values sort first in ascending and last in descending order
+constexpr double kNullSortKey = -std::numeric_limits<double>::infinity();
+
+struct MergeRange {
+    int begin;
+    int middle;
+    int end;
+};
+
+} // anonymous namespace
+
+TrackInfoTable::StringPool::StringPool()
+        : sortRanksCollation(Collation::Lexicographic),
+          sortRanksKeyNotation(KeyUtils::KeyNotation::Invalid) {
+    // Null and empty strings share the first id, which is
+    // also used for rows without a value.
+    intern(QString());
+}
+
+int TrackInfoTable::StringPool::intern(const QString& string) {
+    const auto it = ids.constFind(string);
+    if (it != ids.constEnd()) {
+        return it.value();
+    }
+    const int id = strings.size();
+    strings.append(string);
+    ids.insert(string, id);
+    return id;
+}
+
+void TrackInfoTable::StringPool::updateSortRanks(
+        Collation collation,
+        const mixxx::StringCollator& collator,
+        KeyUtils::KeyNotation keyNotation) const {
+    if (sortRanksCollation != collation ||
+            (collation == Collation::MusicalKey &&
+                    sortRanksKeyNotation != keyNotation)) {
+        sortRanks.clear();
+        sortedIds.clear();
+        equalsPrevious.clear();
+        sortRanksCollation = collation;
+        sortRanksKeyNotation = keyNotation;
+    }
+    const int rankedCount = static_cast<int>(sortRanks.size());
+    const int stringCount = strings.size();
+    if (rankedCount == stringCount) {
+        return;
+    }
+    switch (collation) {
+    case Collation::Numeric:
+        sortRanks.reserve(stringCount);
+        for (int i = rankedCount; i < stringCount; ++i) {
+            // The first id is shared by null and empty strings
+            sortRanks.push_back(i == 0 ? kNullSortKey : strings[i].toDouble());
+        }
+        return;
+    case Collation::MusicalKey:
+        sortRanks.reserve(stringCount);
+        for (int i = rankedCount; i < stringCount; ++i) {
+            sortRanks.push_back(KeyUtils::keyToCircleOfFifthsOrder(
+                    KeyUtils::guessKeyFromText(strings[i]), keyNotation));
+        }
+        return;
+    case Collation::Lexicographic:
+        break;
+    }
+    const auto lessThan = [this, &collator](int lhs, int rhs) {
+        return collator.compare(strings[lhs], strings[rhs]) < 0;
+    };
+    if (sortedIds.empty() ||
+            stringCount - rankedCount >
+                    stringCount / kMaxNewStringsPerRankInsertionDivisor) {
+        // Collate each distinct string only once
+        sortedIds.resize(stringCount);
+        std::iota(sortedIds.begin(), sortedIds.end(), 0);
+        std::sort(sortedIds.begin(), sortedIds.end(), lessThan);
+        equalsPrevious.assign(stringCount, false);
+        for (int i = 1; i < stringCount; ++i) {
+            equalsPrevious[i] = !lessThan(sortedIds[i - 1], sortedIds[i]);
+        }
+    } else {
+        // Only the new strings need to be collated. Inserting them after
+        // all equal strings ensures that they are less than their new
+        // successor.
+        for (int id = rankedCount; id < stringCount; ++id) {
+            const auto pos = std::upper_bound(
+                    sortedIds.begin(), sortedIds.end(), id, lessThan);
+            const auto i = pos - sortedIds.begin();
+            sortedIds.insert(pos, id);
+            equalsPrevious.insert(equalsPrevious.begin() + i,
+                    i > 0 && !lessThan(sortedIds[i - 1], id));
+            if (i + 1 < static_cast<int>(sortedIds.size())) {
+                equalsPrevious[i + 1] = false;
+            }
+        }
+    }
+    // Strings that are considered equal by the collator get the same rank
+    sortRanks.resize(stringCount);
+    int rank = 0;
+    for (int i = 0; i < stringCount; ++i) {
+        if (!equalsPrevious[i]) {
+            rank = i;
+        }
+        sortRanks[sortedIds[i]] = rank;
+    }
+}
+
+TrackInfoTable::TrackInfoTable(int columnCount)
+        : m_columns(columnCount) {
+}
+
+void TrackInfoTable::clear() {
+    const auto columnCount = m_columns.size();
+    m_columns.clear();
+    m_columns.resize(columnCount);
+    m_rowTrackIds.clear();
+    m_rowsByTrackId.clear();
+}
+
+int TrackInfoTable::insertRow(TrackId trackId) {
+    DEBUG_ASSERT(trackId.isValid());
+    const auto it = m_rowsByTrackId.constFind(trackId);
+    if (it != m_rowsByTrackId.constEnd()) {
+        return it.value();
+    }
+    const int row = m_rowTrackIds.size();
+    m_rowTrackIds.append(trackId);
+    m_rowsByTrackId.insert(trackId, row);
+    for (auto& column : m_columns) {
+        resizeColumn(&column, row + 1);
+    }
+    return row;
+}
+
+void TrackInfoTable::removeRow(TrackId trackId) {
+    const auto it = m_rowsByTrackId.find(trackId);
+    if (it == m_rowsByTrackId.end()) {
+        return;
+    }
+    const int row = it.value();
+    m_rowsByTrackId.erase(it);
+    const int lastRow = m_rowTrackIds.size() - 1;
+    if (row != lastRow) {
+        for (auto& column : m_columns) {
+            moveValue(&column, lastRow, row);
+        }
+        m_rowTrackIds[row] = m_rowTrackIds[lastRow];
+        m_rowsByTrackId[m_rowTrackIds[row]] = row;
+    }
+    m_rowTrackIds.removeLast();
+    for (auto& column : m_columns) {
+        resizeColumn(&column, lastRow);
+    }
+}
+
+// static
+TrackInfoTable::ColumnType TrackInfoTable::columnTypeOf(const QVariant& value) {
+    if (value.isNull()) {
+        return ColumnType::Null;
+    }
+    switch (value.userType()) {
+    case QMetaType::Bool:
+    case QMetaType::Int:
+    case QMetaType::UInt:
+    case QMetaType::LongLong:
+    case QMetaType::ULongLong:
+        return ColumnType::Integer;
+    case QMetaType::Double:
+    case QMetaType::Float:
+        return ColumnType::Real;
+    case QMetaType::QString:
+        return ColumnType::String;
+    default:
+        return ColumnType::Variant;
+    }
+}
+
+void TrackInfoTable::resizeColumn(Column* pColumn, int rowCount) {
+    const auto size = static_cast<std::size_t>(rowCount);
+    switch (pColumn->type) {
+    case ColumnType::Null:
+        break;
+    case ColumnType::Integer:
+        pColumn->integers.resize(size);
+        break;
+    case ColumnType::Real:
+        pColumn->reals.resize(size);
+        break;
+    case ColumnType::String:
+        pColumn->stringIds.resize(size);
+        break;
+    case ColumnType::Variant:
+        pColumn->variants.resize(size, pColumn->nullValue);
+        return;
+    }
+    pColumn->nulls.resize(size, true);
+}
+
+void TrackInfoTable::moveValue(Column* pColumn, int fromRow, int toRow) {
+    switch (pColumn->type) {
+    case ColumnType::Null:
+        break;
+    case ColumnType::Integer:
+        pColumn->integers[toRow] = pColumn->integers[fromRow];
+        break;
+    case ColumnType::Real:
+        pColumn->reals[toRow] = pColumn->reals[fromRow];
+        break;
+    case ColumnType::String:
+        pColumn->stringIds[toRow] = pColumn->stringIds[fromRow];
+        break;
+    case ColumnType::Variant:
+        pColumn->variants[toRow] = std::move(pColumn->variants[fromRow]);
+        return;
+    }
+    pColumn->nulls[toRow] = pColumn->nulls[fromRow];
+}
+
+void TrackInfoTable::convertToVariantColumn(Column* pColumn) {
+    DEBUG_ASSERT(pColumn->type != ColumnType::Variant);
+    const int column = static_cast<int>(pColumn - m_columns.data());
+    std::vector<QVariant> variants;
+    variants.reserve(m_rowTrackIds.size());
+    for (int row = 0; row < m_rowTrackIds.size(); ++row) {
+        variants.push_back(value(row, column));
+    }
+    QVariant nullValue = std::move(pColumn->nullValue);
+    *pColumn = Column();
+    pColumn->type = ColumnType::Variant;
+    pColumn->nullValue = std::move(nullValue);
+    pColumn->variants = std::move(variants);
+}
+
+QVariant TrackInfoTable::value(int row, int column) const {
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < rowCount() &&
+            column >= 0 && column < columnCount()) {
+        return QVariant();
+    }
+    const Column& col = m_columns[column];
+    if (col.type == ColumnType::Variant) {
+        return col.variants[row];
+    }
+    if (col.type == ColumnType::Null || col.nulls[row]) {
+        return col.nullValue;
+    }
+    switch (col.type) {
+    case ColumnType::Integer:
+        return QVariant(col.integers[row]);
+    case ColumnType::Real:
+        return QVariant(col.reals[row]);
+    case ColumnType::String:
+        return QVariant(col.stringPool.strings[col.stringIds[row]]);
+    default:
+        DEBUG_ASSERT(!"unreachable");
+        return QVariant();
+    }
+}
+
+void TrackInfoTable::setValue(int row, int column, const QVariant& value) {
+    VERIFY_OR_DEBUG_ASSERT(row >= 0 && row < rowCount() &&
+            column >= 0 && column < columnCount()) {
+        return;
+    }
+    Column* pColumn = &m_columns[column];
+    const ColumnType type = columnTypeOf(value);
+    if (type == ColumnType::Null) {
+        if (!pColumn->nullValue.isValid()) {
+            // Preserve the type of null values
+            pColumn->nullValue = value;
+        }
+        if (pColumn->type == ColumnType::Variant) {
+            pColumn->variants[row] = value;
+        } else if (pColumn->type != ColumnType::Null) {
+            pColumn->nulls[row] = true;
+        }
+        return;
+    }
+    if (pColumn->type == ColumnType::Null) {
+        pColumn->type = type;
+        resizeColumn(pColumn, rowCount());
+    } else if (pColumn->type != type && pColumn->type != ColumnType::Variant) {
+        convertToVariantColumn(pColumn);
+    }
+    switch (pColumn->type) {
+    case ColumnType::Integer:
+        pColumn->integers[row] = value.toLongLong();
+        break;
+    case ColumnType::Real:
+        pColumn->reals[row] = value.toDouble();
+        break;
+    case ColumnType::String:
+        pColumn->stringIds[row] = pColumn->stringPool.intern(value.toString());
+        break;
+    case ColumnType::Variant:
+        pColumn->variants[row] = value;
+        return;
+    default:
+        DEBUG_ASSERT(!"unreachable");
+        return;
+    }
+    pColumn->nulls[row] = false;
+}
+
+void TrackInfoTable::computeSortKeys(
+        const Column& column,
+        Collation collation,
+        const mixxx::StringCollator& collator,
+        KeyUtils::KeyNotation keyNotation,
+        const std::vector<int>& rows,
+        std::vector<double>* pSortKeys) const {
+    pSortKeys->resize(rows.size());
+    switch (column.type) {
+    case ColumnType::Null:
+        std::fill(pSortKeys->begin(), pSortKeys->end(), kNullSortKey);
+        return;
+    case ColumnType::Integer:
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const int row = rows[i];
+            (*pSortKeys)[i] = (row < 0 || column.nulls[row])
+                    ? kNullSortKey
+                    : static_cast<double>(column.integers[row]);
+        }
+        return;
+    case ColumnType::Real:
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const int row = rows[i];
+            (*pSortKeys)[i] = (row < 0 || column.nulls[row])
+                    ? kNullSortKey
+                    : column.reals[row];
+        }
+        return;
+    case ColumnType::String: {
+        const StringPool& pool = column.stringPool;
+        pool.updateSortRanks(collation, collator, keyNotation);
+        // Null values have the same id as empty strings
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const int row = rows[i];
+            (*pSortKeys)[i] = pool.sortRanks[row < 0 ? 0 : column.stringIds[row]];
+        }
+        return;
+    }
+    case ColumnType::Variant: {
+        if (collation == Collation::Numeric) {
+            for (std::size_t i = 0; i < rows.size(); ++i) {
+                const int row = rows[i];
+                (*pSortKeys)[i] = (row < 0 || column.variants[row].isNull())
+                        ? kNullSortKey
+                        : column.variants[row].toDouble();
+            }
+            return;
+        }
+        // Intern the string representations for collating them
+        StringPool pool;
+        std::vector<int> stringIds(rows.size());
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const int row = rows[i];
+            stringIds[i] = row < 0 ? 0 : pool.intern(column.variants[row].toString());
+        }
+        pool.updateSortRanks(collation, collator, keyNotation);
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            (*pSortKeys)[i] = pool.sortRanks[stringIds[i]];
+        }
+        return;
+    }
+    }
+}
+
+void TrackInfoTable::sortTrackIds(
+        QVector<TrackId>* pTrackIds,
+        const QVector<SortKey>& sortKeys,
+        const mixxx::StringCollator& collator,
+        KeyUtils::KeyNotation keyNotation) const {
+    DEBUG_ASSERT(pTrackIds);
+    // Tracks that are not stored get a negative row
+    std::vector<int> rows;
+    rows.reserve(pTrackIds->size());
+    for (const auto& trackId : qAsConst(*pTrackIds)) {
+        rows.push_back(m_rowsByTrackId.value(trackId, -1));
+    }
+
+    // Evaluate all sort keys upfront. Comparing the precomputed keys
+    // is thread-safe and much cheaper than comparing QVariants.
+    std::vector<std::vector<double>> keys;
+    keys.reserve(sortKeys.size());
+    for (const auto& sortKey : sortKeys) {
+        VERIFY_OR_DEBUG_ASSERT(sortKey.column >= 0 && sortKey.column < columnCount()) {
+            continue;
+        }
+        std::vector<double> columnKeys;
+        computeSortKeys(m_columns[sortKey.column],
+                sortKey.collation,
+                collator,
+                keyNotation,
+                rows,
+                &columnKeys);
+        if (sortKey.order == Qt::DescendingOrder) {
+            for (auto& key : columnKeys) {
+                key = -key;
+            }
+        }
+        keys.push_back(std::move(columnKeys));
+    }
+
+    const QVector<TrackId>& trackIds = *pTrackIds;
+    const auto lessThan = [&keys, &trackIds](int lhs, int rhs) {
+        for (const auto& columnKeys : keys) {
+            if (columnKeys[lhs] < columnKeys[rhs]) {
+                return true;
+            }
+            if (columnKeys[rhs] < columnKeys[lhs]) {
+                return false;
+            }
+        }
+        return trackIds[lhs] < trackIds[rhs];
+    };
+
+    const int rowCount = static_cast<int>(rows.size());
+    std::vector<int> order(rowCount);
+    std::iota(order.begin(), order.end(), 0);
+    const int numThreads = math_min(
+            QThread::idealThreadCount(), rowCount / kMinRowsPerSortThread);
+    if (numThreads <= 1) {
+        std::sort(order.begin(), order.end(), lessThan);
+    } else {
+        // Sort slices concurrently and merge adjacent slices pairwise
+        QVector<MergeRange> ranges;
+        for (int i = 0; i < numThreads; ++i) {
+            const int begin = rowCount * i / numThreads;
+            const int end = rowCount * (i + 1) / numThreads;
+            ranges.append(MergeRange{begin, end, end});
+        }
+        QtConcurrent::blockingMap(ranges, [&order, &lessThan](const MergeRange& range) {
+            std::sort(order.begin() + range.begin, order.begin() + range.end, lessThan);
+        });
+        while (ranges.size() > 1) {
+            QVector<MergeRange> merges;
+            for (int i = 0; i + 1 < ranges.size(); i += 2) {
+                merges.append(MergeRange{
+                        ranges[i].begin, ranges[i].end, ranges[i + 1].end});
+            }
+            QtConcurrent::blockingMap(merges, [&order, &lessThan](const MergeRange& merge) {
+                std::inplace_merge(order.begin() + merge.begin,
+                        order.begin() + merge.middle,
+                        order.begin() + merge.end,
+                        lessThan);
+            });
+            if (ranges.size() % 2 != 0) {
+                merges.append(ranges.last());
+            }
+            for (auto& merge : merges) {
+                merge.middle = merge.end;
+            }
+            ranges = std::move(merges);
+        }
+    }
+
+    QVector<TrackId> sortedTrackIds;
+    sortedTrackIds.reserve(rowCount);
+    for (const int i : order) {
+        sortedTrackIds.append(trackIds[i]);
+    }
+    *pTrackIds = std::move(sortedTrackIds);
+}
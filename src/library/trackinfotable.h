@@ -0,0 +1,153 @@
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+#include <vector>
+
+#include "track/keyutils.h"
+#include "track/trackid.h"
+#include "util/string.h"
+
+/// The in-memory table of BaseTrackCache with one row per track.
+///
+/// Values are stored column-wise with a native type per column instead of
+/// a QVariant per cell. The type of a column is detected from the first
+/// non-null value that is stored. Columns that contain values of different
+/// types fall back to storing QVariants.
+///
+/// Strings are interned per column, i.e. each distinct string is stored
+/// only once and rows refer to it by index. Sorting only needs to collate
+/// the distinct strings of a column once and then compares the resulting
+/// ranks. Strings that are added later are inserted into the existing
+/// ranks with a binary search.
+class TrackInfoTable {
+  public:
+    /// How the values of a column are compared when sorting. Numeric
+    /// columns are always compared by their value.
+    enum class Collation {
+        Lexicographic,
+        Numeric,
+        MusicalKey,
+    };
+
+    struct SortKey {
+        int column;
+        Collation collation;
+        Qt::SortOrder order;
+    };
+
+    explicit TrackInfoTable(int columnCount);
+
+    int columnCount() const {
+        return static_cast<int>(m_columns.size());
+    }
+
+    int rowCount() const {
+        return m_rowTrackIds.size();
+    }
+
+    void clear();
+
+    bool contains(TrackId trackId) const {
+        return m_rowsByTrackId.contains(trackId);
+    }
+
+    /// Returns the row of the track or -1 if the track is not stored.
+    int row(TrackId trackId) const {
+        return m_rowsByTrackId.value(trackId, -1);
+    }
+
+    /// Returns the row of the track and appends a new row with all values
+    /// set to null if the track is not stored yet.
+    int insertRow(TrackId trackId);
+
+    /// The last row is moved into the removed row.
+    void removeRow(TrackId trackId);
+
+    QVariant value(int row, int column) const;
+    void setValue(int row, int column, const QVariant& value);
+
+    /// Sorts the tracks by the given keys. Ties are ordered by track id.
+    /// Like in SQL null values sort before all other values in ascending
+    /// order. Tracks that are not stored are sorted as if all of their
+    /// values were null.
+    ///
+    /// Large inputs are sorted on multiple threads.
+    void sortTrackIds(
+            QVector<TrackId>* pTrackIds,
+            const QVector<SortKey>& sortKeys,
+            const mixxx::StringCollator& collator,
+            KeyUtils::KeyNotation keyNotation) const;
+
+  private:
+    enum class ColumnType {
+        Null,
+        Integer,
+        Real,
+        String,
+        Variant,
+    };
+
+    struct StringPool {
+        StringPool();
+
+        int intern(const QString& string);
+
+        // Ranks the strings that have been added since the last call
+        // and starts over if the collation has changed
+        void updateSortRanks(
+                Collation collation,
+                const mixxx::StringCollator& collator,
+                KeyUtils::KeyNotation keyNotation) const;
+
+        QVector<QString> strings;
+        QHash<QString, int> ids;
+
+        // The sort rank of each string for the collation that has
+        // been used for the last sort
+        mutable std::vector<double> sortRanks;
+        mutable Collation sortRanksCollation;
+        mutable KeyUtils::KeyNotation sortRanksKeyNotation;
+        // The string ids in lexicographic order and whether each of
+        // them is considered equal to its predecessor by the collator
+        mutable std::vector<int> sortedIds;
+        mutable std::vector<bool> equalsPrevious;
+    };
+
+    struct Column {
+        Column()
+                : type(ColumnType::Null) {
+        }
+
+        ColumnType type;
+        // Returned for rows without a value
+        QVariant nullValue;
+        std::vector<bool> nulls;
+        std::vector<qint64> integers;
+        std::vector<double> reals;
+        std::vector<int> stringIds;
+        StringPool stringPool;
+        std::vector<QVariant> variants;
+    };
+
+    static ColumnType columnTypeOf(const QVariant& value);
+    void convertToVariantColumn(Column* pColumn);
+    void resizeColumn(Column* pColumn, int rowCount);
+    void moveValue(Column* pColumn, int fromRow, int toRow);
+
+    // Returns one sort key per row, ascending. Rows that are negative
+    // are not stored and only have null values.
+    void computeSortKeys(
+            const Column& column,
+            Collation collation,
+            const mixxx::StringCollator& collator,
+            KeyUtils::KeyNotation keyNotation,
+            const std::vector<int>& rows,
+            std::vector<double>* pSortKeys) const;
+
+    std::vector<Column> m_columns;
+    QVector<TrackId> m_rowTrackIds;
+    QHash<TrackId, int> m_rowsByTrackId;
+};
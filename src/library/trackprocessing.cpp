@@ -13,6 +13,11 @@ namespace {
 
 const Logger kLogger("ModalTrackBatchProcessor");
 
+// Modified tracks are saved in batches to reduce the number of
+// database transactions. Saving them in between limits the number
+// of tracks that are kept in memory.
+constexpr int kSaveTracksBatchSize = 100;
+
 } // anonymous namespace
 
 int ModalTrackBatchProcessor::processTracks(
@@ -36,6 +41,15 @@ int ModalTrackBatchProcessor::processTracks(
             m_minimumProgressDuration,
             this);
     taskMonitor.registerTask(this);
+    QList<TrackPointer> tracksToSave;
+    tracksToSave.reserve(kSaveTracksBatchSize);
+    const auto saveTracks = [pTrackCollectionManager, &tracksToSave] {
+        if (tracksToSave.isEmpty()) {
+            return;
+        }
+        pTrackCollectionManager->saveTracks(tracksToSave);
+        tracksToSave.clear();
+    };
     while (auto nextTrackPointer = pTrackPointerIterator->nextItem()) {
         const auto pTrack = *nextTrackPointer;
         VERIFY_OR_DEBUG_ASSERT(pTrack) {
@@ -53,6 +67,7 @@ int ModalTrackBatchProcessor::processTracks(
                     << "of"
                     << estimatedTotalCount
                     << "track(s)";
+            saveTracks();
             return finishedTrackCount;
         }
         switch (doProcessNextTrack(pTrack)) {
@@ -64,11 +79,15 @@ int ModalTrackBatchProcessor::processTracks(
                     << "of"
                     << estimatedTotalCount
                     << "track(s)";
+            saveTracks();
             return finishedTrackCount;
         case ProcessNextTrackResult::ContinueProcessing:
             break;
         case ProcessNextTrackResult::SaveTrackAndContinueProcessing:
-            pTrackCollectionManager->saveTrack(pTrack);
+            tracksToSave.append(pTrack);
+            if (tracksToSave.size() >= kSaveTracksBatchSize) {
+                saveTracks();
+            }
             break;
         }
         ++finishedTrackCount;
@@ -90,6 +109,7 @@ int ModalTrackBatchProcessor::processTracks(
                                 static_cast<PercentageOfCompletion>(
                                         estimatedTotalCount));
     }
+    saveTracks();
     return finishedTrackCount;
 }
 
@@ -175,9 +175,14 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
             &Library::slotLoadLocationToPlayer);
 
     DEBUG_ASSERT(!m_pTrackAnalysisScheduler);
+    // Tracks loaded into decks are analyzed one at a time, run all
+    // analyzers concurrently to get the results as fast as possible.
     m_pTrackAnalysisScheduler = pLibrary->createTrackAnalysisScheduler(
             kNumberOfAnalyzerThreads,
-            AnalyzerModeFlags::WithWaveform);
+            static_cast<AnalyzerModeFlags>(
+                    AnalyzerModeFlags::WithWaveform |
+                    AnalyzerModeFlags::Pipelined),
+            QStringLiteral("[Master]"));
 
     connect(m_pTrackAnalysisScheduler.get(), &TrackAnalysisScheduler::trackProgress,
             this, &PlayerManager::onTrackAnalysisProgress);
@@ -193,7 +198,10 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
     // Connect the player to the analyzer queue so that loaded tracks are
     // analyzed.
     foreach(Sampler* pSampler, m_samplers) {
-        connect(pSampler, &BaseTrackPlayer::newTrackLoaded, this, &PlayerManager::slotAnalyzeTrack);
+        connect(pSampler,
+                &BaseTrackPlayer::newTrackLoaded,
+                this,
+                &PlayerManager::slotAnalyzePreviewTrack);
     }
 
     // Connect the player to the analyzer queue so that loaded tracks are
@@ -202,7 +210,7 @@ void PlayerManager::bindToLibrary(Library* pLibrary) {
         connect(pPreviewDeck,
                 &BaseTrackPlayer::newTrackLoaded,
                 this,
-                &PlayerManager::slotAnalyzeTrack);
+                &PlayerManager::slotAnalyzePreviewTrack);
     }
 }
 
@@ -467,7 +475,7 @@ void PlayerManager::addSamplerInner() {
         connect(pSampler,
                 &BaseTrackPlayer::newTrackLoaded,
                 this,
-                &PlayerManager::slotAnalyzeTrack);
+                &PlayerManager::slotAnalyzePreviewTrack);
     }
 
     m_players[handleGroup.handle()] = pSampler;
@@ -500,7 +508,7 @@ void PlayerManager::addPreviewDeckInner() {
         connect(pPreviewDeck,
                 &BaseTrackPlayer::newTrackLoaded,
                 this,
-                &PlayerManager::slotAnalyzeTrack);
+                &PlayerManager::slotAnalyzePreviewTrack);
     }
 
     m_players[handleGroup.handle()] = pPreviewDeck;
@@ -703,11 +711,20 @@ void PlayerManager::slotLoadTrackIntoNextAvailableSampler(TrackPointer pTrack) {
 }
 
 void PlayerManager::slotAnalyzeTrack(TrackPointer track) {
+    analyzeTrack(track, TrackAnalysisScheduler::Priority::DeckLoad);
+}
+
+void PlayerManager::slotAnalyzePreviewTrack(TrackPointer track) {
+    analyzeTrack(track, TrackAnalysisScheduler::Priority::Preview);
+}
+
+void PlayerManager::analyzeTrack(
+        const TrackPointer& track, TrackAnalysisScheduler::Priority priority) {
     VERIFY_OR_DEBUG_ASSERT(track) {
         return;
     }
     if (m_pTrackAnalysisScheduler) {
-        if (m_pTrackAnalysisScheduler->scheduleTrackById(track->getId())) {
+        if (m_pTrackAnalysisScheduler->scheduleTrackById(track->getId(), priority)) {
             m_pTrackAnalysisScheduler->resume();
         }
         // The first progress signal will suspend a running batch analysis
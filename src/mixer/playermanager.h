@@ -201,7 +201,9 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
     void slotChangeNumAuxiliaries(double v);
 
   private slots:
+    // Tracks loaded into decks are analyzed first
     void slotAnalyzeTrack(TrackPointer track);
+    void slotAnalyzePreviewTrack(TrackPointer track);
 
     void onTrackAnalysisProgress(TrackId trackId, AnalyzerProgress analyzerProgress);
     void onTrackAnalysisFinished();
@@ -233,6 +235,7 @@ class PlayerManager : public QObject, public PlayerManagerInterface {
 
   private:
     TrackPointer lookupTrack(QString location);
+    void analyzeTrack(const TrackPointer& track, TrackAnalysisScheduler::Priority priority);
     // Must hold m_mutex before calling this method. Internal method that
     // creates a new deck.
     void addDeckInner();
@@ -16,6 +16,7 @@ class AudioOutputBuffer;
 class AudioInputBuffer;
 
 const QString kNetworkDeviceInternalName = "Network stream";
+const QString kOfflineDeviceInternalName = "Offline render";
 
 class SoundDevice {
   public:
@@ -11,6 +11,7 @@
 #include "util/performancetimer.h"
 #include "util/memory.h"
 #include "soundio/sounddevice.h"
+#include "engine/engineprofiler.h"
 #include "engine/sidechain/networkoutputstreamworker.h"
 
 #define CPU_USAGE_UPDATE_RATE 30 // in 1/s, fits to display frame rate
@@ -94,10 +95,13 @@ class SoundDeviceNetworkThread : public QThread {
             qWarning() << "SoundDeviceNetworkThread: Failed bumping priority";
         }
 #endif
+        EngineProfiler::registerThread();
 
         while(!m_stop) {
             m_pParent->callbackProcessClkRef();
         }
+
+        EngineProfiler::unregisterThread();
     }
     SoundDeviceNetwork* m_pParent;
     bool m_stop;
@@ -0,0 +1,220 @@
+#include "soundio/sounddeviceoffline.h"
+
+#include <QCoreApplication>
+#include <QtDebug>
+
+#include "control/controlobject.h"
+#include "engine/engineprofiler.h"
+#include "moc_sounddeviceoffline.cpp"
+#include "soundio/soundmanager.h"
+#include "util/denormalsarezero.h"
+#include "util/logger.h"
+#include "util/sample.h"
+
+namespace {
+
+const mixxx::Logger kLogger("SoundDeviceOffline");
+
+constexpr int kNumOutputChannels = 2;
+
+} // anonymous namespace
+
+SoundDeviceOffline::SoundDeviceOffline(UserSettingsPointer config,
+        SoundManager* sm,
+        const QString& filePath,
+        double durationSeconds)
+        : SoundDevice(config, sm),
+          m_durationSeconds(durationSeconds),
+          m_file(filePath),
+          m_outputBuffer(0),
+          m_pMainThreadSyncCounter(QSharedPointer<std::atomic<int>>::create(0)),
+          m_mainThreadSyncRequests(0),
+          m_framesRendered(0) {
+    // Setting parent class members:
+    m_hostAPI = kOfflineDeviceInternalName;
+    m_dSampleRate = 44100.0;
+    m_deviceId.name = kOfflineDeviceInternalName;
+    m_strDisplayName = QObject::tr("Offline render");
+    m_iNumInputChannels = 0;
+    m_iNumOutputChannels = kNumOutputChannels;
+}
+
+SoundDeviceOffline::~SoundDeviceOffline() {
+    close();
+}
+
+SoundDeviceError SoundDeviceOffline::open(bool isClkRefDevice, int syncBuffers) {
+    Q_UNUSED(syncBuffers);
+    VERIFY_OR_DEBUG_ASSERT(isClkRefDevice) {
+        m_lastError = QStringLiteral("The offline render device must be the clock reference");
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+    if (m_dSampleRate <= 0) {
+        m_dSampleRate = 44100.0;
+    }
+
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        m_lastError = m_file.errorString();
+        kLogger.warning() << "Could not open" << m_file.fileName() << m_lastError;
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    // Use the same encoder as EngineRecord
+    const Encoder::Format format =
+            EncoderFactory::getFactory().getSelectedFormat(m_pConfig);
+    m_pEncoder = EncoderFactory::getFactory().createRecordingEncoder(
+            format, m_pConfig, this);
+    QString userErrorMessage;
+    if (!m_pEncoder ||
+            m_pEncoder->initEncoder(mixxx::audio::SampleRate::fromDouble(m_dSampleRate),
+                    &userErrorMessage) < 0) {
+        m_lastError = userErrorMessage;
+        kLogger.warning() << "Could not initialize the" << format.label
+                          << "encoder" << m_lastError;
+        m_pEncoder.reset();
+        m_file.close();
+        return SOUNDDEVICE_ERROR_ERR;
+    }
+
+    m_outputBuffer = mixxx::SampleBuffer(m_framesPerBuffer * m_iNumOutputChannels);
+
+    // Update the samplerate and latency ControlObjects, which allow the
+    // waveform view to properly correct for the latency.
+    const double bufferMillis = m_framesPerBuffer / m_dSampleRate * 1000;
+    ControlObject::set(ConfigKey("[Master]", "latency"), bufferMillis);
+    ControlObject::set(ConfigKey("[Master]", "samplerate"), m_dSampleRate);
+    ControlObject::set(ConfigKey("[Master]", "audio_buffer_size"), bufferMillis);
+
+    kLogger.info() << "Rendering" << format.label << "to" << m_file.fileName()
+                   << "with" << m_framesPerBuffer << "frames per buffer at"
+                   << m_dSampleRate << "Hz";
+
+    m_framesRendered = 0;
+    m_renderTimer.start();
+    m_pThread = std::make_unique<SoundDeviceOfflineThread>(this);
+    m_pThread->start(QThread::HighPriority);
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+bool SoundDeviceOffline::isOpen() const {
+    return m_pThread != nullptr;
+}
+
+SoundDeviceError SoundDeviceOffline::close() {
+    if (!m_pThread) {
+        return SOUNDDEVICE_ERROR_OK;
+    }
+    m_pThread->stop();
+    m_pThread->wait();
+    m_pThread.reset();
+
+    m_pEncoder->flush();
+    m_pEncoder.reset();
+    m_file.close();
+
+    const double renderedSeconds = m_framesRendered / m_dSampleRate;
+    const double elapsedSeconds = m_renderTimer.elapsed().toDoubleSeconds();
+    kLogger.info() << "Rendered" << renderedSeconds << "s in" << elapsedSeconds
+                   << "s, realtime factor"
+                   << (elapsedSeconds > 0 ? renderedSeconds / elapsedSeconds : 0.0);
+    return SOUNDDEVICE_ERROR_OK;
+}
+
+QString SoundDeviceOffline::getError() const {
+    return m_lastError;
+}
+
+void SoundDeviceOffline::readProcess() {
+    // No inputs
+}
+
+void SoundDeviceOffline::writeProcess() {
+    if (!m_pEncoder) {
+        return;
+    }
+    composeOutputBuffer(m_outputBuffer.data(),
+            m_framesPerBuffer,
+            0,
+            m_iNumOutputChannels);
+    m_pEncoder->encodeBuffer(m_outputBuffer.data(),
+            static_cast<int>(m_outputBuffer.size()));
+}
+
+bool SoundDeviceOffline::callbackProcessClkRef() {
+    m_pSoundManager->readProcess();
+    m_pSoundManager->onDeviceOutputCallback(m_framesPerBuffer);
+    m_pSoundManager->writeProcess();
+    m_pSoundManager->processUnderflowHappened();
+
+    m_framesRendered += m_framesPerBuffer;
+    if (m_durationSeconds > 0 &&
+            m_framesRendered >= m_durationSeconds * m_dSampleRate) {
+        kLogger.info() << "Requested duration has been rendered, quitting";
+        QMetaObject::invokeMethod(
+                QCoreApplication::instance(),
+                [] { QCoreApplication::quit(); },
+                Qt::QueuedConnection);
+        return false;
+    }
+
+    m_pSoundManager->waitForEngineWorkers();
+    waitForMainThread();
+    return true;
+}
+
+void SoundDeviceOffline::waitForMainThread() {
+    const int request = ++m_mainThreadSyncRequests;
+    // Events are processed in order, so all events that have been posted
+    // to the main thread by the previous callback are processed before
+    // this one.
+    QSharedPointer<std::atomic<int>> pCounter = m_pMainThreadSyncCounter;
+    QMetaObject::invokeMethod(
+            QCoreApplication::instance(),
+            [pCounter, request] { pCounter->store(request); },
+            Qt::QueuedConnection);
+    // Don't block forever, the main thread might be waiting for us in close()
+    while (m_pMainThreadSyncCounter->load() != request &&
+            !m_pThread->isStopping()) {
+        QThread::usleep(50);
+    }
+}
+
+void SoundDeviceOffline::write(const unsigned char* header,
+        const unsigned char* body,
+        int headerLen,
+        int bodyLen) {
+    // Relevant for OGG
+    if (headerLen > 0) {
+        m_file.write(reinterpret_cast<const char*>(header), headerLen);
+    }
+    // Always write body
+    m_file.write(reinterpret_cast<const char*>(body), bodyLen);
+}
+
+int SoundDeviceOffline::tell() {
+    return static_cast<int>(m_file.pos());
+}
+
+void SoundDeviceOffline::seek(int pos) {
+    m_file.seek(static_cast<qint64>(pos));
+}
+
+int SoundDeviceOffline::filelen() {
+    return static_cast<int>(m_file.size());
+}
+
+void SoundDeviceOfflineThread::run() {
+#ifdef __SSE__
+    // This disables the denormals calculations like in the real-time
+    // audio threads
+    _MM_SET_DENORMALS_ZERO_MODE(_MM_DENORMALS_ZERO_ON);
+    _MM_SET_FLUSH_ZERO_MODE(_MM_FLUSH_ZERO_ON);
+#endif
+    EngineProfiler::registerThread();
+    while (!m_stop.load()) {
+        if (!m_pParent->callbackProcessClkRef()) {
+            break;
+        }
+    }
+    EngineProfiler::unregisterThread();
+}
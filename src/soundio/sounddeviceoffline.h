@@ -0,0 +1,99 @@
+#pragma once
+
+#include <QFile>
+#include <QSharedPointer>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+#include "encoder/encoder.h"
+#include "encoder/encodercallback.h"
+#include "soundio/sounddevice.h"
+#include "util/duration.h"
+#include "util/performancetimer.h"
+#include "util/samplebuffer.h"
+
+class SoundDeviceOfflineThread;
+
+// A sound device without audio hardware that renders the master output into
+// a file as fast as the CPU allows. It is only created when Mixxx is started
+// with --render-offline and replaces all configured sound devices.
+//
+// After each callback the device waits until the engine workers are idle,
+// i.e. until all chunks that the decks have requested are read, and until
+// the main thread has processed its pending events, so that controls
+// that are updated from the main thread, e.g. by AutoDJ or controller
+// scripts, are not lagging behind the rendered audio.
+class SoundDeviceOffline : public SoundDevice, public EncoderCallback {
+  public:
+    SoundDeviceOffline(UserSettingsPointer config,
+            SoundManager* sm,
+            const QString& filePath,
+            double durationSeconds);
+    ~SoundDeviceOffline() override;
+
+    SoundDeviceError open(bool isClkRefDevice, int syncBuffers) override;
+    bool isOpen() const override;
+    SoundDeviceError close() override;
+    void readProcess() override;
+    void writeProcess() override;
+    QString getError() const override;
+
+    unsigned int getDefaultSampleRate() const override {
+        return 44100;
+    }
+
+    // Returns false after the requested duration has been rendered
+    bool callbackProcessClkRef();
+
+    // EncoderCallback
+    void write(const unsigned char* header,
+            const unsigned char* body,
+            int headerLen,
+            int bodyLen) override;
+    int tell() override;
+    void seek(int pos) override;
+    int filelen() override;
+
+  private:
+    void waitForMainThread();
+
+    const double m_durationSeconds;
+    QFile m_file;
+    EncoderPointer m_pEncoder;
+    QString m_lastError;
+    mixxx::SampleBuffer m_outputBuffer;
+    std::unique_ptr<SoundDeviceOfflineThread> m_pThread;
+
+    // Shared with the events that are posted to the main thread, which
+    // might be processed after this device has been deleted.
+    QSharedPointer<std::atomic<int>> m_pMainThreadSyncCounter;
+    int m_mainThreadSyncRequests;
+
+    qint64 m_framesRendered;
+    PerformanceTimer m_renderTimer;
+};
+
+class SoundDeviceOfflineThread : public QThread {
+    Q_OBJECT
+  public:
+    explicit SoundDeviceOfflineThread(SoundDeviceOffline* pParent)
+            : m_pParent(pParent),
+              m_stop(false) {
+    }
+
+    void stop() {
+        m_stop.store(true);
+    }
+
+    bool isStopping() const {
+        return m_stop.load();
+    }
+
+  private:
+    void run() override;
+
+    SoundDeviceOffline* m_pParent;
+    std::atomic<bool> m_stop;
+};
@@ -8,6 +8,7 @@
 
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
+#include "engine/engineprofiler.h"
 #include "soundio/sounddevice.h"
 #include "soundio/soundmanager.h"
 #include "soundio/soundmanagerutil.h"
@@ -87,6 +88,7 @@ SoundDevicePortAudio::SoundDevicePortAudio(UserSettingsPointer config,
           m_outputDrift(false),
           m_inputDrift(false),
           m_bSetThreadPriority(false),
+          m_profilerThreadSlot(-1),
           m_framesSinceAudioLatencyUsageUpdate(0),
           m_syncBuffers(2),
           m_invalidTimeInfoCount(0),
@@ -389,6 +391,7 @@ SoundDeviceError SoundDevicePortAudio::close() {
         // 1 means the stream is stopped. 0 means active.
         if (err == 1) {
             //qDebug() << "PortAudio: Stream already stopped, but no error.";
+            releaseProfilerThreadSlot();
             return SOUNDDEVICE_ERROR_OK;
         }
         // Real PaErrors are always negative.
@@ -413,6 +416,7 @@ SoundDeviceError SoundDevicePortAudio::close() {
                        << Pa_GetErrorText(err) << m_deviceId;
             return SOUNDDEVICE_ERROR_ERR;
         }
+        releaseProfilerThreadSlot();
 
         // Close stream
         err = Pa_CloseStream(pStream);
@@ -437,6 +441,13 @@ SoundDeviceError SoundDevicePortAudio::close() {
     return SOUNDDEVICE_ERROR_OK;
 }
 
+void SoundDevicePortAudio::releaseProfilerThreadSlot() {
+    // Only called after the stream has been stopped, so the callback
+    // thread doesn't record anymore
+    EngineProfiler::unregisterThread(m_profilerThreadSlot);
+    m_profilerThreadSlot = -1;
+}
+
 QString SoundDevicePortAudio::getError() const {
     return m_lastError;
 }
@@ -878,6 +889,7 @@ int SoundDevicePortAudio::callbackProcessClkRef(
     if (!m_bSetThreadPriority) {
         QThread::currentThread()->setPriority(QThread::TimeCriticalPriority);
         m_bSetThreadPriority = true;
+        m_profilerThreadSlot = EngineProfiler::registerThread();
 
 
 #ifdef __SSE__
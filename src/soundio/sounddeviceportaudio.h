@@ -52,6 +52,7 @@ class SoundDevicePortAudio : public SoundDevice {
   private:
     void updateCallbackEntryToDacTime(const PaStreamCallbackTimeInfo* timeInfo);
     void updateAudioLatencyUsage(const SINT framesPerBuffer);
+    void releaseProfilerThreadSlot();
 
     // PortAudio stream for this device.
     PaStream* volatile m_pStream;
@@ -72,6 +73,8 @@ class SoundDevicePortAudio : public SoundDevice {
     QString m_lastError;
     // Whether we have set the thread priority to realtime or not.
     bool m_bSetThreadPriority;
+    // The EngineProfiler slot of the callback thread, released on close()
+    int m_profilerThreadSlot;
     ControlProxy* m_pMasterAudioLatencyUsage;
     mixxx::Duration m_timeInAudioCallback;
     int m_framesSinceAudioLatencyUsageUpdate;
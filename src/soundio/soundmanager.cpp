@@ -17,6 +17,7 @@
 #include "soundio/sounddevice.h"
 #include "soundio/sounddevicenetwork.h"
 #include "soundio/sounddevicenotfound.h"
+#include "soundio/sounddeviceoffline.h"
 #include "soundio/sounddeviceportaudio.h"
 #include "soundio/soundmanagerutil.h"
 #include "util/cmdlineargs.h"
@@ -319,6 +320,13 @@ void SoundManager::queryDevicesMixxx() {
     auto currentDevice = SoundDevicePointer(new SoundDeviceNetwork(
             m_pConfig, this, m_pNetworkStream));
     m_devices.append(currentDevice);
+
+    if (CmdlineArgs::Instance().getRenderOfflineEnabled()) {
+        m_devices.append(SoundDevicePointer(new SoundDeviceOffline(m_pConfig,
+                this,
+                CmdlineArgs::Instance().getRenderOfflinePath(),
+                CmdlineArgs::Instance().getRenderDuration())));
+    }
 }
 
 SoundDeviceError SoundManager::setupDevices() {
@@ -361,6 +369,13 @@ SoundDeviceError SoundManager::setupDevices() {
     // all found devices are removed below
     QSet<SoundDeviceId> devicesNotFound = m_config.getDevices();
 
+    // When rendering offline, the configured devices are neither opened
+    // nor reported as missing
+    const bool renderOffline = CmdlineArgs::Instance().getRenderOfflineEnabled();
+    if (renderOffline) {
+        devicesNotFound.clear();
+    }
+
     // pair is isInput, isOutput
     QVector<DeviceMode> toOpen;
     bool haveOutput = false;
@@ -369,6 +384,28 @@ SoundDeviceError SoundManager::setupDevices() {
         DeviceMode mode = {pDevice, false, false};
         pDevice->clearInputs();
         pDevice->clearOutputs();
+        if (renderOffline) {
+            if (pDevice->getDeviceId().name != kOfflineDeviceInternalName) {
+                continue;
+            }
+            m_pErrorDevice = pDevice;
+            // Statically connect the master output to the offline device,
+            // which is the only device and therefore the clock reference
+            const AudioOutput out(AudioPath::MASTER, 0, 2, 0);
+            const CSAMPLE* pBuffer = m_registeredSources.value(out)->buffer(out);
+            err = pDevice->addOutput(AudioOutputBuffer(out, pBuffer));
+            if (err != SOUNDDEVICE_ERROR_OK) {
+                goto closeAndError;
+            }
+            m_registeredSources.value(out)->onOutputConnected(out);
+            mode.isOutput = true;
+            haveOutput = true;
+            pNewMasterClockRef = pDevice;
+            pDevice->setSampleRate(m_config.getSampleRate());
+            pDevice->setFramesPerBuffer(m_config.getFramesPerBuffer());
+            toOpen.append(mode);
+            continue;
+        }
         m_pErrorDevice = pDevice;
         const auto inputs = m_config.getInputs().values(pDevice->getDeviceId());
         for (const auto& in : inputs) {
@@ -596,6 +633,10 @@ void SoundManager::onDeviceOutputCallback(const SINT iFramesPerBuffer) {
     m_pMaster->process(iFramesPerBuffer * 2);
 }
 
+void SoundManager::waitForEngineWorkers() {
+    m_pMaster->waitForIdleWorkers();
+}
+
 void SoundManager::pushInputBuffers(const QList<AudioInputBuffer>& inputs,
                                     const SINT iFramesPerBuffer) {
    for (QList<AudioInputBuffer>::ConstIterator i = inputs.begin(),
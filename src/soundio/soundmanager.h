@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "audio/types.h"
+#include "engine/engineprofiler.h"
 #include "engine/sidechain/enginenetworkstream.h"
 #include "preferences/usersettings.h"
 #include "soundio/sounddevice.h"
@@ -79,6 +80,9 @@ class SoundManager : public QObject {
     void checkConfig();
 
     void onDeviceOutputCallback(const SINT iFramesPerBuffer);
+    // Used by SoundDeviceOffline to wait for the background work of the
+    // engine after each callback.
+    void waitForEngineWorkers();
 
     // Used by SoundDevices to "push" any audio from their inputs that they have
     // into the mixing engine.
@@ -100,6 +104,7 @@ class SoundManager : public QObject {
 
     void underflowHappened(int code) {
         m_underflowHappened = 1;
+        EngineProfiler::recordXrun();
         // Disable the engine warnings by default, because printing a warning is a
         // locking function that will make the problem worse
         if (CmdlineArgs::Instance().getDeveloper()) {
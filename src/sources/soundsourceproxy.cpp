@@ -550,6 +550,46 @@ inline bool shouldImportSeratoTagsFromSource(
             pConfig->getValue<bool>(mixxx::library::prefs::kSyncSeratoMetadataConfigKey);
 }
 
+/// Ensures that all tracks have a title
+void parseMissingArtistTitleFromFileName(
+        mixxx::TrackMetadata* pTrackMetadata,
+        std::pair<mixxx::MetadataSource::ImportResult, QDateTime>* pMetadataImportedFromSource,
+        const mixxx::FileInfo& fileInfo) {
+    if (!pTrackMetadata->getTrackInfo().getTitle().trimmed().isEmpty()) {
+        return;
+    }
+    // Only parse artist and title if both fields are empty to avoid
+    // inconsistencies. Otherwise the file name (without extension)
+    // is used as the title and the artist is unmodified.
+    //
+    // TODO(XXX): Disable splitting of artist/title in settings, i.e.
+    // optionally don't split even if both title and artist are empty?
+    // Some users might want to import the whole file name of untagged
+    // files as the title without splitting the artist:
+    //     https://www.mixxx.org/forums/viewtopic.php?f=3&t=12838
+    // NOTE(uklotzde, 2019-09-26): Whoever needs this should simply set
+    // splitArtistTitle = false here and compile their custom version!
+    // It is not worth extending the settings and injecting them into
+    // SoundSourceProxy for just a few people.
+    const bool splitArtistTitle =
+            pTrackMetadata->getTrackInfo().getArtist().trimmed().isEmpty();
+    kLogger.info()
+            << "Parsing missing"
+            << (splitArtistTitle ? "artist/title" : "title")
+            << "from file name:"
+            << fileInfo;
+    if (pTrackMetadata->refTrackInfo().parseArtistTitleFromFileName(
+                fileInfo.fileName(), splitArtistTitle)) {
+        // Pretend that metadata import succeeded
+        pMetadataImportedFromSource->first = mixxx::MetadataSource::ImportResult::Succeeded;
+        if (pMetadataImportedFromSource->second.isNull()) {
+            // Since this is also some kind of metadata import, we mark the
+            // track's metadata as synchronized with the time stamp of the file.
+            pMetadataImportedFromSource->second = fileInfo.lastModified();
+        }
+    }
+}
+
 } // namespace
 
 bool SoundSourceProxy::updateTrackFromSource(
@@ -693,39 +733,10 @@ bool SoundSourceProxy::updateTrackFromSource(
     }
 
     // Ensure that all tracks have a title
-    if (trackMetadata.getTrackInfo().getTitle().trimmed().isEmpty()) {
-        // Only parse artist and title if both fields are empty to avoid
-        // inconsistencies. Otherwise the file name (without extension)
-        // is used as the title and the artist is unmodified.
-        //
-        // TODO(XXX): Disable splitting of artist/title in settings, i.e.
-        // optionally don't split even if both title and artist are empty?
-        // Some users might want to import the whole file name of untagged
-        // files as the title without splitting the artist:
-        //     https://www.mixxx.org/forums/viewtopic.php?f=3&t=12838
-        // NOTE(uklotzde, 2019-09-26): Whoever needs this should simply set
-        // splitArtistTitle = false here and compile their custom version!
-        // It is not worth extending the settings and injecting them into
-        // SoundSourceProxy for just a few people.
-        const bool splitArtistTitle =
-                trackMetadata.getTrackInfo().getArtist().trimmed().isEmpty();
-        const auto fileInfo = m_pTrack->getFileInfo();
-        kLogger.info()
-                << "Parsing missing"
-                << (splitArtistTitle ? "artist/title" : "title")
-                << "from file name:"
-                << fileInfo;
-        if (trackMetadata.refTrackInfo().parseArtistTitleFromFileName(
-                    fileInfo.fileName(), splitArtistTitle)) {
-            // Pretend that metadata import succeeded
-            metadataImportedFromSource.first = mixxx::MetadataSource::ImportResult::Succeeded;
-            if (metadataImportedFromSource.second.isNull()) {
-                // Since this is also some kind of metadata import, we mark the
-                // track's metadata as synchronized with the time stamp of the file.
-                metadataImportedFromSource.second = fileInfo.lastModified();
-            }
-        }
-    }
+    parseMissingArtistTitleFromFileName(
+            &trackMetadata,
+            &metadataImportedFromSource,
+            m_pTrack->getFileInfo());
 
     // Do not continue with unknown and maybe invalid metadata!
     if (metadataImportedFromSource.first != mixxx::MetadataSource::ImportResult::Succeeded) {
@@ -736,24 +747,7 @@ bool SoundSourceProxy::updateTrackFromSource(
             std::move(trackMetadata),
             metadataImportedFromSource.second);
 
-    const bool pendingBeatsImport =
-            m_pTrack->getBeatsImportStatus() == Track::ImportStatus::Pending;
-    const bool pendingCueImport =
-            m_pTrack->getCueImportStatus() == Track::ImportStatus::Pending;
-    if (pendingBeatsImport || pendingCueImport) {
-        // Try to open the audio source once to determine the actual
-        // stream properties for finishing the pending import.
-        kLogger.debug()
-                << "Opening audio source to finish import of beats/cues";
-        const auto pAudioSource = openAudioSource();
-        Q_UNUSED(pAudioSource); // only used in debug assertion
-        DEBUG_ASSERT(!pAudioSource ||
-                m_pTrack->getBeatsImportStatus() ==
-                        Track::ImportStatus::Complete);
-        DEBUG_ASSERT(!pAudioSource ||
-                m_pTrack->getCueImportStatus() ==
-                        Track::ImportStatus::Complete);
-    }
+    finishPendingBeatsAndCuesImport();
 
     if (pCoverImg) {
         // If the pointer is not null then the cover art should be guessed
@@ -769,6 +763,116 @@ bool SoundSourceProxy::updateTrackFromSource(
     return true;
 }
 
+void SoundSourceProxy::finishPendingBeatsAndCuesImport() {
+    const bool pendingBeatsImport =
+            m_pTrack->getBeatsImportStatus() == Track::ImportStatus::Pending;
+    const bool pendingCueImport =
+            m_pTrack->getCueImportStatus() == Track::ImportStatus::Pending;
+    if (!pendingBeatsImport && !pendingCueImport) {
+        return;
+    }
+    // Try to open the audio source once to determine the actual
+    // stream properties for finishing the pending import.
+    kLogger.debug()
+            << "Opening audio source to finish import of beats/cues";
+    const auto pAudioSource = openAudioSource();
+    Q_UNUSED(pAudioSource); // only used in debug assertion
+    DEBUG_ASSERT(!pAudioSource ||
+            m_pTrack->getBeatsImportStatus() ==
+                    Track::ImportStatus::Complete);
+    DEBUG_ASSERT(!pAudioSource ||
+            m_pTrack->getCueImportStatus() ==
+                    Track::ImportStatus::Complete);
+}
+
+//static
+SoundSourceProxy::NewTrackImport SoundSourceProxy::importNewTrackFromFile(
+        const mixxx::FileAccess& trackFileAccess,
+        CoverInfoGuesser* pCoverInfoGuesser) {
+    DEBUG_ASSERT(pCoverInfoGuesser);
+    NewTrackImport newTrackImport;
+    if (!trackFileAccess.info().checkFileExists()) {
+        return newTrackImport;
+    }
+    TrackPointer pCachedTrack;
+    {
+        GlobalTrackCacheLocker locker;
+        pCachedTrack = locker.lookupTrackByRef(
+                TrackRef::fromFileInfo(trackFileAccess.info()));
+    }
+    if (pCachedTrack) {
+        // The metadata of cached track objects might be exported
+        // concurrently. Those need to be updated while keeping the
+        // GlobalTrackCache locked.
+        return newTrackImport;
+    }
+    // No one else is accessing the file and there is no need to lock
+    // the GlobalTrackCache while parsing, which would serialize all
+    // imports.
+    const auto pTrack = Track::newTemporary(trackFileAccess);
+    const SoundSourceProxy proxy(pTrack);
+    // Start with the defaults of a new track object like
+    // updateTrackFromSource() does
+    newTrackImport.trackMetadata = pTrack->getMetadata();
+    QImage coverImg;
+    auto metadataImportedFromSource =
+            proxy.importTrackMetadataAndCoverImage(
+                    &newTrackImport.trackMetadata,
+                    &coverImg);
+    if (metadataImportedFromSource.first ==
+            mixxx::MetadataSource::ImportResult::Failed) {
+        // Let updateTrackFromSource() handle and report the failure
+        return newTrackImport;
+    }
+    parseMissingArtistTitleFromFileName(
+            &newTrackImport.trackMetadata,
+            &metadataImportedFromSource,
+            trackFileAccess.info());
+    if (metadataImportedFromSource.first !=
+            mixxx::MetadataSource::ImportResult::Succeeded) {
+        return newTrackImport;
+    }
+    newTrackImport.result = metadataImportedFromSource.first;
+    newTrackImport.sourceSynchronizedAt = metadataImportedFromSource.second;
+    newTrackImport.coverInfo = pCoverInfoGuesser->guessCoverInfo(
+            trackFileAccess.info(),
+            newTrackImport.trackMetadata.getAlbumInfo().getTitle(),
+            coverImg);
+    DEBUG_ASSERT(newTrackImport.coverInfo.source == CoverInfo::GUESSED);
+    return newTrackImport;
+}
+
+bool SoundSourceProxy::updateNewTrackFromImport(
+        const UserSettingsPointer& pConfig,
+        NewTrackImport newTrackImport) {
+    DEBUG_ASSERT(m_pTrack);
+    if (newTrackImport.result != mixxx::MetadataSource::ImportResult::Succeeded ||
+            getUrl().isEmpty() || !m_pSoundSource) {
+        return updateTrackFromSource(pConfig, UpdateTrackFromSourceMode::Once);
+    }
+    mixxx::TrackRecord::SourceSyncStatus sourceSyncStatus;
+    m_pTrack->getMetadata(&sourceSyncStatus);
+    if (sourceSyncStatus != mixxx::TrackRecord::SourceSyncStatus::Void) {
+        // The track object has been initialized from the file in the meantime
+        return updateTrackFromSource(pConfig, UpdateTrackFromSourceMode::Once);
+    }
+
+    // The SoundSource provides the actual type of the corresponding file
+    m_pTrack->setType(m_pSoundSource->getType());
+    m_pTrack->replaceMetadataFromSource(
+            std::move(newTrackImport.trackMetadata),
+            newTrackImport.sourceSynchronizedAt);
+    finishPendingBeatsAndCuesImport();
+
+    // Avoid replacing user selected cover art with guessed cover art!
+    const auto coverInfo = m_pTrack->getCoverInfo();
+    if (coverInfo.source != CoverInfo::USER_SELECTED ||
+            coverInfo.type != CoverInfo::FILE) {
+        m_pTrack->setCoverInfo(newTrackImport.coverInfo);
+    }
+    return true;
+}
+
 mixxx::AudioSourcePointer SoundSourceProxy::openAudioSource(
         const mixxx::AudioSource::OpenParams& params) {
     auto openMode = mixxx::SoundSource::OpenMode::Strict;
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <QDateTime>
+
+#include "library/coverart.h"
 #include "preferences/usersettings.h"
 #include "sources/soundsourceproviderregistry.h"
 #include "track/track_decl.h"
+#include "track/trackmetadata.h"
 #include "util/sandbox.h"
 
 namespace mixxx {
@@ -11,6 +15,8 @@ class FileAccess;
 
 } // namespace mixxx
 
+class CoverInfoGuesser;
+
 /// Creates sound sources for tracks. Only intended to be used
 /// in a narrow scope and not shareable between multiple threads!
 class SoundSourceProxy {
@@ -152,6 +158,39 @@ class SoundSourceProxy {
             const UserSettingsPointer& pConfig,
             UpdateTrackFromSourceMode mode);
 
+    /// Track metadata and guessed cover art of a file that have been
+    /// imported in advance by importNewTrackFromFile().
+    struct NewTrackImport {
+        mixxx::MetadataSource::ImportResult result =
+                mixxx::MetadataSource::ImportResult::Unavailable;
+        QDateTime sourceSynchronizedAt;
+        mixxx::TrackMetadata trackMetadata;
+        CoverInfoRelative coverInfo;
+    };
+
+    /// Parses the track metadata and guesses the cover art of a file that
+    /// has not been added to the library yet. This is the expensive part
+    /// of updateTrackFromSource() for a newly created track object.
+    ///
+    /// This function is thread-safe and allows to parse many files in
+    /// parallel, e.g. while scanning the library. The import is skipped
+    /// and the result is unavailable if the file is already referenced
+    /// by a cached track object.
+    static NewTrackImport importNewTrackFromFile(
+            const mixxx::FileAccess& trackFileAccess,
+            CoverInfoGuesser* pCoverInfoGuesser);
+
+    /// Variant of updateTrackFromSource() with mode Once that applies
+    /// the results of importNewTrackFromFile() instead of parsing the
+    /// file again.
+    ///
+    /// Falls back to updateTrackFromSource() if the import did not succeed
+    /// or if the track object has already been initialized from the file
+    /// in the meantime.
+    bool updateNewTrackFromImport(
+            const UserSettingsPointer& pConfig,
+            NewTrackImport newTrackImport);
+
     /// Opening the audio source through the proxy will update the
     /// audio properties of the corresponding track object. Returns
     /// a null pointer on failure.
@@ -197,6 +236,8 @@ class SoundSourceProxy {
     // provider and is initialized with -1 if no
     int m_providerRegistrationIndex;
 
+    void finishPendingBeatsAndCuesImport();
+
     void initSoundSource(
             const mixxx::SoundSourceProviderPointer& pProvider);
 
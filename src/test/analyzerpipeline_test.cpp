@@ -0,0 +1,201 @@
+#include "analyzer/analyzerpipeline.h"
+
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr SINT kSamplesPerBlock = 64;
+constexpr int kNumBlocks = 4;
+
+// Records the first sample of each block and the thread it was
+// processed on.
+class RecordingAnalyzer : public Analyzer {
+  public:
+    explicit RecordingAnalyzer(int failAfterBlocks = -1)
+            : m_failAfterBlocks(failAfterBlocks),
+              m_cleanedUp(false),
+              m_thread(nullptr) {
+    }
+
+    bool initialize(TrackPointer, mixxx::audio::SampleRate, int) override {
+        return true;
+    }
+
+    bool processSamples(const CSAMPLE* pIn, const int iLen) override {
+        EXPECT_EQ(kSamplesPerBlock, iLen);
+        m_thread = QThread::currentThread();
+        m_firstSamples.push_back(pIn[0]);
+        // Give the producer a chance to run ahead
+        QThread::yieldCurrentThread();
+        return m_failAfterBlocks < 0 ||
+                static_cast<int>(m_firstSamples.size()) < m_failAfterBlocks;
+    }
+
+    void storeResults(TrackPointer) override {
+    }
+
+    void cleanup() override {
+        m_cleanedUp = true;
+    }
+
+    const int m_failAfterBlocks;
+    std::vector<CSAMPLE> m_firstSamples;
+    bool m_cleanedUp;
+    QThread* m_thread;
+};
+
+class AnalyzerPipelineTest : public testing::Test {
+  protected:
+    RecordingAnalyzer* addAnalyzer(int failAfterBlocks = -1) {
+        auto pAnalyzer = std::make_unique<RecordingAnalyzer>(failAfterBlocks);
+        RecordingAnalyzer* pRecordingAnalyzer = pAnalyzer.get();
+        m_analyzers.emplace_back(std::move(pAnalyzer));
+        return pRecordingAnalyzer;
+    }
+
+    // Must be invoked after all analyzers have been added
+    std::unique_ptr<AnalyzerPipeline> startPipeline() {
+        for (auto& analyzer : m_analyzers) {
+            analyzer.initialize(TrackPointer(), mixxx::audio::SampleRate(44100), 0);
+        }
+        return std::make_unique<AnalyzerPipeline>(
+                &m_analyzers, kNumBlocks, kSamplesPerBlock);
+    }
+
+    void publishBlocks(AnalyzerPipeline* pPipeline, int numBlocks) {
+        for (int i = 0; i < numBlocks; ++i) {
+            auto block = pPipeline->nextWritableBlock();
+            ASSERT_LE(kSamplesPerBlock, block.length());
+            for (SINT j = 0; j < kSamplesPerBlock; ++j) {
+                block[j] = static_cast<CSAMPLE>(i);
+            }
+            pPipeline->publishBlock(block.data(), kSamplesPerBlock);
+        }
+    }
+
+    void TearDown() override {
+        for (auto& analyzer : m_analyzers) {
+            analyzer.cancel();
+        }
+    }
+
+    std::vector<AnalyzerWithState> m_analyzers;
+};
+
+TEST_F(AnalyzerPipelineTest, AllAnalyzersConsumeAllBlocksInOrder) {
+    std::vector<RecordingAnalyzer*> recordingAnalyzers;
+    for (int i = 0; i < 3; ++i) {
+        recordingAnalyzers.push_back(addAnalyzer());
+    }
+    const auto pPipeline = startPipeline();
+
+    // More blocks than the ring can hold
+    constexpr int kPublishedBlocks = 10 * kNumBlocks;
+    publishBlocks(pPipeline.get(), kPublishedBlocks);
+    pPipeline->drain();
+
+    for (const auto* pAnalyzer : recordingAnalyzers) {
+        ASSERT_EQ(static_cast<size_t>(kPublishedBlocks), pAnalyzer->m_firstSamples.size());
+        for (int i = 0; i < kPublishedBlocks; ++i) {
+            EXPECT_EQ(static_cast<CSAMPLE>(i), pAnalyzer->m_firstSamples[i]);
+        }
+        EXPECT_NE(QThread::currentThread(), pAnalyzer->m_thread);
+    }
+    if (pPipeline->numStages() > 1) {
+        // The first analyzers run on their own threads
+        EXPECT_NE(recordingAnalyzers[0]->m_thread, recordingAnalyzers[1]->m_thread);
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, LimitsTotalNumberOfStageThreads) {
+    const int maxStageThreads = AnalyzerPipeline::maxStageThreads();
+    std::vector<RecordingAnalyzer*> recordingAnalyzers;
+    for (int i = 0; i < maxStageThreads + 1; ++i) {
+        recordingAnalyzers.push_back(addAnalyzer());
+    }
+    const auto pPipeline = startPipeline();
+    EXPECT_EQ(maxStageThreads, pPipeline->numStages());
+
+    // No more threads left for another pipeline
+    std::vector<AnalyzerWithState> otherAnalyzers;
+    otherAnalyzers.emplace_back(std::make_unique<RecordingAnalyzer>());
+    otherAnalyzers.emplace_back(std::make_unique<RecordingAnalyzer>());
+    EXPECT_EQ(0,
+            AnalyzerPipeline(&otherAnalyzers, kNumBlocks, kSamplesPerBlock)
+                    .numStages());
+
+    // Analyzers that share a stage thread still consume all blocks
+    publishBlocks(pPipeline.get(), 2 * kNumBlocks);
+    pPipeline->drain();
+    for (const auto* pAnalyzer : recordingAnalyzers) {
+        EXPECT_EQ(static_cast<size_t>(2 * kNumBlocks), pAnalyzer->m_firstSamples.size());
+    }
+}
+
+TEST_F(AnalyzerPipelineTest, ReleasesStageThreads) {
+    addAnalyzer();
+    addAnalyzer();
+    const int numStages = startPipeline()->numStages();
+    EXPECT_EQ(numStages, startPipeline()->numStages());
+}
+
+TEST_F(AnalyzerPipelineTest, SuspendedStagesDoNotConsumeBlocks) {
+    RecordingAnalyzer* pAnalyzer = addAnalyzer();
+    const auto pPipeline = startPipeline();
+
+    pPipeline->suspend();
+    publishBlocks(pPipeline.get(), 1);
+    QThread::msleep(50);
+    EXPECT_TRUE(pAnalyzer->m_firstSamples.empty());
+
+    pPipeline->resume();
+    pPipeline->drain();
+    EXPECT_EQ(1u, pAnalyzer->m_firstSamples.size());
+}
+
+TEST_F(AnalyzerPipelineTest, DiscardWhileSuspended) {
+    RecordingAnalyzer* pAnalyzer = addAnalyzer();
+    const auto pPipeline = startPipeline();
+
+    pPipeline->suspend();
+    publishBlocks(pPipeline.get(), kNumBlocks);
+    // Must not block
+    pPipeline->discard();
+    EXPECT_TRUE(pAnalyzer->m_firstSamples.empty());
+}
+
+TEST_F(AnalyzerPipelineTest, FailingAnalyzerDoesNotStallOthers) {
+    RecordingAnalyzer* pFailing = addAnalyzer(2);
+    RecordingAnalyzer* pWorking = addAnalyzer();
+    const auto pPipeline = startPipeline();
+
+    publishBlocks(pPipeline.get(), 3 * kNumBlocks);
+    pPipeline->drain();
+
+    EXPECT_EQ(2u, pFailing->m_firstSamples.size());
+    EXPECT_TRUE(pFailing->m_cleanedUp);
+    EXPECT_FALSE(m_analyzers[0].isActive());
+    EXPECT_EQ(static_cast<size_t>(3 * kNumBlocks), pWorking->m_firstSamples.size());
+    EXPECT_TRUE(m_analyzers[1].isActive());
+}
+
+TEST_F(AnalyzerPipelineTest, DiscardSkipsPendingBlocks) {
+    RecordingAnalyzer* pAnalyzer = addAnalyzer();
+    const auto pPipeline = startPipeline();
+
+    publishBlocks(pPipeline.get(), kNumBlocks);
+    pPipeline->discard();
+    EXPECT_GE(static_cast<size_t>(kNumBlocks), pAnalyzer->m_firstSamples.size());
+
+    // The pipeline can be reused afterwards
+    const auto consumedBlocks = pAnalyzer->m_firstSamples.size();
+    publishBlocks(pPipeline.get(), 1);
+    pPipeline->drain();
+    EXPECT_EQ(consumedBlocks + 1, pAnalyzer->m_firstSamples.size());
+}
+
+} // namespace
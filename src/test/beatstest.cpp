@@ -1,6 +1,8 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
 #include <QtDebug>
+#include <vector>
 
 #include "audio/types.h"
 #include "track/beats.h"
@@ -34,6 +36,20 @@ const auto kNonConstTempoBeats = Beats(
         kSampleRate,
         QString());
 
+// Create beat positions whose tempo changes every 4 beats, like a beat map
+// imported from a track that was played by a live drummer. This results in a
+// beat marker for every 4 beats.
+QVector<audio::FramePos> makeDriftingTempoBeatPositions(int numBeats) {
+    QVector<audio::FramePos> beatPositions;
+    beatPositions.reserve(numBeats);
+    audio::FramePos position = kStartPosition;
+    for (int i = 0; i < numBeats; i++) {
+        beatPositions.append(position);
+        position += ((i / 4) % 2 == 0) ? 24000 : 24004;
+    }
+    return beatPositions;
+}
+
 TEST(BeatsTest, ConstTempoGetBpmInRange) {
     EXPECT_DOUBLE_EQ(kBpm.value(),
             kConstTempoBeats.getBpmInRange(kStartPosition, kEndPosition)
@@ -537,4 +553,83 @@ TEST(BeatsTest, ConstTempoFindPrevNextBeatWhenNotOnBeat) {
     EXPECT_NEAR(nextBeat.value(), foundNextBeat.value(), kMaxBeatError);
 }
 
+TEST(BeatsTest, DriftingTempoFindBeats) {
+    const auto beatPositions = makeDriftingTempoBeatPositions(1000);
+    const auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    ASSERT_NE(nullptr, pBeats);
+    ASSERT_LT(200, pBeats->getMarkers().size());
+
+    const auto firstBeatIt = pBeats->iteratorFrom(beatPositions.first());
+    for (int i = 0; i < beatPositions.size() - 1; i++) {
+        const audio::FramePos beatPosition = beatPositions[i];
+        EXPECT_NEAR(beatPosition.value(), pBeats->findNextBeat(beatPosition).value(), kMaxBeatError);
+        EXPECT_NEAR(beatPosition.value(), pBeats->findPrevBeat(beatPosition).value(), kMaxBeatError);
+        EXPECT_EQ(i, pBeats->iteratorFrom(beatPosition) - firstBeatIt);
+        EXPECT_NEAR(beatPosition.value(), (*(firstBeatIt + i)).value(), kMaxBeatError);
+
+        const audio::FramePos position = beatPosition + 100;
+        audio::FramePos foundPrevBeat, foundNextBeat;
+        ASSERT_TRUE(pBeats->findPrevNextBeats(position, &foundPrevBeat, &foundNextBeat, false));
+        EXPECT_NEAR(beatPosition.value(), foundPrevBeat.value(), kMaxBeatError);
+        EXPECT_NEAR(beatPositions[i + 1].value(), foundNextBeat.value(), kMaxBeatError);
+        EXPECT_NEAR(beatPosition.value(), pBeats->findClosestBeat(position).value(), kMaxBeatError);
+    }
+}
+
+// Beat maps of imported tracks can have thousands of markers
+constexpr int kNumBenchmarkBeats = 16000;
+
+// Returns positions spread over the whole track that are visited in a
+// non-sequential order, so the lookups can't profit from the CPU cache.
+std::vector<audio::FramePos> makeBenchmarkLookupPositions(
+        const QVector<audio::FramePos>& beatPositions) {
+    std::vector<audio::FramePos> positions;
+    positions.reserve(beatPositions.size());
+    for (int i = 0; i < beatPositions.size() - 1; i++) {
+        const int beatIndex = static_cast<int>((i * 7919LL) % (beatPositions.size() - 1));
+        positions.push_back(beatPositions[beatIndex] + 1000);
+    }
+    return positions;
+}
+
+static void BM_BeatsFindPrevNextBeats(benchmark::State& state) {
+    const auto beatPositions = makeDriftingTempoBeatPositions(kNumBenchmarkBeats);
+    const auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    const auto positions = makeBenchmarkLookupPositions(beatPositions);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        audio::FramePos prevBeatPosition, nextBeatPosition;
+        pBeats->findPrevNextBeats(positions[i], &prevBeatPosition, &nextBeatPosition, false);
+        benchmark::DoNotOptimize(prevBeatPosition);
+        benchmark::DoNotOptimize(nextBeatPosition);
+        i = (i + 1) % positions.size();
+    }
+}
+BENCHMARK(BM_BeatsFindPrevNextBeats);
+
+static void BM_BeatsFindNthBeat(benchmark::State& state) {
+    const auto beatPositions = makeDriftingTempoBeatPositions(kNumBenchmarkBeats);
+    const auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    const auto positions = makeBenchmarkLookupPositions(beatPositions);
+    const int n = static_cast<int>(state.range(0));
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pBeats->findNthBeat(positions[i], n));
+        i = (i + 1) % positions.size();
+    }
+}
+BENCHMARK(BM_BeatsFindNthBeat)->Arg(1)->Arg(-4)->Arg(64);
+
+static void BM_BeatsFindClosestBeat(benchmark::State& state) {
+    const auto beatPositions = makeDriftingTempoBeatPositions(kNumBenchmarkBeats);
+    const auto pBeats = Beats::fromBeatPositions(kSampleRate, beatPositions);
+    const auto positions = makeBenchmarkLookupPositions(beatPositions);
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pBeats->findClosestBeat(positions[i]));
+        i = (i + 1) % positions.size();
+    }
+}
+BENCHMARK(BM_BeatsFindClosestBeat);
+
 } // namespace
@@ -0,0 +1,89 @@
+#include "engine/cachingreader/cachingreadercachesize.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+class CachingReaderCacheSizeTest : public testing::Test {
+  protected:
+    using Lookup = CachingReaderCacheSize::Lookup;
+
+    // Records a full evaluation window with the given number of redecodes
+    bool recordWindow(CachingReaderCacheSize* pCacheSize, int redecodes) {
+        bool changed = false;
+        for (int i = 0; i < CachingReaderCacheSize::kLookupsPerWindow; ++i) {
+            changed |= pCacheSize->recordLookup(
+                    i < redecodes ? Lookup::Redecode : Lookup::Hit);
+        }
+        return changed;
+    }
+};
+
+TEST_F(CachingReaderCacheSizeTest, StartsWithMinimum) {
+    CachingReaderCacheSize cacheSize(80, 320);
+    EXPECT_EQ(80, cacheSize.chunks());
+    EXPECT_FALSE(cacheSize.isPinned());
+}
+
+TEST_F(CachingReaderCacheSizeTest, MaximumIsNotBelowMinimum) {
+    CachingReaderCacheSize cacheSize(80, 10);
+    EXPECT_EQ(80, cacheSize.maxChunks());
+}
+
+TEST_F(CachingReaderCacheSizeTest, GrowsOnRedecodesUpToMaximum) {
+    CachingReaderCacheSize cacheSize(80, 120);
+    EXPECT_TRUE(recordWindow(&cacheSize, 100));
+    EXPECT_EQ(100, cacheSize.chunks());
+    EXPECT_TRUE(recordWindow(&cacheSize, 100));
+    EXPECT_EQ(120, cacheSize.chunks());
+    EXPECT_FALSE(recordWindow(&cacheSize, 100));
+    EXPECT_EQ(120, cacheSize.chunks());
+}
+
+TEST_F(CachingReaderCacheSizeTest, IgnoresCompulsoryMisses) {
+    CachingReaderCacheSize cacheSize(80, 320);
+    for (int i = 0; i < CachingReaderCacheSize::kLookupsPerWindow; ++i) {
+        cacheSize.recordLookup(Lookup::Miss);
+    }
+    EXPECT_EQ(80, cacheSize.chunks());
+}
+
+TEST_F(CachingReaderCacheSizeTest, ShrinksSlowlyDownToMinimum) {
+    CachingReaderCacheSize cacheSize(80, 320);
+    recordWindow(&cacheSize, 100);
+    ASSERT_EQ(100, cacheSize.chunks());
+    // A single window without redecodes is not sufficient
+    EXPECT_FALSE(recordWindow(&cacheSize, 0));
+    bool changed = false;
+    for (int i = 0; i < 100 && !changed; ++i) {
+        changed = recordWindow(&cacheSize, 0);
+    }
+    EXPECT_TRUE(changed);
+    EXPECT_LT(cacheSize.chunks(), 100);
+    for (int i = 0; i < 1000; ++i) {
+        recordWindow(&cacheSize, 0);
+    }
+    EXPECT_EQ(80, cacheSize.chunks());
+}
+
+TEST_F(CachingReaderCacheSizeTest, PinToTrack) {
+    CachingReaderCacheSize cacheSize(80, 320);
+    EXPECT_FALSE(cacheSize.pinToTrack(321));
+    EXPECT_FALSE(cacheSize.isPinned());
+    EXPECT_TRUE(cacheSize.pinToTrack(200));
+    EXPECT_TRUE(cacheSize.isPinned());
+    EXPECT_EQ(200, cacheSize.chunks());
+    // Does not adapt while pinned
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_FALSE(recordWindow(&cacheSize, 0));
+    }
+    EXPECT_EQ(200, cacheSize.chunks());
+    // Short tracks still get the minimum
+    EXPECT_TRUE(cacheSize.pinToTrack(10));
+    EXPECT_EQ(80, cacheSize.chunks());
+    cacheSize.reset();
+    EXPECT_FALSE(cacheSize.isPinned());
+    EXPECT_EQ(80, cacheSize.chunks());
+}
+
+} // namespace
@@ -0,0 +1,139 @@
+#include "engine/cachingreader/cachingreadersharedcache.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+#include "engine/cachingreader/cachingreaderchunk.h"
+
+namespace {
+
+const QString kTrackA = QStringLiteral("/music/a.flac");
+const QString kTrackB = QStringLiteral("/music/b.flac");
+
+const mixxx::IndexRange kTrackFrames =
+        mixxx::IndexRange::forward(0, 10 * CachingReaderChunk::kFrames);
+
+class CachingReaderSharedCacheTest : public testing::Test {
+  protected:
+    static mixxx::IndexRange chunkFrames(SINT chunkIndex) {
+        return mixxx::IndexRange::forward(
+                chunkIndex * CachingReaderChunk::kFrames,
+                CachingReaderChunk::kFrames);
+    }
+
+    static CachingReaderSharedCache::SampleBufferPointer newSamples() {
+        auto pSamples = std::make_shared<mixxx::SampleBuffer>(
+                CachingReaderChunk::kSamples);
+        for (SINT i = 0; i < pSamples->size(); ++i) {
+            *pSamples->data(i) = static_cast<CSAMPLE>(i % 128) / 128;
+        }
+        return pSamples;
+    }
+
+    CachingReaderSharedCache::SampleBufferPointer write(
+            CachingReaderSharedCache* pCache,
+            const QString& trackKey,
+            SINT chunkIndex) {
+        auto pSamples = newSamples();
+        pCache->write(trackKey, chunkIndex, chunkFrames(chunkIndex), pSamples);
+        return pSamples;
+    }
+
+    mixxx::IndexRange read(CachingReaderSharedCache* pCache,
+            const QString& trackKey,
+            SINT chunkIndex) {
+        m_pReadSamples.reset();
+        return pCache->read(trackKey, chunkIndex, &m_pReadSamples);
+    }
+
+    CachingReaderSharedCache::SampleBufferPointer m_pReadSamples;
+};
+
+TEST_F(CachingReaderSharedCacheTest, ReadsChunkWrittenByOtherWorker) {
+    CachingReaderSharedCache cache;
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    cache.acquireTrack(kTrackA, kTrackFrames);
+
+    EXPECT_TRUE(read(&cache, kTrackA, 3).empty());
+    EXPECT_EQ(nullptr, m_pReadSamples);
+    const auto pSamples = write(&cache, kTrackA, 3);
+
+    // The samples are shared and not copied
+    EXPECT_EQ(chunkFrames(3), read(&cache, kTrackA, 3));
+    EXPECT_EQ(pSamples, m_pReadSamples);
+    EXPECT_TRUE(read(&cache, kTrackA, 4).empty());
+    EXPECT_TRUE(read(&cache, kTrackB, 3).empty());
+}
+
+TEST_F(CachingReaderSharedCacheTest, DiscardsChunksWhenLastReferenceIsReleased) {
+    CachingReaderSharedCache cache;
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    write(&cache, kTrackA, 0);
+    write(&cache, kTrackA, 1);
+    EXPECT_EQ(2, cache.size());
+
+    cache.releaseTrack(kTrackA);
+    EXPECT_EQ(2, cache.size());
+    EXPECT_EQ(chunkFrames(1), read(&cache, kTrackA, 1));
+
+    cache.releaseTrack(kTrackA);
+    EXPECT_EQ(0, cache.size());
+    EXPECT_TRUE(read(&cache, kTrackA, 1).empty());
+}
+
+TEST_F(CachingReaderSharedCacheTest, DiscardsChunksOfModifiedFile) {
+    CachingReaderSharedCache cache;
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    write(&cache, kTrackA, 0);
+
+    cache.acquireTrack(kTrackA, mixxx::IndexRange::forward(0, 1000));
+    EXPECT_TRUE(read(&cache, kTrackA, 0).empty());
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST_F(CachingReaderSharedCacheTest, EvictsLeastRecentlyUsedChunk) {
+    CachingReaderSharedCache cache(3);
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    cache.acquireTrack(kTrackB, kTrackFrames);
+    write(&cache, kTrackA, 0);
+    write(&cache, kTrackB, 0);
+    write(&cache, kTrackA, 1);
+    // Touch the oldest chunk
+    EXPECT_FALSE(read(&cache, kTrackA, 0).empty());
+
+    write(&cache, kTrackB, 1);
+    EXPECT_EQ(3, cache.size());
+    EXPECT_TRUE(read(&cache, kTrackB, 0).empty());
+    EXPECT_FALSE(read(&cache, kTrackA, 0).empty());
+    EXPECT_FALSE(read(&cache, kTrackA, 1).empty());
+    EXPECT_FALSE(read(&cache, kTrackB, 1).empty());
+}
+
+TEST_F(CachingReaderSharedCacheTest, KeepsPartialLastChunk) {
+    CachingReaderSharedCache cache;
+    const auto lastChunkFrames = mixxx::IndexRange::forward(
+            2 * CachingReaderChunk::kFrames, 100);
+    cache.acquireTrack(kTrackA,
+            mixxx::IndexRange::between(0, lastChunkFrames.end()));
+    const auto pSamples = newSamples();
+    cache.write(kTrackA, 2, lastChunkFrames, pSamples);
+
+    EXPECT_EQ(lastChunkFrames, read(&cache, kTrackA, 2));
+    EXPECT_EQ(pSamples, m_pReadSamples);
+}
+
+TEST_F(CachingReaderSharedCacheTest, KeepsSamplesOfEvictedChunkAlive) {
+    CachingReaderSharedCache cache(1);
+    cache.acquireTrack(kTrackA, kTrackFrames);
+    const auto pSamples = write(&cache, kTrackA, 0);
+    ASSERT_EQ(2, pSamples.use_count());
+
+    write(&cache, kTrackA, 1);
+    EXPECT_TRUE(read(&cache, kTrackA, 0).empty());
+    // The reader holds the only reference and may reuse the buffer
+    EXPECT_EQ(1, pSamples.use_count());
+}
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "controllers/scripting/legacy/controllerscriptenginelegacy.h"
 
+#include <QElapsedTimer>
 #include <QScopedPointer>
 #include <QTemporaryFile>
 #include <QThread>
@@ -65,6 +66,17 @@ class ControllerScriptEngineLegacyTest : public MixxxTest {
         application()->processEvents();
     }
 
+    /// Processes events until the control has changed or a second has passed.
+    void processEventsUntilChanged(const ControlObject& control) {
+        const double initialValue = control.get();
+        QElapsedTimer timer;
+        timer.start();
+        while (control.get() == initialValue && !timer.hasExpired(1000)) {
+            QThread::msleep(1);
+            application()->processEvents();
+        }
+    }
+
     ControllerScriptEngineLegacy* cEngine;
 };
 
@@ -595,6 +607,42 @@ TEST_F(ControllerScriptEngineLegacyTest, connectionObject_trigger) {
     EXPECT_DOUBLE_EQ(1.0, counter->get());
 }
 
+TEST_F(ControllerScriptEngineLegacyTest, connectionBatching_DeliversLatestValuePerFrame) {
+    auto co = std::make_unique<ControlObject>(ConfigKey("[Test]", "co"));
+    auto calls = std::make_unique<ControlObject>(ConfigKey("[Test]", "calls"));
+    auto last = std::make_unique<ControlObject>(ConfigKey("[Test]", "last"));
+    auto frames = std::make_unique<ControlObject>(ConfigKey("[Test]", "frames"));
+    auto changes = std::make_unique<ControlObject>(ConfigKey("[Test]", "changes"));
+
+    EXPECT_TRUE(evaluateAndAssert(
+            "engine.makeConnection('[Test]', 'co', function(value) {"
+            "  engine.setValue('[Test]', 'calls', engine.getValue('[Test]', 'calls') + 1);"
+            "  engine.setValue('[Test]', 'last', value);"
+            "});"
+            "engine.setConnectionBatching(10, function(changes) {"
+            "  engine.setValue('[Test]', 'changes', changes.length);"
+            "  engine.setValue('[Test]', 'frames', engine.getValue('[Test]', 'frames') + 1);"
+            "});"));
+    co->set(1.0);
+    co->set(2.0);
+    co->set(3.0);
+    processEventsUntilChanged(*frames);
+
+    // The connection is called once with the latest value
+    EXPECT_DOUBLE_EQ(1.0, frames->get());
+    EXPECT_DOUBLE_EQ(1.0, changes->get());
+    EXPECT_DOUBLE_EQ(1.0, calls->get());
+    EXPECT_DOUBLE_EQ(3.0, last->get());
+
+    // Switching batching off restores immediate delivery
+    EXPECT_TRUE(evaluateAndAssert("engine.setConnectionBatching(0);"));
+    co->set(4.0);
+    processEvents();
+    EXPECT_DOUBLE_EQ(2.0, calls->get());
+    EXPECT_DOUBLE_EQ(4.0, last->get());
+    EXPECT_DOUBLE_EQ(1.0, frames->get());
+}
+
 TEST_F(ControllerScriptEngineLegacyTest, connectionExecutesWithCorrectThisObject) {
     // Test that callback functions are executed with JavaScript's
     // 'this' keyword referring to the object in which the connection
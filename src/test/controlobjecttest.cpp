@@ -1,7 +1,13 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
+
+#include <QCoreApplication>
 #include <QtDebug>
+#include <vector>
 
+#include "control/controlchangebatcher.h"
 #include "control/controlobject.h"
+#include "control/controlproxy.h"
 #include "util/memory.h"
 #include "test/mixxxtest.h"
 
@@ -85,4 +91,117 @@ TEST_F(ControlObjectTest, Persistence_ValidValue) {
     EXPECT_DOUBLE_EQ(5.0, co.get());
 }
 
+TEST_F(ControlObjectTest, BatchedValueChanged) {
+    ControlChangeBatcher::setEnabled(true);
+    QObject receiver;
+    int notifications = 0;
+    double lastValue = 0.0;
+    {
+        ControlProxy proxy(ck1);
+        ASSERT_TRUE(proxy.connectValueChangedBatched(&receiver, [&](double value) {
+            notifications++;
+            lastValue = value;
+        }));
+        EXPECT_EQ(1, ControlChangeBatcher::numSubscribedControls());
+
+        // Only the latest value is delivered once per tick
+        co1->set(1.0);
+        co1->set(2.0);
+        co1->set(3.0);
+        EXPECT_EQ(0, notifications);
+        EXPECT_EQ(1, ControlChangeBatcher::deliverChanges());
+        EXPECT_EQ(1, notifications);
+        EXPECT_DOUBLE_EQ(3.0, lastValue);
+
+        // No changes, no notification
+        EXPECT_EQ(0, ControlChangeBatcher::deliverChanges());
+        co2->set(1.0);
+        EXPECT_EQ(0, ControlChangeBatcher::deliverChanges());
+        EXPECT_EQ(1, notifications);
+
+        co1->set(4.0);
+        EXPECT_EQ(1, ControlChangeBatcher::deliverChanges());
+        EXPECT_EQ(2, notifications);
+        EXPECT_DOUBLE_EQ(4.0, lastValue);
+    }
+    EXPECT_EQ(0, ControlChangeBatcher::numSubscribedControls());
+    ControlChangeBatcher::setEnabled(false);
+}
+
+// Benchmarks that mimic a skin with many widgets whose controls are set by
+// the engine several times between two GUI ticks.
+constexpr int kSetsPerTick = 8;
+
+std::vector<std::unique_ptr<ControlObject>> makeBenchmarkControls(int numControls) {
+    std::vector<std::unique_ptr<ControlObject>> controls;
+    controls.reserve(numControls);
+    for (int i = 0; i < numControls; ++i) {
+        controls.push_back(std::make_unique<ControlObject>(
+                ConfigKey(QStringLiteral("[Benchmark]"), QString::number(i))));
+    }
+    return controls;
+}
+
+void setBenchmarkControls(
+        const std::vector<std::unique_ptr<ControlObject>>& controls, int tick) {
+    for (int i = 0; i < kSetsPerTick; ++i) {
+        for (const auto& pControl : controls) {
+            pControl->set(tick * kSetsPerTick + i);
+        }
+    }
+}
+
+static void BM_ControlProxyGet(benchmark::State& state) {
+    ControlObject control(ConfigKey(QStringLiteral("[Benchmark]"), QStringLiteral("get")));
+    ControlProxy proxy(control.getKey());
+    control.set(1.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(proxy.get());
+    }
+}
+BENCHMARK(BM_ControlProxyGet);
+
+static void BM_ControlValueChangedQueued(benchmark::State& state) {
+    const auto controls = makeBenchmarkControls(static_cast<int>(state.range(0)));
+    QObject receiver;
+    int notifications = 0;
+    std::vector<std::unique_ptr<ControlProxy>> proxies;
+    for (const auto& pControl : controls) {
+        proxies.push_back(std::make_unique<ControlProxy>(pControl->getKey()));
+        proxies.back()->connectValueChanged(
+                &receiver, [&notifications](double) { notifications++; }, Qt::QueuedConnection);
+    }
+    int tick = 0;
+    for (auto _ : state) {
+        setBenchmarkControls(controls, tick++);
+        QCoreApplication::sendPostedEvents();
+    }
+    state.counters["notifications"] = benchmark::Counter(
+            notifications, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_ControlValueChangedQueued)->Arg(100)->Arg(3000);
+
+static void BM_ControlValueChangedBatched(benchmark::State& state) {
+    const auto controls = makeBenchmarkControls(static_cast<int>(state.range(0)));
+    ControlChangeBatcher::setEnabled(true);
+    QObject receiver;
+    int notifications = 0;
+    std::vector<std::unique_ptr<ControlProxy>> proxies;
+    for (const auto& pControl : controls) {
+        proxies.push_back(std::make_unique<ControlProxy>(pControl->getKey()));
+        proxies.back()->connectValueChangedBatched(
+                &receiver, [&notifications](double) { notifications++; });
+    }
+    int tick = 0;
+    for (auto _ : state) {
+        setBenchmarkControls(controls, tick++);
+        ControlChangeBatcher::deliverChanges();
+    }
+    state.counters["notifications"] = benchmark::Counter(
+            notifications, benchmark::Counter::kAvgIterations);
+    proxies.clear();
+    ControlChangeBatcher::setEnabled(false);
+}
+BENCHMARK(BM_ControlValueChangedBatched)->Arg(100)->Arg(3000);
+
 } // namespace
@@ -125,6 +125,39 @@ TEST_F(CueControlTest, LoadUnloadTrack) {
     EXPECT_FALSE(m_pOutroEndEnabled->toBool());
 }
 
+TEST_F(CueControlTest, HintReaderPrioritizesJumpTargets) {
+    constexpr auto kCuePosition = mixxx::audio::FramePos(100);
+    constexpr auto kIntroStartPosition = mixxx::audio::FramePos(150);
+    constexpr auto kOutroStartPosition = mixxx::audio::FramePos(250000);
+
+    TrackPointer pTrack = createTestTrack();
+    pTrack->setMainCuePosition(kCuePosition);
+    pTrack->createAndAddCue(
+            mixxx::CueType::Intro,
+            Cue::kNoHotCue,
+            kIntroStartPosition,
+            mixxx::audio::kInvalidFramePos);
+    pTrack->createAndAddCue(
+            mixxx::CueType::Outro,
+            Cue::kNoHotCue,
+            kOutroStartPosition,
+            mixxx::audio::kInvalidFramePos);
+
+    loadTrack(pTrack);
+
+    HintVector hints;
+    m_pChannel1->getEngineBuffer()->m_pCueControl->hintReader(&hints);
+
+    ASSERT_EQ(3, hints.size());
+    EXPECT_EQ(static_cast<SINT>(kCuePosition.value()), hints[0].frame);
+    EXPECT_EQ(Hint::kPriorityJumpTarget, hints[0].priority);
+    EXPECT_EQ(Hint::kFrameCountJumpTarget, hints[0].frameCount);
+    EXPECT_EQ(static_cast<SINT>(kIntroStartPosition.value()), hints[1].frame);
+    EXPECT_EQ(Hint::kPriorityBackground, hints[1].priority);
+    EXPECT_EQ(static_cast<SINT>(kOutroStartPosition.value()), hints[2].frame);
+    EXPECT_EQ(Hint::kPriorityBackground, hints[2].priority);
+}
+
 TEST_F(CueControlTest, LoadTrackWithDetectedCues) {
     constexpr auto kCuePosition = mixxx::audio::FramePos(100);
     constexpr auto kOutroEndPosition = mixxx::audio::FramePos(200);
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include "effects/backends/effectstatepool.h"
+
+namespace {
+
+const mixxx::EngineParameters kEngineParameters(
+        mixxx::audio::SampleRate(96000), 1024);
+
+// Counts its instances to tell when the pool constructs new states
+class CountingState {
+  public:
+    explicit CountingState(const mixxx::EngineParameters& engineParameters)
+            : sampleRate(engineParameters.sampleRate()) {
+        ++s_constructed;
+        ++s_alive;
+    }
+    ~CountingState() {
+        --s_alive;
+    }
+
+    static int s_constructed;
+    static int s_alive;
+
+    const mixxx::audio::SampleRate sampleRate;
+};
+
+int CountingState::s_constructed = 0;
+int CountingState::s_alive = 0;
+
+class EffectStatePoolTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        pool().reserve(0, kEngineParameters);
+        CountingState::s_constructed = 0;
+        ASSERT_EQ(0, CountingState::s_alive);
+    }
+
+    void TearDown() override {
+        pool().reserve(0, kEngineParameters);
+        EXPECT_EQ(0, CountingState::s_alive);
+    }
+
+    static EffectStatePool<CountingState>& pool() {
+        return EffectStatePool<CountingState>::instance();
+    }
+};
+
+TEST_F(EffectStatePoolTest, AcquireDoesNotConstructPooledStates) {
+    pool().reserve(4, kEngineParameters);
+    EXPECT_EQ(4, CountingState::s_constructed);
+    EXPECT_EQ(4, pool().numFreeStates());
+
+    CountingState* pState1 = pool().acquire(kEngineParameters);
+    CountingState* pState2 = pool().acquire(kEngineParameters);
+    EXPECT_EQ(4, CountingState::s_constructed);
+    EXPECT_EQ(2, pool().numFreeStates());
+    EXPECT_NE(pState1, pState2);
+
+    delete pState1;
+    delete pState2;
+}
+
+TEST_F(EffectStatePoolTest, RefillReplacesAcquiredStates) {
+    pool().reserve(2, kEngineParameters);
+    CountingState* pState = pool().acquire(kEngineParameters);
+    EXPECT_EQ(1, pool().numFreeStates());
+
+    pool().refill();
+    EXPECT_EQ(3, CountingState::s_constructed);
+    EXPECT_EQ(2, pool().numFreeStates());
+
+    // A full pool is not refilled
+    pool().refill();
+    EXPECT_EQ(3, CountingState::s_constructed);
+    delete pState;
+}
+
+TEST_F(EffectStatePoolTest, ExhaustedPoolConstructsStates) {
+    pool().reserve(1, kEngineParameters);
+    CountingState* pState1 = pool().acquire(kEngineParameters);
+    CountingState* pState2 = pool().acquire(kEngineParameters);
+    EXPECT_EQ(2, CountingState::s_constructed);
+    EXPECT_EQ(0, pool().numFreeStates());
+
+    // The pool is not filled beyond its capacity
+    pool().refill();
+    EXPECT_EQ(1, pool().numFreeStates());
+    delete pState1;
+    delete pState2;
+    EXPECT_EQ(1, CountingState::s_alive);
+}
+
+TEST_F(EffectStatePoolTest, ReserveResizesPool) {
+    pool().reserve(5, kEngineParameters);
+    EXPECT_EQ(5, pool().capacity());
+    EXPECT_EQ(5, pool().numFreeStates());
+
+    pool().reserve(2, kEngineParameters);
+    EXPECT_EQ(2, pool().capacity());
+    EXPECT_EQ(2, pool().numFreeStates());
+    EXPECT_EQ(2, CountingState::s_alive);
+    EXPECT_EQ(5, CountingState::s_constructed);
+}
+
+TEST_F(EffectStatePoolTest, OtherEngineParameters) {
+    pool().reserve(1, kEngineParameters);
+    const mixxx::EngineParameters otherEngineParameters(
+            mixxx::audio::SampleRate(44100), 1024);
+    CountingState* pState = pool().acquire(otherEngineParameters);
+    EXPECT_EQ(mixxx::audio::SampleRate(44100), pState->sampleRate);
+    EXPECT_EQ(1, pool().numFreeStates());
+    delete pState;
+
+    // Reserving states for other parameters replaces all states
+    pool().reserve(2, otherEngineParameters);
+    EXPECT_EQ(2, CountingState::s_alive);
+    EXPECT_EQ(2, pool().numFreeStates());
+    pState = pool().acquire(otherEngineParameters);
+    EXPECT_EQ(mixxx::audio::SampleRate(44100), pState->sampleRate);
+    delete pState;
+}
+
+} // namespace
@@ -8,6 +8,7 @@
 #include "mixer/basetrackplayer.h"
 #include "preferences/usersettings.h"
 #include "control/controlobject.h"
+#include "engine/readaheadmanager.h"
 #include "test/mockedenginebackendtest.h"
 #include "test/mixxxtest.h"
 #include "test/signalpathtest.h"
@@ -389,6 +390,60 @@ TEST_F(EngineBufferE2ETest, RubberbandReverseTest) {
     // on the uses library version
 }
 
+TEST_F(EngineBufferE2ETest, RubberbandLookAheadTest) {
+    // This test must not crash when the stretched audio of the worker
+    // is invalidated by seeks, rate changes and reversing
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine"),
+            static_cast<double>(EngineBuffer::RUBBERBAND_LOOKAHEAD));
+    ControlObject::set(ConfigKey(m_sGroup1, "pitch"), -1);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    for (int i = 0; i < 50; ++i) {
+        ProcessBuffer();
+    }
+    EXPECT_LT(mixxx::audio::FramePos(0),
+            m_pChannel1->getEngineBuffer()->getExactPlayPos());
+    m_pChannel1->getEngineBuffer()->queueNewPlaypos(
+            mixxx::audio::FramePos(500), EngineBuffer::SEEK_EXACT);
+    for (int i = 0; i < 50; ++i) {
+        ProcessBuffer();
+    }
+    ControlObject::set(ConfigKey(m_sGroup1, "rate"), 0.5);
+    for (int i = 0; i < 50; ++i) {
+        ProcessBuffer();
+    }
+    ControlObject::set(ConfigKey(m_sGroup1, "reverse"), 1.0);
+    ProcessBuffer();
+    // Note: we cannot compare a golden buffer here, because the result depends
+    // on the uses library version and the timing of the worker thread
+}
+
+TEST_F(EngineBufferE2ETest, RubberbandLookAheadClearKeepsPlayPosition) {
+    ControlObject::set(ConfigKey("[Master]", "keylock_engine"),
+            static_cast<double>(EngineBuffer::RUBBERBAND_LOOKAHEAD));
+    ControlObject::set(ConfigKey(m_sGroup1, "pitch"), -1);
+    ControlObject::set(ConfigKey(m_sGroup1, "play"), 1.0);
+    EngineBuffer* pEngineBuffer = m_pChannel1->getEngineBuffer();
+    ReadAheadManager* pReadAheadManager = pEngineBuffer->m_pReadAheadManager;
+    for (int i = 0; i < 50; ++i) {
+        ProcessBuffer();
+    }
+    ASSERT_TRUE(pEngineBuffer->m_pScale == pEngineBuffer->m_pScaleKeylock);
+
+    // The scaler has read ahead of the play position
+    const double playPosition = pEngineBuffer->getExactPlayPos().toEngineSamplePos();
+    ASSERT_LT(playPosition, pReadAheadManager->getPlaypos());
+
+    // The input that is dropped by clear() is read again
+    pEngineBuffer->m_pScale->clear();
+    EXPECT_DOUBLE_EQ(playPosition, pReadAheadManager->getPlaypos());
+
+    // Playback continues at the same position
+    ProcessBuffer();
+    EXPECT_LT(playPosition, pEngineBuffer->getExactPlayPos().toEngineSamplePos());
+    EXPECT_GE(playPosition + 2 * kProcessBufferSize,
+            pEngineBuffer->getExactPlayPos().toEngineSamplePos());
+}
+
 TEST_F(EngineBufferE2ETest, CueGotoAndStopTest) {
     // Be sure, that the Crossfade buffer is processed only once
     // Bug #1504838
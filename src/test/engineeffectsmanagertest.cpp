@@ -0,0 +1,239 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "effects/backends/builtin/filtereffect.h"
+#include "effects/backends/effectsbackendmanager.h"
+#include "engine/effects/engineeffect.h"
+#include "engine/effects/engineeffectchain.h"
+#include "engine/effects/engineeffectsmanager.h"
+#include "test/mixxxtest.h"
+#include "util/defs.h"
+#include "util/sample.h"
+
+namespace {
+
+constexpr int kFifoSize = 64;
+constexpr unsigned int kSampleRate = 44100;
+constexpr unsigned int kBufferSize = 1024;
+
+const QString kInputGroup = QStringLiteral("[Channel1]");
+const QString kOutputGroup = QStringLiteral("[Master]");
+
+std::vector<CSAMPLE> makeInput(int bufferSize) {
+    std::vector<CSAMPLE> input(bufferSize);
+    for (int i = 0; i < bufferSize; ++i) {
+        input[i] = static_cast<CSAMPLE>(std::sin(i * 0.01));
+    }
+    return input;
+}
+
+// Talks to an EngineEffectsManager with one post-fader effect chain like
+// EffectsMessenger does, but processes each request immediately.
+class EffectsRoutingHarness {
+  public:
+    EffectsRoutingHarness()
+            : m_input(m_factory.getOrCreateHandle(kInputGroup), kInputGroup),
+              m_output(m_factory.getOrCreateHandle(kOutputGroup), kOutputGroup),
+              m_pBackendManager(new EffectsBackendManager()),
+              m_nextRequestId(0) {
+        const auto pipes =
+                TwoWayMessagePipe<EffectsRequest*, EffectsResponse>::makeTwoWayMessagePipe(
+                        kFifoSize, kFifoSize);
+        m_pRequestPipe.reset(pipes.first);
+        m_pEngineEffectsManager = std::make_unique<EngineEffectsManager>(pipes.second);
+        m_pChain = std::make_unique<EngineEffectChain>(
+                QStringLiteral("[EffectRack1_EffectUnit1]"),
+                QSet<ChannelHandleAndGroup>{m_input},
+                QSet<ChannelHandleAndGroup>{m_output});
+
+        auto* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ADD_EFFECT_CHAIN;
+        pRequest->AddEffectChain.pChain = m_pChain.get();
+        pRequest->AddEffectChain.signalProcessingStage = SignalProcessingStage::Postfader;
+        sendRequest(pRequest);
+    }
+
+    void loadEffect() {
+        m_pEffect = std::make_unique<EngineEffect>(
+                m_pBackendManager->getManifest(
+                        FilterEffect::getId(), EffectBackendType::BuiltIn),
+                m_pBackendManager,
+                QSet<ChannelHandleAndGroup>(),
+                QSet<ChannelHandleAndGroup>{m_input},
+                QSet<ChannelHandleAndGroup>{m_output});
+
+        auto* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ADD_EFFECT_TO_CHAIN;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->AddEffectToChain.pEffect = m_pEffect.get();
+        pRequest->AddEffectToChain.iIndex = 0;
+        sendRequest(pRequest);
+
+        pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::SET_EFFECT_PARAMETERS;
+        pRequest->pTargetEffect = m_pEffect.get();
+        pRequest->SetEffectParameters.enabled = true;
+        sendRequest(pRequest);
+    }
+
+    void enableForInputChannel() {
+        const mixxx::EngineParameters engineParameters(
+                mixxx::audio::SampleRate(96000),
+                MAX_BUFFER_LEN / mixxx::kEngineChannelCount);
+        auto* pStatesMapArray = new EffectStatesMapArray;
+        if (m_pEffect) {
+            (*pStatesMapArray)[0].insert(m_output.handle(),
+                    m_pEffect->createState(engineParameters));
+        }
+
+        auto* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::ENABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->EnableInputChannelForChain.pEffectStatesMapArray = pStatesMapArray;
+        pRequest->EnableInputChannelForChain.pChannelHandle = &m_input.handle();
+        sendRequest(pRequest);
+    }
+
+    void disableForInputChannel() {
+        auto* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::DISABLE_EFFECT_CHAIN_FOR_INPUT_CHANNEL;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->DisableInputChannelForChain.pChannelHandle = &m_input.handle();
+        sendRequest(pRequest);
+    }
+
+    void setChainEnabled(bool enabled) {
+        auto* pRequest = new EffectsRequest();
+        pRequest->type = EffectsRequest::SET_EFFECT_CHAIN_PARAMETERS;
+        pRequest->pTargetChain = m_pChain.get();
+        pRequest->SetEffectChainParameters.enabled = enabled;
+        pRequest->SetEffectChainParameters.mix_mode = EffectChainMixMode::DrySlashWet;
+        pRequest->SetEffectChainParameters.mix = 1.0;
+        sendRequest(pRequest);
+    }
+
+    bool isChainActive() {
+        return m_pChain->isActiveForChannel(m_input.handle(), m_output.handle());
+    }
+
+    void processAndMix(CSAMPLE* pIn,
+            CSAMPLE* pOut,
+            CSAMPLE_GAIN oldGain,
+            CSAMPLE_GAIN newGain) {
+        m_pEngineEffectsManager->processPostFaderAndMix(m_input.handle(),
+                m_output.handle(),
+                pIn,
+                pOut,
+                kBufferSize,
+                kSampleRate,
+                m_groupFeatures,
+                oldGain,
+                newGain);
+    }
+
+  private:
+    void sendRequest(EffectsRequest* pRequest) {
+        pRequest->request_id = m_nextRequestId++;
+        m_pRequestPipe->writeMessage(pRequest);
+        m_pEngineEffectsManager->onCallbackStart();
+        EffectsResponse response;
+        while (m_pRequestPipe->readMessage(&response)) {
+            EXPECT_TRUE(response.success);
+        }
+        delete pRequest;
+    }
+
+    ChannelHandleFactory m_factory;
+    const ChannelHandleAndGroup m_input;
+    const ChannelHandleAndGroup m_output;
+    EffectsBackendManagerPointer m_pBackendManager;
+    std::unique_ptr<EffectsRequestPipe> m_pRequestPipe;
+    std::unique_ptr<EngineEffectsManager> m_pEngineEffectsManager;
+    std::unique_ptr<EngineEffectChain> m_pChain;
+    std::unique_ptr<EngineEffect> m_pEffect;
+    GroupFeatureState m_groupFeatures;
+    qint64 m_nextRequestId;
+};
+
+class EngineEffectsManagerTest : public MixxxTest {
+};
+
+TEST_F(EngineEffectsManagerTest, ChannelWithoutActiveChainsIsMixedDirectly) {
+    EffectsRoutingHarness harness;
+    harness.loadEffect();
+    ASSERT_FALSE(harness.isChainActive());
+
+    std::vector<CSAMPLE> input = makeInput(kBufferSize);
+    const std::vector<CSAMPLE> originalInput = input;
+    std::vector<CSAMPLE> output(kBufferSize, 0.25f);
+    harness.processAndMix(input.data(), output.data(), 0.5f, 1.0f);
+
+    // The same as copying the input with the gain applied and mixing the copy
+    std::vector<CSAMPLE> expected(kBufferSize);
+    SampleUtil::copyWithRampingGain(
+            expected.data(), originalInput.data(), 0.5f, 1.0f, kBufferSize);
+    for (unsigned int i = 0; i < kBufferSize; ++i) {
+        ASSERT_FLOAT_EQ(0.25f + expected[i], output[i]) << "sample " << i;
+    }
+    EXPECT_EQ(originalInput, input);
+}
+
+TEST_F(EngineEffectsManagerTest, ChainIsActiveWhileRoutedAndEnabled) {
+    EffectsRoutingHarness harness;
+    harness.loadEffect();
+    std::vector<CSAMPLE> input = makeInput(kBufferSize);
+    std::vector<CSAMPLE> output(kBufferSize);
+
+    harness.enableForInputChannel();
+    EXPECT_TRUE(harness.isChainActive());
+    harness.processAndMix(input.data(), output.data(), 1.0f, 1.0f);
+    EXPECT_TRUE(harness.isChainActive());
+
+    // The chain needs to be processed once more to pass the disabling
+    // signal to the effect
+    harness.setChainEnabled(false);
+    EXPECT_TRUE(harness.isChainActive());
+    harness.processAndMix(input.data(), output.data(), 1.0f, 1.0f);
+    EXPECT_FALSE(harness.isChainActive());
+
+    harness.setChainEnabled(true);
+    EXPECT_TRUE(harness.isChainActive());
+    harness.processAndMix(input.data(), output.data(), 1.0f, 1.0f);
+    EXPECT_TRUE(harness.isChainActive());
+
+    harness.disableForInputChannel();
+    EXPECT_TRUE(harness.isChainActive());
+    harness.processAndMix(input.data(), output.data(), 1.0f, 1.0f);
+    EXPECT_FALSE(harness.isChainActive());
+}
+
+static void BM_PostFaderMixEffectsOff(benchmark::State& state) {
+    EffectsRoutingHarness harness;
+    harness.loadEffect();
+    std::vector<CSAMPLE> input = makeInput(kBufferSize);
+    std::vector<CSAMPLE> output(kBufferSize);
+    for (auto _ : state) {
+        harness.processAndMix(input.data(), output.data(), 0.8f, 0.8f);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PostFaderMixEffectsOff);
+
+static void BM_PostFaderMixOneEffectOn(benchmark::State& state) {
+    EffectsRoutingHarness harness;
+    harness.loadEffect();
+    harness.enableForInputChannel();
+    std::vector<CSAMPLE> input = makeInput(kBufferSize);
+    std::vector<CSAMPLE> output(kBufferSize);
+    for (auto _ : state) {
+        harness.processAndMix(input.data(), output.data(), 0.8f, 0.8f);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_PostFaderMixOneEffectOn);
+
+} // namespace
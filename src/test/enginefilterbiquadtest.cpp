@@ -1,12 +1,76 @@
+#include <benchmark/benchmark.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
+#include "engine/filters/enginefilterbessel8.h"
 #include "engine/filters/enginefilterbiquad1.h"
+#include "engine/filters/enginefilterlinkwitzriley8.h"
 
 namespace {
 
+constexpr int kSampleRate = 44100;
+constexpr int kBufferSize = 1024;
+
+// Filters the channels one after the other, as before they were
+// processed together
+template<typename Filter>
+class ScalarFilter : public Filter {
+  public:
+    using Filter::Filter;
+
+    void process(const CSAMPLE* pIn, CSAMPLE* pOutput, const int iBufferSize) override {
+        for (int i = 0; i < iBufferSize; i += 2) {
+            pOutput[i] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, this->m_buf1, static_cast<double>(pIn[i])));
+            pOutput[i + 1] = static_cast<CSAMPLE>(this->processSample(
+                    this->m_coef, this->m_buf2, static_cast<double>(pIn[i + 1])));
+        }
+    }
+};
+
+std::vector<CSAMPLE> makeInput(int bufferSize) {
+    std::vector<CSAMPLE> input(bufferSize);
+    for (int i = 0; i < bufferSize; i += 2) {
+        input[i] = static_cast<CSAMPLE>(std::sin(i * 0.01) + 0.5 * std::sin(i * 0.37));
+        input[i + 1] = static_cast<CSAMPLE>(std::cos(i * 0.02) - 0.3 * std::sin(i * 0.51));
+    }
+    return input;
+}
+
 class EngineFilterBiquadTest : public testing::Test {
+  protected:
+    template<typename Filter, typename... Args>
+    void expectSameAsScalar(Args... args) {
+        Filter filter(args...);
+        ScalarFilter<Filter> scalarFilter(args...);
+        filter.assumeSettled();
+        scalarFilter.assumeSettled();
+
+        const std::vector<CSAMPLE> input = makeInput(kBufferSize);
+        std::vector<CSAMPLE> output(kBufferSize);
+        std::vector<CSAMPLE> scalarOutput(kBufferSize);
+        // Multiple buffers to verify that the state is kept
+        for (int buffer = 0; buffer < 4; ++buffer) {
+            filter.process(input.data(), output.data(), kBufferSize);
+            scalarFilter.process(input.data(), scalarOutput.data(), kBufferSize);
+            for (int i = 0; i < kBufferSize; ++i) {
+                ASSERT_NEAR(scalarOutput[i], output[i], 1e-6) << "sample " << i;
+            }
+        }
+    }
 };
 
+TEST_F(EngineFilterBiquadTest, StereoKernelMatchesScalar) {
+    expectSameAsScalar<EngineFilterBiquad1Low>(kSampleRate, 1000.0, 0.7071, false);
+    expectSameAsScalar<EngineFilterBiquad1High>(kSampleRate, 1000.0, 0.7071, false);
+    expectSameAsScalar<EngineFilterBiquad1Band>(kSampleRate, 1000.0, 1.0);
+    expectSameAsScalar<EngineFilterBiquad1Peaking>(kSampleRate, 1000.0, 1.0);
+    expectSameAsScalar<EngineFilterBessel8Band>(kSampleRate, 250.0, 2500.0);
+    expectSameAsScalar<EngineFilterLinkwitzRiley8Low>(kSampleRate, 250.0);
+}
+
 TEST_F(EngineFilterBiquadTest, fidlibInputRespectsLocale) {
     char spec[FIDSPEC_LENGTH];
 
@@ -19,4 +83,51 @@ TEST_F(EngineFilterBiquadTest, fidspecLengthIsLongEnough) {
     ASSERT_TRUE(FIDSPEC_LENGTH > strlen("LsBq/1.2200000000/-12.0000000000"));
 }
 
+template<typename Filter, typename... Args>
+void benchmarkFilter(benchmark::State& state, Args... args) {
+    const int bufferSize = static_cast<int>(state.range(0));
+    Filter filter(args...);
+    filter.assumeSettled();
+    const std::vector<CSAMPLE> input = makeInput(bufferSize);
+    std::vector<CSAMPLE> output(bufferSize);
+    for (auto _ : state) {
+        filter.process(input.data(), output.data(), bufferSize);
+        benchmark::DoNotOptimize(output.data());
+    }
+    state.SetItemsProcessed(state.iterations() * bufferSize / 2);
+}
+
+void BM_EngineFilterBiquad1Peaking(benchmark::State& state) {
+    benchmarkFilter<EngineFilterBiquad1Peaking>(state, kSampleRate, 1000.0, 1.0);
+}
+BENCHMARK(BM_EngineFilterBiquad1Peaking)->Arg(kBufferSize);
+
+void BM_EngineFilterBiquad1Peaking_Scalar(benchmark::State& state) {
+    benchmarkFilter<ScalarFilter<EngineFilterBiquad1Peaking>>(
+            state, kSampleRate, 1000.0, 1.0);
+}
+BENCHMARK(BM_EngineFilterBiquad1Peaking_Scalar)->Arg(kBufferSize);
+
+void BM_EngineFilterBessel8Band(benchmark::State& state) {
+    benchmarkFilter<EngineFilterBessel8Band>(state, kSampleRate, 250.0, 2500.0);
+}
+BENCHMARK(BM_EngineFilterBessel8Band)->Arg(kBufferSize);
+
+void BM_EngineFilterBessel8Band_Scalar(benchmark::State& state) {
+    benchmarkFilter<ScalarFilter<EngineFilterBessel8Band>>(
+            state, kSampleRate, 250.0, 2500.0);
+}
+BENCHMARK(BM_EngineFilterBessel8Band_Scalar)->Arg(kBufferSize);
+
+void BM_EngineFilterLinkwitzRiley8Low(benchmark::State& state) {
+    benchmarkFilter<EngineFilterLinkwitzRiley8Low>(state, kSampleRate, 250.0);
+}
+BENCHMARK(BM_EngineFilterLinkwitzRiley8Low)->Arg(kBufferSize);
+
+void BM_EngineFilterLinkwitzRiley8Low_Scalar(benchmark::State& state) {
+    benchmarkFilter<ScalarFilter<EngineFilterLinkwitzRiley8Low>>(
+            state, kSampleRate, 250.0);
+}
+BENCHMARK(BM_EngineFilterLinkwitzRiley8Low_Scalar)->Arg(kBufferSize);
+
 } // namespace
@@ -0,0 +1,172 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QVector>
+#include <thread>
+
+#include "engine/engineprofiler.h"
+
+namespace {
+
+using Stage = EngineProfiler::Stage;
+
+class EngineProfilerTest : public testing::Test {
+  protected:
+    void SetUp() override {
+        EngineProfiler::registerThread();
+        EngineProfiler::reset();
+        QVector<EngineProfiler::TraceEvent> events;
+        EngineProfiler::readTraceEvents(&events);
+    }
+
+    void TearDown() override {
+        EngineProfiler::unregisterThread();
+    }
+
+    static EngineProfiler::StageStatistics statistics(Stage stage, int channel = -1) {
+        const auto statistics = EngineProfiler::statistics();
+        for (const auto& stats : statistics) {
+            if (stats.stage == stage && stats.channel == channel) {
+                return stats;
+            }
+        }
+        return EngineProfiler::StageStatistics();
+    }
+};
+
+TEST_F(EngineProfilerTest, CountSumAndMax) {
+    EngineProfiler::record(Stage::WakeWorkers, -1, 1000, 1100);
+    EngineProfiler::record(Stage::WakeWorkers, -1, 2000, 2200);
+    EngineProfiler::record(Stage::WakeWorkers, -1, 3000, 4000);
+
+    const auto stats = statistics(Stage::WakeWorkers);
+    EXPECT_EQ(3u, stats.count);
+    EXPECT_EQ(1300u, stats.sumNanos);
+    EXPECT_EQ(1000u, stats.maxNanos);
+    EXPECT_EQ(433, stats.averageNanos());
+    // Stages that have not been recorded are omitted
+    EXPECT_EQ(0u, statistics(Stage::Headphones).count);
+}
+
+TEST_F(EngineProfilerTest, ChannelsAreRecordedSeparately) {
+    EngineProfiler::record(Stage::Channel, 2, 0, 10);
+    EngineProfiler::record(Stage::Channel, 5, 0, 20);
+    EngineProfiler::record(Stage::Channel, 5, 0, 30);
+    EngineProfiler::record(Stage::ChannelEffects, 5, 0, 40);
+
+    EXPECT_EQ(1u, statistics(Stage::Channel, 2).count);
+    EXPECT_EQ(2u, statistics(Stage::Channel, 5).count);
+    EXPECT_EQ(1u, statistics(Stage::ChannelEffects, 5).count);
+    EXPECT_EQ(0u, statistics(Stage::ChannelEffects, 2).count);
+    EXPECT_EQ(0u, statistics(Stage::Channel).count);
+}
+
+TEST_F(EngineProfilerTest, NamesOfChannels) {
+    EngineProfiler::setChannelName(3, QStringLiteral("[Channel1]"));
+    EngineProfiler::record(Stage::Channel, 3, 0, 10);
+    EngineProfiler::record(Stage::Channels, -1, 0, 10);
+
+    EXPECT_EQ(QStringLiteral("Channel [Channel1]"), statistics(Stage::Channel, 3).name());
+    EXPECT_EQ(QStringLiteral("Channels"), statistics(Stage::Channels).name());
+}
+
+TEST_F(EngineProfilerTest, Percentiles) {
+    for (int i = 0; i < 99; ++i) {
+        EngineProfiler::record(Stage::Callback, -1, 0, 100);
+    }
+    EngineProfiler::record(Stage::Callback, -1, 0, 1000000);
+
+    const auto stats = statistics(Stage::Callback);
+    // 100 ns is in the bucket [64, 128)
+    EXPECT_EQ(127, stats.percentileNanos(0.5));
+    EXPECT_EQ(127, stats.percentileNanos(0.99));
+    // The upper bound of the last bucket is limited by the maximum
+    EXPECT_EQ(1000000, stats.percentileNanos(1.0));
+}
+
+TEST_F(EngineProfilerTest, ThreadsAreSummedUp) {
+    EngineProfiler::record(Stage::Sidechain, -1, 0, 100);
+    std::thread thread([] {
+        EngineProfiler::registerThread();
+        EngineProfiler::record(Stage::Sidechain, -1, 0, 300);
+        EngineProfiler::unregisterThread();
+    });
+    thread.join();
+
+    const auto stats = statistics(Stage::Sidechain);
+    EXPECT_EQ(2u, stats.count);
+    EXPECT_EQ(400u, stats.sumNanos);
+    EXPECT_EQ(300u, stats.maxNanos);
+}
+
+TEST_F(EngineProfilerTest, UnregisteredThreadsOnlyCountXruns) {
+    std::thread thread([] {
+        EngineProfiler::record(Stage::Sidechain, -1, 0, 300);
+        EngineProfiler::recordXrun();
+    });
+    thread.join();
+
+    EXPECT_EQ(0u, statistics(Stage::Sidechain).count);
+    const auto stats = statistics(Stage::Xrun);
+    EXPECT_EQ(1u, stats.count);
+    EXPECT_EQ(0u, stats.sumNanos);
+    EXPECT_EQ(1u, stats.buckets[0]);
+}
+
+TEST_F(EngineProfilerTest, UnregisterOnBehalfOfThread) {
+    const int slotIndex = EngineProfiler::registerThread();
+    ASSERT_LE(0, slotIndex);
+    // Registering again keeps the slot
+    EXPECT_EQ(slotIndex, EngineProfiler::registerThread());
+
+    std::thread thread([slotIndex] {
+        EngineProfiler::unregisterThread(slotIndex);
+    });
+    thread.join();
+
+    // The slot has been released and may be claimed by another thread
+    EngineProfiler::record(Stage::Headphones, -1, 0, 100);
+    EXPECT_EQ(0u, statistics(Stage::Headphones).count);
+
+    EngineProfiler::registerThread();
+    EngineProfiler::record(Stage::Headphones, -1, 0, 100);
+    EXPECT_EQ(1u, statistics(Stage::Headphones).count);
+}
+
+TEST_F(EngineProfilerTest, TraceEvents) {
+    EngineProfiler::enableTracing();
+    ASSERT_TRUE(EngineProfiler::isTracingEnabled());
+    EngineProfiler::record(Stage::Channel, 3, 1000, 1500);
+    EngineProfiler::recordXrun();
+
+    QVector<EngineProfiler::TraceEvent> events;
+    ASSERT_EQ(2, EngineProfiler::readTraceEvents(&events));
+    EXPECT_EQ(Stage::Channel, events[0].stage);
+    EXPECT_EQ(3, events[0].channel);
+    EXPECT_EQ(1000, events[0].startNanos);
+    EXPECT_EQ(500, events[0].durationNanos);
+    EXPECT_EQ(Stage::Xrun, events[1].stage);
+    EXPECT_EQ(0, events[1].durationNanos);
+    EXPECT_EQ(events[0].thread, events[1].thread);
+
+    // Events are only read once
+    EXPECT_EQ(0, EngineProfiler::readTraceEvents(&events));
+}
+
+TEST_F(EngineProfilerTest, ChannelNames) {
+    EngineProfiler::setChannelName(1, QStringLiteral("[Channel2]"));
+    EXPECT_EQ(QStringLiteral("[Channel2]"), EngineProfiler::channelName(1));
+    EXPECT_EQ(QStringLiteral("Channel 100"), EngineProfiler::channelName(100));
+}
+
+static void BM_EngineProfilerScope(benchmark::State& state) {
+    EngineProfiler::registerThread();
+    for (auto _ : state) {
+        EngineProfiler::Scope profilerScope(Stage::ChannelEffects, 1);
+        benchmark::ClobberMemory();
+    }
+    EngineProfiler::unregisterThread();
+}
+BENCHMARK(BM_EngineProfilerScope);
+
+} // namespace
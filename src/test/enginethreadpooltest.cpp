@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <atomic>
+#include <vector>
+
+#include "engine/enginethreadpool.h"
+#include "test/signalpathtest.h"
+
+namespace {
+
+struct RecordingContext {
+    std::vector<std::atomic<int>> runCount;
+    std::vector<Qt::HANDLE> threadIds;
+
+    explicit RecordingContext(int numTasks)
+            : runCount(numTasks),
+              threadIds(numTasks) {
+    }
+};
+
+void recordTask(void* pContext, int index) {
+    auto* pRecording = static_cast<RecordingContext*>(pContext);
+    pRecording->runCount[index].fetch_add(1);
+    pRecording->threadIds[index] = QThread::currentThreadId();
+}
+
+class EngineThreadPoolTest : public testing::Test {
+};
+
+TEST_F(EngineThreadPoolTest, RunsEachTaskExactlyOnce) {
+    EngineThreadPool pool(3);
+    for (int numTasks : {1, 2, 4, 7, 64}) {
+        RecordingContext recording(numTasks);
+        pool.run(recordTask, &recording, numTasks);
+        for (int i = 0; i < numTasks; ++i) {
+            EXPECT_EQ(1, recording.runCount[i].load()) << "task " << i;
+        }
+    }
+}
+
+TEST_F(EngineThreadPoolTest, FirstTaskRunsOnCallingThread) {
+    EngineThreadPool pool(2);
+    RecordingContext recording(6);
+    pool.run(recordTask, &recording, 6);
+    // Tasks are assigned round-robin with the calling thread as participant 0
+    EXPECT_EQ(QThread::currentThreadId(), recording.threadIds[0]);
+    EXPECT_EQ(QThread::currentThreadId(), recording.threadIds[3]);
+    EXPECT_NE(QThread::currentThreadId(), recording.threadIds[1]);
+    EXPECT_EQ(recording.threadIds[1], recording.threadIds[4]);
+    EXPECT_EQ(recording.threadIds[2], recording.threadIds[5]);
+}
+
+TEST_F(EngineThreadPoolTest, NoWorkersRunsSerially) {
+    EngineThreadPool pool(0);
+    RecordingContext recording(5);
+    pool.run(recordTask, &recording, 5);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(1, recording.runCount[i].load());
+        EXPECT_EQ(QThread::currentThreadId(), recording.threadIds[i]);
+    }
+}
+
+// Plays a sine in the three decks of a real EngineMaster
+class EngineMasterBenchmark final : public BaseSignalPathTest {
+  public:
+    EngineMasterBenchmark(int channelProcessingThreads, bool keylock)
+            : BaseSignalPathTest(channelProcessingThreads) {
+        const QString kTrackLocationTest = QDir::currentPath() + "/src/test/sine-30.wav";
+        TrackPointer pTrack(Track::newTemporary(kTrackLocationTest));
+        for (Deck* pDeck : {m_pMixerDeck1, m_pMixerDeck2, m_pMixerDeck3}) {
+            loadTrack(pDeck, pTrack);
+            const QString& group = pDeck->getGroup();
+            // With keylock and a changed tempo the expensive keylock
+            // scaler is used
+            ControlObject::set(ConfigKey(group, "keylock"), keylock ? 1.0 : 0.0);
+            ControlObject::set(ConfigKey(group, "rate"), 0.5);
+            ControlObject::set(ConfigKey(group, "play"), 1.0);
+        }
+    }
+
+    void process() {
+        m_pEngineMaster->process(kProcessBufferSize);
+    }
+
+  private:
+    // Never invoked, but required for instantiating testing::Test
+    void TestBody() override {
+    }
+};
+
+static void BM_EngineMasterProcess(benchmark::State& state) {
+    EngineMasterBenchmark engine(
+            static_cast<int>(state.range(0)), state.range(1) != 0);
+    for (auto _ : state) {
+        engine.process();
+    }
+}
+BENCHMARK(BM_EngineMasterProcess)
+        ->Args({1, 0})
+        ->Args({3, 0})
+        ->Args({1, 1})
+        ->Args({3, 1})
+        ->UseRealTime();
+
+} // namespace
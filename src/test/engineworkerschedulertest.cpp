@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <QThread>
+#include <atomic>
+
+#include "engine/engineworker.h"
+#include "engine/engineworkerscheduler.h"
+
+namespace {
+
+// Processes one item of work for every wake up that it gets from the
+// scheduler. Each item takes a while, so the test would fail if the
+// scheduler didn't wait for it.
+class SlowWorker : public EngineWorker {
+  public:
+    SlowWorker()
+            : m_pendingItems(0),
+              m_processedItems(0),
+              m_stop(false) {
+    }
+
+    void addItem() {
+        m_pendingItems.fetch_add(1);
+        workReady();
+    }
+
+    int processedItems() const {
+        return m_processedItems.load();
+    }
+
+    void quitWait() {
+        m_stop.store(true);
+        m_semaRun.release();
+        wait();
+    }
+
+    void run() override {
+        while (!m_stop.load()) {
+            if (m_pendingItems.load() > 0) {
+                QThread::msleep(20);
+                m_pendingItems.fetch_sub(1);
+                m_processedItems.fetch_add(1);
+            } else {
+                waitForWork();
+            }
+        }
+    }
+
+  private:
+    std::atomic<int> m_pendingItems;
+    std::atomic<int> m_processedItems;
+    std::atomic<bool> m_stop;
+};
+
+class EngineWorkerSchedulerTest : public testing::Test {
+  protected:
+    EngineWorkerScheduler m_scheduler;
+};
+
+TEST_F(EngineWorkerSchedulerTest, IdleWithoutWork) {
+    SlowWorker worker;
+    worker.setScheduler(&m_scheduler);
+    EXPECT_TRUE(worker.isIdle());
+    worker.start();
+    m_scheduler.runWorkersAndWaitUntilIdle();
+    EXPECT_TRUE(worker.isIdle());
+    EXPECT_EQ(0, worker.processedItems());
+    worker.quitWait();
+}
+
+TEST_F(EngineWorkerSchedulerTest, WaitsUntilWorkIsDone) {
+    SlowWorker worker;
+    worker.setScheduler(&m_scheduler);
+    worker.start();
+    for (int i = 1; i <= 3; ++i) {
+        worker.addItem();
+        m_scheduler.runWorkersAndWaitUntilIdle();
+        EXPECT_TRUE(worker.isIdle());
+        EXPECT_EQ(i, worker.processedItems());
+    }
+    worker.quitWait();
+}
+
+} // namespace
@@ -0,0 +1,117 @@
+#include <gmock/gmock.h>
+#include <hidapi.h>
+
+#include <QScopedPointer>
+
+#include "controllers/hid/hidcontroller.h"
+#include "test/mixxxtest.h"
+
+using ::testing::InSequence;
+
+namespace {
+
+hid_device_info emptyDeviceInfo() {
+    hid_device_info deviceInfo = {};
+    return deviceInfo;
+}
+
+} // namespace
+
+class MockHidController : public HidController {
+  public:
+    MockHidController()
+            : HidController(mixxx::hid::DeviceInfo(emptyDeviceInfo())) {
+    }
+    ~MockHidController() override {
+    }
+
+    using HidController::sendReport;
+
+    MOCK_METHOD0(open, int());
+    MOCK_METHOD0(close, int());
+    MOCK_METHOD2(writeOutputReport, void(QByteArray data, unsigned int reportID));
+};
+
+class HidControllerTest : public MixxxTest {
+  protected:
+    void SetUp() override {
+        m_pController.reset(new MockHidController());
+    }
+
+    void sendReport(unsigned int reportID, const QList<int>& data) {
+        m_pController->sendReport(data, data.size(), reportID);
+    }
+
+    static QByteArray bytes(const QList<int>& data) {
+        QByteArray result;
+        for (int datum : data) {
+            result.append(static_cast<char>(datum));
+        }
+        return result;
+    }
+
+    QScopedPointer<MockHidController> m_pController;
+};
+
+TEST_F(HidControllerTest, BatchSendsReportsInOrder) {
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01, 0x10}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x02, 0x20}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x03}), 2));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01, 0x11}), 1));
+    }
+
+    m_pController->beginOutputBatch();
+    sendReport(1, {0x01, 0x10});
+    sendReport(1, {0x02, 0x20});
+    sendReport(2, {0x03});
+    sendReport(1, {0x01, 0x11});
+    m_pController->endOutputBatch();
+}
+
+TEST_F(HidControllerTest, BatchDropsRepeatedReport) {
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x02}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01}), 1));
+    }
+
+    m_pController->beginOutputBatch();
+    sendReport(1, {0x01});
+    sendReport(1, {0x01});
+    sendReport(1, {0x02});
+    sendReport(1, {0x01});
+    m_pController->endOutputBatch();
+}
+
+TEST_F(HidControllerTest, BatchCoalescesFullStateReports) {
+    m_pController->setOutputReportCoalesced(1, true);
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x03, 0x30}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x04}), 2));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x05}), 2));
+    }
+
+    m_pController->beginOutputBatch();
+    sendReport(1, {0x01, 0x10});
+    sendReport(2, {0x04});
+    sendReport(1, {0x02, 0x20});
+    sendReport(2, {0x05});
+    sendReport(1, {0x03, 0x30});
+    m_pController->endOutputBatch();
+}
+
+TEST_F(HidControllerTest, SendsImmediatelyWithoutBatch) {
+    m_pController->setOutputReportCoalesced(1, true);
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01}), 1));
+        EXPECT_CALL(*m_pController, writeOutputReport(bytes({0x01}), 1));
+    }
+
+    sendReport(1, {0x01});
+    sendReport(1, {0x01});
+}
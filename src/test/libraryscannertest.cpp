@@ -1,15 +1,107 @@
-#include <gtest/gtest.h>
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
+#include <gtest/gtest.h>
 
-#include "test/librarytest.h"
+#include <QDateTime>
+#include <QEventLoop>
+#include <QFileInfo>
+#include <QSqlQuery>
+#include <QTemporaryDir>
 
+#include "library/dao/libraryhashdao.h"
+#include "library/library_prefs.h"
 #include "library/scanner/libraryscanner.h"
+#include "test/librarytest.h"
+#include "track/track.h"
+
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+const QString kEditedTitle = QStringLiteral("Edited in the library");
+
+} // anonymous namespace
 
 class LibraryScannerTest : public LibraryTest {
   protected:
     LibraryScannerTest()
             : m_libraryScanner(dbConnectionPooler(), config()) {
+        m_libraryHashDao.initialize(dbConnection());
+    }
+
+    // Adds a copy of a test file to the library and scans it
+    QString addTrackFile(const QString& subdirectory = QString()) {
+        QDir dir(m_libraryDir.path());
+        if (!subdirectory.isEmpty()) {
+            dir.mkdir(subdirectory);
+            dir = QDir(dir.filePath(subdirectory));
+        }
+        const QString trackPath = mixxx::FileInfo(dir.filePath(
+                QStringLiteral("track.mp3"))).location();
+        EXPECT_TRUE(mixxxtest::copyFile(
+                kTestDir.filePath(QStringLiteral("cover-test-jpg.mp3")),
+                trackPath));
+        internalCollection()->addDirectory(mixxx::FileInfo(m_libraryDir.path()));
+        scan();
+        return trackPath;
+    }
+
+    void scan(const QStringList& directories = QStringList()) {
+        if (!m_libraryScanner.isRunning()) {
+            m_libraryScanner.start();
+        }
+        QEventLoop eventLoop;
+        QObject::connect(&m_libraryScanner,
+                &LibraryScanner::scanFinished,
+                &eventLoop,
+                &QEventLoop::quit);
+        if (directories.isEmpty()) {
+            m_libraryScanner.scan();
+        } else {
+            ASSERT_TRUE(m_libraryScanner.scanDirectories(directories));
+        }
+        eventLoop.exec();
+    }
+
+    void setSyncTrackMetadata(bool enabled) {
+        config()->set(
+                mixxx::library::prefs::kSyncTrackMetadataConfigKey,
+                ConfigValue{enabled});
+    }
+
+    // Edits the title in the library without exporting it into the file
+    void editTitle(const QString& trackPath) {
+        setSyncTrackMetadata(false);
+        const auto pTrack = trackCollectionManager()->getTrackByRef(
+                TrackRef::fromFilePath(trackPath));
+        ASSERT_TRUE(pTrack);
+        pTrack->setTitle(kEditedTitle);
     }
+
+    static void touchFile(const QString& filePath) {
+        QFile file(filePath);
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        ASSERT_TRUE(file.setFileTime(
+                QDateTime::currentDateTime().addSecs(60),
+                QFileDevice::FileModificationTime));
+    }
+
+    QString titleInLibrary(const QString& trackPath) const {
+        const auto pTrack = trackCollectionManager()->getTrackByRef(
+                TrackRef::fromFilePath(trackPath));
+        return pTrack ? pTrack->getTitle() : QString();
+    }
+
+    bool isTrackFileDeleted(const QString& trackPath) const {
+        QSqlQuery query(dbConnection());
+        query.prepare(QStringLiteral(
+                "SELECT fs_deleted FROM track_locations WHERE location=:location"));
+        query.bindValue(":location", trackPath);
+        return query.exec() && query.next() && query.value(0).toBool();
+    }
+
+    const QTemporaryDir m_libraryDir;
+    LibraryHashDAO m_libraryHashDao;
     LibraryScanner m_libraryScanner;
 };
 
@@ -52,3 +144,155 @@ TEST_F(LibraryScannerTest, ScannerRoundtrip) {
     m_libraryScanner.changeScannerState(LibraryScanner::IDLE);
     EXPECT_EQ(m_libraryScanner.m_state, LibraryScanner::IDLE);
 }
+
+TEST_F(LibraryScannerTest, ReimportModifiedFileIfSyncEnabled) {
+    const QString trackPath = addTrackFile();
+    editTitle(trackPath);
+
+    touchFile(trackPath);
+    setSyncTrackMetadata(true);
+    scan();
+
+    EXPECT_NE(kEditedTitle, titleInLibrary(trackPath));
+}
+
+TEST_F(LibraryScannerTest, KeepMetadataOfModifiedFileIfSyncDisabled) {
+    const QString trackPath = addTrackFile();
+    editTitle(trackPath);
+
+    touchFile(trackPath);
+    setSyncTrackMetadata(false);
+    scan();
+
+    EXPECT_EQ(kEditedTitle, titleInLibrary(trackPath));
+}
+
+TEST_F(LibraryScannerTest, KeepMetadataOfUnchangedFile) {
+    const QString trackPath = addTrackFile();
+    editTitle(trackPath);
+
+    setSyncTrackMetadata(true);
+    scan();
+
+    EXPECT_EQ(kEditedTitle, titleInLibrary(trackPath));
+}
+
+TEST_F(LibraryScannerTest, PartialScanOfMissingDirectory) {
+    const QString trackPath = addTrackFile(QStringLiteral("subdir"));
+    const QString dirPath = QFileInfo(trackPath).absolutePath();
+    ASSERT_TRUE(mixxx::isValidCacheKey(m_libraryHashDao.getDirectoryHash(dirPath)));
+    ASSERT_FALSE(isTrackFileDeleted(trackPath));
+
+    ASSERT_TRUE(QDir(dirPath).removeRecursively());
+    scan(QStringList{dirPath});
+
+    EXPECT_FALSE(mixxx::isValidCacheKey(m_libraryHashDao.getDirectoryHash(dirPath)));
+    EXPECT_TRUE(isTrackFileDeleted(trackPath));
+}
+
+namespace {
+
+const QStringList kTemplateFileNames = {
+        QStringLiteral("cover-test-jpg.mp3"),
+        QStringLiteral("cover-test.flac"),
+        QStringLiteral("cover-test.ogg"),
+        QStringLiteral("cover-test.wav"),
+};
+
+constexpr int kSyntheticDirs = 50;
+constexpr int kSyntheticFilesPerDir = 20;
+
+/// A synthetic library with copies of the test files in
+/// multiple directories.
+class SyntheticLibrary {
+  public:
+    SyntheticLibrary()
+            : m_numFiles(0) {
+        const QDir rootDir(m_rootDir.path());
+        for (int i = 0; i < kSyntheticDirs; ++i) {
+            const QString dirName = QStringLiteral("dir%1").arg(i);
+            rootDir.mkdir(dirName);
+            const QDir dir(rootDir.filePath(dirName));
+            for (int j = 0; j < kSyntheticFilesPerDir; ++j) {
+                const QString& templateFileName =
+                        kTemplateFileNames[j % kTemplateFileNames.size()];
+                const QString fileName = QStringLiteral("track%1.%2")
+                                                 .arg(j)
+                                                 .arg(QFileInfo(templateFileName).suffix());
+                if (mixxxtest::copyFile(
+                            kTestDir.filePath(templateFileName),
+                            dir.filePath(fileName))) {
+                    ++m_numFiles;
+                }
+            }
+        }
+    }
+
+    QString rootPath() const {
+        return m_rootDir.path();
+    }
+
+    int numFiles() const {
+        return m_numFiles;
+    }
+
+  private:
+    const QTemporaryDir m_rootDir;
+    int m_numFiles;
+};
+
+/// Scans the synthetic library into an empty database.
+class LibraryScannerBenchmark {
+  public:
+    LibraryScannerBenchmark(const SyntheticLibrary& library, int threadCount) {
+        m_library.config()->setValue(
+                mixxx::library::prefs::kScannerThreadCountConfigKey,
+                threadCount);
+        m_library.internalCollection()->addDirectory(
+                mixxx::FileInfo(library.rootPath()));
+        m_pLibraryScanner = std::make_unique<LibraryScanner>(
+                m_library.dbConnectionPooler(), m_library.config());
+        m_pLibraryScanner->start();
+    }
+
+    void scan() {
+        QEventLoop eventLoop;
+        QObject::connect(m_pLibraryScanner.get(),
+                &LibraryScanner::scanFinished,
+                &eventLoop,
+                &QEventLoop::quit);
+        m_pLibraryScanner->scan();
+        eventLoop.exec();
+    }
+
+  private:
+    BenchmarkLibrary m_library;
+    std::unique_ptr<LibraryScanner> m_pLibraryScanner;
+};
+
+static void BM_LibraryScannerAddNewFiles(benchmark::State& state) {
+    const SyntheticLibrary library;
+    const int threadCount = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            LibraryScannerBenchmark scanner(library, threadCount);
+            state.ResumeTiming();
+            scanner.scan();
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.counters["files/s"] = benchmark::Counter(
+            library.numFiles(),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_LibraryScannerAddNewFiles)
+        ->Arg(1)
+        ->Arg(2)
+        ->Arg(4)
+        ->Arg(8)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+} // namespace
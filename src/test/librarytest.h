@@ -31,3 +31,20 @@ class LibraryTest : public MixxxDbTest, SoundSourceProviderRegistration {
     const std::unique_ptr<TrackCollectionManager> m_pTrackCollectionManager;
     ControlObject m_keyNotationCO;
 };
+
+/// Provides the database and the track collections of a LibraryTest
+/// to benchmarks, which do not run as test cases of a fixture.
+class BenchmarkLibrary final : public LibraryTest {
+  public:
+    BenchmarkLibrary() = default;
+
+    using LibraryTest::config;
+    using LibraryTest::dbConnectionPooler;
+    using LibraryTest::internalCollection;
+    using LibraryTest::trackCollectionManager;
+
+  private:
+    // Never invoked, but required for instantiating testing::Test
+    void TestBody() override {
+    }
+};
@@ -51,6 +51,13 @@ class MidiControllerTest : public MixxxTest {
                 value);
     }
 
+    void sendOrQueueShortMsg(MidiOpCode opcode, uint8_t channel, uint8_t control, uint8_t value) {
+        m_pController->sendOrQueueShortMsg(
+                MidiUtils::statusFromOpCodeAndChannel(opcode, channel),
+                control,
+                value);
+    }
+
     std::shared_ptr<LegacyMidiControllerMapping> m_pMapping;
     QScopedPointer<MockMidiController> m_pController;
 };
@@ -596,3 +603,61 @@ TEST_F(MidiControllerTest, ReceiveMessage_PotMeterCO_14BitPitchBend) {
     receivedShortMessage(MidiOpCode::PitchBendChange, channel, 0x01, 0x40);
     EXPECT_LT(kMiddleValue, potmeter.get());
 }
+
+TEST_F(MidiControllerTest, OutputBatch_SendsLatestMessagePerLed) {
+    const unsigned char noteOn =
+            MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::NoteOn, 0x00);
+    const unsigned char noteOff =
+            MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::NoteOff, 0x00);
+    const unsigned char cc =
+            MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::ControlChange, 0x01);
+    const unsigned char pitchBend =
+            MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::PitchBendChange, 0x00);
+
+    // Messages are only sent when the batch is closed, in the order in
+    // which each LED was first addressed.
+    EXPECT_CALL(*m_pController, sendShortMsg(testing::_, testing::_, testing::_)).Times(0);
+    m_pController->beginOutputBatch();
+    sendOrQueueShortMsg(MidiOpCode::NoteOn, 0x00, 0x10, 0x7F);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x01, 0x20, 0x01);
+    sendOrQueueShortMsg(MidiOpCode::NoteOff, 0x00, 0x10, 0x00);
+    sendOrQueueShortMsg(MidiOpCode::PitchBendChange, 0x00, 0x00, 0x40);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x01, 0x20, 0x02);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x01, 0x20, 0x03);
+    testing::Mock::VerifyAndClearExpectations(m_pController.data());
+
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(*m_pController, sendShortMsg(noteOff, 0x10, 0x00));
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 0x20, 0x03));
+        EXPECT_CALL(*m_pController, sendShortMsg(pitchBend, 0x00, 0x40));
+        EXPECT_CALL(*m_pController, sendShortMsg(noteOn, 0x11, 0x7F));
+    }
+    m_pController->endOutputBatch();
+
+    // Outside of a batch, messages are sent immediately.
+    sendOrQueueShortMsg(MidiOpCode::NoteOn, 0x00, 0x11, 0x7F);
+}
+
+TEST_F(MidiControllerTest, OutputBatch_SendsAllParameterNumberMessages) {
+    const unsigned char cc =
+            MidiUtils::statusFromOpCodeAndChannel(MidiOpCode::ControlChange, 0x00);
+
+    m_pController->beginOutputBatch();
+    // Set NRPN 0x0102 to 0x10 and NRPN 0x0103 to 0x20
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x00, 99, 0x01);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x00, 98, 0x02);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x00, 6, 0x10);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x00, 98, 0x03);
+    sendOrQueueShortMsg(MidiOpCode::ControlChange, 0x00, 6, 0x20);
+
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 99, 0x01));
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 98, 0x02));
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 6, 0x10));
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 98, 0x03));
+        EXPECT_CALL(*m_pController, sendShortMsg(cc, 6, 0x20));
+    }
+    m_pController->endOutputBatch();
+}
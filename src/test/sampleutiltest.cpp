@@ -4,6 +4,7 @@
 #include <QList>
 #include <QPair>
 #include <QtDebug>
+#include <cmath>
 #include <vector>
 
 #include "util/sample.h"
@@ -397,6 +398,47 @@ TEST_F(SampleUtilTest, copyReverse) {
     }
 }
 
+TEST_F(SampleUtilTest, instructionSetsProduceSameResults) {
+    constexpr SINT kSize = 1026;
+    std::vector<CSAMPLE> src1(kSize);
+    std::vector<CSAMPLE> src2(kSize);
+    std::vector<CSAMPLE> src3(kSize);
+    for (SINT i = 0; i < kSize; ++i) {
+        src1[i] = static_cast<CSAMPLE>(std::sin(i * 0.1));
+        src2[i] = static_cast<CSAMPLE>(std::cos(i * 0.3));
+        src3[i] = static_cast<CSAMPLE>(i % 7) * 0.25f;
+    }
+    const auto process = [&]() {
+        std::vector<CSAMPLE> dest(kSize, 0.5f);
+        SampleUtil::add3WithGain(dest.data(),
+                src1.data(), 0.5f, src2.data(), 0.7f, src3.data(), 1.3f, kSize);
+        SampleUtil::applyRampingGain(dest.data(), 0.2f, 0.8f, kSize);
+        // The buffers of the copy functions must not overlap
+        std::vector<CSAMPLE> copy(kSize);
+        SampleUtil::copyWithRampingGain(copy.data(), dest.data(), 1.5f, 0.5f, kSize);
+        SampleUtil::copyWithGain(dest.data(), copy.data(), 0.9f, kSize);
+        std::vector<SAMPLE> result(kSize);
+        SampleUtil::convertFloat32ToS16(result.data(), dest.data(), kSize);
+        return result;
+    };
+
+    const SampleUtil::InstructionSet selected = SampleUtil::instructionSet();
+    ASSERT_TRUE(SampleUtil::setInstructionSet(SampleUtil::InstructionSet::Baseline));
+    const std::vector<SAMPLE> expected = process();
+    for (const auto instructionSet : {SampleUtil::InstructionSet::Avx2,
+                 SampleUtil::InstructionSet::Avx512}) {
+        if (!SampleUtil::setInstructionSet(instructionSet)) {
+            continue;
+        }
+        const std::vector<SAMPLE> actual = process();
+        for (SINT i = 0; i < kSize; ++i) {
+            // FMA may round differently
+            EXPECT_NEAR(expected[i], actual[i], 1) << "sample " << i;
+        }
+    }
+    SampleUtil::setInstructionSet(selected);
+}
+
 static void BM_MemCpy(benchmark::State& state) {
     SINT size = static_cast<SINT>(state.range(0));
     CSAMPLE* buffer = SampleUtil::alloc(size);
@@ -583,4 +625,123 @@ static void BM_Copy2WithRampingGain(benchmark::State& state) {
 }
 BENCHMARK(BM_Copy2WithRampingGain)->Range(64, 4096);
 
+// Runs a benchmark for each instruction set that is supported by the CPU
+class ScopedInstructionSet {
+  public:
+    explicit ScopedInstructionSet(benchmark::State& state)
+            : m_previous(SampleUtil::instructionSet()) {
+        const auto instructionSet =
+                static_cast<SampleUtil::InstructionSet>(state.range(1));
+        m_supported = SampleUtil::setInstructionSet(instructionSet);
+        if (!m_supported) {
+            state.SkipWithError("Instruction set not supported by the CPU");
+        }
+    }
+    ~ScopedInstructionSet() {
+        SampleUtil::setInstructionSet(m_previous);
+    }
+
+    bool isSupported() const {
+        return m_supported;
+    }
+
+  private:
+    const SampleUtil::InstructionSet m_previous;
+    bool m_supported;
+};
+
+static void instructionSetArgs(benchmark::internal::Benchmark* pBenchmark) {
+    pBenchmark->ArgNames({"size", "isa"});
+    for (const auto instructionSet : {SampleUtil::InstructionSet::Baseline,
+                 SampleUtil::InstructionSet::Avx2,
+                 SampleUtil::InstructionSet::Avx512}) {
+        pBenchmark->Args({1024, static_cast<int64_t>(instructionSet)});
+    }
+}
+
+static void BM_CopyWithRampingGain(benchmark::State& state) {
+    ScopedInstructionSet scopedInstructionSet(state);
+    if (!scopedInstructionSet.isSupported()) {
+        return;
+    }
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.1f, size);
+
+    for (auto _ : state) {
+        SampleUtil::copyWithRampingGain(buffer, buffer2, 1.1f, 1.2f, size);
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+}
+BENCHMARK(BM_CopyWithRampingGain)->Apply(instructionSetArgs);
+
+static void BM_ApplyRampingGain(benchmark::State& state) {
+    ScopedInstructionSet scopedInstructionSet(state);
+    if (!scopedInstructionSet.isSupported()) {
+        return;
+    }
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.1f, size);
+
+    for (auto _ : state) {
+        SampleUtil::applyRampingGain(buffer, 1.0f, 1.0001f, size);
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_ApplyRampingGain)->Apply(instructionSetArgs);
+
+static void BM_Add3WithGain(benchmark::State& state) {
+    ScopedInstructionSet scopedInstructionSet(state);
+    if (!scopedInstructionSet.isSupported()) {
+        return;
+    }
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.0f, size);
+    CSAMPLE* buffer2 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer2, 0.1f, size);
+    CSAMPLE* buffer3 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer3, 0.2f, size);
+    CSAMPLE* buffer4 = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer4, 0.3f, size);
+
+    for (auto _ : state) {
+        SampleUtil::add3WithGain(buffer, buffer2, 0.1f, buffer3, 0.2f, buffer4, 0.3f, size);
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(buffer);
+    SampleUtil::free(buffer2);
+    SampleUtil::free(buffer3);
+    SampleUtil::free(buffer4);
+}
+BENCHMARK(BM_Add3WithGain)->Apply(instructionSetArgs);
+
+static void BM_ConvertFloat32ToS16(benchmark::State& state) {
+    ScopedInstructionSet scopedInstructionSet(state);
+    if (!scopedInstructionSet.isSupported()) {
+        return;
+    }
+    SINT size = static_cast<SINT>(state.range(0));
+    CSAMPLE* buffer = SampleUtil::alloc(size);
+    SampleUtil::fill(buffer, 0.5f, size);
+    std::vector<SAMPLE> output(size);
+
+    for (auto _ : state) {
+        SampleUtil::convertFloat32ToS16(output.data(), buffer, size);
+        benchmark::ClobberMemory();
+    }
+
+    SampleUtil::free(buffer);
+}
+BENCHMARK(BM_ConvertFloat32ToS16)->Apply(instructionSetArgs);
+
 }  // namespace
@@ -3,6 +3,7 @@
 #include <QDir>
 #include <QtDebug>
 
+#include "library/dao/tracksearchindex.h"
 #include "library/searchqueryparser.h"
 #include "test/librarytest.h"
 #include "track/track.h"
@@ -996,3 +997,90 @@ TEST_F(SearchQueryParserTest, CrateFilterWithCrateFilterAndNegation){
                             ") AND (NOT (" + m_crateFilterQuery.arg(searchTermB) + "))"),
                  qPrintable(pQueryB->toSql()));
 }
+
+TEST_F(SearchQueryParserTest, TextFilterWithSearchIndex) {
+    const TrackSearchIndex& searchIndex =
+            internalCollection()->getTrackDAO().searchIndex();
+    if (!searchIndex.isAvailable()) {
+        qWarning() << "Full-text search is not supported by SQLite";
+        return;
+    }
+    m_parser.setSearchIndex(&searchIndex);
+
+    const QString kTrackALocationTest(QDir::currentPath() %
+            "/src/test/id3-test-data/cover-test-jpg.mp3");
+    const QString kTrackBLocationTest(QDir::currentPath() %
+            "/src/test/id3-test-data/cover-test-png.mp3");
+    const TrackId trackAId = addTrackToCollection(kTrackALocationTest);
+    const TrackId trackBId = addTrackToCollection(kTrackBLocationTest);
+    ASSERT_TRUE(trackAId.isValid());
+    ASSERT_TRUE(trackBId.isValid());
+
+    // The same view as used by the internal library
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec(
+            "CREATE TEMP VIEW search_test_view AS "
+            "SELECT library.id,library.artist,track_locations.location "
+            "FROM library INNER JOIN track_locations "
+            "ON library.location=track_locations.id"));
+    const auto selectTrackIds = [&query](const QString& filter) {
+        QList<TrackId> trackIds;
+        if (!query.exec("SELECT id FROM search_test_view WHERE " + filter)) {
+            return trackIds;
+        }
+        while (query.next()) {
+            trackIds.append(TrackId(query.value(0)));
+        }
+        return trackIds;
+    };
+
+    const QStringList searchColumns = {"artist", "location"};
+    auto pQuery = m_parser.parseQuery("Test-JPG", searchColumns, "");
+    EXPECT_TRUE(pQuery->toSql().startsWith("id IN (SELECT rowid FROM track_search"));
+    EXPECT_EQ(QList<TrackId>{trackAId}, selectTrackIds(pQuery->toSql()));
+
+    // The index is updated when a track is relocated
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE track_locations SET location='/music/relocated.mp3' "
+            "WHERE location='%1'")
+                                   .arg(kTrackALocationTest)));
+    EXPECT_TRUE(selectTrackIds(pQuery->toSql()).isEmpty());
+    pQuery = m_parser.parseQuery("RELOCATED", searchColumns, "");
+    EXPECT_EQ(QList<TrackId>{trackAId}, selectTrackIds(pQuery->toSql()));
+
+    // Too short for the index
+    pQuery = m_parser.parseQuery("mp", searchColumns, "");
+    EXPECT_EQ(QString("(artist LIKE '%mp%') OR (location LIKE '%mp%')"),
+            pQuery->toSql());
+}
+
+TEST_F(SearchQueryParserTest, SearchIndexIsRebuiltAfterExternalModification) {
+    if (!internalCollection()->getTrackDAO().searchIndex().isAvailable()) {
+        qWarning() << "Full-text search is not supported by SQLite";
+        return;
+    }
+    const TrackId trackId = addTrackToCollection(QDir::currentPath() %
+            "/src/test/id3-test-data/cover-test-jpg.mp3");
+    ASSERT_TRUE(trackId.isValid());
+
+    // Modify the library like an application without the temporary triggers
+    QSqlQuery query(dbConnection());
+    ASSERT_TRUE(query.exec("DROP TRIGGER temp.track_search_update"));
+    ASSERT_TRUE(query.exec(QStringLiteral(
+            "UPDATE library SET artist='Externally Modified' WHERE id=%1")
+                                   .arg(trackId.toString())));
+    ASSERT_TRUE(query.exec(
+            "SELECT library_version=index_version FROM track_search_version"));
+    ASSERT_TRUE(query.next());
+    EXPECT_FALSE(query.value(0).toBool());
+
+    TrackSearchIndex searchIndex;
+    searchIndex.initialize(dbConnection());
+    ASSERT_TRUE(searchIndex.isAvailable());
+    m_parser.setSearchIndex(&searchIndex);
+
+    const auto pQuery = m_parser.parseQuery("externally", {"artist"}, "");
+    ASSERT_TRUE(query.exec("SELECT id FROM library WHERE " + pQuery->toSql()));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(trackId, TrackId(query.value(0)));
+}
@@ -72,7 +72,10 @@ class TestEngineMaster : public EngineMaster {
 
 class BaseSignalPathTest : public MixxxTest, SoundSourceProviderRegistration {
   protected:
-    BaseSignalPathTest() {
+    explicit BaseSignalPathTest(int channelProcessingThreads = 1) {
+        config()->setValue(
+                ConfigKey(m_sMasterGroup, "channel_processing_threads"),
+                channelProcessingThreads);
         m_pControlIndicatorTimer = std::make_unique<mixxx::ControlIndicatorTimer>();
         m_pChannelHandleFactory = std::make_shared<ChannelHandleFactory>();
         m_pNumDecks = new ControlObject(ConfigKey(m_sMasterGroup, "num_decks"));
@@ -0,0 +1,151 @@
+#include "analyzer/trackanalysisscheduler.h"
+
+#include <gtest/gtest.h>
+
+#include <QCoreApplication>
+
+#include "test/mixxxdbtest.h"
+#include "track/track.h"
+
+namespace {
+
+using Priority = TrackAnalysisScheduler::Priority;
+
+/// Records the ids of all tracks that the scheduler tries to load and
+/// skips them.
+class RecordingEnvironment : public TrackAnalysisSchedulerEnvironment {
+  public:
+    explicit RecordingEnvironment(QList<TrackId>* pLoadedTrackIds)
+            : m_pLoadedTrackIds(pLoadedTrackIds) {
+    }
+
+    TrackPointer loadTrackById(TrackId trackId) const override {
+        m_pLoadedTrackIds->append(trackId);
+        return TrackPointer();
+    }
+
+  private:
+    QList<TrackId>* const m_pLoadedTrackIds;
+};
+
+} // anonymous namespace
+
+class TrackAnalysisSchedulerTest : public MixxxDbTest {
+  protected:
+    TrackAnalysisScheduler::Pointer createScheduler(
+            int numWorkerThreads, const QString& group) {
+        return TrackAnalysisScheduler::createInstance(
+                std::make_unique<RecordingEnvironment>(&m_loadedTrackIds),
+                numWorkerThreads,
+                dbConnectionPooler(),
+                config(),
+                AnalyzerModeFlags::None,
+                group);
+    }
+
+    void TearDown() override {
+        QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+    }
+
+    QList<TrackId> m_loadedTrackIds;
+};
+
+TEST_F(TrackAnalysisSchedulerTest, preemptNothingWhileNotSaturated) {
+    const std::vector<std::optional<Priority>> trackPriorities = {
+            Priority::Batch,
+            std::nullopt,
+            std::nullopt,
+    };
+    EXPECT_EQ(std::vector<bool>({false, false, false}),
+            TrackAnalysisScheduler::selectPreemptedWorkers(
+                    trackPriorities, Priority::DeckLoad, 2));
+}
+
+TEST_F(TrackAnalysisSchedulerTest, preemptOneWorkerForQueuedTrack) {
+    const std::vector<std::optional<Priority>> trackPriorities = {
+            Priority::Batch,
+            Priority::Batch,
+            std::nullopt,
+    };
+    // The queued track waits for a worker that analyzes a track
+    // with the same priority
+    EXPECT_EQ(std::vector<bool>({false, false, false}),
+            TrackAnalysisScheduler::selectPreemptedWorkers(
+                    trackPriorities, Priority::Batch, 2));
+    // Only the last worker makes room for the queued track
+    EXPECT_EQ(std::vector<bool>({false, true, false}),
+            TrackAnalysisScheduler::selectPreemptedWorkers(
+                    trackPriorities, Priority::DeckLoad, 2));
+}
+
+TEST_F(TrackAnalysisSchedulerTest, preemptWorkersWithLowestPriority) {
+    const std::vector<std::optional<Priority>> trackPriorities = {
+            Priority::Batch,
+            Priority::Preview,
+            Priority::DeckLoad,
+    };
+    EXPECT_EQ(std::vector<bool>({true, false, false}),
+            TrackAnalysisScheduler::selectPreemptedWorkers(
+                    trackPriorities, std::nullopt, 2));
+    EXPECT_EQ(std::vector<bool>({true, true, false}),
+            TrackAnalysisScheduler::selectPreemptedWorkers(
+                    trackPriorities, std::nullopt, 1));
+}
+
+TEST_F(TrackAnalysisSchedulerTest, submitTracksInOrderOfLanes) {
+    auto pScheduler = createScheduler(1, QStringLiteral("[TrackAnalysisSchedulerTest]"));
+    pScheduler->scheduleTracksById(
+            QList<TrackId>{TrackId(1), TrackId(2)}, Priority::Batch);
+    pScheduler->scheduleTrackById(TrackId(3), Priority::DeckLoad);
+    pScheduler->scheduleTrackById(TrackId(4), Priority::Preview);
+    pScheduler->scheduleTrackById(TrackId(5), Priority::DeckLoad);
+
+    // None of the tracks can be loaded, so all of them are skipped
+    EXPECT_FALSE(pScheduler->submitNextTrack(&pScheduler->m_workers.front()));
+    EXPECT_EQ((QList<TrackId>{TrackId(3), TrackId(5), TrackId(4), TrackId(1), TrackId(2)}),
+            m_loadedTrackIds);
+}
+
+TEST_F(TrackAnalysisSchedulerTest, deckLoadPreemptsBatchOfOtherScheduler) {
+    auto pDeckScheduler = createScheduler(1, QStringLiteral("[TrackAnalysisSchedulerTestDeck]"));
+    auto pBatchScheduler = createScheduler(1, QStringLiteral("[TrackAnalysisSchedulerTestBatch]"));
+    auto& deckWorker = pDeckScheduler->m_workers.front();
+    auto& batchWorker = pBatchScheduler->m_workers.front();
+
+    ASSERT_TRUE(batchWorker.submitNextTrack(
+            Track::newTemporary(), Priority::Batch));
+    pBatchScheduler->updatePreemption();
+    EXPECT_FALSE(batchWorker.isPreempted());
+
+    // A track loaded into a deck is analyzed at the same time
+    ASSERT_TRUE(deckWorker.submitNextTrack(
+            Track::newTemporary(), Priority::DeckLoad));
+    pDeckScheduler->updatePreemption();
+    EXPECT_FALSE(deckWorker.isPreempted());
+    EXPECT_TRUE(batchWorker.isPreempted());
+    EXPECT_FALSE(pBatchScheduler->canAnalyzeTrack(Priority::Batch));
+
+    // The batch analysis continues when the deck track is done
+    deckWorker.onTrackDone();
+    pDeckScheduler->updatePreemption();
+    EXPECT_FALSE(batchWorker.isPreempted());
+}
+
+TEST_F(TrackAnalysisSchedulerTest, startReservedWorkerOnDemand) {
+    auto pScheduler = createScheduler(1, QStringLiteral("[TrackAnalysisSchedulerTest]"));
+    ASSERT_EQ(1u, pScheduler->m_workers.size());
+    ASSERT_TRUE(pScheduler->m_workers.front().submitNextTrack(
+            Track::newTemporary(), Priority::Batch));
+
+    // Tracks with the same priority wait for the busy worker
+    pScheduler->scheduleTrackById(TrackId(1), Priority::Batch);
+    pScheduler->updatePreemption();
+    EXPECT_EQ(1u, pScheduler->m_workers.size());
+
+    // The busy worker is preempted in favor of the additional worker
+    pScheduler->scheduleTrackById(TrackId(2), Priority::DeckLoad);
+    pScheduler->updatePreemption();
+    ASSERT_EQ(2u, pScheduler->m_workers.size());
+    EXPECT_TRUE(pScheduler->m_workers.front().isPreempted());
+    EXPECT_FALSE(pScheduler->m_workers.back().isPreempted());
+}
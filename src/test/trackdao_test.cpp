@@ -1,11 +1,44 @@
+#include <benchmark/benchmark.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <QTemporaryDir>
+
+#include "library/coverartutils.h"
 #include "test/librarytest.h"
 #include "track/track.h"
 
 using ::testing::UnorderedElementsAre;
 
+namespace {
+
+const QDir kTestDir(QDir::current().absoluteFilePath("src/test/id3-test-data"));
+
+/// Creates copies of a test file, because only existing files
+/// can be added to the library.
+QList<mixxx::FileAccess> copyTestFiles(const QTemporaryDir& tempDir, int numFiles) {
+    const QDir dir(tempDir.path());
+    QList<mixxx::FileAccess> files;
+    files.reserve(numFiles);
+    for (int i = 0; i < numFiles; ++i) {
+        const QString filePath = dir.filePath(QStringLiteral("track%1.mp3").arg(i));
+        if (mixxxtest::copyFile(
+                    kTestDir.filePath(QStringLiteral("cover-test-jpg.mp3")),
+                    filePath)) {
+            files.append(mixxx::FileAccess(mixxx::FileInfo(filePath)));
+        }
+    }
+    return files;
+}
+
+void setTitles(const QList<TrackPointer>& tracks, const QString& prefix) {
+    for (int i = 0; i < tracks.size(); ++i) {
+        tracks[i]->setTitle(prefix + QString::number(i));
+    }
+}
+
+} // anonymous namespace
+
 class TrackDAOTest : public LibraryTest {
 };
 
@@ -56,3 +89,150 @@ TEST_F(TrackDAOTest, detectMovedTracks) {
     QSet<QString> trackLocations = trackDAO.getAllTrackLocations();
     EXPECT_THAT(trackLocations, UnorderedElementsAre(newFile.location(), otherFile.location()));
 }
+
+TEST_F(TrackDAOTest, addAndSaveTracks) {
+    TrackDAO& trackDAO = internalCollection()->getTrackDAO();
+
+    constexpr int kNumTracks = 20;
+    const QTemporaryDir tempDir;
+    ASSERT_TRUE(tempDir.isValid());
+    const QList<mixxx::FileAccess> files = copyTestFiles(tempDir, kNumTracks);
+    ASSERT_EQ(kNumTracks, files.size());
+
+    const QList<TrackPointer> tracks = trackDAO.addTracks(files, false);
+    ASSERT_EQ(kNumTracks, tracks.size());
+    QSet<TrackId> trackIds;
+    for (const auto& pTrack : tracks) {
+        const TrackId trackId = pTrack->getId();
+        ASSERT_TRUE(trackId.isValid());
+        trackIds.insert(trackId);
+        // The new tracks must have been registered in GlobalTrackCache
+        EXPECT_EQ(pTrack, trackCollectionManager()->getTrackById(trackId));
+    }
+    EXPECT_EQ(kNumTracks, trackIds.size());
+
+    setTitles(tracks, QStringLiteral("Updated "));
+    QSet<TrackId> cleanTrackIds;
+    QObject::connect(&trackDAO,
+            &TrackDAO::trackClean,
+            [&cleanTrackIds](TrackId trackId) {
+                cleanTrackIds.insert(trackId);
+            });
+    trackDAO.saveTracks(tracks);
+    EXPECT_EQ(trackIds, cleanTrackIds);
+
+    QSqlQuery query(dbConnection());
+    query.prepare("SELECT title FROM library WHERE id=:id");
+    for (int i = 0; i < kNumTracks; ++i) {
+        EXPECT_FALSE(tracks[i]->isDirty());
+        query.bindValue(":id", tracks[i]->getId().toVariant());
+        ASSERT_TRUE(query.exec());
+        ASSERT_TRUE(query.next());
+        EXPECT_EQ(QStringLiteral("Updated %1").arg(i), query.value(0).toString());
+    }
+}
+
+namespace {
+
+/// Adds new files including parsing their metadata, which takes most of
+/// the time.
+static void BM_TrackDAOAddTracks(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    const QTemporaryDir tempDir;
+    const QList<mixxx::FileAccess> files = copyTestFiles(tempDir, numTracks);
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            BenchmarkLibrary library;
+            state.ResumeTiming();
+            library.internalCollection()->getTrackDAO().addTracks(files, false);
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.counters["tracks/s"] = benchmark::Counter(
+            files.size(),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_TrackDAOAddTracks)
+        ->Arg(1000)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+/// Adds new files whose metadata has been imported in advance like while
+/// scanning the library, either one by one in separate transactions
+/// (state.range(1) == 0) or in a single batch.
+static void BM_TrackDAOAddImportedTracks(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    const bool batched = state.range(1) != 0;
+    const QTemporaryDir tempDir;
+    const QList<mixxx::FileAccess> files = copyTestFiles(tempDir, numTracks);
+    CoverInfoGuesser coverInfoGuesser;
+    for (auto _ : state) {
+        state.PauseTiming();
+        {
+            BenchmarkLibrary library;
+            TrackDAO& trackDAO = library.internalCollection()->getTrackDAO();
+            QList<SoundSourceProxy::NewTrackImport> newTrackImports;
+            newTrackImports.reserve(files.size());
+            for (const auto& fileAccess : files) {
+                newTrackImports.append(SoundSourceProxy::importNewTrackFromFile(
+                        fileAccess, &coverInfoGuesser));
+            }
+            state.ResumeTiming();
+            if (batched) {
+                trackDAO.addTracks(files, std::move(newTrackImports), false);
+            } else {
+                for (int i = 0; i < files.size(); ++i) {
+                    trackDAO.addTracks({files[i]}, {std::move(newTrackImports[i])}, false);
+                }
+            }
+            state.PauseTiming();
+        }
+        state.ResumeTiming();
+    }
+    state.counters["tracks/s"] = benchmark::Counter(
+            files.size(),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_TrackDAOAddImportedTracks)
+        ->Args({1000, 0})
+        ->Args({1000, 1})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+/// Saves all tracks either one by one like when saving evicted tracks
+/// (state.range(1) == 0) or in a single batch.
+static void BM_TrackDAOSaveTracks(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    const bool batched = state.range(1) != 0;
+    const QTemporaryDir tempDir;
+    BenchmarkLibrary library;
+    TrackDAO& trackDAO = library.internalCollection()->getTrackDAO();
+    const QList<TrackPointer> tracks =
+            trackDAO.addTracks(copyTestFiles(tempDir, numTracks), false);
+
+    int iteration = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        setTitles(tracks, QStringLiteral("Title %1 ").arg(iteration++));
+        state.ResumeTiming();
+        if (batched) {
+            trackDAO.saveTracks(tracks);
+        } else {
+            for (const auto& pTrack : tracks) {
+                trackDAO.saveTrack(pTrack.get());
+            }
+        }
+    }
+    state.counters["tracks/s"] = benchmark::Counter(
+            tracks.size(),
+            benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_TrackDAOSaveTracks)
+        ->Args({1000, 0})
+        ->Args({1000, 1})
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime();
+
+} // anonymous namespace
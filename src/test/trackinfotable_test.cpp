@@ -0,0 +1,239 @@
+#include "library/trackinfotable.h"
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QRandomGenerator>
+
+namespace {
+
+enum Column {
+    kArtistColumn,
+    kBpmColumn,
+    kYearColumn,
+    kColumnCount,
+};
+
+const QVector<TrackInfoTable::SortKey> kSortByArtistAndBpmDesc = {
+        {kArtistColumn, TrackInfoTable::Collation::Lexicographic, Qt::AscendingOrder},
+        {kBpmColumn, TrackInfoTable::Collation::Numeric, Qt::DescendingOrder},
+};
+
+void addTrack(TrackInfoTable* pTable, int id, const QVariant& artist, const QVariant& bpm) {
+    const int row = pTable->insertRow(TrackId(id));
+    pTable->setValue(row, kArtistColumn, artist);
+    pTable->setValue(row, kBpmColumn, bpm);
+}
+
+// Artists are repeated to mimic the distribution of a real library
+void addSyntheticTracks(TrackInfoTable* pTable, int numTracks) {
+    QRandomGenerator random(42);
+    for (int id = 1; id <= numTracks; ++id) {
+        const int row = pTable->insertRow(TrackId(id));
+        pTable->setValue(row,
+                kArtistColumn,
+                QStringLiteral("Artist %1").arg(random.bounded(numTracks / 10 + 1)));
+        pTable->setValue(row, kBpmColumn, 60.0 + random.bounded(120.0));
+        pTable->setValue(row,
+                kYearColumn,
+                QString::number(1950 + random.bounded(75)));
+    }
+}
+
+class TrackInfoTableTest : public testing::Test {
+  protected:
+    TrackInfoTableTest()
+            : m_table(kColumnCount) {
+    }
+
+    QVector<TrackId> sorted(
+            QVector<TrackId> trackIds,
+            const QVector<TrackInfoTable::SortKey>& sortKeys) const {
+        m_table.sortTrackIds(&trackIds,
+                sortKeys,
+                m_collator,
+                KeyUtils::KeyNotation::OpenKey);
+        return trackIds;
+    }
+
+    TrackInfoTable m_table;
+    const mixxx::StringCollator m_collator;
+};
+
+TEST_F(TrackInfoTableTest, StoresTypedValues) {
+    addTrack(&m_table, 1, QStringLiteral("Artist"), 120.5);
+    addTrack(&m_table, 2, QVariant(QString()), QVariant());
+    const int row1 = m_table.row(TrackId(1));
+    const int row2 = m_table.row(TrackId(2));
+
+    EXPECT_EQ(QVariant(QStringLiteral("Artist")), m_table.value(row1, kArtistColumn));
+    EXPECT_EQ(QVariant(120.5), m_table.value(row1, kBpmColumn));
+    EXPECT_TRUE(m_table.value(row2, kArtistColumn).isNull());
+    EXPECT_FALSE(m_table.value(row2, kBpmColumn).isValid());
+    // Never set
+    EXPECT_FALSE(m_table.value(row1, kYearColumn).isValid());
+}
+
+TEST_F(TrackInfoTableTest, StoresValuesOfDifferentTypes) {
+    addTrack(&m_table, 1, QStringLiteral("Artist"), 120);
+    addTrack(&m_table, 2, 42, QStringLiteral("fast"));
+
+    EXPECT_EQ(QVariant(QStringLiteral("Artist")),
+            m_table.value(m_table.row(TrackId(1)), kArtistColumn));
+    EXPECT_EQ(QVariant(42), m_table.value(m_table.row(TrackId(2)), kArtistColumn));
+    EXPECT_EQ(120, m_table.value(m_table.row(TrackId(1)), kBpmColumn).toInt());
+    EXPECT_EQ(QVariant(QStringLiteral("fast")),
+            m_table.value(m_table.row(TrackId(2)), kBpmColumn));
+}
+
+TEST_F(TrackInfoTableTest, RemoveRow) {
+    addTrack(&m_table, 1, QStringLiteral("A"), 1.0);
+    addTrack(&m_table, 2, QStringLiteral("B"), 2.0);
+    addTrack(&m_table, 3, QStringLiteral("C"), 3.0);
+
+    m_table.removeRow(TrackId(1));
+    EXPECT_EQ(2, m_table.rowCount());
+    EXPECT_FALSE(m_table.contains(TrackId(1)));
+    EXPECT_EQ(QVariant(QStringLiteral("C")),
+            m_table.value(m_table.row(TrackId(3)), kArtistColumn));
+    EXPECT_EQ(QVariant(2.0), m_table.value(m_table.row(TrackId(2)), kBpmColumn));
+}
+
+TEST_F(TrackInfoTableTest, SortByMultipleColumns) {
+    addTrack(&m_table, 1, QStringLiteral("beta"), 120.0);
+    addTrack(&m_table, 2, QStringLiteral("Alpha"), 100.0);
+    addTrack(&m_table, 3, QStringLiteral("alpha"), 130.0);
+    addTrack(&m_table, 4, QStringLiteral("Beta"), 120.0);
+    addTrack(&m_table, 5, QVariant(QString()), 90.0);
+
+    const QVector<TrackId> trackIds = {
+            TrackId(1), TrackId(2), TrackId(3), TrackId(4), TrackId(5), TrackId(6)};
+    // Case-insensitive with ties broken by track id. The track that
+    // is not stored only has null values.
+    const QVector<TrackId> expected = {
+            TrackId(5), TrackId(6), TrackId(3), TrackId(2), TrackId(1), TrackId(4)};
+    EXPECT_EQ(expected, sorted(trackIds, kSortByArtistAndBpmDesc));
+}
+
+TEST_F(TrackInfoTableTest, SortNullNumbersFirst) {
+    addTrack(&m_table, 1, QStringLiteral("A"), -10.0);
+    addTrack(&m_table, 2, QStringLiteral("B"), QVariant());
+    addTrack(&m_table, 3, QStringLiteral("C"), 0.0);
+
+    const QVector<TrackId> trackIds = {TrackId(1), TrackId(2), TrackId(3), TrackId(4)};
+    const QVector<TrackId> ascending = {TrackId(2), TrackId(4), TrackId(1), TrackId(3)};
+    EXPECT_EQ(ascending,
+            sorted(trackIds,
+                    {{kBpmColumn,
+                            TrackInfoTable::Collation::Numeric,
+                            Qt::AscendingOrder}}));
+    const QVector<TrackId> descending = {TrackId(3), TrackId(1), TrackId(2), TrackId(4)};
+    EXPECT_EQ(descending,
+            sorted(trackIds,
+                    {{kBpmColumn,
+                            TrackInfoTable::Collation::Numeric,
+                            Qt::DescendingOrder}}));
+}
+
+TEST_F(TrackInfoTableTest, SortStringsAddedAfterSorting) {
+    const QVector<TrackInfoTable::SortKey> sortByArtist = {
+            {kArtistColumn, TrackInfoTable::Collation::Lexicographic, Qt::AscendingOrder},
+    };
+    addTrack(&m_table, 1, QStringLiteral("delta"), QVariant());
+    addTrack(&m_table, 2, QStringLiteral("Bravo"), QVariant());
+    for (int id = 3; id <= 100; ++id) {
+        addTrack(&m_table, id, QStringLiteral("zulu %1").arg(id), QVariant());
+    }
+    QVector<TrackId> trackIds = {TrackId(1), TrackId(2)};
+    ASSERT_EQ(QVector<TrackId>({TrackId(2), TrackId(1)}), sorted(trackIds, sortByArtist));
+
+    // Few new strings are inserted into the existing ranks
+    addTrack(&m_table, 101, QStringLiteral("charlie"), QVariant());
+    addTrack(&m_table, 102, QStringLiteral("bravo"), QVariant());
+    addTrack(&m_table, 103, QStringLiteral("alpha"), QVariant());
+    trackIds = {TrackId(1), TrackId(2), TrackId(101), TrackId(102), TrackId(103)};
+    const QVector<TrackId> expected = {
+            TrackId(103), TrackId(2), TrackId(102), TrackId(101), TrackId(1)};
+    EXPECT_EQ(expected, sorted(trackIds, sortByArtist));
+}
+
+TEST_F(TrackInfoTableTest, SortStringsNumerically) {
+    const int row1 = m_table.insertRow(TrackId(1));
+    m_table.setValue(row1, kYearColumn, QStringLiteral("2001"));
+    const int row2 = m_table.insertRow(TrackId(2));
+    m_table.setValue(row2, kYearColumn, QStringLiteral("999"));
+
+    const QVector<TrackId> expected = {TrackId(2), TrackId(1)};
+    EXPECT_EQ(expected,
+            sorted({TrackId(1), TrackId(2)},
+                    {{kYearColumn,
+                            TrackInfoTable::Collation::Numeric,
+                            Qt::AscendingOrder}}));
+}
+
+TEST_F(TrackInfoTableTest, SortLargeInputConcurrently) {
+    constexpr int kNumTracks = 100000;
+    addSyntheticTracks(&m_table, kNumTracks);
+    QVector<TrackId> trackIds;
+    for (int id = kNumTracks; id > 0; --id) {
+        trackIds.append(TrackId(id));
+    }
+
+    const QVector<TrackId> sortedTrackIds = sorted(trackIds, kSortByArtistAndBpmDesc);
+
+    ASSERT_EQ(trackIds.size(), sortedTrackIds.size());
+    for (int i = 1; i < sortedTrackIds.size(); ++i) {
+        const int prevRow = m_table.row(sortedTrackIds[i - 1]);
+        const int row = m_table.row(sortedTrackIds[i]);
+        const int compare = m_collator.compare(
+                m_table.value(prevRow, kArtistColumn).toString(),
+                m_table.value(row, kArtistColumn).toString());
+        ASSERT_LE(compare, 0);
+        if (compare == 0) {
+            ASSERT_GE(m_table.value(prevRow, kBpmColumn).toDouble(),
+                    m_table.value(row, kBpmColumn).toDouble());
+        }
+    }
+}
+
+void BM_TrackInfoTableSort(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    TrackInfoTable table(kColumnCount);
+    addSyntheticTracks(&table, numTracks);
+    QVector<TrackId> trackIds;
+    for (int id = 1; id <= numTracks; ++id) {
+        trackIds.append(TrackId(id));
+    }
+    const mixxx::StringCollator collator;
+
+    for (auto _ : state) {
+        // Reverse the order to avoid sorting a sorted input
+        state.PauseTiming();
+        std::reverse(trackIds.begin(), trackIds.end());
+        state.ResumeTiming();
+        table.sortTrackIds(&trackIds,
+                kSortByArtistAndBpmDesc,
+                collator,
+                KeyUtils::KeyNotation::OpenKey);
+    }
+    state.SetItemsProcessed(state.iterations() * numTracks);
+}
+BENCHMARK(BM_TrackInfoTableSort)
+        ->Arg(100000)
+        ->Arg(200000)
+        ->Unit(benchmark::kMillisecond);
+
+void BM_TrackInfoTableBuild(benchmark::State& state) {
+    const int numTracks = static_cast<int>(state.range(0));
+    for (auto _ : state) {
+        TrackInfoTable table(kColumnCount);
+        addSyntheticTracks(&table, numTracks);
+        benchmark::DoNotOptimize(table.rowCount());
+    }
+    state.SetItemsProcessed(state.iterations() * numTracks);
+}
+BENCHMARK(BM_TrackInfoTableBuild)
+        ->Arg(100000)
+        ->Unit(benchmark::kMillisecond);
+
+} // namespace
@@ -0,0 +1,339 @@
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+
+#include <QDomNode>
+#include <QImage>
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "control/controlobject.h"
+#include "proto/waveform.pb.h"
+#include "skin/legacy/skincontext.h"
+#include "test/mixxxtest.h"
+#include "track/track.h"
+#include "waveform/renderers/waveformrendererrgb.h"
+#include "waveform/renderers/waveformwidgetrenderer.h"
+#include "waveform/waveform.h"
+#include "waveform/waveformwidgetfactory.h"
+
+namespace {
+
+constexpr int kSampleRate = 44100;
+constexpr int kVisualSampleRate = 441;
+
+// Fills the waveform with a pattern that differs in each band and channel
+void fillWaveform(Waveform* pWaveform, int begin, int end) {
+    WaveformData* pData = pWaveform->data();
+    for (int i = begin; i < end; ++i) {
+        pData[i].filtered.low = static_cast<unsigned char>((i * 7) % 251);
+        pData[i].filtered.mid = static_cast<unsigned char>((i * 13) % 241);
+        pData[i].filtered.high = static_cast<unsigned char>((i * 31) % 239);
+        pData[i].filtered.all = static_cast<unsigned char>((i * 3) % 233);
+    }
+}
+
+WaveformPointer makeWaveform(int seconds) {
+    auto pWaveform = WaveformPointer(new Waveform(
+            kSampleRate, kSampleRate * 2 * seconds, kVisualSampleRate, -1));
+    fillWaveform(pWaveform.data(), 0, pWaveform->getDataSize());
+    pWaveform->setCompletion(pWaveform->getDataSize());
+    return pWaveform;
+}
+
+// Checks that every visual sample of each level holds the maximum of the
+// corresponding visual samples of the previous level, for the first numFrames
+// visual frames of level 1.
+void expectMipmapsReduceByMax(const Waveform& waveform, int numFrames) {
+    for (int level = 1; level < waveform.getMipmapLevelCount(); ++level) {
+        const WaveformData* pSource = waveform.getMipmapData(level - 1);
+        const int sourceFrames = waveform.getMipmapDataSize(level - 1) / 2;
+        const WaveformData* pTarget = waveform.getMipmapData(level);
+        for (int frame = 0; frame < numFrames; ++frame) {
+            const int first = 2 * frame;
+            const int second = std::min(first + 1, sourceFrames - 1);
+            for (int channel = 0; channel < 2; ++channel) {
+                const WaveformData& a = pSource[first * 2 + channel];
+                const WaveformData& b = pSource[second * 2 + channel];
+                const WaveformData& target = pTarget[frame * 2 + channel];
+                ASSERT_EQ(std::max(a.filtered.low, b.filtered.low), target.filtered.low)
+                        << "level " << level << " frame " << frame;
+                ASSERT_EQ(std::max(a.filtered.mid, b.filtered.mid), target.filtered.mid);
+                ASSERT_EQ(std::max(a.filtered.high, b.filtered.high), target.filtered.high);
+                ASSERT_EQ(std::max(a.filtered.all, b.filtered.all), target.filtered.all);
+            }
+        }
+        numFrames /= 2;
+    }
+}
+
+class WaveformTest : public MixxxTest {
+};
+
+TEST_F(WaveformTest, MipmapsReduceByMax) {
+    const WaveformPointer pWaveform = makeWaveform(60);
+    ASSERT_LT(2, pWaveform->getMipmapLevelCount());
+    for (int level = 1; level < pWaveform->getMipmapLevelCount(); ++level) {
+        const int sourceFrames = pWaveform->getMipmapDataSize(level - 1) / 2;
+        EXPECT_EQ((sourceFrames + 1) / 2 * 2, pWaveform->getMipmapDataSize(level));
+    }
+    expectMipmapsReduceByMax(*pWaveform, pWaveform->getMipmapDataSize(1) / 2);
+}
+
+TEST_F(WaveformTest, MipmapsFollowCompletion) {
+    auto pWaveform = WaveformPointer(new Waveform(
+            kSampleRate, kSampleRate * 2 * 10, kVisualSampleRate, -1));
+    const int dataSize = pWaveform->getDataSize();
+
+    // Complete half of the waveform like the analyzer does
+    const int halfSize = dataSize / 4 * 2;
+    fillWaveform(pWaveform.data(), 0, halfSize);
+    pWaveform->setCompletion(halfSize);
+    expectMipmapsReduceByMax(*pWaveform, halfSize / 4);
+
+    // The visual frames of level 1 after the completed part are not computed yet
+    const int lastIndex = pWaveform->getMipmapDataSize(1) - 1;
+    EXPECT_EQ(0, pWaveform->getMipmapData(1)[lastIndex].m_i);
+
+    fillWaveform(pWaveform.data(), halfSize, dataSize);
+    pWaveform->setCompletion(dataSize);
+    EXPECT_NE(0, pWaveform->getMipmapData(1)[lastIndex].m_i);
+    expectMipmapsReduceByMax(*pWaveform, pWaveform->getMipmapDataSize(1) / 2);
+}
+
+TEST_F(WaveformTest, MipmapsOfLoadedWaveform) {
+    const WaveformPointer pWaveform = makeWaveform(10);
+    const Waveform loadedWaveform(pWaveform->toByteArray());
+    ASSERT_EQ(pWaveform->getMipmapLevelCount(), loadedWaveform.getMipmapLevelCount());
+    for (int level = 1; level < loadedWaveform.getMipmapLevelCount(); ++level) {
+        const int dataSize = loadedWaveform.getMipmapDataSize(level);
+        ASSERT_EQ(pWaveform->getMipmapDataSize(level), dataSize);
+        for (int i = 0; i < dataSize; ++i) {
+            ASSERT_EQ(pWaveform->getMipmapData(level)[i].m_i,
+                    loadedWaveform.getMipmapData(level)[i].m_i);
+        }
+    }
+}
+
+TEST_F(WaveformTest, BinaryFormatRoundTrip) {
+    const WaveformPointer pWaveform = makeWaveform(10);
+    const QByteArray data = pWaveform->toByteArray();
+    ASSERT_TRUE(Waveform::hasBinaryFormat(data));
+
+    const Waveform loadedWaveform(data);
+    EXPECT_EQ(Waveform::SaveState::Saved, loadedWaveform.saveState());
+    EXPECT_EQ(pWaveform->getVisualSampleRate(), loadedWaveform.getVisualSampleRate());
+    EXPECT_EQ(pWaveform->getAudioVisualRatio(), loadedWaveform.getAudioVisualRatio());
+    EXPECT_EQ(pWaveform->getCompletion(), loadedWaveform.getCompletion());
+    ASSERT_EQ(pWaveform->getDataSize(), loadedWaveform.getDataSize());
+    for (int i = 0; i < pWaveform->getDataSize(); ++i) {
+        ASSERT_EQ(pWaveform->data()[i].m_i, loadedWaveform.data()[i].m_i) << i;
+    }
+
+    // A truncated analysis is not loaded
+    const Waveform truncatedWaveform(data.left(data.size() - 1));
+    EXPECT_FALSE(truncatedWaveform.isValid());
+}
+
+TEST_F(WaveformTest, ReadsLegacyProtobufFormat) {
+    const WaveformPointer pWaveform = makeWaveform(10);
+    const int dataSize = pWaveform->getDataSize();
+
+    // Stored like by previous versions
+    mixxx::track::io::Waveform legacyWaveform;
+    legacyWaveform.set_visual_sample_rate(pWaveform->getVisualSampleRate());
+    legacyWaveform.set_audio_visual_ratio(pWaveform->getAudioVisualRatio());
+    auto* pAll = legacyWaveform.mutable_signal_all();
+    auto* pFiltered = legacyWaveform.mutable_signal_filtered();
+    auto* pLow = pFiltered->mutable_low();
+    auto* pMid = pFiltered->mutable_mid();
+    auto* pHigh = pFiltered->mutable_high();
+    for (int i = 0; i < dataSize; ++i) {
+        const WaveformData& datum = pWaveform->data()[i];
+        pAll->add_value(datum.filtered.all);
+        pLow->add_value(datum.filtered.low);
+        pMid->add_value(datum.filtered.mid);
+        pHigh->add_value(datum.filtered.high);
+    }
+    std::string output;
+    legacyWaveform.SerializeToString(&output);
+    const QByteArray legacyData(output.data(), static_cast<int>(output.length()));
+    ASSERT_FALSE(Waveform::hasBinaryFormat(legacyData));
+
+    const Waveform loadedWaveform(legacyData);
+    ASSERT_EQ(dataSize, loadedWaveform.getDataSize());
+    for (int i = 0; i < dataSize; ++i) {
+        ASSERT_EQ(pWaveform->data()[i].m_i, loadedWaveform.data()[i].m_i) << i;
+    }
+    EXPECT_EQ(pWaveform->toByteArray(), loadedWaveform.toByteArray());
+}
+
+TEST_F(WaveformTest, MipmapLevelMatchesZoom) {
+    const WaveformPointer pWaveform = makeWaveform(60);
+    const int maxLevel = pWaveform->getMipmapLevelCount() - 1;
+    EXPECT_EQ(0, pWaveform->getMipmapLevel(0.1));
+    EXPECT_EQ(0, pWaveform->getMipmapLevel(1.0));
+    EXPECT_EQ(0, pWaveform->getMipmapLevel(1.9));
+    EXPECT_EQ(1, pWaveform->getMipmapLevel(2.0));
+    EXPECT_EQ(1, pWaveform->getMipmapLevel(3.9));
+    EXPECT_EQ(2, pWaveform->getMipmapLevel(4.0));
+    EXPECT_EQ(maxLevel, pWaveform->getMipmapLevel(1e6));
+}
+
+const QString kGroup = QStringLiteral("[Channel1]");
+constexpr int kWidth = 1000;
+constexpr int kHeight = 100;
+
+// Exposes the displayed range, which is otherwise computed from the play
+// position at the next VSync.
+class OffscreenWaveformWidgetRenderer : public WaveformWidgetRenderer {
+  public:
+    OffscreenWaveformWidgetRenderer()
+            : WaveformWidgetRenderer(kGroup) {
+    }
+
+    void setDisplayedRange(double first, double displayedFraction) {
+        m_firstDisplayedPosition = first;
+        m_lastDisplayedPosition = first + displayedFraction;
+        m_trackPixelCount = getLength() / displayedFraction;
+    }
+};
+
+class DirectWaveformRendererRGB : public WaveformRendererRGB {
+  public:
+    explicit DirectWaveformRendererRGB(WaveformWidgetRenderer* waveformWidgetRenderer)
+            : WaveformRendererRGB(waveformWidgetRenderer) {
+    }
+
+    using WaveformRendererRGB::drawSignal;
+};
+
+// Draws a WaveformRendererRGB of a 10 minute track into an offscreen QImage
+class OffscreenRendererRGB {
+  public:
+    OffscreenRendererRGB()
+            : m_image(kWidth, kHeight, QImage::Format_ARGB32_Premultiplied) {
+        for (const auto* item : {"filterWaveformEnable",
+                     "filterLow",
+                     "filterMid",
+                     "filterHigh",
+                     "filterLowKill",
+                     "filterMidKill",
+                     "filterHighKill"}) {
+            m_controls.push_back(std::make_unique<ControlObject>(ConfigKey(kGroup, item)));
+        }
+        WaveformWidgetFactory::createInstance();
+
+        m_pTrack = Track::newTemporary();
+        m_pWaveform = makeWaveform(600);
+        m_pTrack->setWaveform(m_pWaveform);
+
+        m_pWidgetRenderer = std::make_unique<OffscreenWaveformWidgetRenderer>();
+        m_pWidgetRenderer->resize(kWidth, kHeight, 1.0f);
+        m_pRenderer = m_pWidgetRenderer->addRenderer<DirectWaveformRendererRGB>();
+        m_pRenderer->init();
+        const SkinContext context(UserSettingsPointer(new UserSettings(QString())), QString());
+        m_pRenderer->setup(QDomNode(), context);
+        m_pWidgetRenderer->setTrack(m_pTrack);
+    }
+
+    ~OffscreenRendererRGB() {
+        m_pWidgetRenderer.reset();
+        WaveformWidgetFactory::destroy();
+    }
+
+    // Returns the fraction of the track that is displayed at the given zoom
+    double displayedFraction(double visualFramesPerPixel) const {
+        return visualFramesPerPixel * kWidth * 2 / m_pWaveform->getDataSize();
+    }
+
+    const QImage& draw(double firstPosition, double displayedFraction) {
+        m_pWidgetRenderer->setDisplayedRange(firstPosition, displayedFraction);
+        m_image.fill(Qt::black);
+        QPainter painter(&m_image);
+        m_pRenderer->draw(&painter, nullptr);
+        return m_image;
+    }
+
+    // Draws the whole view with drawSignal(), bypassing the tile cache
+    const QImage& drawDirect(double firstPosition, double displayedFraction) {
+        m_pWidgetRenderer->setDisplayedRange(firstPosition, displayedFraction);
+        m_image.fill(Qt::black);
+        QPainter painter(&m_image);
+        painter.setRenderHints(QPainter::Antialiasing, false);
+        m_pRenderer->drawSignal(&painter,
+                firstPosition,
+                firstPosition + displayedFraction,
+                kWidth);
+        return m_image;
+    }
+
+  private:
+    std::vector<std::unique_ptr<ControlObject>> m_controls;
+    TrackPointer m_pTrack;
+    WaveformPointer m_pWaveform;
+    std::unique_ptr<OffscreenWaveformWidgetRenderer> m_pWidgetRenderer;
+    DirectWaveformRendererRGB* m_pRenderer;
+    QImage m_image;
+};
+
+TEST_F(WaveformTest, ScrollingMatchesDirectDrawing) {
+    OffscreenRendererRGB renderer;
+    // At mipmap level 0 and a pixel aligned position both ways of drawing
+    // take the same visual samples into account for each pixel column.
+    const double displayedFraction = renderer.displayedFraction(1);
+    const double trackPixelCount = kWidth / displayedFraction;
+
+    // Scroll by whole and partial pixels into the position, so that most
+    // of the view is drawn from tiles that have been cached before.
+    double pixel = std::round(0.25 * trackPixelCount);
+    for (int i = 0; i < 100; ++i) {
+        renderer.draw(pixel / trackPixelCount, displayedFraction);
+        pixel += 3.5;
+    }
+    const double position = pixel / trackPixelCount;
+    const QImage scrolledImage = renderer.draw(position, displayedFraction);
+
+    EXPECT_TRUE(renderer.drawDirect(position, displayedFraction) == scrolledImage);
+}
+
+// Draws a WaveformRendererRGB with a given number of visual frames per
+// pixel, jumping to another part of the track for every frame so that all
+// of the view needs to be rendered.
+static void BM_WaveformRendererRGB(benchmark::State& state) {
+    OffscreenRendererRGB renderer;
+    const double displayedFraction = renderer.displayedFraction(
+            static_cast<double>(state.range(0)));
+
+    double position = 0.0;
+    for (auto _ : state) {
+        renderer.draw(position, displayedFraction);
+        position += displayedFraction * 1.5;
+        if (position + displayedFraction > 1.0) {
+            position = 0.0;
+        }
+    }
+}
+BENCHMARK(BM_WaveformRendererRGB)->Arg(1)->Arg(4)->Arg(16)->Arg(64);
+
+// Draws a WaveformRendererRGB that scrolls by a few pixels per frame, like
+// during playback at the default zoom.
+static void BM_WaveformRendererRGBScrolling(benchmark::State& state) {
+    OffscreenRendererRGB renderer;
+    const double displayedFraction = renderer.displayedFraction(4);
+    const double pixelFraction = displayedFraction / kWidth;
+
+    double position = 0.0;
+    for (auto _ : state) {
+        renderer.draw(position, displayedFraction);
+        position += 3 * pixelFraction;
+        if (position + displayedFraction > 1.0) {
+            position = 0.0;
+        }
+    }
+}
+BENCHMARK(BM_WaveformRendererRGBScrolling);
+
+} // namespace
@@ -1,5 +1,6 @@
 #include "track/beats.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iterator>
 #include <vector>
@@ -72,9 +73,8 @@ Beats::ConstIterator Beats::ConstIterator::operator+=(Beats::ConstIterator::diff
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
-        m_beatOffset -= m_it->beatsTillNextMarker();
-        m_it++;
+    if (m_it != m_beats->m_markers.cend() && m_beatOffset >= m_it->beatsTillNextMarker()) {
+        seekToBeatIndex(beatIndex());
     }
     updateValue();
     return *this;
@@ -115,9 +115,8 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
     }
 
     m_beatOffset = beatOffset;
-    while (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
-        m_it--;
-        m_beatOffset += m_it->beatsTillNextMarker();
+    if (m_it != m_beats->m_markers.cbegin() && m_beatOffset < 0) {
+        seekToBeatIndex(beatIndex());
     }
     updateValue();
     return *this;
@@ -125,23 +124,24 @@ Beats::ConstIterator Beats::ConstIterator::operator-=(Beats::ConstIterator::diff
 
 Beats::ConstIterator::difference_type Beats::ConstIterator::operator-(
         const Beats::ConstIterator& other) const {
-    const int vectorItDiff = m_it - other.m_it;
-    if (vectorItDiff == 0) {
-        return m_beatOffset - other.m_beatOffset;
-    }
+    DEBUG_ASSERT(m_beats == other.m_beats);
+    return static_cast<difference_type>(beatIndex() - other.beatIndex());
+}
 
-    if (vectorItDiff > 0) {
-        return -(other - *this);
-    }
+qint64 Beats::ConstIterator::beatIndex() const {
+    return m_beats->m_markerBeatIndices[m_it - m_beats->m_markers.cbegin()] +
+            static_cast<qint64>(m_beatOffset);
+}
 
-    auto it = m_it;
-    int result = -m_beatOffset + other.m_beatOffset;
-    while (it != m_beats->m_markers.cend() && it != other.m_it) {
-        result += it->beatsTillNextMarker();
-        it++;
-    }
-    DEBUG_ASSERT(it == other.m_it);
-    return -result;
+void Beats::ConstIterator::seekToBeatIndex(qint64 beatIndex) {
+    const std::vector<int>& indices = m_beats->m_markerBeatIndices;
+    // Find the last marker at or before the beat. Beats before the first
+    // marker belong to the first marker, beats after the last marker belong
+    // to the last marker.
+    const auto it = std::upper_bound(indices.cbegin(), indices.cend(), beatIndex);
+    const auto markerIndex = (it == indices.cbegin()) ? 0 : std::prev(it) - indices.cbegin();
+    m_it = m_beats->m_markers.cbegin() + markerIndex;
+    m_beatOffset = static_cast<int>(beatIndex - indices[markerIndex]);
 }
 
 void Beats::ConstIterator::updateValue() {
@@ -440,8 +440,34 @@ Beats::ConstIterator Beats::iteratorFrom(audio::FramePos position) const {
             return cbegin();
         }
         it -= static_cast<int>(n);
+    } else if (!m_markers.empty()) {
+        // Lookup position is between the first and the last marker position.
+        // Find the last marker at or before the position with a binary search
+        // and calculate the beat inside of its tempo section.
+        const auto markerIt = std::prev(std::upper_bound(m_markers.cbegin(),
+                m_markers.cend(),
+                position,
+                [](audio::FramePos position, const BeatMarker& marker) {
+                    return position < marker.position();
+                }));
+        it = ConstIterator(this, markerIt, 0);
+        const double n = std::ceil((position - markerIt->position()) / it.beatLengthFrames());
+        DEBUG_ASSERT(n >= 0);
+        it += std::min(static_cast<int>(n), markerIt->beatsTillNextMarker());
+
+        // Same as above, compensate floating point errors in both directions
+        // to end up at the first beat at or after the position.
+        if (*it < position) {
+            it++;
+        } else {
+            auto previousBeatIt = it - 1;
+            if (*previousBeatIt >= position) {
+                it = previousBeatIt;
+            }
+        }
     } else {
-        it = std::lower_bound(cfirstmarker(), clastmarker() + 1, position);
+        // Lookup position is exactly at the last marker of a constant tempo
+        it = clastmarker();
     }
     DEBUG_ASSERT(it == cbegin() || it == cend() || *it >= position);
     DEBUG_ASSERT(it == cbegin() || it == cend() ||
@@ -666,18 +692,20 @@ std::optional<BeatsPointer> Beats::trySetBpm(mixxx::Bpm bpm) const {
     return BeatsPointer(new Beats({}, *it, bpm, m_sampleRate, m_subVersion));
 }
 
-bool Beats::isValid() const {
-    if (!m_lastMarkerPosition.isValid() || !m_lastMarkerBpm.isValid()) {
-        return false;
-    }
+void Beats::initBeatIndex() {
+    m_isValid = m_lastMarkerPosition.isValid() && m_lastMarkerBpm.isValid();
 
+    m_markerBeatIndices.clear();
+    m_markerBeatIndices.reserve(m_markers.size() + 1);
+    int beatIndex = 0;
+    m_markerBeatIndices.push_back(beatIndex);
     for (const BeatMarker& marker : m_markers) {
         if (!marker.position().isValid() || marker.beatsTillNextMarker() <= 0) {
-            return false;
+            m_isValid = false;
         }
+        beatIndex += marker.beatsTillNextMarker();
+        m_markerBeatIndices.push_back(beatIndex);
     }
-
-    return true;
 }
 
 mixxx::audio::FrameDiff_t Beats::firstBeatLengthFrames() const {
@@ -6,6 +6,7 @@
 #include <QVector>
 #include <memory>
 #include <optional>
+#include <vector>
 
 #include "audio/frame.h"
 #include "audio/types.h"
@@ -142,6 +143,12 @@ class Beats : private std::enable_shared_from_this<Beats> {
         }
 
       private:
+        /// Returns the number of beats between the first beat marker and the
+        /// beat that this iterator points to.
+        qint64 beatIndex() const;
+        /// Moves the iterator to the beat with the given index, relative to
+        /// the first beat marker.
+        void seekToBeatIndex(qint64 beatIndex);
         void updateValue();
 
         mixxx::audio::FramePos m_value;
@@ -165,6 +172,7 @@ class Beats : private std::enable_shared_from_this<Beats> {
         DEBUG_ASSERT(!m_lastMarkerPosition.isFractional());
         DEBUG_ASSERT(m_lastMarkerBpm.isValid());
         DEBUG_ASSERT(m_sampleRate.isValid());
+        initBeatIndex();
     }
 
     Beats(mixxx::audio::FramePos lastMarkerPosition,
@@ -413,14 +421,23 @@ class Beats : private std::enable_shared_from_this<Beats> {
     /// The constructors must be public for using std::make_shared().
     struct MakeSharedTag {};
 
-    Beats() = default;
+    Beats()
+            : m_markerBeatIndices(1, 0),
+              m_isValid(false) {
+    }
 
-    bool isValid() const;
+    bool isValid() const {
+        return m_isValid;
+    }
 
   private:
     Beats(const Beats&) = delete;
     Beats(Beats&&) = delete;
 
+    /// Fills the beat index and caches the validity of the markers. Must
+    /// only be called from the constructor, all instances are immutable.
+    void initBeatIndex();
+
     QByteArray toBeatGridByteArray() const;
     QByteArray toBeatMapByteArray() const;
 
@@ -432,6 +449,14 @@ class Beats : private std::enable_shared_from_this<Beats> {
     mixxx::Bpm m_lastMarkerBpm;
     mixxx::audio::SampleRate m_sampleRate;
 
+    /// Flat index that allows random access to beats in O(log n) with a
+    /// binary search instead of walking the markers. Element i is the number
+    /// of beats between the first marker and marker i, the last element is
+    /// the number of beats between the first marker and the last marker.
+    /// It always contains at least one element.
+    std::vector<int> m_markerBeatIndices;
+    bool m_isValid;
+
     // The sub-version of this beatgrid.
     const QString m_subVersion;
 };
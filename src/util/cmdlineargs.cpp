@@ -25,6 +25,7 @@ CmdlineArgs::CmdlineArgs()
           m_debugAssertBreak(false),
           m_settingsPathSet(false),
           m_scaleFactor(1.0),
+          m_renderDuration(0.0),
           m_useColors(false),
           m_parseForUserFeedbackRequired(false),
           m_logLevel(mixxx::kLogLevelDefault),
@@ -170,6 +171,32 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
     parser.addOption(timelinePath);
     parser.addOption(timelinePathDeprecated);
 
+    const QCommandLineOption engineTracePath(QStringLiteral("engine-trace-path"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Path a trace of the audio engine processing stages is "
+                                      "written to in the Chrome trace event format")
+                            : QString(),
+            QStringLiteral("path"));
+    parser.addOption(engineTracePath);
+
+    const QCommandLineOption renderOffline(QStringLiteral("render-offline"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Renders the master output into the given file as fast "
+                                      "as possible instead of playing it on the configured "
+                                      "sound devices. The recording format from the "
+                                      "preferences is used.")
+                            : QString(),
+            QStringLiteral("path"));
+    parser.addOption(renderOffline);
+
+    const QCommandLineOption renderDuration(QStringLiteral("render-duration"),
+            forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
+                                      "Quits Mixxx after the given number of seconds have "
+                                      "been rendered with --render-offline")
+                            : QString(),
+            QStringLiteral("seconds"));
+    parser.addOption(renderDuration);
+
     const QCommandLineOption controllerDebug(QStringLiteral("controller-debug"),
             forUserFeedback ? QCoreApplication::translate("CmdlineArgs",
                                       "Causes Mixxx to display/log all of the controller data it "
@@ -325,6 +352,23 @@ bool CmdlineArgs::parse(const QStringList& arguments, CmdlineArgs::ParseMode mod
         m_timelinePath = parser.value(timelinePathDeprecated);
     }
 
+    if (parser.isSet(engineTracePath)) {
+        m_engineTracePath = parser.value(engineTracePath);
+    }
+
+    if (parser.isSet(renderOffline)) {
+        m_renderOfflinePath = parser.value(renderOffline);
+    }
+
+    if (parser.isSet(renderDuration)) {
+        bool ok = false;
+        m_renderDuration = parser.value(renderDuration).toDouble(&ok);
+        if (!ok || m_renderDuration < 0) {
+            fputs("Render duration must be a positive number of seconds\n", stdout);
+            m_renderDuration = 0;
+        }
+    }
+
     m_controllerDebug = parser.isSet(controllerDebug) || parser.isSet(controllerDebugDeprecated);
     m_developer = parser.isSet(developer);
     m_qml = parser.isSet(qml);
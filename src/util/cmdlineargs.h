@@ -47,6 +47,9 @@ class CmdlineArgs final {
     mixxx::LogLevel getLogLevel() const { return m_logLevel; }
     mixxx::LogLevel getLogFlushLevel() const { return m_logFlushLevel; }
     bool getTimelineEnabled() const { return !m_timelinePath.isEmpty(); }
+    bool getEngineTraceEnabled() const {
+        return !m_engineTracePath.isEmpty();
+    }
     const QString& getLocale() const { return m_locale; }
     const QString& getSettingsPath() const { return m_settingsPath; }
     void setSettingsPath(const QString& newSettingsPath) {
@@ -54,6 +57,18 @@ class CmdlineArgs final {
     }
     const QString& getResourcePath() const { return m_resourcePath; }
     const QString& getTimelinePath() const { return m_timelinePath; }
+    const QString& getEngineTracePath() const {
+        return m_engineTracePath;
+    }
+    bool getRenderOfflineEnabled() const {
+        return !m_renderOfflinePath.isEmpty();
+    }
+    const QString& getRenderOfflinePath() const {
+        return m_renderOfflinePath;
+    }
+    double getRenderDuration() const {
+        return m_renderDuration;
+    }
 
     void setScaleFactor(double scaleFactor) {
         m_scaleFactor = scaleFactor;
@@ -79,6 +94,7 @@ class CmdlineArgs final {
     bool m_debugAssertBreak;
     bool m_settingsPathSet; // has --settingsPath been set on command line ?
     double m_scaleFactor;
+    double m_renderDuration; // in seconds, 0 renders until Mixxx is quit
     bool m_useColors;       // should colors be used
     bool m_parseForUserFeedbackRequired;
     mixxx::LogLevel m_logLevel; // Level of stderr logging message verbosity
@@ -87,4 +103,6 @@ class CmdlineArgs final {
     QString m_settingsPath;
     QString m_resourcePath;
     QString m_timelinePath;
+    QString m_engineTracePath;
+    QString m_renderOfflinePath;
 };
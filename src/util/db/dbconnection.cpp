@@ -191,6 +191,8 @@ int sqliteStringCompareUTF16(void* pArg,
 
 const char kLexicographicalCollationFunc[] = "mixxxLexicographicalCollationFunc";
 
+const char kLatinLowFunc[] = "mixxxLatinLow";
+
 // This implements the like() SQL function. This is used by the LIKE operator.
 // The SQL statement 'A LIKE B' is implemented as 'like(B, A)', and if there is
 // an escape character, say E, it is implemented as 'like(B, A, E)'
@@ -231,6 +233,28 @@ void sqliteLikeUtf8(sqlite3_context* context,
     return;
 }
 
+// This implements the mixxxLatinLow() SQL function for folding strings
+// in the same way as the custom like() function.
+void sqliteLatinLowUtf8(sqlite3_context* context,
+        int aArgc,
+        sqlite3_value** aArgv) {
+    VERIFY_OR_DEBUG_ASSERT(aArgc == 1) {
+        return;
+    }
+
+    const char* a = reinterpret_cast<const char*>(
+            sqlite3_value_text(aArgv[0]));
+    if (!a) {
+        sqlite3_result_null(context);
+        return;
+    }
+
+    QString stringA = QString::fromUtf8(a);
+    makeLatinLow(stringA.data(), stringA.length());
+    const QByteArray utf8 = stringA.toUtf8();
+    sqlite3_result_text(context, utf8.constData(), utf8.size(), SQLITE_TRANSIENT);
+}
+
 #endif // __SQLITE3__
 
 bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator) {
@@ -305,6 +329,21 @@ bool initDatabase(const QSqlDatabase& database, mixxx::StringCollator* pCollator
                 << "Failed to install custom 3-arg LIKE function for SQLite3:"
                 << result;
     }
+
+    result = sqlite3_create_function(
+            handle,
+            kLatinLowFunc,
+            1,
+            SQLITE_UTF8 | SQLITE_DETERMINISTIC,
+            nullptr,
+            sqliteLatinLowUtf8,
+            nullptr,
+            nullptr);
+    VERIFY_OR_DEBUG_ASSERT(result == SQLITE_OK) {
+        kLogger.warning()
+                << "Failed to install custom latin low function for SQLite3:"
+                << result;
+    }
 #else
     Q_UNUSED(database);
     Q_UNUSED(pCollator);
@@ -382,6 +421,15 @@ QString DbConnection::collateLexicographically(const QString& orderByQuery) {
 #endif //  __SQLITE3__
 }
 
+//static
+QString DbConnection::latinLow(const QString& stringExpression) {
+#ifdef __SQLITE3__
+    return QStringLiteral("%1(%2)").arg(kLatinLowFunc, stringExpression);
+#else
+    return stringExpression;
+#endif //  __SQLITE3__
+}
+
 //static
 int DbConnection::likeCompareLatinLow(
         QString* pattern,
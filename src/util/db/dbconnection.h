@@ -15,6 +15,12 @@ class DbConnection final {
     static QString collateLexicographically(
             const QString& orderByQuery);
 
+    // Wrap a string expression with a custom function that
+    // applies makeStringLatinLow() to its result if available
+    // (SQLite3). Otherwise the expression is returned unmodified.
+    static QString latinLow(
+            const QString& stringExpression);
+
     static int likeCompareLatinLow(
         QString* pattern,
         QString* string,
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstdlib>
 #include <cstddef>
 
@@ -36,8 +37,254 @@ constexpr bool useAlignedAlloc() {
             sizeof(CSAMPLE*) == sizeof(size_t);
 }
 
+// The loops of the most frequently used functions are compiled multiple
+// times for different instruction sets. The best version that is supported
+// by the CPU is selected once at startup. This allows packaged builds for
+// the SSE2 baseline to utilize AVX2 and AVX-512 registers.
+#if (defined(__GNUC__) || defined(__clang__)) && \
+        (defined(__x86_64__) || defined(__i386__))
+#define SAMPLEUTIL_DISPATCH
+#define SAMPLEUTIL_KERNEL inline __attribute__((always_inline))
+#define SAMPLEUTIL_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#if defined(__clang__)
+#define SAMPLEUTIL_TARGET_AVX512                        \
+    __attribute__((target("avx512f,avx512vl,avx2,fma"), \
+            min_vector_width(512)))
+#else
+#define SAMPLEUTIL_TARGET_AVX512 \
+    __attribute__((target("avx512f,avx512vl,avx2,fma,prefer-vector-width=512")))
+#endif
+#else
+#define SAMPLEUTIL_KERNEL inline
+#endif
+
+namespace kernel {
+
+SAMPLEUTIL_KERNEL void applyGain(CSAMPLE* pBuffer,
+        CSAMPLE_GAIN gain,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pBuffer[i] *= gain;
+    }
+}
+
+SAMPLEUTIL_KERNEL void applyRampingGain(CSAMPLE* pBuffer,
+        CSAMPLE_GAIN start_gain,
+        CSAMPLE_GAIN gain_delta,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (int i = 0; i < numSamples / 2; ++i) {
+        const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+        // a loop counter i += 2 prevents vectorizing.
+        pBuffer[i * 2] *= gain;
+        pBuffer[i * 2 + 1] *= gain;
+    }
+}
+
+SAMPLEUTIL_KERNEL void addWithGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN gain,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pDest[i] += pSrc[i] * gain;
+    }
+}
+
+SAMPLEUTIL_KERNEL void add2WithGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        CSAMPLE_GAIN gain1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        CSAMPLE_GAIN gain2,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (int i = 0; i < numSamples; ++i) {
+        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2;
+    }
+}
+
+SAMPLEUTIL_KERNEL void add3WithGain(CSAMPLE* pDest,
+        const CSAMPLE* M_RESTRICT pSrc1,
+        CSAMPLE_GAIN gain1,
+        const CSAMPLE* M_RESTRICT pSrc2,
+        CSAMPLE_GAIN gain2,
+        const CSAMPLE* M_RESTRICT pSrc3,
+        CSAMPLE_GAIN gain3,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2 + pSrc3[i] * gain3;
+    }
+}
+
+SAMPLEUTIL_KERNEL void copyWithGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN gain,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED.
+    for (SINT i = 0; i < numSamples; ++i) {
+        pDest[i] = pSrc[i] * gain;
+    }
+}
+
+SAMPLEUTIL_KERNEL void copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
+        const CSAMPLE* M_RESTRICT pSrc,
+        CSAMPLE_GAIN start_gain,
+        CSAMPLE_GAIN gain_delta,
+        SINT numSamples) {
+    // note: LOOP VECTORIZED only with "int i" (not SINT i)
+    for (int i = 0; i < numSamples / 2; ++i) {
+        const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
+        pDest[i * 2] = pSrc[i * 2] * gain;
+        pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
+    }
+}
+
+SAMPLEUTIL_KERNEL void convertFloat32ToS16(SAMPLE* pDest,
+        const CSAMPLE* pSrc,
+        SINT numSamples) {
+    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
+    // note: LOOP VECTORIZED only with "int i" (not SINT i)
+    for (int i = 0; i < numSamples; ++i) {
+        pDest[i] = static_cast<SAMPLE>(math_clamp(pSrc[i] * kConversionFactor,
+                static_cast<CSAMPLE>(SAMPLE_MINIMUM),
+                static_cast<CSAMPLE>(SAMPLE_MAXIMUM)));
+    }
+}
+
+} // namespace kernel
+
+// Instantiates a kernel for each instruction set
+template<typename Signature, Signature* kernel>
+struct Dispatch;
+
+template<typename... Args, void (*kernel)(Args...)>
+struct Dispatch<void(Args...), kernel> {
+    static void baseline(Args... args) {
+        kernel(args...);
+    }
+#ifdef SAMPLEUTIL_DISPATCH
+    SAMPLEUTIL_TARGET_AVX2 static void avx2(Args... args) {
+        kernel(args...);
+    }
+    SAMPLEUTIL_TARGET_AVX512 static void avx512(Args... args) {
+        kernel(args...);
+    }
+#endif
+};
+
+struct Kernels {
+    decltype(&kernel::applyGain) applyGain;
+    decltype(&kernel::applyRampingGain) applyRampingGain;
+    decltype(&kernel::addWithGain) addWithGain;
+    decltype(&kernel::add2WithGain) add2WithGain;
+    decltype(&kernel::add3WithGain) add3WithGain;
+    decltype(&kernel::copyWithGain) copyWithGain;
+    decltype(&kernel::copyWithRampingGain) copyWithRampingGain;
+    decltype(&kernel::convertFloat32ToS16) convertFloat32ToS16;
+};
+
+#define SAMPLEUTIL_KERNEL_FOR(name, instructionSet) \
+    Dispatch<decltype(kernel::name), kernel::name>::instructionSet
+
+#define SAMPLEUTIL_KERNELS(instructionSet)                                  \
+    Kernels {                                                               \
+        SAMPLEUTIL_KERNEL_FOR(applyGain, instructionSet),                   \
+                SAMPLEUTIL_KERNEL_FOR(applyRampingGain, instructionSet),    \
+                SAMPLEUTIL_KERNEL_FOR(addWithGain, instructionSet),         \
+                SAMPLEUTIL_KERNEL_FOR(add2WithGain, instructionSet),        \
+                SAMPLEUTIL_KERNEL_FOR(add3WithGain, instructionSet),        \
+                SAMPLEUTIL_KERNEL_FOR(copyWithGain, instructionSet),        \
+                SAMPLEUTIL_KERNEL_FOR(copyWithRampingGain, instructionSet), \
+                SAMPLEUTIL_KERNEL_FOR(convertFloat32ToS16, instructionSet), \
+    }
+
+constexpr Kernels kBaselineKernels = SAMPLEUTIL_KERNELS(baseline);
+#ifdef SAMPLEUTIL_DISPATCH
+constexpr Kernels kAvx2Kernels = SAMPLEUTIL_KERNELS(avx2);
+constexpr Kernels kAvx512Kernels = SAMPLEUTIL_KERNELS(avx512);
+#endif
+
+const Kernels* kernelsFor(SampleUtil::InstructionSet instructionSet) {
+    switch (instructionSet) {
+    case SampleUtil::InstructionSet::Baseline:
+        return &kBaselineKernels;
+#ifdef SAMPLEUTIL_DISPATCH
+    case SampleUtil::InstructionSet::Avx2:
+        return &kAvx2Kernels;
+    case SampleUtil::InstructionSet::Avx512:
+        return &kAvx512Kernels;
+#endif
+    default:
+        return nullptr;
+    }
+}
+
+// Constant initialized, i.e. valid before the dynamic initialization
+// below selects the best kernels
+std::atomic<SampleUtil::InstructionSet> s_instructionSet{
+        SampleUtil::InstructionSet::Baseline};
+std::atomic<const Kernels*> s_pKernels{&kBaselineKernels};
+
+SampleUtil::InstructionSet bestSupportedInstructionSet() {
+    if (SampleUtil::isInstructionSetSupported(SampleUtil::InstructionSet::Avx512)) {
+        return SampleUtil::InstructionSet::Avx512;
+    }
+    if (SampleUtil::isInstructionSetSupported(SampleUtil::InstructionSet::Avx2)) {
+        return SampleUtil::InstructionSet::Avx2;
+    }
+    return SampleUtil::InstructionSet::Baseline;
+}
+
+[[maybe_unused]] const bool s_kernelsSelected =
+        SampleUtil::setInstructionSet(bestSupportedInstructionSet());
+
+inline const Kernels& kernels() {
+    return *s_pKernels.load(std::memory_order_relaxed);
+}
+
 } // anonymous namespace
 
+// static
+bool SampleUtil::isInstructionSetSupported(InstructionSet instructionSet) {
+    switch (instructionSet) {
+    case InstructionSet::Baseline:
+        return true;
+#ifdef SAMPLEUTIL_DISPATCH
+    case InstructionSet::Avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case InstructionSet::Avx512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") &&
+                __builtin_cpu_supports("avx512vl") &&
+                isInstructionSetSupported(InstructionSet::Avx2);
+#endif
+    default:
+        return false;
+    }
+}
+
+// static
+SampleUtil::InstructionSet SampleUtil::instructionSet() {
+    return s_instructionSet.load(std::memory_order_relaxed);
+}
+
+// static
+bool SampleUtil::setInstructionSet(InstructionSet instructionSet) {
+    if (!isInstructionSetSupported(instructionSet)) {
+        return false;
+    }
+    const Kernels* pKernels = kernelsFor(instructionSet);
+    VERIFY_OR_DEBUG_ASSERT(pKernels) {
+        return false;
+    }
+    s_pKernels.store(pKernels, std::memory_order_relaxed);
+    s_instructionSet.store(instructionSet, std::memory_order_relaxed);
+    return true;
+}
+
 // static
 CSAMPLE* SampleUtil::alloc(SINT size) {
     // To speed up vectorization we align our sample buffers to 16-byte (128
@@ -119,10 +366,7 @@ void SampleUtil::applyGain(CSAMPLE* pBuffer, CSAMPLE_GAIN gain,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pBuffer[i] *= gain;
-    }
+    kernels().applyGain(pBuffer, gain, numSamples);
 }
 
 // static
@@ -140,18 +384,9 @@ void SampleUtil::applyRampingGain(CSAMPLE* pBuffer, CSAMPLE_GAIN old_gain,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta != 0) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            // a loop counter i += 2 prevents vectorizing.
-            pBuffer[i * 2] *= gain;
-            pBuffer[i * 2 + 1] *= gain;
-        }
+        kernels().applyRampingGain(pBuffer, start_gain, gain_delta, numSamples);
     } else {
-        // note: LOOP VECTORIZED.
-        for (int i = 0; i < numSamples; ++i) {
-            pBuffer[i] *= old_gain;
-        }
+        kernels().applyGain(pBuffer, old_gain, numSamples);
     }
 }
 
@@ -231,10 +466,7 @@ void SampleUtil::addWithGain(CSAMPLE* M_RESTRICT pDest,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pDest[i] += pSrc[i] * gain;
-    }
+    kernels().addWithGain(pDest, pSrc, gain, numSamples);
 }
 
 void SampleUtil::addWithRampingGain(CSAMPLE* M_RESTRICT pDest,
@@ -276,10 +508,7 @@ void SampleUtil::add2WithGain(CSAMPLE* M_RESTRICT pDest,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (int i = 0; i < numSamples; ++i) {
-        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2;
-    }
+    kernels().add2WithGain(pDest, pSrc1, gain1, pSrc2, gain2, numSamples);
 }
 
 // static
@@ -299,10 +528,7 @@ void SampleUtil::add3WithGain(CSAMPLE* pDest,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pDest[i] += pSrc1[i] * gain1 + pSrc2[i] * gain2 + pSrc3[i] * gain3;
-    }
+    kernels().add3WithGain(pDest, pSrc1, gain1, pSrc2, gain2, pSrc3, gain3, numSamples);
 }
 
 // static
@@ -318,10 +544,7 @@ void SampleUtil::copyWithGain(CSAMPLE* M_RESTRICT pDest,
         return;
     }
 
-    // note: LOOP VECTORIZED.
-    for (SINT i = 0; i < numSamples; ++i) {
-        pDest[i] = pSrc[i] * gain;
-    }
+    kernels().copyWithGain(pDest, pSrc, gain, numSamples);
 
     // OR! need to test which fares better
     // copy(pDest, pSrc, iNumSamples);
@@ -347,17 +570,9 @@ void SampleUtil::copyWithRampingGain(CSAMPLE* M_RESTRICT pDest,
             / CSAMPLE_GAIN(numSamples / 2);
     if (gain_delta != 0) {
         const CSAMPLE_GAIN start_gain = old_gain + gain_delta;
-        // note: LOOP VECTORIZED only with "int i" (not SINT i)
-        for (int i = 0; i < numSamples / 2; ++i) {
-            const CSAMPLE_GAIN gain = start_gain + gain_delta * i;
-            pDest[i * 2] = pSrc[i * 2] * gain;
-            pDest[i * 2 + 1] = pSrc[i * 2 + 1] * gain;
-        }
+        kernels().copyWithRampingGain(pDest, pSrc, start_gain, gain_delta, numSamples);
     } else {
-        // note: LOOP VECTORIZED.
-        for (SINT i = 0; i < numSamples; ++i) {
-            pDest[i] = pSrc[i] * old_gain;
-        }
+        kernels().copyWithGain(pDest, pSrc, old_gain, numSamples);
     }
 
     // OR! need to test which fares better
@@ -385,13 +600,7 @@ void SampleUtil::convertFloat32ToS16(SAMPLE* pDest, const CSAMPLE* pSrc,
     // We use here -SAMPLE_MINIMUM for a perfect round trip with convertS16ToFloat32
     // +1.0 is clamped to 32767 (0.99996942)
     DEBUG_ASSERT(-SAMPLE_MINIMUM >= SAMPLE_MAXIMUM);
-    const CSAMPLE kConversionFactor = SAMPLE_MINIMUM * -1.0f;
-    // note: LOOP VECTORIZED only with "int i" (not SINT i)
-    for (int i = 0; i < numSamples; ++i) {
-        pDest[i] = static_cast<SAMPLE>(math_clamp(pSrc[i] * kConversionFactor,
-                static_cast<CSAMPLE>(SAMPLE_MINIMUM),
-                static_cast<CSAMPLE>(SAMPLE_MAXIMUM)));
-    }
+    kernels().convertFloat32ToS16(pDest, pSrc, numSamples);
 }
 
 // static
@@ -25,6 +25,23 @@ class SampleUtil {
     // This is some legacy, we cannot easily revert.
     static constexpr double kPlayPositionChannels = 2.0;
 
+    // The instruction sets for which the loops of applyGain(),
+    // applyRampingGain(), addWithGain(), add2WithGain(), add3WithGain(),
+    // copyWithGain(), copyWithRampingGain() and convertFloat32ToS16()
+    // are compiled. The best one that is supported by the CPU is
+    // selected at startup.
+    enum class InstructionSet {
+        Baseline, // The instruction set of the build, e.g. SSE2
+        Avx2,     // AVX2 and FMA
+        Avx512,   // AVX-512 F and VL
+    };
+
+    static bool isInstructionSetSupported(InstructionSet instructionSet);
+    static InstructionSet instructionSet();
+    // Selects the loops for another instruction set, e.g. for comparing
+    // them in benchmarks. Returns false if it is not supported.
+    static bool setInstructionSet(InstructionSet instructionSet);
+
     // Allocated a buffer of CSAMPLE's with length size. Ensures that the buffer
     // is 16-byte aligned for SSE enhancement.
     static CSAMPLE* alloc(SINT size);
@@ -0,0 +1,150 @@
+#pragma once
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define MIXXX_STEREODOUBLE_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define MIXXX_STEREODOUBLE_NEON
+#endif
+
+#include "util/types.h"
+
+// A pair of double precision values for the left and the right channel
+// that are processed together.
+//
+// The pair fits into a single SSE2 or NEON register, which are part of
+// the base instruction set of all 64 bit targets. On other targets the
+// channels are processed one after the other.
+class StereoDouble {
+  public:
+    StereoDouble() = default;
+    StereoDouble(double left, double right) {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        m_value = _mm_set_pd(right, left);
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        const double values[2] = {left, right};
+        m_value = vld1q_f64(values);
+#else
+        m_left = left;
+        m_right = right;
+#endif
+    }
+
+    // Reads the two samples of an interleaved stereo frame
+    static StereoDouble fromFrame(const CSAMPLE* pFrame) {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return StereoDouble(_mm_cvtps_pd(_mm_castpd_ps(
+                _mm_load_sd(reinterpret_cast<const double*>(pFrame)))));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return StereoDouble(vcvt_f64_f32(vld1_f32(pFrame)));
+#else
+        return StereoDouble(pFrame[0], pFrame[1]);
+#endif
+    }
+
+    // Writes the two samples of an interleaved stereo frame
+    void toFrame(CSAMPLE* pFrame) const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        _mm_store_sd(reinterpret_cast<double*>(pFrame),
+                _mm_castps_pd(_mm_cvtpd_ps(m_value)));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        vst1_f32(pFrame, vcvt_f32_f64(m_value));
+#else
+        pFrame[0] = static_cast<CSAMPLE>(m_left);
+        pFrame[1] = static_cast<CSAMPLE>(m_right);
+#endif
+    }
+
+    double left() const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return _mm_cvtsd_f64(m_value);
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return vgetq_lane_f64(m_value, 0);
+#else
+        return m_left;
+#endif
+    }
+
+    double right() const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return _mm_cvtsd_f64(_mm_unpackhi_pd(m_value, m_value));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return vgetq_lane_f64(m_value, 1);
+#else
+        return m_right;
+#endif
+    }
+
+    StereoDouble operator+(StereoDouble other) const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return StereoDouble(_mm_add_pd(m_value, other.m_value));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return StereoDouble(vaddq_f64(m_value, other.m_value));
+#else
+        return StereoDouble(m_left + other.m_left, m_right + other.m_right);
+#endif
+    }
+
+    StereoDouble operator-(StereoDouble other) const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return StereoDouble(_mm_sub_pd(m_value, other.m_value));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return StereoDouble(vsubq_f64(m_value, other.m_value));
+#else
+        return StereoDouble(m_left - other.m_left, m_right - other.m_right);
+#endif
+    }
+
+    StereoDouble operator-() const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return StereoDouble(_mm_xor_pd(m_value, _mm_set1_pd(-0.0)));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return StereoDouble(vnegq_f64(m_value));
+#else
+        return StereoDouble(-m_left, -m_right);
+#endif
+    }
+
+    StereoDouble operator*(double factor) const {
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+        return StereoDouble(_mm_mul_pd(m_value, _mm_set1_pd(factor)));
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+        return StereoDouble(vmulq_n_f64(m_value, factor));
+#else
+        return StereoDouble(m_left * factor, m_right * factor);
+#endif
+    }
+
+    StereoDouble& operator+=(StereoDouble other) {
+        *this = *this + other;
+        return *this;
+    }
+
+    StereoDouble& operator-=(StereoDouble other) {
+        *this = *this - other;
+        return *this;
+    }
+
+  private:
+#if defined(MIXXX_STEREODOUBLE_SSE2)
+    explicit StereoDouble(__m128d value)
+            : m_value(value) {
+    }
+
+    __m128d m_value;
+#elif defined(MIXXX_STEREODOUBLE_NEON)
+    explicit StereoDouble(float64x2_t value)
+            : m_value(value) {
+    }
+
+    float64x2_t m_value;
+#else
+    double m_left;
+    double m_right;
+#endif
+};
+
+inline StereoDouble operator*(double factor, StereoDouble value) {
+    return value * factor;
+}
@@ -49,13 +49,13 @@ class WorkerThread : public QThread {
     ///
     /// Must not be invoked from the worker thread itself to
     /// avoid race conditions!
-    void suspend();
+    virtual void suspend();
 
     /// Resumes a suspended thread by waking it up.
     ///
     /// Must not be invoked from the worker thread itself to
     /// avoid race conditions!
-    void resume();
+    virtual void resume();
 
     /// Wakes up a sleeping thread. If the thread has been suspended
     /// it will fall asleep again. A suspended thread needs to be
@@ -79,6 +79,11 @@ class WorkerThread : public QThread {
         return m_stop.load();
     }
 
+    /// Non-blocking atomic read of the suspend flag.
+    bool isSuspended() const {
+        return m_suspend.load();
+    }
+
   protected:
     void run() final;
 
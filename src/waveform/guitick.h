@@ -9,9 +9,11 @@
 
 // A helper class that manages the "guiTickTime" COs, that drive updates of the
 // GUI from the VsyncThread at the user's configured FPS (possibly downsampled).
+// It also delivers the batched control changes to the skin widgets.
 class GuiTick {
   public:
     GuiTick();
+    ~GuiTick();
     void process();
 
   private:
@@ -35,12 +35,13 @@ void GLWaveformRendererFilteredSignal::draw(QPainter* painter, QPaintEvent* /*ev
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipmapLevel = getMipmapLevel(*waveform);
+    const int dataSize = waveform->getMipmapDataSize(mipmapLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipmapData(mipmapLevel);
     if (data == nullptr) {
         return;
     }
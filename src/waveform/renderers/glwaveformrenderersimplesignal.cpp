@@ -37,12 +37,13 @@ void GLWaveformRendererSimpleSignal::draw(QPainter* painter, QPaintEvent* /*even
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipmapLevel = getMipmapLevel(*waveform);
+    const int dataSize = waveform->getMipmapDataSize(mipmapLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipmapData(mipmapLevel);
     if (data == nullptr) {
         return;
     }
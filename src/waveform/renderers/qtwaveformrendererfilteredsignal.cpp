@@ -107,12 +107,13 @@ int QtWaveformRendererFilteredSignal::buildPolygon() {
         return 0;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipmapLevel = getMipmapLevel(*waveform);
+    const int dataSize = waveform->getMipmapDataSize(mipmapLevel);
     if (dataSize <= 1) {
         return 0;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipmapData(mipmapLevel);
     if (data == nullptr) {
         return 0;
     }
@@ -8,7 +8,6 @@
 #include "track/track.h"
 #include "widget/wwidget.h"
 #include "util/math.h"
-#include "util/painterscope.h"
 
 WaveformRendererFilteredSignal::WaveformRendererFilteredSignal(
         WaveformWidgetRenderer* waveformWidgetRenderer)
@@ -30,6 +29,13 @@ void WaveformRendererFilteredSignal::onSetup(const QDomNode& node) {
 
 void WaveformRendererFilteredSignal::draw(QPainter* painter,
                                           QPaintEvent* /*event*/) {
+    drawTiled(painter);
+}
+
+void WaveformRendererFilteredSignal::drawSignal(QPainter* painter,
+        double firstPosition,
+        double lastPosition,
+        int length) {
     const TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
     if (!trackInfo) {
         return;
@@ -40,34 +46,29 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipmapLevel = getMipmapLevel(*waveform, firstPosition, lastPosition, length);
+    const int dataSize = waveform->getMipmapDataSize(mipmapLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipmapData(mipmapLevel);
     if (data == nullptr) {
         return;
     }
 
-    PainterScope PainterScope(painter);
-
-    painter->setRenderHints(QPainter::Antialiasing, false);
-    painter->setRenderHints(QPainter::SmoothPixmapTransform, false);
-    painter->setWorldMatrixEnabled(false);
-    painter->resetTransform();
-
-    // Rotate if drawing vertical waveforms
-    if (m_waveformRenderer->getOrientation() == Qt::Vertical) {
-        painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
+    // The tiles of drawTiled() might be longer than the widget
+    if (m_lowLines.size() < static_cast<std::size_t>(length)) {
+        m_lowLines.resize(length);
+        m_midLines.resize(length);
+        m_highLines.resize(length);
     }
 
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    const double firstVisualIndex = firstPosition * dataSize;
+    const double lastVisualIndex = lastPosition * dataSize;
 
     // Represents the # of waveform data points per horizontal pixel.
-    const double gain = (lastVisualIndex - firstVisualIndex) /
-            (double)m_waveformRenderer->getLength();
+    const double gain = (lastVisualIndex - firstVisualIndex) / length;
 
     // Per-band gain from the EQ knobs.
     float allGain(1.0), lowGain(1.0), midGain(1.0), highGain(1.0);
@@ -83,14 +84,14 @@ void WaveformRendererFilteredSignal::draw(QPainter* painter,
     //draw reference line
     if (m_alignment == Qt::AlignCenter) {
         painter->setPen(m_pColors->getAxesColor());
-        painter->drawLine(QLineF(0, halfBreadth, m_waveformRenderer->getLength(), halfBreadth));
+        painter->drawLine(QLineF(0, halfBreadth, length, halfBreadth));
     }
 
     int actualLowLineNumber = 0;
     int actualMidLineNumber = 0;
     int actualHighLineNumber = 0;
 
-    for (int x = 0; x < m_waveformRenderer->getLength(); ++x) {
+    for (int x = 0; x < length; ++x) {
         // Width of the x position in visual indices.
         const double xSampleWidth = gain * x;
 
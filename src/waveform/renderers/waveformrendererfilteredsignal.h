@@ -16,6 +16,12 @@ class WaveformRendererFilteredSignal : public WaveformRendererSignalBase {
 
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
+  protected:
+    void drawSignal(QPainter* painter,
+            double firstPosition,
+            double lastPosition,
+            int length) override;
+
     virtual void onResize();
 
   private:
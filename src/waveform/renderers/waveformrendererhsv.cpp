@@ -7,7 +7,6 @@
 #include "track/track.h"
 #include "widget/wwidget.h"
 #include "util/math.h"
-#include "util/painterscope.h"
 
 WaveformRendererHSV::WaveformRendererHSV(
         WaveformWidgetRenderer* waveformWidgetRenderer)
@@ -23,6 +22,13 @@ void WaveformRendererHSV::onSetup(const QDomNode& node) {
 
 void WaveformRendererHSV::draw(QPainter* painter,
                                           QPaintEvent* /*event*/) {
+    drawTiled(painter);
+}
+
+void WaveformRendererHSV::drawSignal(QPainter* painter,
+        double firstPosition,
+        double lastPosition,
+        int length) {
     const TrackPointer trackInfo = m_waveformRenderer->getTrackInfo();
     if (!trackInfo) {
         return;
@@ -33,36 +39,24 @@ void WaveformRendererHSV::draw(QPainter* painter,
         return;
     }
 
-    const int dataSize = waveform->getDataSize();
+    const int mipmapLevel = getMipmapLevel(*waveform, firstPosition, lastPosition, length);
+    const int dataSize = waveform->getMipmapDataSize(mipmapLevel);
     if (dataSize <= 1) {
         return;
     }
 
-    const WaveformData* data = waveform->data();
+    const WaveformData* data = waveform->getMipmapData(mipmapLevel);
     if (data == nullptr) {
         return;
     }
 
-    PainterScope PainterScope(painter);
-
-    painter->setRenderHints(QPainter::Antialiasing, false);
-    painter->setRenderHints(QPainter::SmoothPixmapTransform, false);
-    painter->setWorldMatrixEnabled(false);
-    painter->resetTransform();
-
-    // Rotate if drawing vertical waveforms
-    if (m_waveformRenderer->getOrientation() == Qt::Vertical) {
-        painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
-    }
-
-    const double firstVisualIndex = m_waveformRenderer->getFirstDisplayedPosition() * dataSize;
-    const double lastVisualIndex = m_waveformRenderer->getLastDisplayedPosition() * dataSize;
+    const double firstVisualIndex = firstPosition * dataSize;
+    const double lastVisualIndex = lastPosition * dataSize;
 
     const double offset = firstVisualIndex;
 
     // Represents the # of waveform data points per horizontal pixel.
-    const double gain = (lastVisualIndex - firstVisualIndex) /
-            (double)m_waveformRenderer->getLength();
+    const double gain = (lastVisualIndex - firstVisualIndex) / length;
 
     float allGain(1.0);
     getGains(&allGain, nullptr, nullptr, nullptr);
@@ -89,9 +83,9 @@ void WaveformRendererHSV::draw(QPainter* painter,
 
     //draw reference line
     painter->setPen(m_pColors->getAxesColor());
-    painter->drawLine(QLineF(0, halfBreadth, m_waveformRenderer->getLength(), halfBreadth));
+    painter->drawLine(QLineF(0, halfBreadth, length, halfBreadth));
 
-    for (int x = 0; x < m_waveformRenderer->getLength(); ++x) {
+    for (int x = 0; x < length; ++x) {
         // Width of the x position in visual indices.
         const double xSampleWidth = gain * x;
 
@@ -13,6 +13,12 @@ class WaveformRendererHSV : public WaveformRendererSignalBase {
 
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
+  protected:
+    void drawSignal(QPainter* painter,
+            double firstPosition,
+            double lastPosition,
+            int length) override;
+
   private:
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererHSV);
 };
@@ -12,6 +12,12 @@ class WaveformRendererRGB : public WaveformRendererSignalBase {
     virtual void onSetup(const QDomNode& node);
     virtual void draw(QPainter* painter, QPaintEvent* event);
 
+  protected:
+    void drawSignal(QPainter* painter,
+            double firstPosition,
+            double lastPosition,
+            int length) override;
+
   private:
     DISALLOW_COPY_AND_ASSIGN(WaveformRendererRGB);
 };
@@ -1,14 +1,26 @@
 #include "waveformrenderersignalbase.h"
 
 #include <QDomNode>
+#include <QPainter>
+#include <cmath>
 
+#include "waveform/waveform.h"
 #include "waveform/waveformwidgetfactory.h"
 #include "waveformwidgetrenderer.h"
 #include "control/controlobject.h"
 #include "control/controlproxy.h"
+#include "track/track.h"
+#include "util/painterscope.h"
 #include "widget/wskincolor.h"
 #include "widget/wwidget.h"
 
+namespace {
+
+// The number of pixel columns of a tile of drawTiled()
+constexpr int kTileLength = 256;
+
+} // anonymous namespace
+
 WaveformRendererSignalBase::WaveformRendererSignalBase(
         WaveformWidgetRenderer* waveformWidgetRenderer)
         : WaveformRendererAbstract(waveformWidgetRenderer),
@@ -46,7 +58,8 @@ WaveformRendererSignalBase::WaveformRendererSignalBase(
           m_rgbMidColor_b(0),
           m_rgbHighColor_r(0),
           m_rgbHighColor_g(0),
-          m_rgbHighColor_b(0) {
+          m_rgbHighColor_b(0),
+          m_tileCompletion(-1) {
 }
 
 WaveformRendererSignalBase::~WaveformRendererSignalBase() {
@@ -169,6 +182,9 @@ void WaveformRendererSignalBase::setup(const QDomNode& node,
     const QColor& signal = m_pColors->getSignalColor();
     signal.getRgbF(&m_signalColor_r, &m_signalColor_g, &m_signalColor_b);
 
+    // The colors might have changed
+    m_tiles.clear();
+
     onSetup(node);
 }
 
@@ -226,3 +242,143 @@ void WaveformRendererSignalBase::getGains(float* pAllGain, float* pLowGain,
         }
     }
 }
+
+int WaveformRendererSignalBase::getMipmapLevel(const Waveform& waveform) const {
+    return getMipmapLevel(waveform,
+            m_waveformRenderer->getFirstDisplayedPosition(),
+            m_waveformRenderer->getLastDisplayedPosition(),
+            m_waveformRenderer->getLength());
+}
+
+int WaveformRendererSignalBase::getMipmapLevel(const Waveform& waveform,
+        double firstPosition,
+        double lastPosition,
+        int length) const {
+    if (length <= 0) {
+        return 0;
+    }
+    const double visualFramesPerPixel =
+            (lastPosition - firstPosition) * waveform.getDataSize() / 2.0 / length;
+    return waveform.getMipmapLevel(visualFramesPerPixel);
+}
+
+void WaveformRendererSignalBase::drawTiled(QPainter* painter) {
+    const TrackPointer pTrack = m_waveformRenderer->getTrackInfo();
+    if (!pTrack) {
+        return;
+    }
+    ConstWaveformPointer pWaveform = pTrack->getWaveform();
+    if (pWaveform.isNull() || pWaveform->getDataSize() <= 1) {
+        return;
+    }
+    const double trackPixelCount = m_waveformRenderer->getTrackPixelCount();
+    const int length = m_waveformRenderer->getLength();
+    if (trackPixelCount <= 0.0 || length <= 0) {
+        return;
+    }
+
+    TileParameters parameters;
+    parameters.pWaveform = pWaveform;
+    parameters.trackPixelCount = trackPixelCount;
+    parameters.breadth = m_waveformRenderer->getBreadth();
+    parameters.devicePixelRatio = m_waveformRenderer->getDevicePixelRatio();
+    getGains(&parameters.allGain,
+            &parameters.lowGain,
+            &parameters.midGain,
+            &parameters.highGain);
+    parameters.lowKill = m_pLowKillControlObject && m_pLowKillControlObject->get() != 0.0;
+    parameters.midKill = m_pMidKillControlObject && m_pMidKillControlObject->get() != 0.0;
+    parameters.highKill = m_pHighKillControlObject && m_pHighKillControlObject->get() != 0.0;
+    // The parameters change with every frame while the tempo or the gains
+    // are adjusted, so only render tiles once they have settled.
+    const bool parametersChanged = !(parameters == m_tileParameters);
+    if (parametersChanged) {
+        m_tiles.clear();
+        m_tileParameters = parameters;
+    }
+
+    const int completion = pWaveform->getCompletion();
+    if (completion != m_tileCompletion) {
+        // Redraw the tiles that have been drawn from incomplete data
+        auto it = m_tiles.begin();
+        while (it != m_tiles.end()) {
+            if (it->complete) {
+                ++it;
+            } else {
+                it = m_tiles.erase(it);
+            }
+        }
+        m_tileCompletion = completion;
+    }
+
+    PainterScope painterScope(painter);
+
+    painter->setRenderHints(QPainter::Antialiasing, false);
+    painter->setRenderHints(QPainter::SmoothPixmapTransform, false);
+    painter->setWorldMatrixEnabled(false);
+    painter->resetTransform();
+
+    // Rotate if drawing vertical waveforms
+    if (m_waveformRenderer->getOrientation() == Qt::Vertical) {
+        painter->setTransform(QTransform(0, 1, 1, 0, 0, 0));
+    }
+
+    if (parametersChanged) {
+        drawSignal(painter,
+                m_waveformRenderer->getFirstDisplayedPosition(),
+                m_waveformRenderer->getLastDisplayedPosition(),
+                length);
+        return;
+    }
+
+    // The tiles are aligned to the pixels of the whole track
+    const double firstPixel =
+            m_waveformRenderer->getFirstDisplayedPosition() * trackPixelCount;
+    const int firstTileIndex = static_cast<int>(std::floor(firstPixel / kTileLength));
+    const int lastTileIndex = static_cast<int>(
+            std::floor((firstPixel + length) / kTileLength));
+    for (int tileIndex = firstTileIndex; tileIndex <= lastTileIndex; ++tileIndex) {
+        auto it = m_tiles.find(tileIndex);
+        if (it == m_tiles.end()) {
+            it = m_tiles.insert(tileIndex, renderTile(tileIndex));
+        }
+        const double x = std::round(tileIndex * kTileLength - firstPixel);
+        painter->drawImage(QPointF(x, 0), it->image);
+    }
+
+    // Keep a tile on either side of the view for scrolling back and forth
+    auto it = m_tiles.begin();
+    while (it != m_tiles.end()) {
+        if (it.key() < firstTileIndex - 1 || it.key() > lastTileIndex + 1) {
+            it = m_tiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+WaveformRendererSignalBase::SignalTile WaveformRendererSignalBase::renderTile(int tileIndex) {
+    const float devicePixelRatio = m_tileParameters.devicePixelRatio;
+    SignalTile tile;
+    tile.image = QImage(static_cast<int>(kTileLength * devicePixelRatio),
+            static_cast<int>(m_tileParameters.breadth * devicePixelRatio),
+            QImage::Format_ARGB32_Premultiplied);
+    tile.image.setDevicePixelRatio(devicePixelRatio);
+    tile.image.fill(Qt::transparent);
+
+    const double trackPixelCount = m_tileParameters.trackPixelCount;
+    const double firstPosition = tileIndex * kTileLength / trackPixelCount;
+    const double lastPosition = (tileIndex + 1) * kTileLength / trackPixelCount;
+    {
+        QPainter painter(&tile.image);
+        painter.setRenderHints(QPainter::Antialiasing, false);
+        drawSignal(&painter, firstPosition, lastPosition, kTileLength);
+    }
+
+    // The columns at the end of the tile also take the visual samples of
+    // the next tile into account, so leave a margin of one tile.
+    const int dataSize = m_tileParameters.pWaveform->getDataSize();
+    tile.complete = m_tileCompletion >= dataSize ||
+            (2 * lastPosition - firstPosition) * dataSize < m_tileCompletion;
+    return tile;
+}
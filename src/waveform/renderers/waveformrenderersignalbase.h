@@ -1,5 +1,9 @@
 #pragma once
 
+#include <QHash>
+#include <QImage>
+
+#include "waveform/waveform.h"
 #include "waveformrendererabstract.h"
 #include "waveformsignalcolors.h"
 #include "skin/legacy/skincontext.h"
@@ -24,6 +28,38 @@ public:
     void getGains(float* pAllGain, float* pLowGain, float* pMidGain,
                   float* highGain);
 
+    // Returns the mipmap level of the waveform that has one to two visual
+    // frames per pixel at the current zoom. Renderers draw from this level
+    // so that the number of visual samples per pixel does not grow when
+    // zooming out.
+    int getMipmapLevel(const Waveform& waveform) const;
+    int getMipmapLevel(const Waveform& waveform,
+            double firstPosition,
+            double lastPosition,
+            int length) const;
+
+    // Draws the signal from a cache of image tiles. Each tile holds a fixed
+    // number of pixel columns of the whole track at the current zoom, so
+    // while the waveform scrolls only the tiles that enter the view are
+    // rendered with drawSignal() and the others are only copied. The cache
+    // is cleared when the zoom, the tempo, the size, the gains or the kills
+    // change, and the view is drawn with drawSignal() directly until they
+    // are the same as in the previous frame.
+    void drawTiled(QPainter* painter);
+
+    // Draws the signal between the track positions firstPosition and
+    // lastPosition into the pixel columns [0, length) of an unrotated
+    // painter. Renderers that use drawTiled() must implement this.
+    virtual void drawSignal(QPainter* painter,
+            double firstPosition,
+            double lastPosition,
+            int length) {
+        Q_UNUSED(painter);
+        Q_UNUSED(firstPosition);
+        Q_UNUSED(lastPosition);
+        Q_UNUSED(length);
+    }
+
   protected:
     ControlProxy* m_pEQEnabled;
     ControlProxy* m_pLowFilterControlObject;
@@ -48,4 +84,45 @@ public:
     qreal m_rgbLowFilteredColor_r, m_rgbLowFilteredColor_g, m_rgbLowFilteredColor_b;
     qreal m_rgbMidFilteredColor_r, m_rgbMidFilteredColor_g, m_rgbMidFilteredColor_b;
     qreal m_rgbHighFilteredColor_r, m_rgbHighFilteredColor_g, m_rgbHighFilteredColor_b;
+
+  private:
+    struct SignalTile {
+        QImage image;
+        // False if the tile has been drawn while the waveform was incomplete
+        bool complete;
+    };
+    // Everything that the pixels of the tiles depend on
+    struct TileParameters {
+        ConstWaveformPointer pWaveform;
+        double trackPixelCount = 0.0;
+        int breadth = 0;
+        float devicePixelRatio = 0.0f;
+        float allGain = 0.0f;
+        float lowGain = 0.0f;
+        float midGain = 0.0f;
+        float highGain = 0.0f;
+        bool lowKill = false;
+        bool midKill = false;
+        bool highKill = false;
+
+        bool operator==(const TileParameters& other) const {
+            return pWaveform == other.pWaveform &&
+                    trackPixelCount == other.trackPixelCount &&
+                    breadth == other.breadth &&
+                    devicePixelRatio == other.devicePixelRatio &&
+                    allGain == other.allGain &&
+                    lowGain == other.lowGain &&
+                    midGain == other.midGain &&
+                    highGain == other.highGain &&
+                    lowKill == other.lowKill &&
+                    midKill == other.midKill &&
+                    highKill == other.highKill;
+        }
+    };
+
+    SignalTile renderTile(int tileIndex);
+
+    QHash<int, SignalTile> m_tiles;
+    TileParameters m_tileParameters;
+    int m_tileCompletion;
 };
@@ -76,6 +76,10 @@ class WaveformWidgetRenderer {
         const double relativePosition = samplePosition / m_trackSamples;
         return transformPositionInRendererWorld(relativePosition);
     }
+    // The length of the whole track in pixels at the current zoom
+    double getTrackPixelCount() const {
+        return m_trackPixelCount;
+    }
     // Transform position (percentage of track) to pixel in track.
     inline double transformPositionInRendererWorld(double position) const {
         return m_trackPixelCount * (position - m_firstDisplayedPosition);
@@ -1,12 +1,32 @@
+#include <QDataStream>
 #include <QtDebug>
+#include <cmath>
+#include <cstring>
 
 #include "waveform/waveform.h"
 #include "proto/waveform.pb.h"
+#include "util/math.h"
 
 using namespace mixxx::track;
 
 constexpr int kNumChannels = 2;
 
+// The binary format starts with the magic and the format version, followed
+// by the visual sample rate, the audio visual ratio and the data size. The
+// header is followed by the data size visual samples, each one stored like
+// WaveformData as the bytes low, mid, high and all.
+const char kBinaryMagic[] = "MXWF";
+constexpr int kBinaryMagicLength = 4;
+constexpr quint32 kBinaryFormatVersion = 1;
+constexpr QDataStream::Version kBinaryDataStreamVersion = QDataStream::Qt_5_0;
+
+static_assert(sizeof(WaveformData) == 4,
+        "The binary format stores WaveformData as 4 bytes");
+
+// Levels up to a reduction by 64 cover the maximum zoom out even at high
+// rate ratios, without paying for levels that are never drawn.
+constexpr int kMaxMipmapLevels = 7;
+
 // Return the smallest power of 2 which is greater than the desired size when
 // squared.
 int computeTextureStride(int size) {
@@ -68,62 +88,28 @@ Waveform::~Waveform() {
 }
 
 QByteArray Waveform::toByteArray() const {
-    io::Waveform waveform;
-    waveform.set_visual_sample_rate(m_visualSampleRate);
-    waveform.set_audio_visual_ratio(m_audioVisualRatio);
-
-    io::Waveform::Signal* all = waveform.mutable_signal_all();
-    io::Waveform::FilteredSignal* filtered = waveform.mutable_signal_filtered();
-    // TODO(rryan) get the actual cutoff values from analyzerwaveform.cpp so
-    // that if they change we don't have to remember to update these.
-
-    // Frequency cutoffs for butterworth filters:
-    // filtered->set_low_cutoff_frequency(200);
-    // filtered->set_mid_low_cutoff_frequency(200);
-    // filtered->set_mid_high_cutoff_frequency(2000);
-    // filtered->set_high_cutoff_frequency(2000);
-
-    // Frequency cutoff for bessel_lowpass4
-    filtered->set_low_cutoff_frequency(600);
-    // Frequency cutoff for bessel_bandpass
-    filtered->set_mid_low_cutoff_frequency(600);
-    filtered->set_mid_high_cutoff_frequency(4000);
-    // Frequency cutoff for bessel_highpass4
-    filtered->set_high_cutoff_frequency(4000);
-
-    io::Waveform::Signal* low = filtered->mutable_low();
-    io::Waveform::Signal* mid = filtered->mutable_mid();
-    io::Waveform::Signal* high = filtered->mutable_high();
-
-    // TODO(vrince) set max/min for each signal
-    int numChannels = kNumChannels;
-    all->set_units(io::Waveform::RMS);
-    all->set_channels(numChannels);
-    low->set_units(io::Waveform::RMS);
-    low->set_channels(numChannels);
-    mid->set_units(io::Waveform::RMS);
-    mid->set_channels(numChannels);
-    high->set_units(io::Waveform::RMS);
-    high->set_channels(numChannels);
-
-    int dataSize = getDataSize();
-    for (int i = 0; i < dataSize; ++i) {
-        const WaveformData& datum = m_data.at(i);
-        all->add_value(datum.filtered.all);
-        low->add_value(datum.filtered.low);
-        mid->add_value(datum.filtered.mid);
-        high->add_value(datum.filtered.high);
-    }
+    const int dataSize = getDataSize();
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setVersion(kBinaryDataStreamVersion);
+    stream.writeRawData(kBinaryMagic, kBinaryMagicLength);
+    stream << kBinaryFormatVersion
+           << m_visualSampleRate
+           << m_audioVisualRatio
+           << static_cast<qint32>(dataSize);
+    stream.writeRawData(reinterpret_cast<const char*>(m_data.data()),
+            dataSize * static_cast<int>(sizeof(WaveformData)));
 
-    qDebug() << "Writing waveform from byte array:"
+    qDebug() << "Writing waveform to byte array:"
              << "dataSize" << dataSize
-             << "allSignalSize" << all->value_size()
-             << "visualSampleRate" << waveform.visual_sample_rate()
-             << "audioVisualRatio" << waveform.audio_visual_ratio();
+             << "visualSampleRate" << m_visualSampleRate
+             << "audioVisualRatio" << m_audioVisualRatio;
+    return data;
+}
 
-    std::string output;
-    waveform.SerializeToString(&output);
-    return QByteArray(output.data(), static_cast<int>(output.length()));
+// static
+bool Waveform::hasBinaryFormat(const QByteArray& data) {
+    return data.startsWith(kBinaryMagic);
 }
 
 void Waveform::readByteArray(const QByteArray& data) {
@@ -131,6 +117,51 @@ void Waveform::readByteArray(const QByteArray& data) {
         return;
     }
 
+    if (hasBinaryFormat(data)) {
+        readBinaryByteArray(data);
+    } else {
+        readProtobufByteArray(data);
+    }
+}
+
+void Waveform::readBinaryByteArray(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setVersion(kBinaryDataStreamVersion);
+    stream.skipRawData(kBinaryMagicLength);
+    quint32 formatVersion = 0;
+    double visualSampleRate = 0;
+    double audioVisualRatio = 0;
+    qint32 dataSize = 0;
+    stream >> formatVersion >> visualSampleRate >> audioVisualRatio >> dataSize;
+    if (stream.status() != QDataStream::Ok || formatVersion != kBinaryFormatVersion) {
+        qDebug() << "ERROR: Could not read Waveform header of version"
+                 << formatVersion << "from QByteArray of size" << data.size();
+        return;
+    }
+
+    const auto headerSize = static_cast<int>(stream.device()->pos());
+    const int dataBytes = data.size() - headerSize;
+    if (dataSize < 0 || dataBytes != dataSize * static_cast<int>(sizeof(WaveformData))) {
+        qDebug() << "ERROR: Waveform data size" << dataSize
+                 << "does not match the QByteArray of size" << data.size();
+        return;
+    }
+
+    qDebug() << "Reading waveform from byte array:"
+             << "dataSize" << dataSize
+             << "visualSampleRate" << visualSampleRate
+             << "audioVisualRatio" << audioVisualRatio;
+
+    resize(dataSize);
+    m_visualSampleRate = visualSampleRate;
+    m_audioVisualRatio = audioVisualRatio;
+    std::memcpy(m_data.data(), data.constData() + headerSize, dataBytes);
+    updateMipmaps(dataSize);
+    m_completion = dataSize;
+    m_saveState = SaveState::Saved;
+}
+
+void Waveform::readProtobufByteArray(const QByteArray& data) {
     io::Waveform waveform;
 
     if (!waveform.ParseFromArray(data.constData(), data.size())) {
@@ -193,6 +224,7 @@ void Waveform::readByteArray(const QByteArray& data) {
         m_data[i].filtered.mid = use_mid ? static_cast<unsigned char>(mid.value(i)) : 0;
         m_data[i].filtered.high = use_high ? static_cast<unsigned char>(high.value(i)) : 0;
     }
+    updateMipmaps(dataSize);
     m_completion = dataSize;
     m_saveState = SaveState::Saved;
 }
@@ -201,6 +233,7 @@ void Waveform::resize(int size) {
     m_dataSize = size;
     m_textureStride = computeTextureStride(size);
     m_data.resize(m_textureStride * m_textureStride);
+    allocateMipmaps();
 }
 
 void Waveform::assign(int size, int value) {
@@ -208,6 +241,64 @@ void Waveform::assign(int size, int value) {
     m_textureStride = computeTextureStride(size);
     m_data.assign(m_textureStride * m_textureStride, value);
     m_saveState = SaveState::SavePending;
+    allocateMipmaps();
+}
+
+void Waveform::allocateMipmaps() {
+    m_mipmapLevels.clear();
+    int frames = m_dataSize / kNumChannels;
+    int totalSize = 0;
+    while (frames > 1 && static_cast<int>(m_mipmapLevels.size()) + 1 < kMaxMipmapLevels) {
+        // Round up, so that the last visual frame of an odd number of frames
+        // is not dropped.
+        frames = (frames + 1) / 2;
+        m_mipmapLevels.push_back(MipmapLevel{totalSize, frames * kNumChannels, 0});
+        totalSize += frames * kNumChannels;
+    }
+    m_mipmapData.assign(totalSize, 0);
+}
+
+void Waveform::updateMipmaps(int completion) {
+    const bool complete = completion >= m_dataSize;
+    const WaveformData* pSource = data();
+    int sourceFrames = m_dataSize / kNumChannels;
+    int availableFrames = math_min(completion, m_dataSize) / kNumChannels;
+    for (auto& level : m_mipmapLevels) {
+        WaveformData* pTarget = &m_mipmapData[level.offset];
+        const int targetFrames = level.dataSize / kNumChannels;
+        // A visual frame can be computed when both of its source frames are
+        // available, or the last one if the waveform is complete.
+        const int computableFrames = complete ? targetFrames : availableFrames / 2;
+        if (computableFrames <= level.completedFrames) {
+            // The following levels are not affected either
+            break;
+        }
+        for (int frame = level.completedFrames; frame < computableFrames; ++frame) {
+            const int firstSourceFrame = 2 * frame;
+            const int secondSourceFrame = math_min(firstSourceFrame + 1, sourceFrames - 1);
+            for (int channel = 0; channel < kNumChannels; ++channel) {
+                const WaveformData& first = pSource[firstSourceFrame * kNumChannels + channel];
+                const WaveformData& second = pSource[secondSourceFrame * kNumChannels + channel];
+                WaveformData& target = pTarget[frame * kNumChannels + channel];
+                target.filtered.low = math_max(first.filtered.low, second.filtered.low);
+                target.filtered.mid = math_max(first.filtered.mid, second.filtered.mid);
+                target.filtered.high = math_max(first.filtered.high, second.filtered.high);
+                target.filtered.all = math_max(first.filtered.all, second.filtered.all);
+            }
+        }
+        level.completedFrames = computableFrames;
+        pSource = pTarget;
+        sourceFrames = targetFrames;
+        availableFrames = computableFrames;
+    }
+}
+
+int Waveform::getMipmapLevel(double visualFramesPerPixel) const {
+    if (!(visualFramesPerPixel >= 2.0)) {
+        return 0;
+    }
+    const int level = static_cast<int>(std::log2(visualFramesPerPixel));
+    return math_min(level, getMipmapLevelCount() - 1);
 }
 
 void Waveform::dump() const {
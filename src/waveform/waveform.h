@@ -70,7 +70,14 @@ class Waveform {
         m_description = description;
     }
 
+    // Serializes the waveform to a flat binary layout: a small header
+    // followed by the visual samples as an array of WaveformData, which is
+    // read back with a single copy. The constructor also reads the protobuf
+    // format of older versions.
     QByteArray toByteArray() const;
+    // Tells apart the binary layout of toByteArray() from the protobuf
+    // format of older versions.
+    static bool hasBinaryFormat(const QByteArray& data);
 
     // We do not lock the mutex since m_dataSize and m_visualSampleRate are not
     // changed after the constructor runs.
@@ -99,7 +106,9 @@ class Waveform {
     int getCompletion() const {
         return m_completion.loadAcquire();
     }
+    // Updates the mipmaps up to completion before publishing it.
     void setCompletion(int completion) {
+        updateMipmaps(completion);
         m_completion = completion;
     }
 
@@ -130,12 +139,37 @@ class Waveform {
     // constructor runs.
     const WaveformData* data() const { return &m_data[0];}
 
+    // The mipmaps are successively reduced copies of the waveform data. Each
+    // visual sample of level n + 1 holds the maximum of two visual samples of
+    // level n in each band, interleaved by channel like the data of level 0,
+    // which is the waveform data itself. They are allocated by the
+    // constructor and computed as the waveform is completed, so renderers
+    // can pick the level that matches the zoom and inspect a bounded number
+    // of visual samples per pixel. We do not lock the mutex since the levels
+    // are not resized after the constructor runs.
+    int getMipmapLevelCount() const {
+        return static_cast<int>(m_mipmapLevels.size()) + 1;
+    }
+    int getMipmapDataSize(int level) const {
+        return level == 0 ? m_dataSize : m_mipmapLevels[level - 1].dataSize;
+    }
+    const WaveformData* getMipmapData(int level) const {
+        return level == 0 ? data() : &m_mipmapData[m_mipmapLevels[level - 1].offset];
+    }
+    // Returns the coarsest level that still has at least one visual frame
+    // per pixel, given the number of visual frames of level 0 per pixel.
+    int getMipmapLevel(double visualFramesPerPixel) const;
+
     void dump() const;
 
   private:
     void readByteArray(const QByteArray& data);
+    void readBinaryByteArray(const QByteArray& data);
+    void readProtobufByteArray(const QByteArray& data);
     void resize(int size);
     void assign(int size, int value = 0);
+    void allocateMipmaps();
+    void updateMipmaps(int completion);
 
     inline WaveformData& at(int i) { return m_data[i];}
     inline unsigned char& low(int i) { return m_data[i].filtered.low;}
@@ -171,6 +205,18 @@ class Waveform {
     // stride is N. Not allowed to change after the constructor runs.
     int m_textureStride;
 
+    struct MipmapLevel {
+        // The offset of the level in m_mipmapData
+        int offset;
+        int dataSize;
+        // The number of visual frames that have been computed
+        int completedFrames;
+    };
+    // Levels 1 and up, level 0 is m_data. Not allowed to be resized after
+    // the constructor runs.
+    std::vector<MipmapLevel> m_mipmapLevels;
+    std::vector<WaveformData> m_mipmapData;
+
     // For performance, completion is shared as a QAtomicInt and does not lock
     // the mutex. The completion of the waveform calculation.
     QAtomicInt m_completion;
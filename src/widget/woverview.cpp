@@ -13,11 +13,14 @@
 #include "woverview.h"
 
 #include <QBrush>
+#include <QCache>
+#include <QHash>
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QPaintEvent>
 #include <QPainter>
 #include <QUrl>
+#include <QtConcurrentRun>
 #include <QtDebug>
 
 #include "analyzer/analyzerprogress.h"
@@ -39,17 +42,54 @@
 #include "widget/controlwidgetconnection.h"
 #include "wskincolor.h"
 
+namespace {
+
+// The cost of the cached images is counted in KiB
+constexpr int kImageCacheLimit = 16 * 1024;
+
+struct CachedImage {
+    QImage image;
+    // Needed to tell whether the image fits the current gain
+    float waveformPeak;
+    float diffGain;
+};
+
+// Complete overview images of recently loaded tracks, so that loading a
+// track again does not need to render its overview again. Only used from
+// the main thread.
+QCache<QString, CachedImage>& imageCache() {
+    static QCache<QString, CachedImage> s_imageCache(kImageCacheLimit);
+    return s_imageCache;
+}
+
+// The number of pixel rows that are cropped from both sides of the source
+// image to apply the visual gain
+float computeDiffGain(bool normalize, float visualGain, bool pixmapDone, float waveformPeak) {
+    if (normalize && pixmapDone && waveformPeak > 1) {
+        return 255 - waveformPeak - 1;
+    }
+    return 255.0f - (255.0f / visualGain);
+}
+
+void removeCachedImages(TrackId trackId) {
+    const QString prefix = trackId.toString() + QChar('_');
+    const auto keys = imageCache().keys();
+    for (const auto& key : keys) {
+        if (key.startsWith(prefix)) {
+            imageCache().remove(key);
+        }
+    }
+}
+
+} // anonymous namespace
+
 WOverview::WOverview(
         const QString& group,
         PlayerManager* pPlayerManager,
         UserSettingsPointer pConfig,
+        DrawWaveformPartFunction drawWaveformPart,
         QWidget* parent)
         : WWidget(parent),
-          m_actualCompletion(0),
-          m_pixmapDone(false),
-          m_waveformPeak(-1.0),
-          m_diffGain(0),
-          m_devicePixelRatio(1.0),
           m_group(group),
           m_pConfig(pConfig),
           m_endOfTrack(false),
@@ -68,7 +108,15 @@ WOverview::WOverview(
           m_b(0.0),
           m_analyzerProgress(kAnalyzerProgressUnknown),
           m_trackLoaded(false),
-          m_scaleFactor(1.0) {
+          m_scaleFactor(1.0),
+          m_drawWaveformPart(drawWaveformPart),
+          m_imageGeneration(0),
+          m_imageRequestPending(false),
+          m_actualCompletion(0),
+          m_pixmapDone(false),
+          m_waveformPeak(-1.0),
+          m_diffGain(0),
+          m_devicePixelRatio(1.0) {
     m_endOfTrackControl = new ControlProxy(
             m_group, "end_of_track", this, ControlFlag::NoAssertIfMissing);
     m_endOfTrackControl->connectValueChanged(this, &WOverview::onEndOfTrackChange);
@@ -96,6 +144,11 @@ WOverview::WOverview(
 
     connect(m_pCueMenuPopup.get(), &WCueMenuPopup::aboutToHide, this, &WOverview::slotCueMenuPopupAboutToHide);
 
+    connect(&m_imageWatcher,
+            &QFutureWatcher<ImageResult>::finished,
+            this,
+            &WOverview::slotImageRendered);
+
     m_pPassthroughLabel = new QLabel(this);
     m_pPassthroughLabel->setObjectName("PassthroughLabel");
     m_pPassthroughLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
@@ -120,6 +173,14 @@ void WOverview::setup(const QDomNode& node, const SkinContext& context) {
     m_playedOverlayColor = m_signalColors.getPlayedOverlayColor();
     m_lowColor = m_signalColors.getLowColor();
     m_dimBrightThreshold = m_signalColors.getDimBrightThreshold();
+    m_signalColorsKey = QStringList{
+            m_signalColors.getLowColor().name(QColor::HexArgb),
+            m_signalColors.getMidColor().name(QColor::HexArgb),
+            m_signalColors.getHighColor().name(QColor::HexArgb),
+            m_signalColors.getRgbLowColor().name(QColor::HexArgb),
+            m_signalColors.getRgbMidColor().name(QColor::HexArgb),
+            m_signalColors.getRgbHighColor().name(QColor::HexArgb)}
+                                .join(QChar('_'));
 
     m_labelBackgroundColor = context.selectColor(node, "LabelBackgroundColor");
     if (!m_labelBackgroundColor.isValid()) {
@@ -272,18 +333,17 @@ void WOverview::slotWaveformSummaryUpdated() {
     if (m_pWaveform) {
         // If the waveform is already complete, just draw it.
         if (m_pWaveform->getCompletion() == m_pWaveform->getDataSize()) {
-            m_actualCompletion = 0;
-            if (drawNextPixmapPart()) {
-                update();
-            }
+            resetImage();
+            requestImage();
+        } else {
+            // The track is being analyzed (again)
+            removeCachedImages(pTrack->getId());
         }
     } else {
         // Null waveform pointer means waveform was cleared.
-        m_waveformSourceImage = QImage();
+        removeCachedImages(pTrack->getId());
+        resetImage();
         m_analyzerProgress = kAnalyzerProgressUnknown;
-        m_actualCompletion = 0;
-        m_waveformPeak = -1.0;
-        m_pixmapDone = false;
 
         update();
     }
@@ -294,13 +354,217 @@ void WOverview::onTrackAnalyzerProgress(TrackId trackId, AnalyzerProgress analyz
         return;
     }
 
-    bool updateNeeded = drawNextPixmapPart();
-    if (updateNeeded || (m_analyzerProgress != analyzerProgress)) {
+    // The widget is updated when the image has been rendered
+    requestImage();
+    if (m_analyzerProgress != analyzerProgress) {
         m_analyzerProgress = analyzerProgress;
         update();
     }
 }
 
+void WOverview::requestImage() {
+    if (!m_pWaveform) {
+        return;
+    }
+    const int dataSize = m_pWaveform->getDataSize();
+    if (dataSize == 0) {
+        return;
+    }
+    if (m_imageWatcher.isRunning()) {
+        // Only one image is rendered at a time, because each rendering
+        // continues the source image of the previous one
+        m_imageRequestPending = true;
+        return;
+    }
+    m_imageRequestPending = false;
+
+    WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
+    const bool normalize = widgetFactory->isOverviewNormalized();
+    const auto visualGain = static_cast<float>(
+            widgetFactory->getVisualGain(WaveformWidgetFactory::All));
+    const QSize scaledSize = size() * m_devicePixelRatio;
+
+    // Always multiple of 2
+    const int waveformCompletion = m_pWaveform->getCompletion();
+    bool newData = false;
+    if (!m_pixmapDone) {
+        // Test if there is some new to draw (at least of pixel width)
+        const int completionIncrement = waveformCompletion - m_actualCompletion;
+        const int visiblePixelIncrement = completionIncrement * length() / dataSize;
+        newData = waveformCompletion >= (dataSize - 2) ||
+                (completionIncrement >= 2 && visiblePixelIncrement != 0);
+    }
+    const bool imageOutdated = m_waveformImageScaled.size() != scaledSize ||
+            m_diffGain !=
+                    computeDiffGain(normalize, visualGain, m_pixmapDone, m_waveformPeak);
+    if (!newData && !(imageOutdated && m_actualCompletion > 0)) {
+        return;
+    }
+
+    if (waveformCompletion == dataSize) {
+        const CachedImage* pCachedImage =
+                imageCache().object(imageCacheKey(
+                        *m_pWaveform, size(), m_devicePixelRatio));
+        if (pCachedImage &&
+                pCachedImage->diffGain ==
+                        computeDiffGain(normalize,
+                                visualGain,
+                                true,
+                                pCachedImage->waveformPeak)) {
+            m_waveformSourceImage = QImage();
+            m_waveformImageScaled = pCachedImage->image;
+            m_actualCompletion = dataSize;
+            m_waveformPeak = pCachedImage->waveformPeak;
+            m_pixmapDone = true;
+            m_diffGain = pCachedImage->diffGain;
+            update();
+            return;
+        }
+    }
+
+    // Continue the source image if there is one. The worker thread hands it
+    // back with the result.
+    const bool continueSourceImage = !m_waveformSourceImage.isNull();
+    const ImageRequest request{
+            m_imageGeneration,
+            m_pWaveform,
+            m_waveformSourceImage,
+            continueSourceImage ? m_actualCompletion : 0,
+            waveformCompletion,
+            continueSourceImage ? m_waveformPeak : -1.0f,
+            m_signalColors,
+            size(),
+            m_devicePixelRatio,
+            m_orientation,
+            normalize,
+            visualGain};
+    m_waveformSourceImage = QImage();
+    m_imageWatcher.setFuture(QtConcurrent::run(
+            &WOverview::renderImage, m_drawWaveformPart, request));
+}
+
+// static
+WOverview::ImageResult WOverview::renderImage(
+        DrawWaveformPartFunction drawWaveformPart,
+        ImageRequest request) {
+    ScopedTimer t("WOverview::renderImage");
+
+    ImageResult result;
+    result.sourceImage = request.sourceImage;
+    request.sourceImage = QImage();
+
+    const Waveform& waveform = *request.pWaveform;
+    if (result.sourceImage.isNull() || request.firstCompletion < request.lastCompletion) {
+        drawWaveformPart(&result.sourceImage,
+                waveform,
+                request.signalColors,
+                request.devicePixelRatio,
+                request.firstCompletion,
+                request.lastCompletion);
+    }
+
+    // Evaluate waveform ratio peak
+    result.waveformPeak = request.waveformPeak;
+    for (int currentCompletion = request.firstCompletion;
+            currentCompletion < request.lastCompletion;
+            currentCompletion += 2) {
+        result.waveformPeak = math_max3(
+                result.waveformPeak,
+                static_cast<float>(waveform.getAll(currentCompletion)),
+                static_cast<float>(waveform.getAll(currentCompletion + 1)));
+    }
+
+    // Test if the complete waveform is done
+    result.pixmapDone = request.lastCompletion >= waveform.getDataSize() - 2;
+
+    result.diffGain = computeDiffGain(request.normalize,
+            request.visualGain,
+            result.pixmapDone,
+            result.waveformPeak);
+    QRect sourceRect(0,
+            static_cast<int>(result.diffGain),
+            result.sourceImage.width(),
+            result.sourceImage.height() -
+                    2 * static_cast<int>(result.diffGain));
+    QImage croppedImage = result.sourceImage.copy(sourceRect);
+    if (request.orientation == Qt::Vertical) {
+        // Rotate pixmap
+        croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
+    }
+    result.scaledImage = croppedImage.scaled(request.size * request.devicePixelRatio,
+            Qt::IgnoreAspectRatio,
+            Qt::SmoothTransformation);
+
+    result.request = std::move(request);
+    return result;
+}
+
+void WOverview::slotImageRendered() {
+    const ImageResult result = m_imageWatcher.result();
+    // Discard images of a previous waveform
+    if (result.request.generation == m_imageGeneration) {
+        m_waveformSourceImage = result.sourceImage;
+        m_waveformImageScaled = result.scaledImage;
+        m_actualCompletion = result.request.lastCompletion;
+        m_waveformPeak = result.waveformPeak;
+        m_pixmapDone = result.pixmapDone;
+        m_diffGain = result.diffGain;
+
+        if (m_pixmapDone) {
+            const QString cacheKey = imageCacheKey(*result.request.pWaveform,
+                    result.request.size,
+                    result.request.devicePixelRatio);
+            if (!cacheKey.isNull()) {
+                const auto cost = static_cast<int>(result.scaledImage.sizeInBytes() / 1024);
+                imageCache().insert(cacheKey,
+                        new CachedImage{result.scaledImage, m_waveformPeak, m_diffGain},
+                        cost);
+            }
+        }
+        update();
+    }
+
+    if (m_imageRequestPending) {
+        requestImage();
+    }
+}
+
+void WOverview::resetImage() {
+    ++m_imageGeneration;
+    m_waveformSourceImage = QImage();
+    m_waveformImageScaled = QImage();
+    m_actualCompletion = 0;
+    m_waveformPeak = -1.0;
+    m_pixmapDone = false;
+    m_diffGain = 0;
+}
+
+QString WOverview::imageCacheKey(const Waveform& waveform,
+        const QSize& size,
+        qreal devicePixelRatio) const {
+    if (!m_pCurrentTrack || !m_pCurrentTrack->getId().isValid()) {
+        return QString();
+    }
+    // The track ID comes first for removeCachedImages()
+    return QStringList{
+            m_pCurrentTrack->getId().toString(),
+            // Tells apart the summaries of different analyses of the track,
+            // e.g. after the file has been modified or with another
+            // analyzer version. Only complete summaries are cached, so the
+            // data does not change anymore.
+            QString::number(qHashBits(waveform.data(),
+                                    sizeof(WaveformData) * waveform.getDataSize()),
+                    16),
+            // Distinguishes the LMH, HSV and RGB overviews
+            QString::number(reinterpret_cast<quintptr>(m_drawWaveformPart), 16),
+            QString::number(size.width()),
+            QString::number(size.height()),
+            QString::number(devicePixelRatio),
+            QString::number(m_orientation),
+            m_signalColorsKey}
+            .join(QChar('_'));
+}
+
 void WOverview::slotTrackLoaded(TrackPointer pTrack) {
     Q_UNUSED(pTrack); // only used in DEBUG_ASSERT
     //qDebug() << "WOverview::slotTrackLoaded()" << m_pCurrentTrack.get() << pTrack.get();
@@ -323,11 +587,8 @@ void WOverview::slotLoadingTrack(TrackPointer pNewTrack, TrackPointer pOldTrack)
                 &WOverview::slotWaveformSummaryUpdated);
     }
 
-    m_waveformSourceImage = QImage();
+    resetImage();
     m_analyzerProgress = kAnalyzerProgressUnknown;
-    m_actualCompletion = 0;
-    m_waveformPeak = -1.0;
-    m_pixmapDone = false;
     m_trackLoaded = false;
     m_endOfTrack = false;
 
@@ -651,42 +912,26 @@ void WOverview::drawAxis(QPainter* pPainter) {
 
 void WOverview::drawWaveformPixmap(QPainter* pPainter) {
     WaveformWidgetFactory* widgetFactory = WaveformWidgetFactory::instance();
-    if (!m_waveformSourceImage.isNull()) {
-        PainterScope painterScope(pPainter);
-        float diffGain;
-        bool normalize = widgetFactory->isOverviewNormalized();
-        if (normalize && m_pixmapDone && m_waveformPeak > 1) {
-            diffGain = 255 - m_waveformPeak - 1;
-        } else {
-            const auto visualGain = static_cast<float>(
-                    widgetFactory->getVisualGain(WaveformWidgetFactory::All));
-            diffGain = 255.0f - (255.0f / visualGain);
-        }
-
-        if (m_diffGain != diffGain || m_waveformImageScaled.isNull()) {
-            QRect sourceRect(0,
-                    static_cast<int>(diffGain),
-                    m_waveformSourceImage.width(),
-                    m_waveformSourceImage.height() -
-                            2 * static_cast<int>(diffGain));
-            QImage croppedImage = m_waveformSourceImage.copy(sourceRect);
-            if (m_orientation == Qt::Vertical) {
-                // Rotate pixmap
-                croppedImage = croppedImage.transformed(QTransform(0, 1, 1, 0, 0, 0));
-            }
-            m_waveformImageScaled = croppedImage.scaled(size() * m_devicePixelRatio,
-                    Qt::IgnoreAspectRatio,
-                    Qt::SmoothTransformation);
-            m_diffGain = diffGain;
-        }
+    const auto visualGain = static_cast<float>(
+            widgetFactory->getVisualGain(WaveformWidgetFactory::All));
+    const float diffGain = computeDiffGain(widgetFactory->isOverviewNormalized(),
+            visualGain,
+            m_pixmapDone,
+            m_waveformPeak);
+    if (m_diffGain != diffGain) {
+        // Keep drawing the current image until it has been rendered with
+        // the new gain
+        requestImage();
+    }
 
+    if (!m_waveformImageScaled.isNull()) {
         pPainter->drawImage(rect(), m_waveformImageScaled);
     }
 }
 
 void WOverview::drawPlayedOverlay(QPainter* pPainter) {
     // Overlay the played part of the overview-waveform with a skin defined color
-    if (!m_waveformSourceImage.isNull() && m_playedOverlayColor.alpha() > 0) {
+    if (!m_waveformImageScaled.isNull() && m_playedOverlayColor.alpha() > 0) {
         if (m_orientation == Qt::Vertical) {
             pPainter->fillRect(0,
                     0,
@@ -1211,7 +1456,7 @@ void WOverview::drawMarkLabels(QPainter* pPainter, const float offset, const flo
 }
 
 void WOverview::drawPassthroughOverlay(QPainter* pPainter) {
-    if (!m_waveformSourceImage.isNull() && m_passthroughOverlayColor.alpha() > 0) {
+    if (!m_waveformImageScaled.isNull() && m_passthroughOverlayColor.alpha() > 0) {
         // Overlay the entire overview-waveform with a skin defined color
         pPainter->fillRect(rect(), m_passthroughOverlayColor);
     }
@@ -1268,8 +1513,9 @@ void WOverview::resizeEvent(QResizeEvent* pEvent) {
 
     m_devicePixelRatio = devicePixelRatioF();
 
-    m_waveformImageScaled = QImage();
-    m_diffGain = 0;
+    // Keep drawing the stretched image until it has been rendered for the
+    // new size
+    requestImage();
     Init();
 }
 
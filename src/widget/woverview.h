@@ -12,6 +12,8 @@
 #pragma once
 
 #include <QColor>
+#include <QFutureWatcher>
+#include <QImage>
 #include <QList>
 #include <QMouseEvent>
 #include <QPaintEvent>
@@ -51,10 +53,21 @@ class WOverview : public WWidget, public TrackDropTarget {
     void cloneDeck(const QString& sourceGroup, const QString& targetGroup) override;
 
   protected:
+    // Draws the visual samples [firstCompletion, lastCompletion) of the
+    // waveform into the source image, which is created on the first call.
+    // This is called from a worker thread, so it must only use its arguments.
+    typedef void (*DrawWaveformPartFunction)(QImage* pSourceImage,
+            const Waveform& waveform,
+            const WaveformSignalColors& signalColors,
+            qreal devicePixelRatio,
+            int firstCompletion,
+            int lastCompletion);
+
     WOverview(
             const QString& group,
             PlayerManager* pPlayerManager,
             UserSettingsPointer pConfig,
+            DrawWaveformPartFunction drawWaveformPart,
             QWidget* parent = nullptr);
 
     void mouseMoveEvent(QMouseEvent* e) override;
@@ -78,20 +91,6 @@ class WOverview : public WWidget, public TrackDropTarget {
         return m_pWaveform;
     }
 
-    QImage m_waveformSourceImage;
-    QImage m_waveformImageScaled;
-
-    WaveformSignalColors m_signalColors;
-
-    // Hold the last visual sample processed to generate the pixmap
-    int m_actualCompletion;
-
-    bool m_pixmapDone;
-    float m_waveformPeak;
-
-    float m_diffGain;
-    qreal m_devicePixelRatio;
-
   private slots:
     void onEndOfTrackChange(double v);
 
@@ -103,11 +102,49 @@ class WOverview : public WWidget, public TrackDropTarget {
 
     void slotWaveformSummaryUpdated();
     void slotCueMenuPopupAboutToHide();
+    void slotImageRendered();
 
   private:
-    // Append the waveform overview pixmap according to available data
-    // in waveform
-    virtual bool drawNextPixmapPart() = 0;
+    // Everything that the worker thread needs to render the overview image
+    struct ImageRequest {
+        int generation;
+        ConstWaveformPointer pWaveform;
+        QImage sourceImage;
+        int firstCompletion;
+        int lastCompletion;
+        float waveformPeak;
+        WaveformSignalColors signalColors;
+        QSize size;
+        qreal devicePixelRatio;
+        Qt::Orientation orientation;
+        bool normalize;
+        float visualGain;
+    };
+    struct ImageResult {
+        ImageRequest request;
+        // The source image and waveform peak up to request.lastCompletion
+        QImage sourceImage;
+        float waveformPeak;
+        bool pixmapDone;
+        // The image to blit, with the size and device pixel ratio of the request
+        QImage scaledImage;
+        float diffGain;
+    };
+
+    // Renders the overview image for the request. This runs in a worker
+    // thread.
+    static ImageResult renderImage(
+            DrawWaveformPartFunction drawWaveformPart,
+            ImageRequest request);
+
+    // Starts rendering the overview image in a worker thread if there is
+    // new waveform data, or if the size or the gain has changed. Complete
+    // images are taken from a cache that is shared by all overviews.
+    void requestImage();
+    void resetImage();
+    QString imageCacheKey(const Waveform& waveform,
+            const QSize& size,
+            qreal devicePixelRatio) const;
     void drawEndOfTrackBackground(QPainter* pPainter);
     void drawAxis(QPainter* pPainter);
     void drawWaveformPixmap(QPainter* pPainter);
@@ -196,4 +233,30 @@ class WOverview : public WWidget, public TrackDropTarget {
     AnalyzerProgress m_analyzerProgress;
     bool m_trackLoaded;
     double m_scaleFactor;
+
+    WaveformSignalColors m_signalColors;
+    // Identifies the colors of m_signalColors in the image cache key
+    QString m_signalColorsKey;
+
+    const DrawWaveformPartFunction m_drawWaveformPart;
+    QFutureWatcher<ImageResult> m_imageWatcher;
+    // Incremented when the waveform changes, so that images that are
+    // rendered for the previous waveform are discarded
+    int m_imageGeneration;
+    bool m_imageRequestPending;
+
+    // Full range rendering of the waveform, scaled and cropped in the
+    // worker thread to m_waveformImageScaled. It is null if
+    // m_waveformImageScaled has been taken from the cache.
+    QImage m_waveformSourceImage;
+    QImage m_waveformImageScaled;
+
+    // Hold the last visual sample processed to generate the pixmap
+    int m_actualCompletion;
+
+    bool m_pixmapDone;
+    float m_waveformPeak;
+
+    float m_diffGain;
+    qreal m_devicePixelRatio;
 };
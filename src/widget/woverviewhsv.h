@@ -11,5 +11,10 @@ class WOverviewHSV : public WOverview {
             QWidget* parent = nullptr);
 
   private:
-    bool drawNextPixmapPart() override;
+    static void drawWaveformPart(QImage* pSourceImage,
+            const Waveform& waveform,
+            const WaveformSignalColors& signalColors,
+            qreal devicePixelRatio,
+            int firstCompletion,
+            int lastCompletion);
 };